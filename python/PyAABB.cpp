@@ -9,6 +9,7 @@
 #include <CGAL/AABBTree2.h>
 #endif
 #include <BVH/BVHEngine.h>
+#include <BVH/AttributeTransfer.h>
 
 namespace py = pybind11;
 using namespace PyMesh;
@@ -126,4 +127,16 @@ void init_BVH(py::module &m) {
                         closest_points,
                         closest_face_normals);
                 });
+
+    py::class_<AttributeTransfer, std::shared_ptr<AttributeTransfer> >(
+            m, "AttributeTransfer")
+        .def(py::init<Mesh::Ptr, BVHEngine::Ptr>())
+        .def(py::init<Mesh::Ptr>())
+        .def("transfer", &AttributeTransfer::transfer)
+        .def("transfer_vertex_attributes",
+                &AttributeTransfer::transfer_vertex_attributes)
+        .def("transfer_face_attributes",
+                &AttributeTransfer::transfer_face_attributes)
+        .def("transfer_corner_attributes",
+                &AttributeTransfer::transfer_corner_attributes);
 }
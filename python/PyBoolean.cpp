@@ -6,6 +6,7 @@
 
 #include <Boolean/BooleanEngine.h>
 #include <Boolean/CSGTree.h>
+#include <Boolean/NaryBooleanEngine.h>
 
 namespace py = pybind11;
 using namespace PyMesh;
@@ -42,4 +43,20 @@ void init_Boolean(py::module& m) {
         .def("get_faces", &CSGTree::get_faces)
         .def("get_num_vertices", &CSGTree::get_num_vertices)
         .def("get_num_faces", &CSGTree::get_num_faces);
+
+    py::class_<NaryBooleanEngine, std::shared_ptr<NaryBooleanEngine> >(
+            m, "NaryBooleanEngine")
+        .def_static("create", &NaryBooleanEngine::create)
+        .def("add_mesh", &NaryBooleanEngine::add_mesh)
+        .def("get_num_meshes", &NaryBooleanEngine::get_num_meshes)
+        .def("clear", &NaryBooleanEngine::clear)
+        .def("set_expression", &NaryBooleanEngine::set_expression)
+        .def("compute", &NaryBooleanEngine::compute)
+        .def("compute_union", &NaryBooleanEngine::compute_union)
+        .def("compute_intersection",
+                &NaryBooleanEngine::compute_intersection)
+        .def("get_vertices", &NaryBooleanEngine::get_vertices)
+        .def("get_faces", &NaryBooleanEngine::get_faces)
+        .def("get_face_sources", &NaryBooleanEngine::get_face_sources)
+        .def("get_mesh_sources", &NaryBooleanEngine::get_mesh_sources);
 }
@@ -17,5 +17,11 @@ void init_Compression(py::module& m) {
                 const auto data = engine->compress(mesh);
                 return py::bytes(data);
                 })
-        .def("decompress", &CompressionEngine::decompress);
+        .def("decompress", &CompressionEngine::decompress)
+        .def("set_speed", &CompressionEngine::set_speed)
+        .def("set_position_quantization_bits",
+                &CompressionEngine::set_position_quantization_bits)
+        .def("set_attribute_quantization_bits",
+                &CompressionEngine::set_attribute_quantization_bits)
+        .def("set_chunk_size", &CompressionEngine::set_chunk_size);
 }
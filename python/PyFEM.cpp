@@ -30,5 +30,13 @@ void init_FEM(py::module& m) {
         .def_static("create", &FEAssembler::create)
         .def_static("create_from_name", &FEAssembler::create_from_name)
         .def("assemble", &FEAssembler::assemble)
+        .def("apply",
+                [](FEAssembler& self, const std::string& matrix_name,
+                    const VectorF& x) {
+                    VectorF y;
+                    self.get_linear_operator(matrix_name)(x, y);
+                    return y;
+                })
+        .def("assemble_diagonal", &FEAssembler::assemble_diagonal)
         .def("set_material", &FEAssembler::set_material);
 }
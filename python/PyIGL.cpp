@@ -43,6 +43,9 @@ void init_IGL(py::module &m) {
                 &HarmonicSolver::get_boundary_values,
                 &HarmonicSolver::set_boundary_values,
                 py::return_value_policy::reference_internal)
+        .def_property("solver_type",
+                &HarmonicSolver::get_solver_type,
+                &HarmonicSolver::set_solver_type)
         .def("pre_process", &HarmonicSolver::pre_process)
         .def("solve", &HarmonicSolver::solve)
         .def_property_readonly("solution",
@@ -20,9 +20,11 @@
 #include <MeshUtils/DuplicatedVertexRemoval.h>
 #include <MeshUtils/IsolatedVertexRemoval.h>
 #include <MeshUtils/LongEdgeRemoval.h>
+#include <MeshUtils/IsotropicRemesher.h>
 #include <MeshUtils/FinFaceRemoval.h>
 #include <MeshUtils/DegeneratedTriangleRemoval.h>
 #include <MeshUtils/FaceUtils.h>
+#include <MeshUtils/TetQuality.h>
 #include <MeshUtils/VoxelUtils.h>
 
 namespace py = pybind11;
@@ -61,7 +63,10 @@ void init_MeshUtils(py::module& m) {
     m.def("get_degenerated_faces", &FaceUtils::get_degenerated_faces);
     m.def("get_triangle_orientations", &FaceUtils::get_triangle_orientations);
     m.def("get_tet_orientations", &VoxelUtils::get_tet_orientations);
-    m.def("is_delaunay", &VoxelUtils::is_delaunay);
+    m.def("is_delaunay", &VoxelUtils::is_delaunay,
+            "vertices"_a, "tets"_a, "early_exit"_a=false);
+    m.def("is_globally_delaunay", &VoxelUtils::is_globally_delaunay,
+            "vertices"_a, "tets"_a, "early_exit"_a=false);
     m.def("is_vertex_manifold", &ManifoldCheck::is_vertex_manifold);
     m.def("is_edge_manifold", &ManifoldCheck::is_edge_manifold);
     m.def("cut_to_manifold", &ManifoldCheck::cut_to_manifold);
@@ -71,7 +76,8 @@ void init_MeshUtils(py::module& m) {
         .def(py::init<MatrixFr&, MatrixIr&>())
         .def("run", &ObtuseTriangleRemoval::run)
         .def("get_vertices", &ObtuseTriangleRemoval::get_vertices)
-        .def("get_faces", &ObtuseTriangleRemoval::get_faces);
+        .def("get_faces", &ObtuseTriangleRemoval::get_faces)
+        .def("get_face_indices", &ObtuseTriangleRemoval::get_face_indices);
 
     py::class_<ShortEdgeRemoval>(m, "ShortEdgeRemoval")
         .def(py::init<const MatrixFr&, const MatrixIr&>())
@@ -106,7 +112,10 @@ void init_MeshUtils(py::module& m) {
         .def("has_complex_boundary", &MeshChecker::has_complex_boundary)
         .def("get_num_boundary_edges", &MeshChecker::get_num_boundary_edges)
         .def("get_num_boundary_loops", &MeshChecker::get_num_boundary_loops)
-        .def("get_boundary_edges", &MeshChecker::get_boundary_edges)
+        // Boundary edges are computed once in the constructor, so a view is
+        // safe.  Results of engines that can be re-run are returned as copies.
+        .def("get_boundary_edges", &MeshChecker::get_boundary_edges,
+                py::return_value_policy::reference_internal)
         .def("get_boundary_loops", &MeshChecker::get_boundary_loops)
         .def("get_genus", &MeshChecker::get_genus)
         .def("get_euler_characteristic",
@@ -166,6 +175,31 @@ void init_MeshUtils(py::module& m) {
         .def("get_faces", &LongEdgeRemoval::get_faces)
         .def("get_ori_faces", &LongEdgeRemoval::get_ori_faces);
 
+    py::class_<IsotropicRemesher>(m, "IsotropicRemesher")
+        .def(py::init<const MatrixFr&, const MatrixIr&>())
+        .def("set_target_length", &IsotropicRemesher::set_target_length)
+        .def("set_sizing_field", &IsotropicRemesher::set_sizing_field)
+        .def("run", &IsotropicRemesher::run, "num_iterations"_a=10)
+        .def("get_vertices", &IsotropicRemesher::get_vertices)
+        .def("get_faces", &IsotropicRemesher::get_faces)
+        .def("get_num_splits", &IsotropicRemesher::get_num_splits)
+        .def("get_num_collapses", &IsotropicRemesher::get_num_collapses)
+        .def("get_num_flips", &IsotropicRemesher::get_num_flips);
+
+    py::class_<TetQuality>(m, "TetQuality")
+        .def(py::init<>())
+        .def("run", &TetQuality::run)
+        .def("get_volumes", &TetQuality::get_volumes)
+        .def("get_orientations", &TetQuality::get_orientations)
+        .def("get_dihedral_angles", &TetQuality::get_dihedral_angles)
+        .def("get_inradii", &TetQuality::get_inradii)
+        .def("get_circumradii", &TetQuality::get_circumradii)
+        .def("get_radius_edge_ratios", &TetQuality::get_radius_edge_ratios)
+        .def("get_min_edge_lengths", &TetQuality::get_min_edge_lengths)
+        .def("get_max_edge_lengths", &TetQuality::get_max_edge_lengths)
+        .def_static("compute_histogram", &TetQuality::compute_histogram,
+                "values"_a, "min_value"_a, "max_value"_a, "num_bins"_a);
+
     py::class_<FinFaceRemoval>(m, "FinFaceRemoval")
         .def(py::init<const MatrixFr&, const MatrixIr&>())
         .def("set_fins_only", &FinFaceRemoval::set_fins_only)
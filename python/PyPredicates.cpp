@@ -8,10 +8,12 @@ extern "C"
 {
 #include <Predicates/predicates.h>
 }
+#include <Predicates/BatchPredicates.h>
 
 namespace py = pybind11;
 using Arr2D = Eigen::Matrix<double, 2, 1>;
 using Arr3D = Eigen::Matrix<double, 3, 1>;
+using PyMesh::MatrixFr;
 
 void init_predicates(py::module& m) {
     m.def("exactinit", &exactinit);
@@ -47,4 +49,25 @@ void init_predicates(py::module& m) {
             [](Arr3D& pa, Arr3D& pb, Arr3D& pc, Arr3D& pd, Arr3D& pe) {
             return insphereexact(pa.data(), pb.data(), pc.data(), pd.data(), pe.data());
             });
+
+    // Batched predicates, each argument is a N x dim array of points.
+    m.def("orient2d_batch",
+            [](const MatrixFr& pa, const MatrixFr& pb, const MatrixFr& pc) {
+            return PyMesh::BatchPredicates::orient2d(pa, pb, pc);
+            });
+    m.def("orient3d_batch",
+            [](const MatrixFr& pa, const MatrixFr& pb, const MatrixFr& pc,
+                const MatrixFr& pd) {
+            return PyMesh::BatchPredicates::orient3d(pa, pb, pc, pd);
+            });
+    m.def("incircle_batch",
+            [](const MatrixFr& pa, const MatrixFr& pb, const MatrixFr& pc,
+                const MatrixFr& pd) {
+            return PyMesh::BatchPredicates::incircle(pa, pb, pc, pd);
+            });
+    m.def("insphere_batch",
+            [](const MatrixFr& pa, const MatrixFr& pb, const MatrixFr& pc,
+                const MatrixFr& pd, const MatrixFr& pe) {
+            return PyMesh::BatchPredicates::insphere(pa, pb, pc, pd, pe);
+            });
 }
@@ -2,6 +2,7 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/eigen.h>
+#include <pybind11/functional.h>
 #include <pybind11/stl.h>
 
 #include <SparseSolver/SparseSolver.h>
@@ -19,9 +20,21 @@ void init_SparseSolver(py::module& m) {
         .def_property("max_iterations",
                 &SparseSolver::get_max_iterations,
                 &SparseSolver::set_max_iterations)
+        .def_property("block_size",
+                &SparseSolver::get_block_size,
+                &SparseSolver::set_block_size)
         .def("compute", &SparseSolver::compute)
         .def("analyze_pattern", &SparseSolver::analyze_pattern)
         .def("factorize", &SparseSolver::factorize)
+        .def("set_linear_operator",
+                [](SparseSolver& self, size_t size,
+                    const std::function<VectorF(const VectorF&)>& op,
+                    const VectorF& diagonal) {
+                    self.set_linear_operator(size,
+                            [op](const VectorF& x, VectorF& y) { y = op(x); },
+                            diagonal);
+                }, py::arg("size"), py::arg("op"),
+                py::arg("diagonal")=VectorF())
         .def("test", &SparseSolver::test)
         .def("solve", &SparseSolver::solve);
 }
@@ -27,4 +27,22 @@ void init_VoxelGrid(py::module &m) {
         .def("dilate", &VoxelGrid<3>::dilate)
         .def("remove_cavities", &VoxelGrid<3>::remove_cavities)
         .def("get_voxel_mesh", &VoxelGrid<3>::get_voxel_mesh);
+
+    py::class_<SparseVoxelGrid2D, std::shared_ptr<SparseVoxelGrid2D> >(m, "SparseVoxelGrid2D")
+        .def(py::init<Float>())
+        .def("insert_mesh", &SparseVoxelGrid2D::insert_mesh)
+        .def("create_grid", &SparseVoxelGrid2D::create_grid)
+        .def("erode", &SparseVoxelGrid2D::erode)
+        .def("dilate", &SparseVoxelGrid2D::dilate)
+        .def("remove_cavities", &SparseVoxelGrid2D::remove_cavities)
+        .def("get_voxel_mesh", &SparseVoxelGrid2D::get_voxel_mesh);
+
+    py::class_<SparseVoxelGrid3D, std::shared_ptr<SparseVoxelGrid3D> >(m, "SparseVoxelGrid3D")
+        .def(py::init<Float>())
+        .def("insert_mesh", &SparseVoxelGrid3D::insert_mesh)
+        .def("create_grid", &SparseVoxelGrid3D::create_grid)
+        .def("erode", &SparseVoxelGrid3D::erode)
+        .def("dilate", &SparseVoxelGrid3D::dilate)
+        .def("remove_cavities", &SparseVoxelGrid3D::remove_cavities)
+        .def("get_voxel_mesh", &SparseVoxelGrid3D::get_voxel_mesh);
 }
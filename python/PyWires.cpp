@@ -85,6 +85,8 @@ void init_Wires(py::module &m) {
         .def("set_dofs", &ParameterManager::set_dofs)
         .def("compute_shape_velocity",
                 &ParameterManager::compute_shape_velocity)
+        .def("compute_shape_velocity_tensor",
+                &ParameterManager::compute_shape_velocity_tensor)
         .def("compute_wire_gradient", &ParameterManager::compute_wire_gradient)
         .def("get_thickness_dof_map", &ParameterManager::get_thickness_dof_map)
         .def("get_offset_dof_map", &ParameterManager::get_offset_dof_map)
@@ -98,6 +100,10 @@ void init_Wires(py::module &m) {
         .def("evaluate_offset_no_formula",
                 &ParameterManager::evaluate_offset_no_formula)
         .def("evaluate_offset", &ParameterManager::evaluate_offset)
+        .def("evaluate_thickness_batch",
+                &ParameterManager::evaluate_thickness_batch)
+        .def("evaluate_offset_batch",
+                &ParameterManager::evaluate_offset_batch)
         .def("get_thickness_type", &ParameterManager::get_thickness_type)
         .def("set_thickness_type", &ParameterManager::set_thickness_type)
         .def("add_thickness_parameter",
@@ -40,6 +40,19 @@ class Assembler:
     def assemble(self, matrix_name):
         return self.__raw_assembler.assemble(matrix_name);
 
+    def apply(self, matrix_name, x):
+        """ Compute ``A * x`` without assembling ``A``.  Only ``stiffness``
+        is supported.  Together with :py:meth:`assemble_diagonal`, this can
+        be used as a matrix-free operator for
+        :py:meth:`pymesh.SparseSolver.set_linear_operator`.
+        """
+        return self.__raw_assembler.apply(matrix_name, x);
+
+    def assemble_diagonal(self, matrix_name):
+        """ Diagonal of the matrix ``matrix_name``.
+        """
+        return self.__raw_assembler.assemble_diagonal(matrix_name);
+
     @property
     def material(self):
         return self.__material;
@@ -13,16 +13,24 @@ class HarmonicSolver(PyMesh.HarmonicSolver):
         boundary_indices (:class:``numpy.ndarray``): Indices into ``nodes``,
             specifying boundary nodes.
         boundary_values (:class:``numpy.ndarray``): Function values associated
-            with the boundary node.
+            with the boundary node.  A ``#boundary_indices`` by ``k`` matrix
+            solves ``k`` boundary value problems at once.
+        solver_type (``str``): Name of the sparse solver used to factorize
+            the system (see :py:func:`pymesh.SparseSolver.get_supported_solvers`).
+            Default is ``LDLT``.
 
     Methods:
-        pre_process(): Run preprocessing step.  (All input attribute must be
-            specified prior of calling this method.)
-        solve(): Run solver.
+        pre_process(): Assemble and factorize the system.  (All input
+            attribute except ``boundary_values`` must be specified prior of
+            calling this method.)
+        solve(): Run solver.  The factorization is reused until ``nodes``,
+            ``elements``, ``order``, ``boundary_indices`` or ``solver_type``
+            changes, so only ``boundary_values`` may change between calls.
 
     Output attributes:
         solution (:class:``numpy.ndarray``): Solution for the specified harmonic
-            PDE.  (i.e. Solved functions evaluated on the input nodes.)
+            PDE.  (i.e. Solved functions evaluated on the input nodes.)  It
+            has one column per column of ``boundary_values``.
 
     Example:
         >>> solver = pymesh.HarmonicSolver.create(mesh);
@@ -24,6 +24,16 @@ class SparseSolver(PyMesh.SparseSolver):
     * ``CG``: Wrapper of `Eigen::ConjugateGradient`_. SPD only.
     * ``LSCG``: Wrapper of `Eigen::LeastSquaresConjugateGradient`_.
     * ``BiCG``: Wrapper of `Eigen::BiCGSTAB`_.
+    * ``PCG_Jacobi``: Multithreaded preconditioned conjugate gradient with
+      Jacobi preconditioner. SPD only.
+    * ``PCG_IC``: Same as ``PCG_Jacobi`` with incomplete Cholesky
+      preconditioner. SPD only.
+    * ``PCG_AMG``: Same as ``PCG_Jacobi`` with smoothed aggregation algebraic
+      multigrid preconditioner. SPD only.
+
+    ``PCG_Jacobi`` also supports matrix-free mode via
+    :py:meth:`set_linear_operator`, where ``op(x)`` returns ``A * x`` and
+    ``diagonal`` (optional) is the diagonal of ``A``.
 
     Attributes:
 
@@ -35,6 +45,9 @@ class SparseSolver(PyMesh.SparseSolver):
         max_iterations (``int``):  The max iterations allowed for iterative
             solvers.  Default is twice the number of columns of the matrix.
 
+        block_size (``int``): Number of interleaved unknowns per node (e.g.
+            ``dim`` for elasticity).  Used by ``PCG_AMG``.  Default is 1.
+
     Example:
 
         For direct solvers:
@@ -55,6 +68,16 @@ class SparseSolver(PyMesh.SparseSolver):
         >>> solver.compute(M);
         >>> x = solver.solve(rhs);
 
+        Matrix-free mode:
+
+        >>> assembler = pymesh.Assembler(mesh, material);
+        >>> solver = pymesh.SparseSolver.create("PCG_Jacobi");
+        >>> solver.tolerance = 1e-8;
+        >>> solver.set_linear_operator(mesh.num_vertices * mesh.dim,
+        ...         lambda x: assembler.apply("stiffness", x),
+        ...         assembler.assemble_diagonal("stiffness"));
+        >>> x = solver.solve(rhs);
+
     .. _`Eigen::SimplicialLLT`: https://eigen.tuxfamily.org/dox/classEigen_1_1SimplicialLLT.html
     .. _`Eigen::SimplicialLDLT`: https://eigen.tuxfamily.org/dox/classEigen_1_1SimplicialLDLT.html
     .. _`Eigen::SparseLU`: https://eigen.tuxfamily.org/dox/classEigen_1_1SparseLU.html
@@ -2,12 +2,21 @@ import PyMesh
 from .Mesh import Mesh
 
 class VoxelGrid:
-    def __init__(self, cell_size, dim=3):
+    def __init__(self, cell_size, dim=3, sparse=False):
+        """ Set ``sparse`` to store voxels in 8^dim blocks, only blocks
+        containing solid voxels use memory.
+        """
         self.dim = dim;
         if dim == 3:
-            self.raw_grid = PyMesh.VoxelGrid3D(cell_size);
+            if sparse:
+                self.raw_grid = PyMesh.SparseVoxelGrid3D(cell_size);
+            else:
+                self.raw_grid = PyMesh.VoxelGrid3D(cell_size);
         elif dim == 2:
-            self.raw_grid = PyMesh.VoxelGrid2D(cell_size);
+            if sparse:
+                self.raw_grid = PyMesh.SparseVoxelGrid2D(cell_size);
+            else:
+                self.raw_grid = PyMesh.VoxelGrid2D(cell_size);
         else:
             raise NotImplementedError("Unsupported dim: {}".format(dim));
 
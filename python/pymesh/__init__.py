@@ -19,7 +19,7 @@ from .Mesh import Mesh
 from .meshio import load_mesh, form_mesh, save_mesh, save_mesh_raw
 from .Arrangement2 import Arrangement2
 from .Assembler import Assembler
-from .boolean import boolean
+from .boolean import boolean, boolean_nary
 from .compression import compress, decompress
 from .convex_hull import convex_hull
 from .CSGTree import CSGTree
@@ -55,6 +55,7 @@ from .igl_utils import face_normals, vertex_normals, edge_normals, orient_faces,
 from .map_attributes import map_vertex_attribute
 from .map_attributes import map_face_attribute
 from .map_attributes import map_corner_attribute
+from .map_attributes import map_attributes
 
 __all__ = [
         "Mesh",
@@ -64,6 +65,7 @@ __all__ = [
         "save_mesh",
         "save_mesh_raw",
         "boolean",
+        "boolean_nary",
         "CSGTree",
         "cut_to_disk"
         "Gmpq",
@@ -104,6 +106,7 @@ __all__ = [
         "map_vertex_attribute",
         "map_face_attribute",
         "map_corner_attribute",
+        "map_attributes",
         "refine_triangulation",
         "unique_rows",
         "face_normals",
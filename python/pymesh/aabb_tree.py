@@ -63,6 +63,10 @@ class BVH:
         signed_dists, face_indices, closest_pts, face_normals = self.__raw_bvh.lookup_signed(pts, fn, vn, en, emap);
         return signed_dists, face_indices.squeeze(), closest_pts, face_normals.squeeze();
 
+    @property
+    def raw_bvh(self):
+        return self.__raw_bvh;
+
 
 def distance_to_mesh(mesh, pts, engine="auto", bvh=None):
     """ Compute the distance from a set of points to a mesh.
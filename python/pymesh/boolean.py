@@ -110,3 +110,67 @@ def boolean(mesh_1, mesh_2, operation, engine="auto", with_timing=False,
     else:
         return output_mesh;
 
+
+def boolean_nary(meshes, operation, engine="auto", with_timing=False):
+    """ Perform a boolean operation over any number of input meshes at once.
+
+    All intersections between the input meshes are resolved in a single
+    pass, which is much faster than a sequence of binary :func:`boolean`
+    calls or a :class:`CSGTree` when there are many operands.
+
+    Args:
+        meshes (``list`` of :class:`Mesh`): The input 3D triangle meshes,
+            :math:`M_0, M_1, \ldots`.
+        operation (``string``): Either ``union``, ``intersection``, or a
+            boolean expression over the mesh indices using ``|`` (union),
+            ``&`` (intersection), ``-`` (difference), ``^`` (symmetric
+            difference) and parentheses, e.g. ``"(0 | 1 | 2) - 3"``.  ``&``
+            binds tighter than the other operators.
+        engine (``string``): (optional) N-ary boolean engine name.  Only
+            ``igl`` is supported, which is also the default.
+        with_timing (``boolean``): (optional) Whether to time the code.
+
+    Returns: The output mesh.
+
+    The following attributes are defined in the output mesh:
+
+        * "source": An array of indices, one per output face, indicating which
+          input mesh an output face comes from.
+        * "source_face": An array of indices, one per output face, into the
+          concatenated faces of the input meshes.
+    """
+    for mesh in meshes:
+        assert(mesh.dim == 3);
+        assert(mesh.vertex_per_face == 3);
+
+    engine = PyMesh.NaryBooleanEngine.create(engine);
+    for mesh in meshes:
+        engine.add_mesh(mesh.vertices, mesh.faces);
+
+    if with_timing:
+        start_time = time();
+
+    if operation == "union":
+        engine.compute_union();
+    elif operation == "intersection":
+        engine.compute_intersection();
+    else:
+        engine.set_expression(operation);
+        engine.compute();
+
+    if with_timing:
+        finish_time = time();
+        running_time = finish_time - start_time;
+
+    output_mesh = form_mesh(engine.get_vertices(), engine.get_faces());
+    face_sources = engine.get_face_sources();
+    if len(face_sources) != 0:
+        output_mesh.add_attribute("source_face", dtype=np.int32);
+        output_mesh.set_attribute("source_face", face_sources);
+        output_mesh.add_attribute("source", dtype=np.int32);
+        output_mesh.set_attribute("source", engine.get_mesh_sources());
+
+    if with_timing:
+        return output_mesh, running_time;
+    else:
+        return output_mesh;
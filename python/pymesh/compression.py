@@ -3,7 +3,9 @@ import numpy as np
 
 from .Mesh import Mesh
 
-def compress(mesh, engine_name="draco"):
+def compress(mesh, engine_name="draco", speed=None,
+        position_quantization_bits=0, attribute_quantization_bits=None,
+        chunk_size=0):
     """ Compress mesh data.
 
     Args:
@@ -13,6 +15,21 @@ def compress(mesh, engine_name="draco"):
             * ``draco``: `Google's Draco engine <https://google.github.io/draco/>`_
               [#]_
 
+        speed (``int`` or ``tuple``): Encoding speed in [0, 10], or a tuple
+            of encoding and decoding speeds.  0 gives the best compression
+            ratio, 10 is the fastest.  Default is engine specific.
+        position_quantization_bits (``int``): Number of quantization bits
+            for vertex positions.  0 (default) means no quantization.
+        attribute_quantization_bits (``dict``): Map from vertex attribute
+            name to its number of quantization bits.  Only float attributes
+            can be quantized, nonzero bits for an int attribute raise an
+            error.
+        chunk_size (``int``): If positive, meshes with more faces (points
+            for point clouds) than ``chunk_size`` are split spatially into
+            chunks that are compressed and decompressed in parallel.
+            Chunking preserves the vertex order, but vertices not used by
+            any face are dropped.
+
     Returns:
         A binary string representing the compressed mesh data.
 
@@ -29,6 +46,16 @@ def compress(mesh, engine_name="draco"):
 
     """
     engine = PyMesh.CompressionEngine.create(engine_name);
+    if speed is not None:
+        if isinstance(speed, tuple):
+            engine.set_speed(*speed);
+        else:
+            engine.set_speed(speed, speed);
+    engine.set_position_quantization_bits(position_quantization_bits);
+    if attribute_quantization_bits is not None:
+        for name, bits in attribute_quantization_bits.items():
+            engine.set_attribute_quantization_bits(name, bits);
+    engine.set_chunk_size(chunk_size);
     data = engine.compress(mesh.raw_mesh);
     return data;
 
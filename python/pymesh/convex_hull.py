@@ -19,6 +19,8 @@ def convex_hull(mesh, engine="auto", with_timing=False):
                 `3D <https://doc.cgal.org/latest/Convex_hull_3/index.html>`_)
             * `triangle`: Triangle convex hull engine.
             * `tetgen`: Tetgen convex hull engine.
+            * `incremental`: Built-in engine for small point sets.  It has no
+              external dependency.
         with_timing (``boolean``): (optional) Whether to time the code
 
     Returns: The output mesh representing the convex hull.
@@ -17,6 +17,8 @@ from .generate_minimal_surface import generate_minimal_surface
 from .generate_tube import generate_tube
 from .generate_regular_tetrahedron import generate_regular_tetrahedron
 from .hex_to_tet import hex_to_tet
+from .isotropic_remesh import isotropic_remesh
+from .isotropic_remesh import isotropic_remesh_raw
 from .quad_to_tri import quad_to_tri
 from .manifold_check import is_vertex_manifold, is_edge_manifold, cut_to_manifold
 from .merge_meshes import merge_meshes
@@ -40,10 +42,14 @@ from .face_utils import get_degenerated_faces_raw
 from .face_utils import get_triangle_orientations
 from .face_utils import get_triangle_orientations_raw
 from .subdivide import subdivide
+from .voxel_utils import compute_tet_quality
+from .voxel_utils import compute_tet_quality_raw
 from .voxel_utils import get_tet_orientations
 from .voxel_utils import get_tet_orientations_raw
 from .voxel_utils import is_delaunay
 from .voxel_utils import is_delaunay_raw
+from .voxel_utils import is_globally_delaunay
+from .voxel_utils import is_globally_delaunay_raw
 
 __all__ = [
         "chain_edges",
@@ -55,6 +61,8 @@ __all__ = [
         "convert_to_voxel_attribute_from_name",
         "collapse_short_edges",
         "collapse_short_edges_raw",
+        "compute_tet_quality",
+        "compute_tet_quality_raw",
         "cut_mesh",
         "cut_to_manifold",
         "generate_box_mesh",
@@ -76,7 +84,11 @@ __all__ = [
         "is_colinear",
         "is_delaunay",
         "is_delaunay_raw",
+        "is_globally_delaunay",
+        "is_globally_delaunay_raw",
         "is_edge_manifold",
+        "isotropic_remesh",
+        "isotropic_remesh_raw",
         "is_vertex_manifold",
         "merge_meshes",
         "mesh_to_dual_graph",
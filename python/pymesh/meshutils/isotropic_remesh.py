@@ -0,0 +1,70 @@
+import numpy as np
+
+from ..meshio import form_mesh
+from PyMesh import IsotropicRemesher
+
+def isotropic_remesh_raw(vertices, faces, target_length=None, sizing=None,
+        num_iterations=10):
+    """ Remesh a triangle mesh so that all edges have roughly the target
+    length.  Each iteration splits long edges, collapses short edges, flips
+    edges to improve vertex valences and smooths vertices tangentially.
+
+    Args:
+        vertices (``numpy.ndarray``): Vertex array with one vertex per row.
+        faces (``numpy.ndarray``): Face array with one face per row.
+        target_length (``float``): (optional) Target edge length.  Default is
+            the average input edge length.
+        sizing (``numpy.ndarray``): (optional) Target edge length per input
+            vertex.  Overrides ``target_length``.
+        num_iterations (``int``): (optional) Number of iterations.  Default
+            is 10.
+
+    Returns:
+        3 values are returned.
+
+            * ``output_vertices``: Output vertex array with one vertex per row.
+            * ``output_faces``: Output face array with one face per row.
+            * ``info``: Additional information dict.
+
+        The following fields are defined in the ``info`` dict:
+            * ``num_splits``: number of edge splits.
+            * ``num_collapses``: number of edge collapses.
+            * ``num_flips``: number of edge flips.
+
+    Boundary vertices and vertices adjacent to non-manifold edges are kept
+    fixed.
+    """
+    remesher = IsotropicRemesher(vertices, faces);
+    if sizing is not None:
+        remesher.set_sizing_field(np.asarray(sizing, dtype=float).ravel());
+    elif target_length is not None:
+        remesher.set_target_length(target_length);
+    remesher.run(num_iterations);
+    info = {
+            "num_splits": remesher.get_num_splits(),
+            "num_collapses": remesher.get_num_collapses(),
+            "num_flips": remesher.get_num_flips(),
+            };
+    return remesher.get_vertices(), remesher.get_faces(), info;
+
+def isotropic_remesh(mesh, target_length=None, sizing=None, num_iterations=10):
+    """ Wrapper function of :func:`isotropic_remesh_raw`.
+
+    Args:
+        mesh (:class:`Mesh`): Input mesh.
+        target_length (``float``): (optional) Target edge length.  Default is
+            the average input edge length.
+        sizing (``numpy.ndarray``): (optional) Target edge length per input
+            vertex.  Overrides ``target_length``.
+        num_iterations (``int``): (optional) Number of iterations.  Default
+            is 10.
+
+    Returns:
+        2 values are returned.
+
+            * ``output_mesh`` (:class:`Mesh`): Output mesh.
+            * ``info``: Additional information dictionary.
+    """
+    vertices, faces, info = isotropic_remesh_raw(mesh.vertices, mesh.faces,
+            target_length, sizing, num_iterations);
+    return form_mesh(vertices, faces), info;
@@ -0,0 +1,40 @@
+from pymesh.meshutils import isotropic_remesh_raw
+from pymesh.TestCase import TestCase
+
+import numpy as np
+import numpy.testing
+import unittest
+
+class IsotropicRemeshTest(TestCase):
+    def test_refine(self):
+        vertices = np.array([
+            [0.0, 0.0, 0.0],
+            [1.0, 0.0, 0.0],
+            [1.0, 1.0, 0.0],
+            [0.0, 1.0, 0.0],
+            ], dtype=float);
+        faces = np.array([[0, 1, 2], [0, 2, 3]], dtype=int);
+
+        out_vertices, out_faces, info = isotropic_remesh_raw(
+                vertices, faces, target_length=0.2);
+
+        self.assertLess(2, len(out_faces));
+        self.assertLess(0, info["num_splits"]);
+        numpy.testing.assert_array_less(-1e-12, out_vertices);
+        numpy.testing.assert_array_less(out_vertices, 1.0 + 1e-12);
+
+    def test_sizing_field(self):
+        vertices = np.array([
+            [0.0, 0.0, 0.0],
+            [1.0, 0.0, 0.0],
+            [1.0, 1.0, 0.0],
+            [0.0, 1.0, 0.0],
+            ], dtype=float);
+        faces = np.array([[0, 1, 2], [0, 2, 3]], dtype=int);
+        sizing = np.array([0.1, 0.5, 0.5, 0.1]);
+
+        out_vertices, out_faces, info = isotropic_remesh_raw(
+                vertices, faces, sizing=sizing);
+
+        num_fine = np.count_nonzero(out_vertices[:, 0] < 0.5);
+        self.assertLess(len(out_vertices) - num_fine, num_fine);
@@ -25,27 +25,115 @@ def get_tet_orientations(mesh):
         raise NotImplementedError("Orientation computation expect a tet mesh.");
     return PyMesh.get_tet_orientations(mesh.vertices, mesh.voxels);
 
-def is_delaunay_raw(vertices, tets):
+def is_delaunay_raw(vertices, tets, early_exit=False):
     """ Compute whether each tet is strictly locally Delaunay, cospherical or
     not locally Delaunay.
 
     Args:
         vertices (``numpy.ndarray``): n by 3 matrix representing vertices.
         tets (``numpy.ndarray``): m by 4 matrix of vertex indices representing tets.
+        early_exit (``bool``): (optional) Stop shortly after the first tet
+            that is not locally Delaunay is found.  Tets that are not checked
+            are set to NaN.
 
     Returns:
         A list of m floats representing result for each tet:
-            * 1 => tet is strictly locally Delaunay.
-            * 0 => tet is cospherical with an adjacent tet.
-            * 1 => tet is not locally Delaunay.
+            *  1 => tet is strictly locally Delaunay.
+            *  0 => tet is cospherical with an adjacent tet.
+            * -1 => tet is not locally Delaunay.
     """
-    return PyMesh.is_delaunay(vertices, tets);
+    return PyMesh.is_delaunay(vertices, tets, early_exit);
 
-def is_delaunay(mesh):
+def is_delaunay(mesh, early_exit=False):
     """ A thin wrapper of ``is_delaunay_raw``.
     """
     if mesh.num_voxels == 0:
         return np.zeros(0);
     if mesh.vertex_per_voxel != 4:
         raise NotImplementedError("Delaunay property computation expect a tet mesh.");
-    return PyMesh.is_delaunay(mesh.vertices, mesh.voxels);
+    return PyMesh.is_delaunay(mesh.vertices, mesh.voxels, early_exit);
+
+def is_globally_delaunay_raw(vertices, tets, early_exit=False):
+    """ Compute whether the circumsphere of each tet is empty, i.e. contains
+    no vertex in its interior.
+
+    Args:
+        vertices (``numpy.ndarray``): n by 3 matrix representing vertices.
+        tets (``numpy.ndarray``): m by 4 matrix of vertex indices representing tets.
+        early_exit (``bool``): (optional) Stop shortly after the first tet
+            that is not Delaunay is found.  Tets that are not checked are set
+            to NaN.
+
+    Returns:
+        A list of m floats representing result for each tet:
+            *  1 => circumsphere contains no other vertex.
+            *  0 => another vertex is on the circumsphere, or tet is degenerate.
+            * -1 => circumsphere contains another vertex.
+    """
+    return PyMesh.is_globally_delaunay(vertices, tets, early_exit);
+
+def is_globally_delaunay(mesh, early_exit=False):
+    """ A thin wrapper of ``is_globally_delaunay_raw``.
+    """
+    if mesh.num_voxels == 0:
+        return np.zeros(0);
+    if mesh.vertex_per_voxel != 4:
+        raise NotImplementedError("Delaunay property computation expect a tet mesh.");
+    return PyMesh.is_globally_delaunay(mesh.vertices, mesh.voxels, early_exit);
+
+def compute_tet_quality_raw(vertices, tets, num_bins=None):
+    """ Compute quality measures of all tets in a single parallel pass.
+
+    Args:
+        vertices (``numpy.ndarray``): n by 3 matrix representing vertices.
+        tets (``numpy.ndarray``): m by 4 matrix of vertex indices representing tets.
+        num_bins (``int``): (optional) Number of histogram bins.  If set,
+            histograms of dihedral angles (over [0, pi]) and radius edge
+            ratios (over [sqrt(6)/4, 10]) are also computed.
+
+    Returns:
+        A dict with the following fields, one entry per tet:
+            * ``volume``: signed volume.
+            * ``orientation``: exact orientation, same as :func:`get_tet_orientations_raw`.
+            * ``dihedral_angles``: m by 6 matrix of dihedral angles of edges
+              (0,1), (1,2), (0,2), (0,3), (2,3), (1,3).
+            * ``inradius``: inscribed sphere radius.
+            * ``circumradius``: circumscribed sphere radius.
+            * ``radius_edge_ratio``: circumradius over shortest edge length.
+            * ``min_edge_length``: shortest edge length.
+            * ``max_edge_length``: longest edge length.
+
+        If ``num_bins`` is set, ``dihedral_angle_histogram`` and
+        ``radius_edge_ratio_histogram`` are defined as well.  Values outside
+        of the histogram range are counted in the end bins.
+    """
+    quality = PyMesh.TetQuality();
+    quality.run(vertices, tets);
+    result = {
+            "volume": quality.get_volumes(),
+            "orientation": quality.get_orientations(),
+            "dihedral_angles": quality.get_dihedral_angles(),
+            "inradius": quality.get_inradii(),
+            "circumradius": quality.get_circumradii(),
+            "radius_edge_ratio": quality.get_radius_edge_ratios(),
+            "min_edge_length": quality.get_min_edge_lengths(),
+            "max_edge_length": quality.get_max_edge_lengths(),
+            };
+    if num_bins is not None:
+        result["dihedral_angle_histogram"] = \
+                PyMesh.TetQuality.compute_histogram(
+                        result["dihedral_angles"].ravel(),
+                        0.0, np.pi, num_bins);
+        result["radius_edge_ratio_histogram"] = \
+                PyMesh.TetQuality.compute_histogram(
+                        result["radius_edge_ratio"].ravel(),
+                        np.sqrt(6.0) / 4.0, 10.0, num_bins);
+    return result;
+
+def compute_tet_quality(mesh, num_bins=None):
+    """ A thin wrapper of ``compute_tet_quality_raw``.
+    """
+    if mesh.num_voxels > 0 and mesh.vertex_per_voxel != 4:
+        raise NotImplementedError("Tet quality computation expect a tet mesh.");
+    return compute_tet_quality_raw(mesh.vertices,
+            mesh.voxels.reshape((-1, 4)), num_bins);
@@ -1,4 +1,5 @@
 import PyMesh
+import numpy as np
 
 """
 This module wraps the exact predicates Jonathan Richard Shewchuk.
@@ -7,56 +8,76 @@ This module wraps the exact predicates Jonathan Richard Shewchuk.
 # The init function would be called when predicates module is imported.
 PyMesh.exactinit();
 
+def _is_batch(*pts):
+    """ Return True if any argument is an array of points.
+    """
+    return any(np.ndim(p) > 1 for p in pts);
+
+def _as_batch(dim, *pts):
+    return [np.asarray(p, dtype=float).reshape((-1, dim)) for p in pts];
+
 def orient_2D(p1, p2, p3):
     """ Determine the orientation 2D points p1, p2, p3
 
     Args:
-        p1,p2,p3: 2D points.
+        p1,p2,p3: 2D points or N x 2 arrays of points.  A single point is
+            broadcast against arrays of points.
 
     Returns:
         positive if (p1, p2, p3) is in counterclockwise order.
         negative if (p1, p2, p3) is in clockwise order.
         0.0 if they are collinear.
     """
+    if _is_batch(p1, p2, p3):
+        return PyMesh.orient2d_batch(*_as_batch(2, p1, p2, p3)).ravel();
     return PyMesh.orient2d(p1, p2, p3);
 
 def orient_3D(p1, p2, p3, p4):
     """ Determine the orientation 3D points p1, p2, p3, p4.
 
     Args:
-        p1,p2,p3,p4: 3D points.
+        p1,p2,p3,p4: 3D points or N x 3 arrays of points.  A single point is
+            broadcast against arrays of points.
 
     Returns:
         positive if p4 is below the plane formed by (p1, p2, p3).
         negative if p4 is above the plane formed by (p1, p2, p3).
         0.0 if they are coplanar.
     """
+    if _is_batch(p1, p2, p3, p4):
+        return PyMesh.orient3d_batch(*_as_batch(3, p1, p2, p3, p4)).ravel();
     return PyMesh.orient3d(p1, p2, p3, p4);
 
 def in_circle(p1, p2, p3, p4):
     """ Determine if p4 is in the circle formed by p1, p2, p3.
 
     Args:
-        p1,p2,p3,p4: 2D points.  ``orient_2D(p1, p2, p3)`` must be postive,
-            otherwise the result will be flipped.
+        p1,p2,p3,p4: 2D points or N x 2 arrays of points.
+            ``orient_2D(p1, p2, p3)`` must be postive, otherwise the result
+            will be flipped.
 
     Returns:
         positive p4 is inside of the circle.
         negative p4 is outside of the circle.
         0.0 if they are cocircular.
     """
+    if _is_batch(p1, p2, p3, p4):
+        return PyMesh.incircle_batch(*_as_batch(2, p1, p2, p3, p4)).ravel();
     return PyMesh.incircle(p1, p2, p3, p4);
 
 def in_sphere(p1, p2, p3, p4, p5):
     """ Determine if p5 is in the sphere formed by p1, p2, p3, p4.
 
     Args:
-        p1,p2,p3,p4,p5: 3D points.  ``orient_3D(p1, p2, p3, p4)`` must be
-            positive, otherwise the result will be flipped.
+        p1,p2,p3,p4,p5: 3D points or N x 3 arrays of points.
+            ``orient_3D(p1, p2, p3, p4)`` must be positive, otherwise the
+            result will be flipped.
 
     Returns:
         positive p5 is inside of the sphere.
         negative p5 is outside of the sphere.
         0.0 if they are cospherical.
     """
+    if _is_batch(p1, p2, p3, p4, p5):
+        return PyMesh.insphere_batch(*_as_batch(3, p1, p2, p3, p4, p5)).ravel();
     return PyMesh.insphere(p1, p2, p3, p4, p5);
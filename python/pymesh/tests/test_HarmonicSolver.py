@@ -106,6 +106,37 @@ class HarmonicSolverTest(TestCase):
         self.assertEqual(mesh.num_vertices, len(sol));
         self.assert_array_almost_equal(target_solution, sol, 3);
 
+    def test_multiple_boundary_conditions(self):
+        mesh = pymesh.generate_icosphere(1.0, np.zeros(3), 2);
+        tetgen = pymesh.tetgen();
+        tetgen.points = mesh.vertices;
+        tetgen.triangles = mesh.faces;
+        tetgen.max_tet_volume = 0.1;
+        tetgen.verbosity = 0;
+        tetgen.run();
+
+        mesh = tetgen.mesh;
+        self.assertLess(0, mesh.num_voxels);
+
+        # All three coordinate functions are solved at once.
+        solver = pymesh.HarmonicSolver.create(mesh);
+        bd_indices = np.unique(mesh.faces.ravel());
+        solver.boundary_indices = bd_indices;
+        solver.boundary_values = mesh.vertices[bd_indices];
+        solver.pre_process();
+        solver.solve();
+
+        sol = solver.solution;
+        self.assertEqual((mesh.num_vertices, 3), sol.shape);
+        self.assert_array_almost_equal(mesh.vertices, sol, 12);
+
+        # Factorization is reused when only boundary values change.
+        solver.boundary_values = 2.0 * mesh.vertices[bd_indices, 1];
+        solver.solve();
+
+        sol = solver.solution.ravel();
+        self.assert_array_almost_equal(2.0 * mesh.vertices[:, 1], sol, 12);
+
 if __name__ == '__main__':
     import unittest
     unittest.main()
\ No newline at end of file
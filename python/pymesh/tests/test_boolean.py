@@ -1,5 +1,5 @@
 from pymesh.TestCase import TestCase
-from pymesh import boolean
+from pymesh import boolean, boolean_nary
 from pymesh.meshutils import generate_box_mesh
 from pymesh.misc import Quaternion
 from pymesh.meshio import form_mesh
@@ -555,6 +555,32 @@ class BooleanTest(TestCase):
         self.assertTrue(mesh.is_manifold());
         self.assertEqual(1, mesh.num_components);
 
+    def test_nary_union(self):
+        meshes = [generate_box_mesh(
+            np.array([i*0.5, 0, 0]), np.array([i*0.5+1, 1, 1]))
+            for i in range(5)];
+        mesh = boolean_nary(meshes, "union");
+        self.assertTrue(mesh.is_closed());
+        self.assertTrue(mesh.is_manifold());
+        self.assertEqual(1, mesh.num_components);
+        self.assertAlmostEqual(3.0, mesh.volume);
+
+        sources = mesh.get_attribute("source");
+        self.assertEqual(0, np.amin(sources));
+        self.assertEqual(4, np.amax(sources));
+
+    def test_nary_expression(self):
+        meshes = [generate_box_mesh(
+            np.array([i*0.5, 0, 0]), np.array([i*0.5+1, 1, 1]))
+            for i in range(3)];
+        mesh = boolean_nary(meshes, "(0 | 2) - 1");
+        self.assertTrue(mesh.is_closed());
+        self.assertTrue(mesh.is_manifold());
+        self.assertEqual(2, mesh.num_components);
+        self.assertAlmostEqual(1.0, mesh.volume);
+
+        mesh = boolean_nary(meshes, "intersection");
+        self.assertEqual(0, mesh.num_faces);
 
 
 if __name__ == '__main__':
@@ -94,6 +94,43 @@ class TestCompression(TestCase):
         #face_index_map = mesh2.get_attribute("face_index").ravel().astype(int);
         #self.assertEqual(mesh.num_faces, len(face_index_map));
 
+    def test_options(self):
+        mesh = pymesh.generate_icosphere(1.0, np.zeros(3), 2);
+        mesh.add_attribute("vertex_normal");
+        data = pymesh.compress(mesh, speed=(10, 10),
+                position_quantization_bits=14,
+                attribute_quantization_bits={"vertex_normal": 8});
+        mesh2 = pymesh.decompress(data);
+
+        self.assertEqual(mesh.num_vertices, mesh2.num_vertices);
+        self.assertEqual(mesh.num_faces, mesh2.num_faces);
+        self.assert_array_almost_equal(mesh.bbox, mesh2.bbox, 3);
+        self.assertTrue(mesh2.has_attribute("vertex_normal"));
+
+    def test_chunked(self):
+        mesh = pymesh.generate_icosphere(1.0, np.zeros(3), 3);
+        mesh.add_attribute("vertex_index");
+        data = pymesh.compress(mesh, chunk_size=100);
+        mesh2 = pymesh.decompress(data);
+
+        self.assertEqual(mesh.num_vertices, mesh2.num_vertices);
+        self.assertEqual(mesh.num_faces, mesh2.num_faces);
+        self.assert_array_equal(mesh.vertices, mesh2.vertices);
+        self.assert_array_equal(
+                mesh.get_attribute("vertex_index"),
+                mesh2.get_attribute("vertex_index"));
+        self.assertTrue(mesh2.is_closed());
+
+    def test_chunked_point_cloud(self):
+        vertices = numpy.random.rand(1000, 3);
+        mesh = pymesh.form_mesh(vertices, np.zeros((0, 3)));
+        data = pymesh.compress(mesh, chunk_size=64);
+        mesh2 = pymesh.decompress(data);
+
+        self.assertEqual(mesh.num_vertices, mesh2.num_vertices);
+        self.assertEqual(0, mesh2.num_faces);
+        self.assert_array_equal(mesh.vertices, mesh2.vertices);
+
 
 if __name__ == '__main__':
     import unittest
@@ -0,0 +1,49 @@
+import PyMesh
+from pymesh.TestCase import TestCase
+from pymesh.meshutils import generate_box_mesh
+from pymesh.meshutils import remove_isolated_vertices_raw
+
+import numpy as np
+
+class EngineResultsTest(TestCase):
+    def test_point_locator_rerun(self):
+        mesh = generate_box_mesh(np.zeros(3), np.ones(3), 2);
+        locator = PyMesh.PointLocator(mesh.raw_mesh);
+        pts = np.array([
+            [0.1, 0.2, 0.3],
+            [0.7, 0.6, 0.8],
+            [0.4, 0.9, 0.2] ]);
+        locator.locate(pts);
+        voxels = locator.get_enclosing_voxels();
+        coords = locator.get_barycentric_coords();
+        expected_voxels = voxels.copy();
+        expected_coords = coords.copy();
+
+        # Clearing and re-running the engine must not invalidate earlier
+        # results.
+        locator.clear();
+        locator.locate(pts[:1]);
+        self.assertEqual(1, len(locator.get_enclosing_voxels()));
+        self.assert_array_equal(expected_voxels, voxels);
+        self.assert_array_equal(expected_coords, coords);
+
+        locator.clear();
+        self.assert_array_equal(expected_voxels, voxels);
+        self.assert_array_equal(expected_coords, coords);
+
+    def test_writable_results(self):
+        vertices = np.array([
+            [0.0, 0.0, 0.0],
+            [1.0, 0.0, 0.0],
+            [0.0, 1.0, 0.0],
+            [5.0, 5.0, 5.0] ]);
+        faces = np.array([[0, 1, 2]]);
+        out_vertices, out_faces, info = remove_isolated_vertices_raw(
+                vertices, faces);
+        self.assertEqual(3, len(out_vertices));
+
+        # Results of public helpers are ordinary arrays.
+        out_vertices[0] += 1.0;
+        out_faces[0] = out_faces[0, [0, 2, 1]];
+        self.assert_array_equal([1.0, 1.0, 1.0], out_vertices[0]);
+        self.assert_array_equal([0, 2, 1], out_faces[0]);
@@ -80,6 +80,34 @@ class MapAttributesTest(TestCase):
         largest_error = np.amax(np.absolute(diff));
         self.assertLess(largest_error, 1e-12);
 
+    def test_map_multiple_attributes(self):
+        mesh1 = pymesh.generate_icosphere(2.0, [0.0, 0.0, 0.0], 2);
+        mesh2 = pymesh.generate_icosphere(2.1, [0.0, 0.0, 0.0], 2);
+
+        mesh1.add_attribute("x");
+        mesh1.set_attribute("x", mesh1.vertices[:,0]);
+        mesh1.add_attribute("xyz");
+        mesh1.set_attribute("xyz", mesh1.vertices);
+        value = np.arange(mesh1.num_faces);
+        mesh1.add_attribute("value", dtype=np.int32);
+        mesh1.set_attribute("value", value);
+
+        pymesh.map_attributes(mesh1, mesh2,
+                vertex_attributes=["x", "xyz"],
+                face_attributes=["value"]);
+
+        self.assertTrue(mesh2.has_attribute("x"));
+        self.assertTrue(mesh2.has_attribute("xyz"));
+        self.assertTrue(mesh2.has_attribute("value"));
+
+        xyz = mesh2.get_vertex_attribute("xyz");
+        self.assertEqual((mesh2.num_vertices, 3), xyz.shape);
+        self.assert_array_almost_equal(mesh2.vertices / 1.05, xyz);
+        self.assert_array_almost_equal(xyz[:,0],
+                mesh2.get_vertex_attribute("x").ravel());
+        self.assert_array_equal(value,
+                mesh2.get_face_attribute("value").ravel());
+
 
 
 if __name__ == '__main__':
@@ -86,6 +86,29 @@ class PredicatesTest(TestCase):
         self.assertGreater(0.0, in_sphere(p1, p2, p3, p4, p_out));
         self.assertEqual(0.0, in_sphere(p1, p2, p3, p4, p_on));
 
+    def test_batch_3D(self):
+        p1 = np.array([0, 0, 0]);
+        p2 = np.array([1, 0, 0]);
+        p3 = np.array([0, 1, 0]);
+        pts = np.array([[0, 0, 1], [0, 0,-1], [5, 5, 0]]);
+
+        result = orient_3D(p1, p2, p3, pts);
+        self.assertEqual(3, len(result));
+        self.assertGreater(0.0, result[0]);
+        self.assertLess(0.0, result[1]);
+        self.assertEqual(0.0, result[2]);
+
+    def test_batch_in_circle(self):
+        p1 = np.array([0, 0]);
+        p2 = np.array([1, 0]);
+        p3 = np.array([0, 1]);
+        pts = np.array([[0.5, 0.5], [2, 2], [1, 1]]);
+
+        result = in_circle(p1, p2, p3, pts);
+        self.assertLess(0.0, result[0]);
+        self.assertGreater(0.0, result[1]);
+        self.assertEqual(0.0, result[2]);
+
 if __name__ == '__main__':
     import unittest
     unittest.main()
\ No newline at end of file
@@ -18,6 +18,17 @@ class SparseSolverTest(TestCase):
             x = solver.solve(rhs);
             self.assert_array_almost_equal(rhs.ravel(), x.ravel());
 
+    def test_matrix_free(self):
+        N = 100;
+        M = scipy.sparse.diags([-np.ones(N-1), 4*np.ones(N), -np.ones(N-1)],
+                [-1, 0, 1], format="csc");
+        rhs = np.ones(N);
+        solver = pymesh.SparseSolver.create("PCG_Jacobi");
+        solver.tolerance = 1e-12;
+        solver.set_linear_operator(N, lambda x: M * x, M.diagonal());
+        x = solver.solve(rhs);
+        self.assert_array_almost_equal(rhs, M * x.ravel());
+
 
 if __name__ == '__main__':
     import unittest
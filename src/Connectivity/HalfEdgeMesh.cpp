@@ -0,0 +1,479 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "HalfEdgeMesh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+#include <Mesh.h>
+#include <Core/Exception.h>
+
+using namespace PyMesh;
+
+namespace HalfEdgeMeshHelper {
+    struct EdgeKey {
+        int v_min;
+        int v_max;
+        int half_edge;
+
+        bool same_edge(const EdgeKey& other) const {
+            return v_min == other.v_min && v_max == other.v_max;
+        }
+
+        bool operator<(const EdgeKey& other) const {
+            if (v_min != other.v_min) return v_min < other.v_min;
+            if (v_max != other.v_max) return v_max < other.v_max;
+            return half_edge < other.half_edge;
+        }
+    };
+}
+
+using namespace HalfEdgeMeshHelper;
+
+const int HalfEdgeMesh::BOUNDARY;
+const int HalfEdgeMesh::NON_MANIFOLD;
+const int HalfEdgeMesh::INVALID;
+
+HalfEdgeMesh::HalfEdgeMesh(const MatrixFr& vertices, const MatrixIr& faces) {
+    initialize(vertices, faces);
+}
+
+HalfEdgeMesh::HalfEdgeMesh(const Mesh& mesh) {
+    const size_t dim = mesh.get_dim();
+    const size_t num_vertices = mesh.get_num_vertices();
+    const size_t num_faces = mesh.get_num_faces();
+    const size_t vertex_per_face = mesh.get_vertex_per_face();
+    if (num_faces > 0 && vertex_per_face != 3) {
+        throw NotImplementedError("HalfEdgeMesh only supports triangle meshes");
+    }
+
+    MatrixFr vertices = Eigen::Map<const MatrixFr>(
+            mesh.get_vertices().data(), num_vertices, dim);
+    MatrixIr faces = Eigen::Map<const MatrixIr>(
+            mesh.get_faces().data(), num_faces, 3);
+    initialize(vertices, faces);
+}
+
+void HalfEdgeMesh::initialize(const MatrixFr& vertices, const MatrixIr& faces) {
+    if (faces.rows() > 0 && faces.cols() != 3) {
+        throw NotImplementedError("HalfEdgeMesh only supports triangle meshes");
+    }
+
+    m_dim = vertices.cols();
+    const size_t num_vertices = vertices.rows();
+    const size_t num_faces = faces.rows();
+    const size_t num_half_edges = num_faces * 3;
+
+    m_vertices.resize(num_vertices * m_dim);
+    std::copy(vertices.data(), vertices.data() + num_vertices * m_dim,
+            m_vertices.begin());
+    m_tail.resize(num_half_edges);
+    std::copy(faces.data(), faces.data() + num_half_edges, m_tail.begin());
+    m_twin.assign(num_half_edges, BOUNDARY);
+
+    // Sorting the half-edges by their undirected edge places twins next to
+    // each other.
+    std::vector<EdgeKey> keys(num_half_edges);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const int v0 = tail(i);
+                    const int v1 = head(i);
+                    keys[i] = {std::min(v0, v1), std::max(v0, v1), int(i)};
+                }
+            });
+    tbb::parallel_sort(keys.begin(), keys.end());
+
+    // Each group of equal keys is handled by the thread owning its first
+    // entry, so every twin is written exactly once.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    if (i > 0 && keys[i].same_edge(keys[i-1])) continue;
+                    size_t j = i+1;
+                    while (j < num_half_edges && keys[j].same_edge(keys[i])) j++;
+
+                    if (j - i == 1) continue;
+                    const int h0 = keys[i].half_edge;
+                    const int h1 = keys[i+1].half_edge;
+                    if (j - i == 2 && tail(h0) != tail(h1)) {
+                        m_twin[h0] = h1;
+                        m_twin[h1] = h0;
+                    } else {
+                        for (size_t k=i; k<j; k++) {
+                            m_twin[keys[k].half_edge] = NON_MANIFOLD;
+                        }
+                    }
+                }
+            });
+
+    // Pick one outgoing half-edge per vertex, boundary ones first.
+    typedef long long Priority;
+    const Priority unset = std::numeric_limits<Priority>::max();
+    std::unique_ptr<std::atomic<Priority>[]> best(
+            new std::atomic<Priority>[num_vertices]);
+    for (size_t i=0; i<num_vertices; i++) best[i] = unset;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Priority priority = (m_twin[i] == BOUNDARY) ?
+                        Priority(i) : Priority(i + num_half_edges);
+                    std::atomic<Priority>& entry = best[tail(i)];
+                    Priority curr = entry.load();
+                    while (priority < curr &&
+                            !entry.compare_exchange_weak(curr, priority)) {}
+                }
+            });
+
+    m_vertex_half_edge.resize(num_vertices);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Priority priority = best[i].load();
+                    m_vertex_half_edge[i] = (priority == unset) ?
+                        INVALID : int(priority % num_half_edges);
+                }
+            });
+}
+
+MatrixFr HalfEdgeMesh::get_vertices() const {
+    const size_t num_vertices = get_num_vertices();
+    MatrixFr vertices(num_vertices, m_dim);
+    std::copy(m_vertices.begin(), m_vertices.end(), vertices.data());
+    return vertices;
+}
+
+MatrixIr HalfEdgeMesh::get_faces() const {
+    const size_t num_faces = get_num_faces();
+    MatrixIr faces(num_faces, 3);
+    std::copy(m_tail.begin(), m_tail.end(), faces.data());
+    return faces;
+}
+
+bool HalfEdgeMesh::is_boundary_vertex(int vi) const {
+    const int h = m_vertex_half_edge[vi];
+    return h != INVALID && m_twin[h] == BOUNDARY;
+}
+
+int HalfEdgeMesh::find_half_edge(int v0, int v1) const {
+    const int start = m_vertex_half_edge[v0];
+    if (start == INVALID) return INVALID;
+
+    int h = start;
+    do {
+        if (head(h) == v1) return h;
+        h = m_twin[prev(h)];
+    } while (h >= 0 && h != start);
+    return INVALID;
+}
+
+std::vector<int> HalfEdgeMesh::get_vertex_adjacent_vertices(int vi) const {
+    std::vector<int> neighbors;
+    const int start = m_vertex_half_edge[vi];
+    if (start == INVALID) return neighbors;
+
+    int h = start;
+    while (true) {
+        neighbors.push_back(head(h));
+        const int t = m_twin[prev(h)];
+        if (t < 0) {
+            neighbors.push_back(tail(prev(h)));
+            break;
+        }
+        if (t == start) break;
+        h = t;
+    }
+    return neighbors;
+}
+
+std::vector<int> HalfEdgeMesh::get_vertex_adjacent_faces(int vi) const {
+    std::vector<int> neighbors;
+    const int start = m_vertex_half_edge[vi];
+    if (start == INVALID) return neighbors;
+
+    int h = start;
+    do {
+        neighbors.push_back(face(h));
+        h = m_twin[prev(h)];
+    } while (h >= 0 && h != start);
+    return neighbors;
+}
+
+std::vector<int> HalfEdgeMesh::get_boundary_half_edges() const {
+    std::vector<int> bd_half_edges;
+    const size_t num_half_edges = get_num_half_edges();
+    for (size_t i=0; i<num_half_edges; i++) {
+        if (m_twin[i] == BOUNDARY && m_tail[i] != INVALID) {
+            bd_half_edges.push_back(i);
+        }
+    }
+    return bd_half_edges;
+}
+
+int HalfEdgeMesh::split_edge(int h, const VectorF& p) {
+    const int t = m_twin[h];
+    if (t == NON_MANIFOLD) {
+        throw RuntimeError("Cannot split non-manifold edge");
+    }
+
+    const int a = tail(h);
+    const int b = head(h);
+    const int c = tail(prev(h));
+    const int x_bc = m_twin[next(h)];
+
+    const int m = get_num_vertices();
+    m_vertices.insert(m_vertices.end(), p.data(), p.data() + m_dim);
+    m_vertex_half_edge.push_back(INVALID);
+
+    // (a, b, c) -> (a, m, c) + (m, b, c)
+    m_tail[next(h)] = m;
+    const int e0 = add_face(m, b, c) * 3;
+    link_twins(e0+1, x_bc);
+    link_twins(e0+2, next(h));
+
+    if (t >= 0) {
+        // (b, a, d) -> (b, m, d) + (m, a, d)
+        const int d = tail(prev(t));
+        const int x_ad = m_twin[next(t)];
+        m_tail[next(t)] = m;
+        const int g0 = add_face(m, a, d) * 3;
+        link_twins(g0+1, x_ad);
+        link_twins(g0+2, next(t));
+        link_twins(h, g0);
+        link_twins(t, e0);
+        reset_vertex_half_edge(d, prev(t));
+    }
+
+    reset_vertex_half_edge(a, h);
+    reset_vertex_half_edge(b, e0+1);
+    reset_vertex_half_edge(c, prev(h));
+    reset_vertex_half_edge(m, e0);
+    return m;
+}
+
+void HalfEdgeMesh::flip_edge(int h) {
+    const int t = m_twin[h];
+    if (t < 0) {
+        throw RuntimeError("Cannot flip boundary or non-manifold edge");
+    }
+
+    const int a = tail(h);
+    const int b = head(h);
+    const int c = tail(prev(h));
+    const int d = tail(prev(t));
+    if (c == d || find_half_edge(c, d) != INVALID ||
+            find_half_edge(d, c) != INVALID) {
+        std::stringstream err_msg;
+        err_msg << "Flipping edge (" << a << ", " << b
+            << ") would duplicate edge (" << c << ", " << d << ")";
+        throw RuntimeError(err_msg.str());
+    }
+
+    const int x_bc = m_twin[next(h)];
+    const int x_ca = m_twin[prev(h)];
+    const int x_ad = m_twin[next(t)];
+    const int x_db = m_twin[prev(t)];
+
+    // (a, b, c) + (b, a, d) -> (c, d, b) + (d, c, a)
+    m_tail[h] = c;
+    m_tail[next(h)] = d;
+    m_tail[prev(h)] = b;
+    m_tail[t] = d;
+    m_tail[next(t)] = c;
+    m_tail[prev(t)] = a;
+
+    link_twins(next(h), x_db);
+    link_twins(prev(h), x_bc);
+    link_twins(next(t), x_ca);
+    link_twins(prev(t), x_ad);
+
+    reset_vertex_half_edge(a, prev(t));
+    reset_vertex_half_edge(b, prev(h));
+    reset_vertex_half_edge(c, h);
+    reset_vertex_half_edge(d, t);
+}
+
+bool HalfEdgeMesh::is_collapsible(int h) const {
+    const int t = m_twin[h];
+    if (t == NON_MANIFOLD) return false;
+    for (size_t j=0; j<3; j++) {
+        if (m_twin[half_edge(face(h), j)] == NON_MANIFOLD) return false;
+        if (t >= 0 && m_twin[half_edge(face(t), j)] == NON_MANIFOLD)
+            return false;
+    }
+
+    const int a = tail(h);
+    const int b = head(h);
+    if (t >= 0 && is_boundary_vertex(a) && is_boundary_vertex(b)) {
+        return false;
+    }
+
+    // Interior vertices opposite to the edge would be left with 2 faces.
+    const int c = tail(prev(h));
+    if (!is_boundary_vertex(c) && get_vertex_adjacent_vertices(c).size() <= 3)
+        return false;
+    if (t >= 0) {
+        const int d = tail(prev(t));
+        if (!is_boundary_vertex(d) &&
+                get_vertex_adjacent_vertices(d).size() <= 3)
+            return false;
+    }
+
+    std::vector<int> ring_a = get_vertex_adjacent_vertices(a);
+    std::vector<int> ring_b = get_vertex_adjacent_vertices(b);
+    std::sort(ring_a.begin(), ring_a.end());
+    std::sort(ring_b.begin(), ring_b.end());
+    std::vector<int> common;
+    std::set_intersection(ring_a.begin(), ring_a.end(),
+            ring_b.begin(), ring_b.end(), std::back_inserter(common));
+    return common.size() == (t >= 0 ? 2 : 1);
+}
+
+int HalfEdgeMesh::collapse_edge(int h, const VectorF& p) {
+    if (!is_collapsible(h)) {
+        std::stringstream err_msg;
+        err_msg << "Edge (" << tail(h) << ", " << head(h)
+            << ") is not collapsible";
+        throw RuntimeError(err_msg.str());
+    }
+
+    const int t = m_twin[h];
+    const int a = tail(h);
+    const int b = head(h);
+    const int c = tail(prev(h));
+    const int x_bc = m_twin[next(h)];
+    const int x_ca = m_twin[prev(h)];
+    int d = INVALID;
+    int x_ad = BOUNDARY;
+    int x_db = BOUNDARY;
+    if (t >= 0) {
+        d = tail(prev(t));
+        x_ad = m_twin[next(t)];
+        x_db = m_twin[prev(t)];
+    }
+
+    for (int fi : get_vertex_adjacent_faces(b)) {
+        for (size_t j=0; j<3; j++) {
+            int& v = m_tail[half_edge(fi, j)];
+            if (v == b) v = a;
+        }
+    }
+
+    auto delete_face = [&](int fi) {
+        for (size_t j=0; j<3; j++) {
+            m_tail[half_edge(fi, j)] = INVALID;
+            m_twin[half_edge(fi, j)] = BOUNDARY;
+        }
+    };
+    delete_face(face(h));
+    link_twins(x_bc, x_ca);
+    if (t >= 0) {
+        delete_face(face(t));
+        link_twins(x_ad, x_db);
+    }
+    m_vertex_half_edge[b] = INVALID;
+    set_vertex(a, p);
+
+    // x_ca, x_db start at a while x_bc, x_ad end at a.
+    auto reset_with_candidates = [&](int vi,
+            std::initializer_list<int> outgoing,
+            std::initializer_list<int> incoming) {
+        for (int e : outgoing) {
+            if (e >= 0) { reset_vertex_half_edge(vi, e); return; }
+        }
+        for (int e : incoming) {
+            if (e >= 0) { reset_vertex_half_edge(vi, next(e)); return; }
+        }
+        m_vertex_half_edge[vi] = INVALID;
+    };
+    reset_with_candidates(a, {x_ca, x_db}, {x_bc, x_ad});
+    reset_with_candidates(c, {x_bc}, {x_ca});
+    if (t >= 0) {
+        reset_with_candidates(d, {x_ad}, {x_db});
+    }
+    return a;
+}
+
+VectorI HalfEdgeMesh::collect_garbage() {
+    const size_t num_vertices = get_num_vertices();
+    const size_t num_faces = get_num_faces();
+
+    VectorI vertex_map = VectorI::Constant(num_vertices, INVALID);
+    size_t vertex_count = 0;
+    for (size_t i=0; i<num_vertices; i++) {
+        if (is_vertex_deleted(i)) continue;
+        vertex_map[i] = vertex_count;
+        std::copy(m_vertices.begin() + i*m_dim,
+                m_vertices.begin() + (i+1)*m_dim,
+                m_vertices.begin() + vertex_count*m_dim);
+        m_vertex_half_edge[vertex_count] = m_vertex_half_edge[i];
+        vertex_count++;
+    }
+    m_vertices.resize(vertex_count * m_dim);
+    m_vertex_half_edge.resize(vertex_count);
+
+    std::vector<int> half_edge_map(num_faces * 3, INVALID);
+    size_t face_count = 0;
+    for (size_t i=0; i<num_faces; i++) {
+        if (is_face_deleted(i)) continue;
+        for (size_t j=0; j<3; j++) {
+            half_edge_map[i*3+j] = face_count*3+j;
+        }
+        face_count++;
+    }
+
+    for (size_t i=0; i<num_faces; i++) {
+        if (is_face_deleted(i)) continue;
+        for (size_t j=0; j<3; j++) {
+            const int h = half_edge_map[i*3+j];
+            const int t = m_twin[i*3+j];
+            m_tail[h] = vertex_map[m_tail[i*3+j]];
+            m_twin[h] = (t >= 0) ? half_edge_map[t] : t;
+        }
+    }
+    m_tail.resize(face_count * 3);
+    m_twin.resize(face_count * 3);
+
+    for (auto& h : m_vertex_half_edge) {
+        h = half_edge_map[h];
+    }
+    return vertex_map;
+}
+
+void HalfEdgeMesh::link_twins(int h0, int h1) {
+    if (h0 >= 0) m_twin[h0] = h1;
+    if (h1 >= 0) m_twin[h1] = h0;
+}
+
+/**
+ * Set the outgoing half-edge of vertex vi to h, then rotate clockwise to
+ * the outgoing boundary half-edge if there is one.
+ */
+void HalfEdgeMesh::reset_vertex_half_edge(int vi, int h) {
+    assert(tail(h) == vi);
+    int curr = h;
+    do {
+        const int t = m_twin[curr];
+        if (t < 0) {
+            m_vertex_half_edge[vi] = curr;
+            return;
+        }
+        curr = next(t);
+    } while (curr != h);
+    m_vertex_half_edge[vi] = h;
+}
+
+int HalfEdgeMesh::add_face(int v0, int v1, int v2) {
+    const int fi = get_num_faces();
+    m_tail.push_back(v0);
+    m_tail.push_back(v1);
+    m_tail.push_back(v2);
+    m_twin.insert(m_twin.end(), 3, BOUNDARY);
+    return fi;
+}
@@ -0,0 +1,149 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+
+namespace PyMesh {
+
+class Mesh;
+
+/**
+ * Index based half-edge structure for triangle meshes.
+ *
+ * Half-edge h belongs to face h/3 and runs from corner h%3 to the next
+ * corner of that face, so next(), prev() and face() are implicit.  Only the
+ * tail vertex and the twin of each half-edge are stored.  Twin is
+ * BOUNDARY if no other face shares the edge, and NON_MANIFOLD if the edge
+ * is shared by more than 2 faces or by 2 inconsistently oriented faces.
+ *
+ * Each vertex stores one outgoing half-edge.  For boundary vertices it is
+ * the outgoing boundary half-edge, so a single sweep around the vertex
+ * visits its whole fan.
+ *
+ * split_edge(), flip_edge() and collapse_edge() update the structure in
+ * place.  Collapsing leaves deleted faces and vertices behind, call
+ * collect_garbage() to compact the arrays.  Isolated vertices have no
+ * outgoing half-edge and are treated as deleted.
+ */
+class HalfEdgeMesh {
+    public:
+        typedef std::shared_ptr<HalfEdgeMesh> Ptr;
+        static const int BOUNDARY = -1;
+        static const int NON_MANIFOLD = -2;
+        static const int INVALID = -1;
+
+    public:
+        HalfEdgeMesh() : m_dim(0) {}
+        HalfEdgeMesh(const MatrixFr& vertices, const MatrixIr& faces);
+        HalfEdgeMesh(const Mesh& mesh);
+
+        void initialize(const MatrixFr& vertices, const MatrixIr& faces);
+
+    public:
+        size_t get_dim() const { return m_dim; }
+        size_t get_num_vertices() const { return m_vertex_half_edge.size(); }
+        size_t get_num_faces() const { return m_tail.size() / 3; }
+        size_t get_num_half_edges() const { return m_tail.size(); }
+
+        VectorF get_vertex(int vi) const {
+            return Eigen::Map<const VectorF>(m_vertices.data() + vi*m_dim, m_dim);
+        }
+        void set_vertex(int vi, const VectorF& v) {
+            std::copy(v.data(), v.data() + m_dim, m_vertices.begin() + vi*m_dim);
+        }
+
+        /**
+         * Deleted faces show up as rows of INVALID until collect_garbage()
+         * is called.
+         */
+        MatrixFr get_vertices() const;
+        MatrixIr get_faces() const;
+
+    public:
+        // Local traversal, all O(1).
+        static int next(int h) { return h - h%3 + (h+1)%3; }
+        static int prev(int h) { return h - h%3 + (h+2)%3; }
+        static int face(int h) { return h / 3; }
+        int tail(int h) const { return m_tail[h]; }
+        int head(int h) const { return m_tail[next(h)]; }
+        int twin(int h) const { return m_twin[h]; }
+        int half_edge(int fi, int j) const { return fi*3 + j; }
+        int outgoing_half_edge(int vi) const { return m_vertex_half_edge[vi]; }
+
+        bool is_boundary_half_edge(int h) const { return m_twin[h] == BOUNDARY; }
+        bool is_manifold_half_edge(int h) const { return m_twin[h] != NON_MANIFOLD; }
+        bool is_boundary_vertex(int vi) const;
+        bool is_face_deleted(int fi) const { return m_tail[fi*3] == INVALID; }
+        bool is_vertex_deleted(int vi) const {
+            return m_vertex_half_edge[vi] == INVALID;
+        }
+
+        /**
+         * Find the half-edge from v0 to v1, or INVALID.
+         */
+        int find_half_edge(int v0, int v1) const;
+
+        /**
+         * One ring neighbors in counterclockwise order.  Both assume the
+         * fan around vi is manifold.
+         */
+        std::vector<int> get_vertex_adjacent_vertices(int vi) const;
+        std::vector<int> get_vertex_adjacent_faces(int vi) const;
+
+        /**
+         * Half-edges without a twin, one per boundary edge.
+         */
+        std::vector<int> get_boundary_half_edges() const;
+
+    public:
+        // In place modifications.  All of them require manifold edges.
+
+        /**
+         * Insert a vertex at p on the edge of h.  The faces adjacent to the
+         * edge are split in two.  Returns the new vertex index.
+         */
+        int split_edge(int h, const VectorF& p);
+
+        /**
+         * Replace the interior edge of h by the other diagonal of the quad
+         * formed by its two adjacent faces.  Afterwards h runs between the
+         * two previously opposite vertices.
+         */
+        void flip_edge(int h);
+
+        /**
+         * Check the link condition, that an interior edge does not join two
+         * boundary vertices and that no interior vertex drops to valence 2.
+         */
+        bool is_collapsible(int h) const;
+
+        /**
+         * Merge head(h) into tail(h) and move the merged vertex to p.  The
+         * faces adjacent to the edge are deleted.  Returns the surviving
+         * vertex.
+         */
+        int collapse_edge(int h, const VectorF& p);
+
+        /**
+         * Remove deleted faces and vertices.  Returns the map from old to
+         * new vertex indices (INVALID for deleted vertices).
+         */
+        VectorI collect_garbage();
+
+    private:
+        void link_twins(int h0, int h1);
+        void reset_vertex_half_edge(int vi, int h);
+        int add_face(int v0, int v1, int v2);
+
+    private:
+        size_t m_dim;
+        std::vector<Float> m_vertices;
+        std::vector<int> m_tail;
+        std::vector<int> m_twin;
+        std::vector<int> m_vertex_half_edge;
+};
+
+}
@@ -1,10 +1,16 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "PLYParser.h"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <tbb/tbb.h>
+
 #include <Core/EigenTypedef.h>
 #include <Core/Exception.h>
 
@@ -31,6 +37,11 @@ namespace PLYParserHelper {
         return elem_name + "_" + prop_name;
     }
 
+    bool is_float_type(e_ply_type type) {
+        return type == PLY_FLOAT || type == PLY_DOUBLE ||
+            type == PLY_FLOAT32 || type == PLY_FLOAT64;
+    }
+
     int ply_parser_call_back(p_ply_argument argument) {
         p_ply_element elem;
         p_ply_property prop;
@@ -51,8 +62,7 @@ namespace PLYParserHelper {
         double value = ply_get_argument_value(argument);
 
         if (value_idx >= 0)
-            if(type == PLY_FLOAT || type == PLY_DOUBLE ||
-                    value_type == PLY_FLOAT || value_type == PLY_DOUBLE)
+            if(is_float_type(type) || is_float_type(value_type))
                 parser->add_property_value(elem_name, prop_name, value);
             else
                 parser->add_property_value(elem_name, prop_name, static_cast<int>(value));
@@ -78,8 +88,7 @@ namespace PLYParserHelper {
                 assert_success(ply_get_property_info(property, &prop_name, &type, NULL, &value_type));
 
                 ply_set_read_cb(ply, elem_name, prop_name, ply_parser_call_back, parser, 0);
-                if(type == PLY_FLOAT || type == PLY_DOUBLE ||
-                value_type == PLY_FLOAT || value_type == PLY_DOUBLE)
+                if(is_float_type(type) || is_float_type(value_type))
                     parser->add_float_property(elem_name, prop_name, num_elements);
                 else
                     parser->add_int_property(elem_name, prop_name, num_elements);
@@ -91,12 +100,414 @@ namespace PLYParserHelper {
         assert_success(ply_read(ply));
         ply_close(ply);
     }
+
+    /**
+     * Bytes read from disk at a time by the binary reader.
+     */
+    const size_t CHUNK_SIZE = size_t(1) << 26;
+
+    struct PropertyInfo {
+        std::string name;
+        bool is_list;
+        e_ply_type type;        // Value type for list properties.
+        e_ply_type length_type; // Only valid for list properties.
+        size_t offset;          // Byte offset within a fixed-size record.
+    };
+
+    struct ElementInfo {
+        std::string name;
+        size_t count;
+        std::vector<PropertyInfo> properties;
+        size_t record_size;     // 0 if the element has list properties.
+    };
+
+    bool parse_type(const std::string& name, e_ply_type& type) {
+        const char* names[] = {
+            "int8", "uint8", "int16", "uint16",
+            "int32", "uint32", "float32", "float64",
+            "char", "uchar", "short", "ushort",
+            "int", "uint", "float", "double" };
+        for (int i=0; i<16; i++) {
+            if (name == names[i]) {
+                type = static_cast<e_ply_type>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t type_size(e_ply_type type) {
+        switch (type) {
+            case PLY_INT8: case PLY_UINT8: case PLY_CHAR: case PLY_UCHAR:
+                return 1;
+            case PLY_INT16: case PLY_UINT16: case PLY_SHORT: case PLY_USHORT:
+                return 2;
+            case PLY_INT32: case PLY_UIN32: case PLY_INT: case PLY_UINT:
+            case PLY_FLOAT32: case PLY_FLOAT:
+                return 4;
+            case PLY_FLOAT64: case PLY_DOUBLE:
+                return 8;
+            default:
+                throw IOError("Unsupported PLY type");
+        }
+    }
+
+    bool is_little_endian_host() {
+        const uint16_t value = 1;
+        uint8_t first_byte;
+        std::memcpy(&first_byte, &value, 1);
+        return first_byte == 1;
+    }
+
+    /**
+     * Parse the header of a binary PLY file.  Return false if the file is
+     * not a binary PLY file this reader understands, in which case the
+     * caller should fall back to rply.
+     */
+    bool parse_binary_header(std::istream& fin,
+            std::vector<ElementInfo>& elements, bool& swap_bytes) {
+        std::string line;
+        if (!std::getline(fin, line) || line.substr(0, 3) != "ply") {
+            return false;
+        }
+
+        bool has_format = false;
+        while (std::getline(fin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            std::stringstream sin(line);
+            std::string keyword;
+            sin >> keyword;
+            if (keyword == "end_header") {
+                return has_format;
+            } else if (keyword == "format") {
+                std::string format;
+                sin >> format;
+                if (format == "binary_little_endian") {
+                    swap_bytes = !is_little_endian_host();
+                } else if (format == "binary_big_endian") {
+                    swap_bytes = is_little_endian_host();
+                } else {
+                    return false;
+                }
+                has_format = true;
+            } else if (keyword == "element") {
+                ElementInfo elem;
+                long count = -1;
+                sin >> elem.name >> count;
+                if (sin.fail() || count < 0) return false;
+                elem.count = count;
+                elem.record_size = 0;
+                elements.push_back(elem);
+            } else if (keyword == "property") {
+                if (elements.empty()) return false;
+                ElementInfo& elem = elements.back();
+                PropertyInfo prop;
+                std::string type_name;
+                sin >> type_name;
+                if (type_name == "list") {
+                    std::string length_type_name, value_type_name;
+                    sin >> length_type_name >> value_type_name;
+                    if (!parse_type(length_type_name, prop.length_type) ||
+                            !parse_type(value_type_name, prop.type)) {
+                        return false;
+                    }
+                    prop.is_list = true;
+                } else {
+                    if (!parse_type(type_name, prop.type)) return false;
+                    prop.is_list = false;
+                }
+                sin >> prop.name;
+                if (sin.fail()) return false;
+                prop.offset = 0;
+                elem.properties.push_back(prop);
+            } else if (keyword != "comment" && keyword != "obj_info") {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Sequential reader over a binary stream with a large internal buffer.
+     */
+    class BinaryReader {
+        public:
+            BinaryReader(std::istream& fin, size_t num_bytes)
+                : m_fin(fin), m_unread(num_bytes), m_capacity(0),
+                  m_begin(0), m_end(0) {}
+
+            /**
+             * Return a pointer to the next n bytes without consuming them.
+             */
+            const char* peek(size_t n) {
+                if (m_end - m_begin < n) {
+                    const size_t remaining = m_end - m_begin;
+                    if (remaining + m_unread < n) {
+                        throw IOError("Unexpected end of PLY file");
+                    }
+                    const size_t capacity = std::max(n,
+                            std::min(CHUNK_SIZE, remaining + m_unread));
+                    if (capacity > m_capacity) {
+                        std::unique_ptr<char[]> buffer(new char[capacity]);
+                        std::copy(m_buffer.get() + m_begin,
+                                m_buffer.get() + m_end, buffer.get());
+                        m_buffer.swap(buffer);
+                        m_capacity = capacity;
+                    } else {
+                        std::copy(m_buffer.get() + m_begin,
+                                m_buffer.get() + m_end, m_buffer.get());
+                    }
+                    const size_t num_to_read = std::min(
+                            capacity - remaining, m_unread);
+                    m_fin.read(m_buffer.get() + remaining, num_to_read);
+                    if (size_t(m_fin.gcount()) != num_to_read) {
+                        throw IOError("Unexpected end of PLY file");
+                    }
+                    m_unread -= num_to_read;
+                    m_begin = 0;
+                    m_end = remaining + num_to_read;
+                }
+                return m_buffer.get() + m_begin;
+            }
+
+            void consume(size_t n) { m_begin += n; }
+
+        private:
+            std::istream& m_fin;
+            std::unique_ptr<char[]> m_buffer;
+            size_t m_unread;
+            size_t m_capacity;
+            size_t m_begin;
+            size_t m_end;
+    };
+
+    template<typename T>
+    T load_value(const char* data, bool swap_bytes) {
+        T value;
+        if (swap_bytes) {
+            char bytes[sizeof(T)];
+            std::reverse_copy(data, data + sizeof(T), bytes);
+            std::memcpy(&value, bytes, sizeof(T));
+        } else {
+            std::memcpy(&value, data, sizeof(T));
+        }
+        return value;
+    }
+
+    template<typename D>
+    D read_value(const char* data, e_ply_type type, bool swap_bytes) {
+        switch (type) {
+            case PLY_INT8: case PLY_CHAR:
+                return static_cast<D>(load_value<int8_t>(data, swap_bytes));
+            case PLY_UINT8: case PLY_UCHAR:
+                return static_cast<D>(load_value<uint8_t>(data, swap_bytes));
+            case PLY_INT16: case PLY_SHORT:
+                return static_cast<D>(load_value<int16_t>(data, swap_bytes));
+            case PLY_UINT16: case PLY_USHORT:
+                return static_cast<D>(load_value<uint16_t>(data, swap_bytes));
+            case PLY_INT32: case PLY_INT:
+                return static_cast<D>(load_value<int32_t>(data, swap_bytes));
+            case PLY_UIN32: case PLY_UINT:
+                return static_cast<D>(load_value<uint32_t>(data, swap_bytes));
+            case PLY_FLOAT32: case PLY_FLOAT:
+                return static_cast<D>(load_value<float>(data, swap_bytes));
+            case PLY_FLOAT64: case PLY_DOUBLE:
+                return static_cast<D>(load_value<double>(data, swap_bytes));
+            default:
+                throw IOError("Unsupported PLY type");
+        }
+    }
+
+    template<typename T, typename D>
+    void decode_column(const char* data, size_t stride, size_t n,
+            bool swap_bytes, D* dst) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        dst[i] = static_cast<D>(
+                                load_value<T>(data + i*stride, swap_bytes));
+                    }
+                });
+    }
+
+    /**
+     * Strided copy of one fixed-size property out of n consecutive records.
+     */
+    template<typename D>
+    void decode_column(const char* data, size_t stride, size_t n,
+            e_ply_type type, bool swap_bytes, D* dst) {
+        switch (type) {
+            case PLY_INT8: case PLY_CHAR:
+                decode_column<int8_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_UINT8: case PLY_UCHAR:
+                decode_column<uint8_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_INT16: case PLY_SHORT:
+                decode_column<int16_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_UINT16: case PLY_USHORT:
+                decode_column<uint16_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_INT32: case PLY_INT:
+                decode_column<int32_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_UIN32: case PLY_UINT:
+                decode_column<uint32_t>(data, stride, n, swap_bytes, dst); break;
+            case PLY_FLOAT32: case PLY_FLOAT:
+                decode_column<float>(data, stride, n, swap_bytes, dst); break;
+            case PLY_FLOAT64: case PLY_DOUBLE:
+                decode_column<double>(data, stride, n, swap_bytes, dst); break;
+            default:
+                throw IOError("Unsupported PLY type");
+        }
+    }
+
+    /**
+     * Read an element whose properties are all fixed-size.  Records are
+     * read in large blocks and each property is decoded in parallel
+     * directly into its attribute buffer.
+     */
+    void read_fixed_size_element(BinaryReader& reader, const ElementInfo& elem,
+            bool swap_bytes, PLYParser* parser) {
+        std::vector<std::vector<Float>*> float_buffers;
+        std::vector<std::vector<int>*> int_buffers;
+        for (const auto& prop : elem.properties) {
+            if (is_float_type(prop.type)) {
+                float_buffers.push_back(
+                        &parser->get_float_property(elem.name, prop.name));
+                float_buffers.back()->resize(elem.count);
+                int_buffers.push_back(nullptr);
+            } else {
+                int_buffers.push_back(
+                        &parser->get_int_property(elem.name, prop.name));
+                int_buffers.back()->resize(elem.count);
+                float_buffers.push_back(nullptr);
+            }
+        }
+
+        const size_t stride = elem.record_size;
+        const size_t records_per_chunk = std::max<size_t>(1, CHUNK_SIZE / stride);
+        for (size_t begin=0; begin<elem.count; begin+=records_per_chunk) {
+            const size_t n = std::min(records_per_chunk, elem.count - begin);
+            const char* data = reader.peek(n * stride);
+            const size_t num_props = elem.properties.size();
+            for (size_t i=0; i<num_props; i++) {
+                const PropertyInfo& prop = elem.properties[i];
+                if (float_buffers[i] != nullptr) {
+                    decode_column(data + prop.offset, stride, n, prop.type,
+                            swap_bytes, float_buffers[i]->data() + begin);
+                } else {
+                    decode_column(data + prop.offset, stride, n, prop.type,
+                            swap_bytes, int_buffers[i]->data() + begin);
+                }
+            }
+            reader.consume(n * stride);
+        }
+    }
+
+    /**
+     * Read an element with list properties record by record.
+     */
+    void read_variable_size_element(BinaryReader& reader,
+            const ElementInfo& elem, bool swap_bytes, PLYParser* parser) {
+        std::vector<std::vector<Float>*> float_buffers;
+        std::vector<std::vector<int>*> int_buffers;
+        for (const auto& prop : elem.properties) {
+            const bool is_float = is_float_type(prop.type);
+            float_buffers.push_back(is_float ?
+                    &parser->get_float_property(elem.name, prop.name) : nullptr);
+            int_buffers.push_back(is_float ?
+                    nullptr : &parser->get_int_property(elem.name, prop.name));
+        }
+
+        const size_t num_props = elem.properties.size();
+        for (size_t i=0; i<elem.count; i++) {
+            for (size_t j=0; j<num_props; j++) {
+                const PropertyInfo& prop = elem.properties[j];
+                size_t length = 1;
+                if (prop.is_list) {
+                    const size_t length_size = type_size(prop.length_type);
+                    const Float raw_length = read_value<Float>(
+                            reader.peek(length_size), prop.length_type,
+                            swap_bytes);
+                    if (raw_length < 0) {
+                        throw IOError("Negative list length in PLY file");
+                    }
+                    length = size_t(raw_length);
+                    reader.consume(length_size);
+                }
+
+                const size_t value_size = type_size(prop.type);
+                const char* data = reader.peek(length * value_size);
+                for (size_t k=0; k<length; k++) {
+                    if (float_buffers[j] != nullptr) {
+                        float_buffers[j]->push_back(read_value<Float>(
+                                    data + k*value_size, prop.type, swap_bytes));
+                    } else {
+                        int_buffers[j]->push_back(read_value<int>(
+                                    data + k*value_size, prop.type, swap_bytes));
+                    }
+                }
+                reader.consume(length * value_size);
+            }
+        }
+    }
+
+    /**
+     * Read binary PLY files without going through rply callbacks.  Return
+     * false if the file is not binary, in which case nothing is read.
+     */
+    bool parse_binary_ply(const std::string& filename, PLYParser* parser) {
+        std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!fin.is_open()) {
+            return false;
+        }
+
+        std::vector<ElementInfo> elements;
+        bool swap_bytes = false;
+        if (!parse_binary_header(fin, elements, swap_bytes)) {
+            return false;
+        }
+
+        for (auto& elem : elements) {
+            size_t offset = 0;
+            bool is_fixed_size = true;
+            for (auto& prop : elem.properties) {
+                if (prop.is_list) {
+                    is_fixed_size = false;
+                } else {
+                    prop.offset = offset;
+                    offset += type_size(prop.type);
+                }
+
+                if (is_float_type(prop.type))
+                    parser->add_float_property(elem.name, prop.name, elem.count);
+                else
+                    parser->add_int_property(elem.name, prop.name, elem.count);
+            }
+            elem.record_size = is_fixed_size ? offset : 0;
+        }
+
+        const std::streampos data_begin = fin.tellg();
+        fin.seekg(0, std::ios::end);
+        const std::streampos data_end = fin.tellg();
+        fin.seekg(data_begin);
+
+        BinaryReader reader(fin, size_t(data_end - data_begin));
+        for (const auto& elem : elements) {
+            if (elem.count == 0 || elem.properties.empty()) continue;
+            if (elem.record_size > 0) {
+                read_fixed_size_element(reader, elem, swap_bytes, parser);
+            } else {
+                read_variable_size_element(reader, elem, swap_bytes, parser);
+            }
+        }
+        return true;
+    }
 }
 
 using namespace PLYParserHelper;
 
 bool PLYParser::parse(const std::string& filename) {
-    parse_ply(filename, this);
+    if (!parse_binary_ply(filename, this)) {
+        parse_ply(filename, this);
+    }
     init_vertices();
     init_faces();
     init_voxels();
@@ -240,6 +651,26 @@ void PLYParser::add_property_value(const std::string& elem_name,
     attr.push_back(value);
 }
 
+std::vector<Float>& PLYParser::get_float_property(
+        const std::string& elem_name, const std::string& prop_name) {
+    std::string attr_name = form_attribute_name(elem_name, prop_name);
+    AttributeMapF::iterator itr = m_attributesF.find(attr_name);
+    if (itr == m_attributesF.end()) {
+        throw_attribute_not_found_exception(attr_name);
+    }
+    return itr->second;
+}
+
+std::vector<int>& PLYParser::get_int_property(
+        const std::string& elem_name, const std::string& prop_name) {
+    std::string attr_name = form_attribute_name(elem_name, prop_name);
+    AttributeMapI::iterator itr = m_attributesI.find(attr_name);
+    if (itr == m_attributesI.end()) {
+        throw_attribute_not_found_exception(attr_name);
+    }
+    return itr->second;
+}
+
 void PLYParser::init_vertices() {
     std::string field_names[] = {
         std::string("vertex_x"),
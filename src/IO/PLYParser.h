@@ -47,6 +47,15 @@ class PLYParser : public MeshParser {
         void add_property_value(const std::string& elem_name,
                             const std::string& prop_name, int value);
 
+        /**
+         * Direct access to the values of a property added by
+         * add_float_property/add_int_property, used for bulk reading.
+         */
+        std::vector<Float>& get_float_property(const std::string& elem_name,
+                const std::string& prop_name);
+        std::vector<int>& get_int_property(const std::string& elem_name,
+                const std::string& prop_name);
+
         void init_vertices();
         void init_faces();
         void init_voxels();
@@ -1,10 +1,17 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "PLYWriter.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
+#include <tbb/tbb.h>
+
 #include <Core/EigenTypedef.h>
 #include <Core/Exception.h>
 #include <Mesh.h>
@@ -36,6 +43,82 @@ namespace PLYWriterHelper {
             return name;
         }
     }
+
+    /**
+     * Bytes of binary records encoded in memory before they are written.
+     */
+    const size_t CHUNK_SIZE = size_t(1) << 26;
+
+    bool is_color(const std::string& name) {
+        return name == "red" || name == "green" || name == "blue";
+    }
+
+    const char* type_name(e_ply_type type) {
+        switch (type) {
+            case PLY_UCHAR: return "uchar";
+            case PLY_INT: return "int";
+            case PLY_UINT: return "uint";
+            case PLY_FLOAT: return "float";
+            case PLY_DOUBLE: return "double";
+            default:
+                throw NotImplementedError("Unsupported PLY output type");
+        }
+    }
+
+    size_t type_size(e_ply_type type) {
+        switch (type) {
+            case PLY_UCHAR: return 1;
+            case PLY_INT: case PLY_UINT: case PLY_FLOAT: return 4;
+            case PLY_DOUBLE: return 8;
+            default:
+                throw NotImplementedError("Unsupported PLY output type");
+        }
+    }
+
+    bool is_little_endian_host() {
+        const uint16_t value = 1;
+        uint8_t first_byte;
+        std::memcpy(&first_byte, &value, 1);
+        return first_byte == 1;
+    }
+
+    template<typename T>
+    void store_value(char* data, T value, bool swap_bytes) {
+        if (swap_bytes) {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            std::reverse_copy(bytes, bytes + sizeof(T), data);
+        } else {
+            std::memcpy(data, &value, sizeof(T));
+        }
+    }
+
+    /**
+     * Store value as the given PLY type and return the number of bytes
+     * written.  Conversions match the ones done by rply's ply_write.
+     */
+    template<typename S>
+    size_t write_value(char* data, e_ply_type type, S value, bool swap_bytes) {
+        switch (type) {
+            case PLY_UCHAR:
+                store_value(data, static_cast<uint8_t>(value), swap_bytes);
+                return 1;
+            case PLY_INT:
+                store_value(data, static_cast<int32_t>(value), swap_bytes);
+                return 4;
+            case PLY_UINT:
+                store_value(data, static_cast<uint32_t>(value), swap_bytes);
+                return 4;
+            case PLY_FLOAT:
+                store_value(data, static_cast<float>(value), swap_bytes);
+                return 4;
+            case PLY_DOUBLE:
+                store_value(data, static_cast<double>(value), swap_bytes);
+                return 8;
+            default:
+                throw NotImplementedError("Unsupported PLY output type");
+        }
+    }
 }
 
 using namespace PLYWriterHelper;
@@ -45,28 +128,18 @@ void PLYWriter::with_attribute(const std::string& attr_name) {
 }
 
 void PLYWriter::write_mesh(Mesh& mesh) {
-    p_ply ply = ply_create(m_filename.c_str(),
-            m_in_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
-            NULL, 0, NULL);
-    assert_success(ply != NULL, "ply_create_failed");
-
     regroup_attribute_names(mesh);
 
-    add_vertex_elements_header(mesh, ply);
-    add_face_elements_header(mesh, ply);
-    add_voxel_elements_header(mesh, ply);
+    ElementArray elements;
+    add_vertex_element(mesh, elements);
+    add_face_element(mesh, elements);
+    add_voxel_element(mesh, elements);
 
-    if (!is_anonymous()) {
-        assert_success(ply_add_comment(ply, "Generated by PyMesh"),
-                "Adding comment failed");
+    if (m_in_ascii) {
+        write_ascii(elements);
+    } else {
+        write_binary(elements);
     }
-    assert_success(ply_write_header(ply), "Writting header failed");
-
-    write_vertex_elements(mesh, ply);
-    write_face_elements(mesh, ply);
-    write_voxel_elements(mesh, ply);
-
-    ply_close(ply);
 }
 
 void PLYWriter::write(
@@ -138,308 +211,231 @@ void PLYWriter::regroup_attribute_names(Mesh& mesh) {
     }
 }
 
-void PLYWriter::add_vertex_elements_header(Mesh& mesh, p_ply& ply) {
+void PLYWriter::add_vertex_element(Mesh& mesh, ElementArray& elements) {
     const size_t dim = mesh.get_dim();
-    const size_t num_vertices = mesh.get_num_vertices();
-    assert_success(ply_add_element(ply, "vertex", num_vertices),
-            "Add element failed");
-    assert_success(ply_add_scalar_property(ply, "x", m_scalar),
-            "Add X coordinate failed");
-    assert_success(ply_add_scalar_property(ply, "y", m_scalar),
-            "Add Y coordinate failed");
-    if (dim == 3) {
-        assert_success(ply_add_scalar_property(ply, "z", m_scalar),
-                "Add Z coordinate failed");
-    }
-
-    for (NameArray::const_iterator itr = m_vertex_attr_namesF.begin();
-            itr != m_vertex_attr_namesF.end(); itr++) {
-        const std::string name = strip_prefix(*itr, "vertex_");
-        const VectorF& attr = mesh.get_float_attribute(*itr);
-        const size_t per_vertex_size = attr.size() / num_vertices;
-        e_ply_type ply_type = m_scalar;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_vertex_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                    "Add scalar property failed");
-        } else {
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                        ply_type), "Add list property failed");
-        }
-    }
-
-    for (NameArray::const_iterator itr = m_vertex_attr_namesI.begin();
-         itr != m_vertex_attr_namesI.end(); itr++) {
-        const std::string name = strip_prefix(*itr, "vertex_");
-        const VectorI& attr = mesh.get_int_attribute(*itr);
-        const size_t per_vertex_size = attr.size() / num_vertices;
-        e_ply_type ply_type = PLY_INT;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_vertex_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                           "Add scalar property failed");
-        } else {
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                                                 ply_type), "Add list property failed");
-        }
+    const VectorF& vertices = mesh.get_vertices();
+    const char* coordinate_names[] = {"x", "y", "z"};
+
+    Element element;
+    element.name = "vertex";
+    element.count = mesh.get_num_vertices();
+    for (size_t i=0; i<std::min<size_t>(dim, 3); i++) {
+        Property prop;
+        prop.name = coordinate_names[i];
+        prop.type = m_scalar;
+        prop.length_type = PLY_UINT;
+        prop.is_list = false;
+        prop.width = 1;
+        prop.stride = dim;
+        prop.data_f = vertices.data() + i;
+        element.properties.push_back(prop);
     }
+    add_attribute_properties(mesh, m_vertex_attr_namesF, m_vertex_attr_namesI,
+            "vertex_", element);
+    elements.push_back(element);
 }
 
-void PLYWriter::add_face_elements_header(Mesh& mesh, p_ply& ply) {
-    const size_t num_faces = mesh.get_num_faces();
-    assert_success(ply_add_element(ply, "face", num_faces), "Add face failed");
-    assert_success(ply_add_list_property(ply, "vertex_indices", PLY_UCHAR,
-                PLY_INT), "Add face vertex indices failed");
-
-    for (NameArray::const_iterator itr = m_face_attr_namesF.begin();
-            itr != m_face_attr_namesF.end(); itr++) {
-        std::string name = strip_prefix(*itr, "face_");
-        const VectorF& attr = mesh.get_float_attribute(*itr);
-        const size_t per_face_size = attr.size() / num_faces;
-        e_ply_type ply_type = m_scalar;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_face_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                    "Add per face scalar attribute failed");
-        } else {
-            if (name == "corner_texture") {
-                name = "texcoord";
-            }
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                        ply_type), "Add per face vector attribute failed");
-        }
-    }
-
-    for (NameArray::const_iterator itr = m_face_attr_namesI.begin();
-         itr != m_face_attr_namesI.end(); itr++) {
-        std::string name = strip_prefix(*itr, "face_");
-        const VectorI& attr = mesh.get_int_attribute(*itr);
-        const size_t per_face_size = attr.size() / num_faces;
-        e_ply_type ply_type = PLY_INT;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_face_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                           "Add per face scalar attribute failed");
-        } else {
-            if (name == "corner_texture") {
-                name = "texcoord";
-            }
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                                                 ply_type), "Add per face vector attribute failed");
+void PLYWriter::add_face_element(Mesh& mesh, ElementArray& elements) {
+    Element element;
+    element.name = "face";
+    element.count = mesh.get_num_faces();
+
+    Property indices;
+    indices.name = "vertex_indices";
+    indices.type = PLY_INT;
+    indices.length_type = PLY_UCHAR;
+    indices.is_list = true;
+    indices.width = mesh.get_vertex_per_face();
+    indices.stride = indices.width;
+    indices.data_i = mesh.get_faces().data();
+    element.properties.push_back(indices);
+
+    add_attribute_properties(mesh, m_face_attr_namesF, m_face_attr_namesI,
+            "face_", element);
+    for (auto& prop : element.properties) {
+        if (prop.is_list && prop.name == "corner_texture") {
+            prop.name = "texcoord";
         }
     }
+    elements.push_back(element);
 }
 
-void PLYWriter::add_voxel_elements_header(Mesh& mesh, p_ply& ply) {
+void PLYWriter::add_voxel_element(Mesh& mesh, ElementArray& elements) {
     const size_t num_voxels = mesh.get_num_voxels();
     if (num_voxels == 0) return;
-    assert_success(ply_add_element(ply, "voxel", num_voxels), "Add voxel failed");
-    assert_success(ply_add_list_property(ply, "vertex_indices", PLY_UCHAR,
-                PLY_INT), "Add voxel vertex indices failed");
-
-    for (NameArray::const_iterator itr = m_voxel_attr_namesF.begin();
-            itr != m_voxel_attr_namesF.end(); itr++) {
-        const std::string name = strip_prefix(*itr, "voxel_");
-        const VectorF& attr = mesh.get_float_attribute(*itr);
-        const size_t per_voxel_size = attr.size() / num_voxels;
-        e_ply_type ply_type = m_scalar;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_voxel_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                    "Add per voxel scalar attribute failed");
-        } else {
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                        ply_type), "Add per voxel vector attribute failed");
-        }
-    }
 
-    for (NameArray::const_iterator itr = m_voxel_attr_namesI.begin();
-         itr != m_voxel_attr_namesI.end(); itr++) {
-        const std::string name = strip_prefix(*itr, "voxel_");
-        const VectorI& attr = mesh.get_int_attribute(*itr);
-        const size_t per_voxel_size = attr.size() / num_voxels;
-        e_ply_type ply_type = PLY_INT;
-        if (name == "red" || name == "green" || name == "blue") {
-            ply_type = PLY_UCHAR;
-        }
-        if (per_voxel_size == 1) {
-            assert_success(ply_add_scalar_property(ply, name.c_str(), ply_type),
-                           "Add per voxel scalar attribute failed");
-        } else {
-            assert_success(ply_add_list_property(ply, name.c_str(), PLY_UINT,
-                                                 ply_type), "Add per voxel vector attribute failed");
-        }
-    }
+    Element element;
+    element.name = "voxel";
+    element.count = num_voxels;
+
+    Property indices;
+    indices.name = "vertex_indices";
+    indices.type = PLY_INT;
+    indices.length_type = PLY_UCHAR;
+    indices.is_list = true;
+    indices.width = mesh.get_vertex_per_voxel();
+    indices.stride = indices.width;
+    indices.data_i = mesh.get_voxels().data();
+    element.properties.push_back(indices);
+
+    add_attribute_properties(mesh, m_voxel_attr_namesF, m_voxel_attr_namesI,
+            "voxel_", element);
+    elements.push_back(element);
 }
 
-void PLYWriter::write_vertex_elements(Mesh& mesh, p_ply& ply) {
-    const size_t dim = mesh.get_dim();
-    const size_t num_vertices = mesh.get_num_vertices();
-    const VectorF& vertices = mesh.get_vertices();
-
-    std::vector<const VectorF*> attributesF;
-    std::vector<const VectorI*> attributesI;
-    std::vector<size_t> per_vertex_sizesF;
-    std::vector<size_t> per_vertex_sizesI;
-    for (NameArray::const_iterator itr = m_vertex_attr_namesF.begin();
-            itr != m_vertex_attr_namesF.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorF& attr = mesh.get_float_attribute(name);
-        attributesF.push_back(&attr);
-        per_vertex_sizesF.push_back(attr.size() / num_vertices);
+void PLYWriter::add_attribute_properties(Mesh& mesh,
+        const NameArray& float_names, const NameArray& int_names,
+        const std::string& prefix, Element& element) {
+    const size_t num_entries = element.count;
+    for (const auto& attr_name : float_names) {
+        const VectorF& attr = mesh.get_float_attribute(attr_name);
+        assert(attr.size() % num_entries == 0);
+        Property prop;
+        prop.name = strip_prefix(attr_name, prefix);
+        prop.type = is_color(prop.name) ? PLY_UCHAR : m_scalar;
+        prop.length_type = PLY_UINT;
+        prop.width = attr.size() / num_entries;
+        prop.is_list = prop.width != 1;
+        prop.stride = prop.width;
+        prop.data_f = attr.data();
+        element.properties.push_back(prop);
     }
-    for (NameArray::const_iterator itr = m_vertex_attr_namesI.begin();
-         itr != m_vertex_attr_namesI.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorI& attr = mesh.get_int_attribute(name);
-        attributesI.push_back(&attr);
-        per_vertex_sizesI.push_back(attr.size() / num_vertices);
+    for (const auto& attr_name : int_names) {
+        const VectorI& attr = mesh.get_int_attribute(attr_name);
+        assert(attr.size() % num_entries == 0);
+        Property prop;
+        prop.name = strip_prefix(attr_name, prefix);
+        prop.type = is_color(prop.name) ? PLY_UCHAR : PLY_INT;
+        prop.length_type = PLY_UINT;
+        prop.width = attr.size() / num_entries;
+        prop.is_list = prop.width != 1;
+        prop.stride = prop.width;
+        prop.data_i = attr.data();
+        element.properties.push_back(prop);
     }
+}
 
-    const size_t num_attributesF = attributesF.size();
-    const size_t num_attributesI = attributesI.size();
+void PLYWriter::write_ascii(const ElementArray& elements) {
+    p_ply ply = ply_create(m_filename.c_str(), PLY_ASCII, NULL, 0, NULL);
+    assert_success(ply != NULL, "ply_create_failed");
 
-    for (size_t i=0; i<num_vertices; i++) {
-        for (size_t j=0; j<dim; j++) {
-            ply_write(ply, vertices[i*dim + j]);
-        }
-        for (size_t j=0; j<num_attributesF; j++) {
-            const size_t per_vertex_size = per_vertex_sizesF[j];
-            if (per_vertex_size != 1) {
-                ply_write(ply, per_vertex_size);
-            }
-            for (size_t k=0; k<per_vertex_size; k++) {
-                ply_write(ply, attributesF[j]->coeff(i*per_vertex_size + k));
-            }
-        }
-        for (size_t j=0; j<num_attributesI; j++) {
-            const size_t per_vertex_size = per_vertex_sizesI[j];
-            if (per_vertex_size != 1) {
-                ply_write(ply, per_vertex_size);
-            }
-            for (size_t k=0; k<per_vertex_size; k++) {
-                ply_write(ply, attributesI[j]->coeff(i*per_vertex_size + k));
+    for (const auto& element : elements) {
+        assert_success(ply_add_element(ply, element.name.c_str(),
+                    element.count), "Add element failed");
+        for (const auto& prop : element.properties) {
+            if (prop.is_list) {
+                assert_success(ply_add_list_property(ply, prop.name.c_str(),
+                            prop.length_type, prop.type),
+                        "Add list property failed");
+            } else {
+                assert_success(ply_add_scalar_property(ply, prop.name.c_str(),
+                            prop.type), "Add scalar property failed");
             }
         }
     }
-}
 
-void PLYWriter::write_face_elements(Mesh& mesh, p_ply& ply) {
-    const size_t num_faces = mesh.get_num_faces();
-    const size_t num_vertex_per_face = mesh.get_vertex_per_face();
-    const VectorI& faces = mesh.get_faces();
-
-    std::vector<const VectorF*> attributesF;
-    std::vector<const VectorI*> attributesI;
-    std::vector<size_t> per_face_sizesF;
-    std::vector<size_t> per_face_sizesI;
-    for (NameArray::const_iterator itr = m_face_attr_namesF.begin();
-            itr != m_face_attr_namesF.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorF& attr = mesh.get_float_attribute(name);
-        attributesF.push_back(&attr);
-        per_face_sizesF.push_back(attr.size() / num_faces);
-    }
-    for (NameArray::const_iterator itr = m_face_attr_namesI.begin();
-         itr != m_face_attr_namesI.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorI& attr = mesh.get_int_attribute(name);
-        attributesI.push_back(&attr);
-        per_face_sizesI.push_back(attr.size() / num_faces);
+    if (!is_anonymous()) {
+        assert_success(ply_add_comment(ply, "Generated by PyMesh"),
+                "Adding comment failed");
     }
+    assert_success(ply_write_header(ply), "Writting header failed");
 
-    const size_t num_attributesF = attributesF.size();
-    const size_t num_attributesI = attributesI.size();
-
-    for (size_t i=0; i<num_faces; i++) {
-        ply_write(ply, num_vertex_per_face);
-        for (size_t j=0; j<num_vertex_per_face; j++) {
-            ply_write(ply, faces[i*num_vertex_per_face + j]);
-        }
-        for (size_t j=0; j<num_attributesF; j++) {
-            const size_t per_face_size = per_face_sizesF[j];
-            if (per_face_size != 1) {
-                ply_write(ply, per_face_size);
-            }
-            for (size_t k=0; k<per_face_size; k++) {
-                ply_write(ply, attributesF[j]->coeff(i*per_face_size + k));
-            }
-        }
-        for (size_t j=0; j<num_attributesI; j++) {
-            const size_t per_face_size = per_face_sizesI[j];
-            if (per_face_size != 1) {
-                ply_write(ply, per_face_size);
-            }
-            for (size_t k=0; k<per_face_size; k++) {
-                ply_write(ply, attributesI[j]->coeff(i*per_face_size + k));
+    for (const auto& element : elements) {
+        for (size_t i=0; i<element.count; i++) {
+            for (const auto& prop : element.properties) {
+                if (prop.is_list) {
+                    ply_write(ply, prop.width);
+                }
+                for (size_t k=0; k<prop.width; k++) {
+                    const size_t index = i*prop.stride + k;
+                    ply_write(ply, prop.data_f != nullptr ?
+                            prop.data_f[index] : prop.data_i[index]);
+                }
             }
         }
     }
+
+    ply_close(ply);
 }
 
-void PLYWriter::write_voxel_elements(Mesh& mesh, p_ply& ply) {
-    const size_t num_voxels = mesh.get_num_voxels();
-    if (num_voxels == 0) return;
-    const size_t num_vertex_per_voxel = mesh.get_vertex_per_voxel();
-    const VectorI& voxels = mesh.get_voxels();
-
-    std::vector<const VectorF*> attributesF;
-    std::vector<const VectorI*> attributesI;
-    std::vector<size_t> per_voxel_sizesF;
-    std::vector<size_t> per_voxel_sizesI;
-    for (NameArray::const_iterator itr = m_voxel_attr_namesF.begin();
-            itr != m_voxel_attr_namesF.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorF& attr = mesh.get_float_attribute(name);
-        attributesF.push_back(&attr);
-        assert(attr.size() % num_voxels == 0);
-        per_voxel_sizesF.push_back(attr.size() / num_voxels);
+/**
+ * Every record of an element has the same size because list lengths are
+ * fixed per property.  Records are encoded in parallel into a large buffer
+ * which is then flushed with a single write.
+ */
+void PLYWriter::write_binary(const ElementArray& elements) {
+    std::ofstream fout(m_filename.c_str(), std::ios::out | std::ios::binary);
+    assert_success(fout.is_open(), "Cannot open " + m_filename);
+
+    fout << "ply\nformat binary_little_endian 1.0\n";
+    if (!is_anonymous()) {
+        fout << "comment Generated by PyMesh\n";
     }
-    for (NameArray::const_iterator itr = m_voxel_attr_namesI.begin();
-         itr != m_voxel_attr_namesI.end(); itr++) {
-        const std::string& name = *itr;
-        const VectorI& attr = mesh.get_int_attribute(name);
-        attributesI.push_back(&attr);
-        assert(attr.size() % num_voxels == 0);
-        per_voxel_sizesI.push_back(attr.size() / num_voxels);
+    for (const auto& element : elements) {
+        fout << "element " << element.name << " " << element.count << "\n";
+        for (const auto& prop : element.properties) {
+            if (prop.is_list) {
+                fout << "property list " << type_name(prop.length_type) << " "
+                    << type_name(prop.type) << " " << prop.name << "\n";
+            } else {
+                fout << "property " << type_name(prop.type) << " "
+                    << prop.name << "\n";
+            }
+        }
     }
-
-    const size_t num_attributesF = attributesF.size();
-    const size_t num_attributesI = attributesI.size();
-
-    for (size_t i=0; i<num_voxels; i++) {
-        ply_write(ply, num_vertex_per_voxel);
-        for (size_t j=0; j<num_vertex_per_voxel; j++) {
-            ply_write(ply, voxels[i*num_vertex_per_voxel + j]);
+    fout << "end_header\n";
+
+    const bool swap_bytes = !is_little_endian_host();
+    std::unique_ptr<char[]> buffer;
+    size_t capacity = 0;
+    for (const auto& element : elements) {
+        size_t record_size = 0;
+        for (const auto& prop : element.properties) {
+            if (prop.is_list) record_size += type_size(prop.length_type);
+            record_size += prop.width * type_size(prop.type);
         }
-        for (size_t j=0; j<num_attributesF; j++) {
-            const size_t per_voxel_size = per_voxel_sizesF[j];
-            if (per_voxel_size != 1) {
-                ply_write(ply, per_voxel_size);
-            }
-            for (size_t k=0; k<per_voxel_size; k++) {
-                ply_write(ply, attributesF[j]->coeff(i*per_voxel_size + k));
-            }
+        if (record_size == 0 || element.count == 0) continue;
+
+        const size_t records_per_chunk = std::max<size_t>(1,
+                CHUNK_SIZE / record_size);
+        const size_t chunk_size = std::min(records_per_chunk, element.count)
+            * record_size;
+        if (chunk_size > capacity) {
+            buffer.reset(new char[chunk_size]);
+            capacity = chunk_size;
         }
-        for (size_t j=0; j<num_attributesI; j++) {
-            const size_t per_voxel_size = per_voxel_sizesI[j];
-            if (per_voxel_size != 1) {
-                ply_write(ply, per_voxel_size);
-            }
-            for (size_t k=0; k<per_voxel_size; k++) {
-                ply_write(ply, attributesI[j]->coeff(i*per_voxel_size + k));
-            }
+
+        for (size_t begin=0; begin<element.count; begin+=records_per_chunk) {
+            const size_t n = std::min(records_per_chunk, element.count-begin);
+            char* data = buffer.get();
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                        for (size_t i=r.begin(); i!=r.end(); i++) {
+                            char* record = data + i*record_size;
+                            const size_t row = begin + i;
+                            for (const auto& prop : element.properties) {
+                                if (prop.is_list) {
+                                    record += write_value(record,
+                                            prop.length_type, prop.width,
+                                            swap_bytes);
+                                }
+                                const size_t offset = row * prop.stride;
+                                for (size_t k=0; k<prop.width; k++) {
+                                    record += prop.data_f != nullptr ?
+                                        write_value(record, prop.type,
+                                                prop.data_f[offset+k],
+                                                swap_bytes) :
+                                        write_value(record, prop.type,
+                                                prop.data_i[offset+k],
+                                                swap_bytes);
+                                }
+                            }
+                        }
+                    });
+            fout.write(data, n * record_size);
         }
     }
-}
 
+    assert_success(fout.good(), "Writing " + m_filename + " failed");
+    fout.close();
+}
@@ -28,15 +28,41 @@ class PLYWriter : public MeshWriter {
                 size_t dim, size_t vertex_per_face, size_t vertex_per_voxel);
 
     protected:
+        /**
+         * A PLY property and the mesh data backing it.  Value k of entry i
+         * is read from data[i*stride + k] for k in [0, width).  Exactly one
+         * of data_f and data_i is set.
+         */
+        struct Property {
+            std::string name;
+            e_ply_type type;
+            e_ply_type length_type; // Only used by list properties.
+            bool is_list;
+            size_t width;
+            size_t stride;
+            const Float* data_f = nullptr;
+            const int* data_i = nullptr;
+        };
+
+        struct Element {
+            std::string name;
+            size_t count;
+            std::vector<Property> properties;
+        };
+        typedef std::vector<Element> ElementArray;
+
         void regroup_attribute_names(Mesh& mesh);
 
-        void add_vertex_elements_header(Mesh& mesh, p_ply& ply);
-        void add_face_elements_header(Mesh& mesh, p_ply& ply);
-        void add_voxel_elements_header(Mesh& mesh, p_ply& ply);
+        void add_vertex_element(Mesh& mesh, ElementArray& elements);
+        void add_face_element(Mesh& mesh, ElementArray& elements);
+        void add_voxel_element(Mesh& mesh, ElementArray& elements);
+        void add_attribute_properties(Mesh& mesh,
+                const std::vector<std::string>& float_names,
+                const std::vector<std::string>& int_names,
+                const std::string& prefix, Element& element);
 
-        void write_vertex_elements(Mesh& mesh, p_ply& ply);
-        void write_face_elements(Mesh& mesh, p_ply& ply);
-        void write_voxel_elements(Mesh& mesh, p_ply& ply);
+        void write_ascii(const ElementArray& elements);
+        void write_binary(const ElementArray& elements);
 
     protected:
         typedef std::vector<std::string> NameArray;
@@ -0,0 +1,216 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <Mesh.h>
+#include <Connectivity/HalfEdgeMesh.h>
+#include <TestBase.h>
+
+class HalfEdgeMeshTest : public TestBase {
+    protected:
+        /**
+         * n x n grid of unit squares, each split along its diagonal.
+         */
+        void create_grid(size_t n, MatrixFr& vertices, MatrixIr& faces) {
+            vertices.resize((n+1)*(n+1), 2);
+            for (size_t i=0; i<=n; i++) {
+                for (size_t j=0; j<=n; j++) {
+                    vertices.row(i*(n+1)+j) << Float(j), Float(i);
+                }
+            }
+            faces.resize(n*n*2, 3);
+            for (size_t i=0; i<n; i++) {
+                for (size_t j=0; j<n; j++) {
+                    const int v0 = i*(n+1)+j;
+                    const int v1 = v0 + 1;
+                    const int v2 = v0 + n + 2;
+                    const int v3 = v0 + n + 1;
+                    faces.row((i*n+j)*2  ) << v0, v1, v2;
+                    faces.row((i*n+j)*2+1) << v0, v2, v3;
+                }
+            }
+        }
+
+        void ASSERT_CONSISTENT(const HalfEdgeMesh& mesh) {
+            const size_t num_half_edges = mesh.get_num_half_edges();
+            for (size_t i=0; i<num_half_edges; i++) {
+                if (mesh.is_face_deleted(HalfEdgeMesh::face(i))) continue;
+                ASSERT_FALSE(mesh.is_vertex_deleted(mesh.tail(i)));
+                const int t = mesh.twin(i);
+                if (t < 0) continue;
+                ASSERT_EQ(int(i), mesh.twin(t));
+                ASSERT_EQ(mesh.tail(i), mesh.head(t));
+                ASSERT_EQ(mesh.head(i), mesh.tail(t));
+            }
+
+            const size_t num_vertices = mesh.get_num_vertices();
+            for (size_t i=0; i<num_vertices; i++) {
+                if (mesh.is_vertex_deleted(i)) continue;
+                const int h = mesh.outgoing_half_edge(i);
+                ASSERT_EQ(int(i), mesh.tail(h));
+                ASSERT_FALSE(mesh.is_face_deleted(HalfEdgeMesh::face(h)));
+            }
+        }
+
+        int count_boundary_vertices(const HalfEdgeMesh& mesh) {
+            int count = 0;
+            const size_t num_vertices = mesh.get_num_vertices();
+            for (size_t i=0; i<num_vertices; i++) {
+                if (!mesh.is_vertex_deleted(i) && mesh.is_boundary_vertex(i))
+                    count++;
+            }
+            return count;
+        }
+
+        Float compute_area(const HalfEdgeMesh& mesh) {
+            Float area = 0.0;
+            const size_t num_faces = mesh.get_num_faces();
+            for (size_t i=0; i<num_faces; i++) {
+                if (mesh.is_face_deleted(i)) continue;
+                const VectorF v0 = mesh.get_vertex(mesh.tail(i*3));
+                const VectorF v1 = mesh.get_vertex(mesh.tail(i*3+1));
+                const VectorF v2 = mesh.get_vertex(mesh.tail(i*3+2));
+                area += 0.5 * ((v1[0]-v0[0]) * (v2[1]-v0[1]) -
+                        (v1[1]-v0[1]) * (v2[0]-v0[0]));
+            }
+            return area;
+        }
+};
+
+TEST_F(HalfEdgeMeshTest, closed) {
+    MeshPtr cube = load_mesh("cube.obj");
+    HalfEdgeMesh mesh(*cube);
+    ASSERT_EQ(8, mesh.get_num_vertices());
+    ASSERT_EQ(12, mesh.get_num_faces());
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_TRUE(mesh.get_boundary_half_edges().empty());
+
+    for (size_t i=0; i<8; i++) {
+        std::vector<int> ring = mesh.get_vertex_adjacent_vertices(i);
+        std::vector<int> faces = mesh.get_vertex_adjacent_faces(i);
+        ASSERT_EQ(ring.size(), faces.size());
+        for (auto vj : ring) {
+            ASSERT_NE(HalfEdgeMesh::INVALID, mesh.find_half_edge(i, vj));
+        }
+    }
+}
+
+TEST_F(HalfEdgeMeshTest, grid) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_grid(4, vertices, faces);
+    HalfEdgeMesh mesh(vertices, faces);
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_EQ(16, mesh.get_boundary_half_edges().size());
+    ASSERT_EQ(16, count_boundary_vertices(mesh));
+
+    // Interior vertex of a diagonally split grid has valence 6.
+    ASSERT_EQ(6, mesh.get_vertex_adjacent_vertices(6).size());
+    ASSERT_EQ(6, mesh.get_vertex_adjacent_faces(6).size());
+    // Corner vertex (0, 0) touches 2 faces and 3 vertices.
+    ASSERT_EQ(3, mesh.get_vertex_adjacent_vertices(0).size());
+    ASSERT_EQ(2, mesh.get_vertex_adjacent_faces(0).size());
+}
+
+TEST_F(HalfEdgeMeshTest, non_manifold) {
+    MatrixFr vertices(5, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0,
+                0.0,-1.0, 0.0,
+                0.0, 0.0, 1.0;
+    MatrixIr faces(3, 3);
+    faces << 0, 1, 2,
+             1, 0, 3,
+             1, 0, 4;
+    HalfEdgeMesh mesh(vertices, faces);
+    const int h = mesh.half_edge(0, 0);
+    ASSERT_FALSE(mesh.is_manifold_half_edge(h));
+    ASSERT_THROW(mesh.split_edge(h, vertices.row(0)), RuntimeError);
+}
+
+TEST_F(HalfEdgeMeshTest, split) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_grid(2, vertices, faces);
+    HalfEdgeMesh mesh(vertices, faces);
+
+    // Interior edge.
+    int h = mesh.find_half_edge(4, 5);
+    int vi = mesh.split_edge(h, Vector2F(1.5, 1.0));
+    ASSERT_EQ(9, vi);
+    ASSERT_EQ(10, mesh.get_num_faces());
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_FALSE(mesh.is_boundary_vertex(vi));
+    ASSERT_EQ(4, mesh.get_vertex_adjacent_vertices(vi).size());
+
+    // Boundary edge.
+    h = mesh.find_half_edge(0, 1);
+    vi = mesh.split_edge(h, Vector2F(0.5, 0.0));
+    ASSERT_EQ(11, mesh.get_num_faces());
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_TRUE(mesh.is_boundary_vertex(vi));
+    ASSERT_EQ(3, mesh.get_vertex_adjacent_vertices(vi).size());
+    ASSERT_EQ(9, mesh.get_boundary_half_edges().size());
+    ASSERT_FLOAT_EQ(4.0, compute_area(mesh));
+}
+
+TEST_F(HalfEdgeMeshTest, flip) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_grid(1, vertices, faces);
+    HalfEdgeMesh mesh(vertices, faces);
+
+    ASSERT_THROW(mesh.flip_edge(mesh.find_half_edge(0, 1)), RuntimeError);
+
+    const int h = mesh.find_half_edge(0, 3);
+    ASSERT_NE(HalfEdgeMesh::INVALID, h);
+    mesh.flip_edge(h);
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_EQ(HalfEdgeMesh::INVALID, mesh.find_half_edge(0, 3));
+    ASSERT_EQ(HalfEdgeMesh::INVALID, mesh.find_half_edge(3, 0));
+    ASSERT_TRUE((mesh.tail(h) == 1 && mesh.head(h) == 2) ||
+                (mesh.tail(h) == 2 && mesh.head(h) == 1));
+    ASSERT_FLOAT_EQ(1.0, compute_area(mesh));
+    ASSERT_EQ(4, mesh.get_boundary_half_edges().size());
+}
+
+TEST_F(HalfEdgeMeshTest, collapse) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_grid(3, vertices, faces);
+    HalfEdgeMesh mesh(vertices, faces);
+
+    // Boundary vertices on an interior edge may not merge.
+    ASSERT_FALSE(mesh.is_collapsible(mesh.find_half_edge(2, 7)));
+
+    int h = mesh.find_half_edge(5, 6);
+    ASSERT_TRUE(mesh.is_collapsible(h));
+    int vi = mesh.collapse_edge(h, Vector2F(1.5, 1.0));
+    ASSERT_EQ(5, vi);
+    ASSERT_TRUE(mesh.is_vertex_deleted(6));
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_FLOAT_EQ(9.0, compute_area(mesh));
+
+    // Boundary edge.
+    h = mesh.find_half_edge(1, 2);
+    ASSERT_TRUE(mesh.is_collapsible(h));
+    vi = mesh.collapse_edge(h, Vector2F(1.5, 0.0));
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_TRUE(mesh.is_boundary_vertex(vi));
+    ASSERT_FLOAT_EQ(9.0, compute_area(mesh));
+
+    VectorI vertex_map = mesh.collect_garbage();
+    ASSERT_EQ(16, vertex_map.size());
+    ASSERT_EQ(HalfEdgeMesh::INVALID, vertex_map[6]);
+    ASSERT_EQ(14, mesh.get_num_vertices());
+    ASSERT_EQ(18 - 3, mesh.get_num_faces());
+    ASSERT_CONSISTENT(mesh);
+    ASSERT_FLOAT_EQ(9.0, compute_area(mesh));
+
+    MatrixIr result = mesh.get_faces();
+    ASSERT_GE(result.minCoeff(), 0);
+    ASSERT_LT(result.maxCoeff(), 14);
+}
@@ -1,5 +1,9 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <string>
 #include <IO/MeshParser.h>
 #include <TestBase.h>
@@ -12,6 +16,86 @@ class PLYParserTest : public TestBase {
             ASSERT_TRUE(result);
         }
 
+        /**
+         * Write a binary PLY file with a single quad face.  Each vertex has
+         * float coordinates, a uchar color and a double quality value.
+         */
+        std::string write_binary_quad(bool big_endian) {
+            std::string filename = big_endian ?
+                "/tmp/tmp_binary_quad_be.ply" : "/tmp/tmp_binary_quad_le.ply";
+            std::ofstream fout(filename.c_str(), std::ios::binary);
+            fout << "ply\n"
+                 << "format " << (big_endian ?
+                         "binary_big_endian" : "binary_little_endian")
+                 << " 1.0\n"
+                 << "comment test\n"
+                 << "element vertex 4\n"
+                 << "property float x\n"
+                 << "property float y\n"
+                 << "property float z\n"
+                 << "property uchar red\n"
+                 << "property double quality\n"
+                 << "element face 1\n"
+                 << "property list uchar int vertex_indices\n"
+                 << "end_header\n";
+
+            const float coords[4][3] = {
+                {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0.5} };
+            for (size_t i=0; i<4; i++) {
+                for (size_t j=0; j<3; j++) {
+                    write_value(fout, coords[i][j], big_endian);
+                }
+                write_value(fout, uint8_t(10*i), big_endian);
+                write_value(fout, double(i) + 0.25, big_endian);
+            }
+            write_value(fout, uint8_t(4), big_endian);
+            for (int32_t i=0; i<4; i++) {
+                write_value(fout, i, big_endian);
+            }
+            return filename;
+        }
+
+        template<typename T>
+        void write_value(std::ofstream& fout, T value, bool big_endian) {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            const uint16_t one = 1;
+            const bool little_endian_host = *reinterpret_cast<const uint8_t*>(&one) == 1;
+            if (big_endian == little_endian_host) {
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+            fout.write(bytes, sizeof(T));
+        }
+
+        void check_binary_quad() {
+            ASSERT_EQ(4, m_parser->num_vertices());
+            ASSERT_EQ(1, m_parser->num_faces());
+            ASSERT_EQ(4, m_parser->vertex_per_face());
+            ASSERT_EQ(3, m_parser->dim());
+
+            VectorF vertices(12);
+            m_parser->export_vertices(vertices.data());
+            ASSERT_FLOAT_EQ(1.0, vertices[3]);
+            ASSERT_FLOAT_EQ(1.0, vertices[7]);
+            ASSERT_FLOAT_EQ(0.5, vertices[11]);
+
+            VectorI faces(4);
+            m_parser->export_faces(faces.data());
+            for (int i=0; i<4; i++) {
+                ASSERT_EQ(i, faces[i]);
+            }
+
+            ASSERT_EQ(4, m_parser->get_attribute_size("vertex_red"));
+            VectorI red(4);
+            m_parser->export_int_attribute("vertex_red", red.data());
+            VectorF quality(4);
+            m_parser->export_float_attribute("vertex_quality", quality.data());
+            for (int i=0; i<4; i++) {
+                ASSERT_EQ(10*i, red[i]);
+                ASSERT_FLOAT_EQ(i + 0.25, quality[i]);
+            }
+        }
+
     protected:
         std::shared_ptr<MeshParser> m_parser;
 };
@@ -47,3 +131,13 @@ TEST_F(PLYParserTest, Empty) {
     ASSERT_EQ(0, m_parser->num_vertices());
     ASSERT_EQ(0, m_parser->num_faces());
 }
+
+TEST_F(PLYParserTest, BinaryLittleEndian) {
+    parse(write_binary_quad(false));
+    check_binary_quad();
+}
+
+TEST_F(PLYParserTest, BinaryBigEndian) {
+    parse(write_binary_quad(true));
+    check_binary_quad();
+}
@@ -132,3 +132,48 @@ TEST_F(PLYWriterTest, DuplicatedAttributes) {
     assert_eq_attribute(mesh, mesh2, "face_red");
 }
 
+
+TEST_F(PLYWriterTest, BinaryMatchesAscii) {
+    MeshPtr mesh = load_mesh("cube.msh");
+    const size_t num_vertices = mesh->get_num_vertices();
+    const size_t num_faces = mesh->get_num_faces();
+    VectorF vertex_field = VectorF::LinSpaced(num_vertices * 3, -1.0, 1.0);
+    VectorI face_field = VectorI::LinSpaced(num_faces, 0, num_faces-1);
+    mesh->add_empty_float_attribute("vertex_field");
+    mesh->set_float_attribute("vertex_field", vertex_field);
+    mesh->add_empty_int_attribute("face_field");
+    mesh->set_int_attribute("face_field", face_field);
+
+    const std::string names[] = {"tmp_cube_binary.ply", "tmp_cube_ascii.ply"};
+    for (size_t i=0; i<2; i++) {
+        PLYWriter writer;
+        writer.set_output_filename(m_tmp_dir + names[i]);
+        writer.with_attribute("vertex_field");
+        writer.with_attribute("face_field");
+        if (i == 1) writer.in_ascii();
+        writer.write_mesh(*mesh);
+    }
+
+    MeshPtr binary = load_tmp_mesh(names[0]);
+    MeshPtr ascii = load_tmp_mesh(names[1]);
+    assert_eq_vertices(mesh, binary);
+    assert_eq_faces(mesh, binary);
+    assert_eq_voxels(mesh, binary);
+    assert_eq_vertices(ascii, binary);
+    assert_eq_faces(ascii, binary);
+
+    ASSERT_TRUE(binary->has_float_attribute("vertex_field"));
+    const VectorF& binary_field = binary->get_float_attribute("vertex_field");
+    const VectorF& ascii_field = ascii->get_float_attribute("vertex_field");
+    ASSERT_EQ(vertex_field.size(), binary_field.size());
+    ASSERT_FLOAT_EQ(0.0, (vertex_field - binary_field).norm());
+    ASSERT_NEAR(0.0, (ascii_field - binary_field).norm(), 1e-5);
+
+    ASSERT_TRUE(binary->has_int_attribute("face_field"));
+    const VectorI& binary_ids = binary->get_int_attribute("face_field");
+    ASSERT_EQ(face_field.size(), binary_ids.size());
+    ASSERT_TRUE((face_field.array() == binary_ids.array()).all());
+
+    remove(names[0]);
+    remove(names[1]);
+}
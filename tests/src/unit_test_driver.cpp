@@ -17,6 +17,7 @@
 #include "IO/STLWriterTest.h"
 #include "Math/ZSparseMatrixTest.h"
 #include "Math/MatrixUtilsTest.h"
+#include "Connectivity/HalfEdgeMeshTest.h"
 #include "Misc/MultipletMapTest.h"
 #include "Misc/TriBox2DTest.h"
 #include "Misc/MultipletTest.h"
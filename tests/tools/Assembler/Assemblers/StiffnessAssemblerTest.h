@@ -43,3 +43,21 @@ TEST_F(StiffnessAssemblerTest, SquarePositiveDiagonal) {
 
 
 
+
+TEST_F(StiffnessAssemblerTest, MatrixFree) {
+    for (const auto& filename : {"tet.msh", "square_2D.obj"}) {
+        FESettingPtr setting = load_setting(filename);
+        ZSparseMatrix K = m_assembler->assemble(setting);
+        VectorF x = VectorF::LinSpaced(K.cols(), -1.0, 2.0);
+        VectorF y;
+        m_assembler->apply(setting, x, y);
+        VectorF expected = K * x;
+        ASSERT_EQ(expected.size(), y.size());
+        ASSERT_NEAR(0.0, (expected - y).norm(), 1e-12 * (1.0 + expected.norm()));
+
+        VectorF diagonal = m_assembler->assemble_diagonal(setting);
+        VectorF expected_diagonal = K.diagonal();
+        ASSERT_NEAR(0.0, (expected_diagonal - diagonal).norm(),
+                1e-12 * (1.0 + expected_diagonal.norm()));
+    }
+}
@@ -0,0 +1,208 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <limits>
+
+#include <TestBase.h>
+#include <BVH/AttributeTransfer.h>
+
+class AttributeTransferTest : public TestBase {
+    protected:
+        /**
+         * Brute force closest point lookup so that the transfer can be
+         * tested without any BVH backend.
+         */
+        class BruteForceBVH : public BVHEngine {
+            public:
+                virtual void build() override {}
+
+                virtual void lookup(const MatrixFr& points,
+                        VectorF& squared_distances,
+                        VectorI& closest_faces,
+                        MatrixFr& closest_points) const override {
+                    const size_t num_points = points.rows();
+                    const size_t num_faces = m_faces.rows();
+                    squared_distances.resize(num_points);
+                    closest_faces.resize(num_points);
+                    closest_points.resize(num_points, 3);
+                    for (size_t i=0; i<num_points; i++) {
+                        const Vector3F p = points.row(i).transpose();
+                        squared_distances[i] = std::numeric_limits<Float>::max();
+                        for (size_t j=0; j<num_faces; j++) {
+                            const Vector3F q = closest_point(p,
+                                    m_vertices.row(m_faces(j,0)).transpose(),
+                                    m_vertices.row(m_faces(j,1)).transpose(),
+                                    m_vertices.row(m_faces(j,2)).transpose());
+                            const Float d = (p-q).squaredNorm();
+                            if (d < squared_distances[i]) {
+                                squared_distances[i] = d;
+                                closest_faces[i] = j;
+                                closest_points.row(i) = q.transpose();
+                            }
+                        }
+                    }
+                }
+
+            private:
+                static Vector3F closest_point(const Vector3F& p,
+                        const Vector3F& a, const Vector3F& b, const Vector3F& c) {
+                    const Vector3F ab = b - a;
+                    const Vector3F ac = c - a;
+                    const Vector3F ap = p - a;
+                    const Float d1 = ab.dot(ap);
+                    const Float d2 = ac.dot(ap);
+                    if (d1 <= 0 && d2 <= 0) return a;
+
+                    const Vector3F bp = p - b;
+                    const Float d3 = ab.dot(bp);
+                    const Float d4 = ac.dot(bp);
+                    if (d3 >= 0 && d4 <= d3) return b;
+
+                    const Float vc = d1*d4 - d3*d2;
+                    if (vc <= 0 && d1 >= 0 && d3 <= 0)
+                        return a + ab * (d1 / (d1 - d3));
+
+                    const Vector3F cp = p - c;
+                    const Float d5 = ab.dot(cp);
+                    const Float d6 = ac.dot(cp);
+                    if (d6 >= 0 && d5 <= d6) return c;
+
+                    const Float vb = d5*d2 - d1*d6;
+                    if (vb <= 0 && d2 >= 0 && d6 <= 0)
+                        return a + ac * (d2 / (d2 - d6));
+
+                    const Float va = d3*d6 - d5*d4;
+                    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+                        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+                    const Float denom = 1.0 / (va + vb + vc);
+                    return a + ab * (vb * denom) + ac * (vc * denom);
+                }
+        };
+
+        /**
+         * Triangulated n x n grid over [0, 1]^2 at height z.
+         */
+        MeshPtr generate_grid(size_t n, Float z) {
+            MatrixFr vertices((n+1)*(n+1), 3);
+            MatrixIr faces(n*n*2, 3);
+            for (size_t i=0; i<=n; i++) {
+                for (size_t j=0; j<=n; j++) {
+                    vertices.row(i*(n+1)+j) << Float(i)/n, Float(j)/n, z;
+                }
+            }
+            for (size_t i=0; i<n; i++) {
+                for (size_t j=0; j<n; j++) {
+                    const int v0 = i*(n+1)+j;
+                    const int v1 = v0 + n + 1;
+                    faces.row((i*n+j)*2  ) << v0, v1, v1+1;
+                    faces.row((i*n+j)*2+1) << v0, v1+1, v0+1;
+                }
+            }
+            return load_data(vertices, faces);
+        }
+
+        AttributeTransfer::Ptr create_transfer(MeshPtr source) {
+            const size_t num_vertices = source->get_num_vertices();
+            const size_t num_faces = source->get_num_faces();
+            MatrixFr vertices(num_vertices, 3);
+            MatrixIr faces(num_faces, 3);
+            std::copy(source->get_vertices().data(),
+                    source->get_vertices().data() + num_vertices*3,
+                    vertices.data());
+            std::copy(source->get_faces().data(),
+                    source->get_faces().data() + num_faces*3,
+                    faces.data());
+
+            auto bvh = std::make_shared<BruteForceBVH>();
+            bvh->set_mesh(vertices, faces);
+            bvh->build();
+            return std::make_shared<AttributeTransfer>(source, bvh);
+        }
+};
+
+TEST_F(AttributeTransferTest, VertexAttribute) {
+    MeshPtr source = generate_grid(4, 0.0);
+    MeshPtr target = generate_grid(7, 0.5);
+    const size_t num_source_vertices = source->get_num_vertices();
+    const size_t num_target_vertices = target->get_num_vertices();
+
+    // Linear field (x + 2y, 1 - y) is reproduced exactly.
+    VectorF values(num_source_vertices * 2);
+    for (size_t i=0; i<num_source_vertices; i++) {
+        const VectorF v = source->get_vertex(i);
+        values[i*2  ] = v[0] + 2*v[1];
+        values[i*2+1] = 1.0 - v[1];
+    }
+    source->add_empty_float_attribute("field");
+    source->set_float_attribute("field", values);
+
+    create_transfer(source)->transfer_vertex_attributes(target, {"field"});
+    ASSERT_TRUE(target->has_float_attribute("field"));
+
+    const VectorF& mapped = target->get_float_attribute("field");
+    ASSERT_EQ(num_target_vertices * 2, mapped.size());
+    for (size_t i=0; i<num_target_vertices; i++) {
+        const VectorF v = target->get_vertex(i);
+        ASSERT_NEAR(v[0] + 2*v[1], mapped[i*2], 1e-12);
+        ASSERT_NEAR(1.0 - v[1], mapped[i*2+1], 1e-12);
+    }
+}
+
+TEST_F(AttributeTransferTest, FaceAndCornerAttributes) {
+    MeshPtr source = generate_grid(3, 0.0);
+    MeshPtr target = generate_grid(3, 0.1);
+    const size_t num_faces = source->get_num_faces();
+
+    VectorI face_values(num_faces);
+    VectorF corner_values(num_faces * 3);
+    for (size_t i=0; i<num_faces; i++) {
+        face_values[i] = i * 10;
+        const VectorI f = source->get_face(i);
+        for (size_t j=0; j<3; j++) {
+            corner_values[i*3+j] = source->get_vertex(f[j])[0];
+        }
+    }
+    source->add_empty_int_attribute("face_id");
+    source->set_int_attribute("face_id", face_values);
+    source->add_empty_float_attribute("corner_x");
+    source->set_float_attribute("corner_x", corner_values);
+
+    create_transfer(source)->transfer(target, {}, {"face_id"}, {"corner_x"});
+    ASSERT_TRUE(target->has_int_attribute("face_id"));
+    ASSERT_TRUE(target->has_float_attribute("corner_x"));
+
+    const VectorI& mapped_faces = target->get_int_attribute("face_id");
+    const VectorF& mapped_corners = target->get_float_attribute("corner_x");
+    ASSERT_EQ(num_faces, mapped_faces.size());
+    ASSERT_EQ(num_faces * 3, mapped_corners.size());
+    for (size_t i=0; i<num_faces; i++) {
+        ASSERT_EQ(face_values[i], mapped_faces[i]);
+        for (size_t j=0; j<3; j++) {
+            ASSERT_NEAR(corner_values[i*3+j], mapped_corners[i*3+j], 1e-12);
+        }
+    }
+}
+
+TEST_F(AttributeTransferTest, MissingAttribute) {
+    MeshPtr source = generate_grid(2, 0.0);
+    MeshPtr target = generate_grid(2, 0.0);
+    ASSERT_THROW(create_transfer(source)->transfer_vertex_attributes(
+                target, {"missing"}), RuntimeError);
+}
+
+TEST_F(AttributeTransferTest, DuplicateAttribute) {
+    MeshPtr source = generate_grid(2, 0.0);
+    MeshPtr target = generate_grid(2, 0.0);
+    const size_t num_faces = source->get_num_faces();
+    VectorF values = VectorF::Ones(num_faces * 3);
+    source->add_empty_float_attribute("value");
+    source->set_float_attribute("value", values);
+
+    // The corner attribute has as many entries as 3 face attributes.
+    ASSERT_THROW(create_transfer(source)->transfer(
+                target, {}, {"value"}, {"value"}), RuntimeError);
+    ASSERT_THROW(create_transfer(source)->transfer_corner_attributes(
+                target, {"value", "value"}), RuntimeError);
+    ASSERT_FALSE(target->has_attribute("value"));
+}
@@ -0,0 +1,88 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+#ifdef WITH_IGL_AND_CGAL
+
+#include <Boolean/NaryBooleanEngine.h>
+
+#include "../BooleanEngineTest.h"
+
+class IGLNaryBooleanEngineTest : public BooleanEngineTest {
+    protected:
+        typedef NaryBooleanEngine::Ptr NaryBooleanPtr;
+
+        /**
+         * Volume enclosed by a closed triangle mesh.
+         */
+        Float compute_volume(const MatrixFr& vertices, const MatrixIr& faces) {
+            Float volume = 0.0;
+            for (size_t i=0; i<faces.rows(); i++) {
+                const Vector3F v0 = vertices.row(faces(i, 0)).transpose();
+                const Vector3F v1 = vertices.row(faces(i, 1)).transpose();
+                const Vector3F v2 = vertices.row(faces(i, 2)).transpose();
+                volume += v0.dot(v1.cross(v2)) / 6.0;
+            }
+            return volume;
+        }
+
+        /**
+         * Adds num_cubes unit-width copies of cube.obj along the x axis,
+         * each overlapping the previous one by half its width.
+         */
+        void add_cubes(NaryBooleanPtr engine, size_t num_cubes) {
+            MeshPtr mesh = load_mesh("cube.obj");
+            const MatrixFr vertices = extract_vertices(mesh);
+            const MatrixIr faces = extract_faces(mesh);
+            const Float width = vertices.col(0).maxCoeff() -
+                vertices.col(0).minCoeff();
+            for (size_t i=0; i<num_cubes; i++) {
+                MatrixFr shifted = vertices;
+                shifted.col(0).array() += i * width * 0.5;
+                engine->add_mesh(shifted, faces);
+            }
+        }
+};
+
+TEST_F(IGLNaryBooleanEngineTest, union) {
+    NaryBooleanPtr engine = NaryBooleanEngine::create("igl");
+    add_cubes(engine, 5);
+    engine->compute_union();
+
+    MeshPtr cube = load_mesh("cube.obj");
+    const Float cube_volume = compute_volume(
+            extract_vertices(cube), extract_faces(cube));
+    const Float volume = compute_volume(
+            engine->get_vertices(), engine->get_faces());
+    // 5 half overlapping cubes span 3 cube widths.
+    ASSERT_NEAR(cube_volume * 3.0, volume, 1e-6);
+
+    const VectorI& face_sources = engine->get_face_sources();
+    const VectorI mesh_sources = engine->get_mesh_sources();
+    ASSERT_EQ(engine->get_faces().rows(), face_sources.size());
+    ASSERT_EQ(face_sources.size(), mesh_sources.size());
+    ASSERT_EQ(0, mesh_sources.minCoeff());
+    ASSERT_EQ(4, mesh_sources.maxCoeff());
+}
+
+TEST_F(IGLNaryBooleanEngineTest, expression) {
+    NaryBooleanPtr engine = NaryBooleanEngine::create("igl");
+    add_cubes(engine, 3);
+
+    MeshPtr cube = load_mesh("cube.obj");
+    const Float cube_volume = compute_volume(
+            extract_vertices(cube), extract_faces(cube));
+
+    engine->set_expression("(0 | 2) - 1");
+    engine->compute();
+    ASSERT_NEAR(cube_volume, compute_volume(
+                engine->get_vertices(), engine->get_faces()), 1e-6);
+
+    engine->compute_intersection();
+    ASSERT_EQ(0, engine->get_faces().rows());
+
+    engine->set_expression("0 ^ 1 ^ 2");
+    engine->compute();
+    ASSERT_NEAR(cube_volume, compute_volume(
+                engine->get_vertices(), engine->get_faces()), 1e-6);
+}
+
+#endif
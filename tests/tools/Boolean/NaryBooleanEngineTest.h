@@ -0,0 +1,144 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Boolean/NaryBooleanEngine.h>
+
+#include "BooleanEngineTest.h"
+
+class NaryBooleanEngineTest : public BooleanEngineTest {
+    protected:
+        /**
+         * Backend free engine that only records the expression so that
+         * expression handling can be tested without a mesh arrangement.
+         */
+        class DummyEngine : public NaryBooleanEngine {
+            public:
+                size_t num_runs = 0;
+
+                void set_face_sources(const VectorI& face_sources) {
+                    m_face_sources = face_sources;
+                }
+
+            protected:
+                virtual void run() override { num_runs++; }
+        };
+
+        std::shared_ptr<DummyEngine> create_engine(size_t num_meshes) {
+            auto engine = std::make_shared<DummyEngine>();
+            MatrixFr vertices(3, 3);
+            vertices << 0.0, 0.0, 0.0,
+                        1.0, 0.0, 0.0,
+                        0.0, 1.0, 0.0;
+            MatrixIr faces(1, 3);
+            faces << 0, 1, 2;
+            for (size_t i=0; i<num_meshes; i++) {
+                engine->add_mesh(vertices, faces);
+            }
+            return engine;
+        }
+
+        bool is_inside(std::shared_ptr<DummyEngine> engine,
+                const std::vector<int>& winding_numbers) {
+            return engine->is_inside(winding_numbers.data());
+        }
+};
+
+TEST_F(NaryBooleanEngineTest, binary_operators) {
+    auto engine = create_engine(2);
+    const std::vector<std::vector<int> > labels = {
+        {0, 0}, {1, 0}, {0, 1}, {1, 1} };
+
+    engine->set_expression("0 | 1");
+    std::vector<bool> expected = {false, true, true, true};
+    for (size_t i=0; i<4; i++) {
+        ASSERT_EQ(expected[i], is_inside(engine, labels[i]));
+    }
+
+    engine->set_expression("0&1");
+    expected = {false, false, false, true};
+    for (size_t i=0; i<4; i++) {
+        ASSERT_EQ(expected[i], is_inside(engine, labels[i]));
+    }
+
+    engine->set_expression("0 - 1");
+    expected = {false, true, false, false};
+    for (size_t i=0; i<4; i++) {
+        ASSERT_EQ(expected[i], is_inside(engine, labels[i]));
+    }
+
+    engine->set_expression("(0) ^ (1)");
+    expected = {false, true, true, false};
+    for (size_t i=0; i<4; i++) {
+        ASSERT_EQ(expected[i], is_inside(engine, labels[i]));
+    }
+}
+
+TEST_F(NaryBooleanEngineTest, precedence) {
+    auto engine = create_engine(3);
+    engine->set_expression("0 | 1 & 2");
+    ASSERT_TRUE(is_inside(engine, {1, 0, 0}));
+    ASSERT_FALSE(is_inside(engine, {0, 1, 0}));
+    ASSERT_TRUE(is_inside(engine, {0, 1, 1}));
+
+    engine->set_expression("(0 | 1) & 2");
+    ASSERT_FALSE(is_inside(engine, {1, 0, 0}));
+    ASSERT_TRUE(is_inside(engine, {1, 0, 1}));
+
+    // Left associative.
+    engine->set_expression("0 - 1 - 2");
+    ASSERT_TRUE(is_inside(engine, {1, 0, 0}));
+    ASSERT_FALSE(is_inside(engine, {1, 0, 1}));
+
+    // Winding numbers other than 0 and 1.
+    engine->set_expression("0 - 1");
+    ASSERT_TRUE(is_inside(engine, {2, -1, 0}));
+    ASSERT_FALSE(is_inside(engine, {2, 3, 0}));
+}
+
+TEST_F(NaryBooleanEngineTest, nary) {
+    const size_t num_meshes = 100;
+    auto engine = create_engine(num_meshes);
+    std::vector<int> labels(num_meshes, 0);
+
+    engine->compute_union();
+    ASSERT_EQ(1, engine->num_runs);
+    ASSERT_FALSE(is_inside(engine, labels));
+    labels[57] = 1;
+    ASSERT_TRUE(is_inside(engine, labels));
+
+    engine->compute_intersection();
+    ASSERT_FALSE(is_inside(engine, labels));
+    std::fill(labels.begin(), labels.end(), 1);
+    ASSERT_TRUE(is_inside(engine, labels));
+}
+
+TEST_F(NaryBooleanEngineTest, invalid_expression) {
+    auto engine = create_engine(2);
+    ASSERT_THROW(engine->compute(), RuntimeError);
+    ASSERT_THROW(engine->set_expression(""), RuntimeError);
+    ASSERT_THROW(engine->set_expression("0 |"), RuntimeError);
+    ASSERT_THROW(engine->set_expression("(0 | 1"), RuntimeError);
+    ASSERT_THROW(engine->set_expression("0 1"), RuntimeError);
+    ASSERT_THROW(engine->set_expression("0 + 1"), RuntimeError);
+
+    engine->set_expression("0 | 2");
+    ASSERT_THROW(engine->compute(), RuntimeError);
+    ASSERT_EQ(0, engine->num_runs);
+
+    engine->set_expression("1 - 0");
+    engine->compute();
+    ASSERT_EQ(1, engine->num_runs);
+}
+
+TEST_F(NaryBooleanEngineTest, mesh_sources) {
+    auto engine = create_engine(3);
+    VectorI face_sources(4);
+    face_sources << 2, 0, 1, 2;
+    engine->set_face_sources(face_sources);
+    VectorI mesh_sources = engine->get_mesh_sources();
+    ASSERT_EQ(4, mesh_sources.size());
+    ASSERT_EQ(2, mesh_sources[0]);
+    ASSERT_EQ(0, mesh_sources[1]);
+    ASSERT_EQ(1, mesh_sources[2]);
+    ASSERT_EQ(2, mesh_sources[3]);
+}
@@ -1,6 +1,7 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include "NaryBooleanEngineTest.h"
 #ifdef WITH_CORK
 #include "Cork/CorkEngineTest.h"
 #endif
@@ -10,6 +11,7 @@
 #ifdef WITH_IGL_AND_CGAL
 #include "IGL/IGLEngineTest.h"
 #include "IGL/IGLCSGTreeTest.h"
+#include "IGL/IGLNaryBooleanEngineTest.h"
 #endif
 #ifdef WITH_CGAL
 #include "CGAL/CGALBooleanEngineTest.h"
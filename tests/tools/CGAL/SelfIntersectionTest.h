@@ -110,4 +110,37 @@ TEST_F(SelfIntersectionTest, PointLikeTriangles) {
     ASSERT_EQ(0, result.rows());
 }
 
+TEST_F(SelfIntersectionTest, ManyTriangles) {
+    // Enough faces to trigger parallel slab-based detection.
+    const size_t num_triangles = 20000;
+    MatrixFr vertices(num_triangles * 3 + 3, 3);
+    MatrixIr faces(num_triangles + 3, 3);
+    for (size_t i=0; i<num_triangles; i++) {
+        vertices.row(i*3  ) << i    , 0.0, 0.0;
+        vertices.row(i*3+1) << i+0.5, 0.0, 0.0;
+        vertices.row(i*3+2) << i    , 1.0, 0.0;
+        faces.row(i) << i*3, i*3+1, i*3+2;
+    }
+
+    // A needle piercing triangle 5000.
+    const size_t base = num_triangles * 3;
+    vertices.row(base  ) << 5000.2, 0.2, -1.0;
+    vertices.row(base+1) << 5000.2, 0.2,  1.0;
+    vertices.row(base+2) << 5000.3, 0.3,  0.0;
+    faces.row(num_triangles) << base, base+1, base+2;
+
+    // Duplicates of triangles 15000 and 100.
+    faces.row(num_triangles+1) = faces.row(15000);
+    faces.row(num_triangles+2) = faces.row(100);
+
+    MatrixIr result = check_self_intersection(vertices, faces);
+    ASSERT_EQ(3, result.rows());
+    ASSERT_EQ(100, result(0, 0));
+    ASSERT_EQ(num_triangles+2, result(0, 1));
+    ASSERT_EQ(5000, result(1, 0));
+    ASSERT_EQ(num_triangles, result(1, 1));
+    ASSERT_EQ(15000, result(2, 0));
+    ASSERT_EQ(num_triangles+1, result(2, 1));
+}
+
 #endif
@@ -2,6 +2,10 @@
 #pragma once
 #ifdef WITH_DRACO
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <Core/EigenTypedef.h>
 #include <Compression/CompressionEngine.h>
 
@@ -28,4 +32,79 @@ TEST_F(DracoCompressionEngineTest, Simple) {
     //ASSERT_MATRIX_EQ(faces, faces2); 
 }
 
+TEST_F(DracoCompressionEngineTest, Options) {
+    auto mesh = load_mesh("ball.msh");
+    auto engine = CompressionEngine::create("draco");
+    engine->set_speed(10, 10);
+    engine->set_position_quantization_bits(12);
+    auto data = engine->compress(mesh);
+    auto mesh2 = engine->decompress(data);
+
+    ASSERT_EQ(mesh->get_num_vertices(), mesh2->get_num_vertices());
+    ASSERT_EQ(mesh->get_num_faces(), mesh2->get_num_faces());
+
+    ASSERT_THROW(engine->set_speed(11, 0), RuntimeError);
+    ASSERT_THROW(engine->set_position_quantization_bits(-1), RuntimeError);
+}
+
+TEST_F(DracoCompressionEngineTest, AttributeQuantization) {
+    auto mesh = load_mesh("suzanne.obj");
+    const size_t num_vertices = mesh->get_num_vertices();
+    VectorF values = mesh->get_vertices();
+    VectorI indices(num_vertices);
+    for (size_t i=0; i<num_vertices; i++) indices[i] = i;
+    mesh->add_empty_float_attribute("vertex_value");
+    mesh->set_float_attribute("vertex_value", values);
+    mesh->add_empty_int_attribute("vertex_id");
+    mesh->set_int_attribute("vertex_id", indices);
+
+    auto engine = CompressionEngine::create("draco");
+    engine->set_attribute_quantization_bits("vertex_value", 12);
+    ASSERT_EQ(12, engine->get_attribute_quantization_bits("vertex_value"));
+    ASSERT_EQ(0, engine->get_attribute_quantization_bits("vertex_id"));
+    auto mesh2 = engine->decompress(engine->compress(mesh));
+    ASSERT_EQ(num_vertices, mesh2->get_num_vertices());
+    ASSERT_TRUE(mesh2->has_float_attribute("vertex_value"));
+    ASSERT_TRUE(mesh2->has_int_attribute("vertex_id"));
+
+    // Int attributes cannot be quantized.
+    engine->set_attribute_quantization_bits("vertex_id", 8);
+    ASSERT_THROW(engine->compress(mesh), RuntimeError);
+}
+
+TEST_F(DracoCompressionEngineTest, Chunked) {
+    auto mesh = load_mesh("suzanne.obj");
+    const size_t num_vertices = mesh->get_num_vertices();
+    const size_t num_faces = mesh->get_num_faces();
+    VectorI indices(num_vertices);
+    for (size_t i=0; i<num_vertices; i++) indices[i] = i;
+    mesh->add_empty_int_attribute("vertex_id");
+    mesh->set_int_attribute("vertex_id", indices);
+
+    auto engine = CompressionEngine::create("draco");
+    engine->set_chunk_size(num_faces / 8);
+    auto data = engine->compress(mesh);
+    auto mesh2 = engine->decompress(data);
+
+    // Vertex order is preserved and the chunks are welded together.
+    ASSERT_EQ(num_vertices, mesh2->get_num_vertices());
+    ASSERT_EQ(num_faces, mesh2->get_num_faces());
+    ASSERT_MATRIX_EQ(mesh->get_vertices(), mesh2->get_vertices());
+    ASSERT_TRUE(mesh2->has_int_attribute("vertex_id"));
+    ASSERT_MATRIX_EQ(indices, mesh2->get_int_attribute("vertex_id"));
+
+    // Faces are reordered, compare them as sorted index triplets.
+    auto sorted_faces = [](Mesh::Ptr m) {
+        const VectorI& faces = m->get_faces();
+        std::vector<std::array<int, 3> > result(m->get_num_faces());
+        for (size_t i=0; i<result.size(); i++) {
+            std::copy(faces.data()+i*3, faces.data()+i*3+3, result[i].begin());
+            std::sort(result[i].begin(), result[i].end());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    ASSERT_TRUE(sorted_faces(mesh) == sorted_faces(mesh2));
+}
+
 #endif
@@ -0,0 +1,252 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+#include <ConvexHull/Incremental/IncrementalConvexHull.h>
+#include <Core/EigenTypedef.h>
+#include <ConvexHullEngineTest.h>
+
+class IncrementalConvexHullTest : public ConvexHullEngineTest {
+};
+
+TEST_F(IncrementalConvexHullTest, simple_cube) {
+    MatrixFr pts(8, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1.0,
+           1.0, 0.0, 1.0,
+           1.0, 1.0, 1.0,
+           0.0, 1.0, 1.0;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(8, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(12, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, interior_points) {
+    MatrixFr pts(10, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1.0,
+           1.0, 0.0, 1.0,
+           1.0, 1.0, 1.0,
+           0.0, 1.0, 1.0,
+           0.5, 0.5, 0.5,
+           0.9, 0.1, 0.9;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(8, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(12, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, near_boundary_points) {
+    MatrixFr pts(10, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1.0,
+           1.0, 0.0, 1.0,
+           1.0, 1.0, 1.0,
+           0.0, 1.0, 1.0,
+           0.5, 1e-6, 1e-6,
+           0.9, 1e-6, 0.9;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(8, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(12, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, near_boundary_points_2) {
+    MatrixFr pts(9, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1.0,
+           1.0, 0.0, 1.0,
+           1.0, 1.0, 1.0,
+           0.0, 1.0, 1.0,
+           0.9, -1e-6, 0.9;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(9, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(14, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, exterior_points) {
+    MatrixFr pts(9, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1.0,
+           1.0, 0.0, 1.0,
+           1.0, 1.0, 1.0,
+           0.0, 1.0, 1.0,
+           0.5, 0.5, 2.0;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(9, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(14, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, near_degenerated_pts) {
+    MatrixFr pts(9, 3);
+    pts << 0.0, 0.0, 0.0,
+           1.0, 0.0, 0.0,
+           1.0, 1.0, 0.0,
+           0.0, 1.0, 0.0,
+           0.0, 0.0, 1e-6,
+           1.0, 0.0, 1e-6,
+           1.0, 1.0, 1e-6,
+           0.0, 1.0, 1e-6,
+           0.5, 0.5, 1e-13;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(8, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(12, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, 2D_square) {
+    MatrixFr pts(5, 2);
+    pts << 0.0, 0.0,
+           1.0, 0.0,
+           0.0, 1.0,
+           1.0, 1.0,
+           0.5, 0.5;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(4, vertices.rows());
+    ASSERT_EQ(2, vertices.cols());
+    ASSERT_EQ(4, faces.rows());
+    ASSERT_EQ(2, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, 2D_square_2) {
+    MatrixFr pts(6, 2);
+    pts << 0.0, 0.0,
+           1.0, 0.0,
+           0.0, 1.0,
+           1.0, 1.0,
+           0.5, 0.5,
+           0.5, 1.1;
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(5, vertices.rows());
+    ASSERT_EQ(2, vertices.cols());
+    ASSERT_EQ(5, faces.rows());
+    ASSERT_EQ(2, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, coplanar_loops) {
+    // Two parallel octagons, similar to the end loops around a wire joint.
+    const size_t loop_size = 8;
+    MatrixFr pts(loop_size*2+1, 3);
+    for (size_t i=0; i<loop_size; i++) {
+        Float angle = 2 * M_PI * i / loop_size;
+        pts.row(i) = Vector3F(cos(angle), sin(angle), -1.0);
+        pts.row(i+loop_size) = Vector3F(cos(angle), sin(angle), 1.0);
+    }
+    pts.row(loop_size*2) = Vector3F::Zero();
+
+    IncrementalConvexHull engine;
+    engine.run(pts);
+
+    MatrixFr vertices = engine.get_vertices();
+    MatrixIr faces = engine.get_faces();
+
+    ASSERT_EQ(loop_size*2, vertices.rows());
+    ASSERT_EQ(3, vertices.cols());
+    ASSERT_EQ(loop_size*4-4, faces.rows());
+    ASSERT_EQ(3, faces.cols());
+    ASSERT_SAME_BBOX(pts, vertices);
+    ASSERT_INDEX_MAP_IS_VALID(pts, vertices, engine.get_index_map());
+    ASSERT_ORIENTATION_IS_VALID(vertices, faces);
+}
+
+TEST_F(IncrementalConvexHullTest, 2D_collinear) {
+    MatrixFr pts(3, 2);
+    pts << 0.0, 0.0,
+           1.0, 1.0,
+           2.0, 2.0;
+
+    IncrementalConvexHull engine;
+    ASSERT_THROW(engine.run(pts), RuntimeError);
+}
@@ -1,6 +1,7 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include "Incremental/IncrementalConvexHullTest.h"
 #ifdef WITH_CGAL
 #include "CGAL/CGALConvexHull2DTest.h"
 #include "CGAL/CGALConvexHull3DTest.h"
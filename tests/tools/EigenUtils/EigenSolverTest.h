@@ -112,3 +112,69 @@ TEST_F(EigenUtilsTest, batch_3x3) {
     ASSERT_MATRIX_EQ(true_eigen_vectors, e_vectors);
 }
 
+
+TEST_F(EigenUtilsTest, batch_2x2_random) {
+    const size_t n = 1000;
+    MatrixFr Ms = MatrixFr::Random(n, 3);
+    Ms.row(0) << 1.0, 1.0, 0.0;
+    Ms.row(1) << 1.0, 1.0, 1.0;
+    Ms.row(2) << 0.0, 0.0, 0.0;
+    VectorF flattened = Eigen::Map<VectorF>(Ms.data(), n * 3);
+    m_solver.compute_batch_symmetric_soa(2, flattened);
+    const MatrixFr& values = m_solver.get_batch_eigen_values();
+    const MatrixFr& vectors = m_solver.get_batch_eigen_vectors();
+    ASSERT_EQ(2, values.rows());
+    ASSERT_EQ(n, values.cols());
+    ASSERT_EQ(4, vectors.rows());
+    ASSERT_EQ(n, vectors.cols());
+
+    for (size_t i=0; i<n; i++) {
+        Matrix2F M;
+        M << Ms(i, 0), Ms(i, 2),
+             Ms(i, 2), Ms(i, 1);
+        Eigen::SelfAdjointEigenSolver<Matrix2F> solver(M);
+        ASSERT_LE(values(0, i), values(1, i));
+        for (size_t k=0; k<2; k++) {
+            ASSERT_NEAR(solver.eigenvalues()[k], values(k, i), 1e-12);
+            const Vector2F v(vectors(k*2, i), vectors(k*2+1, i));
+            ASSERT_NEAR(1.0, v.norm(), 1e-12);
+            ASSERT_NEAR(0.0, (M * v - values(k, i) * v).norm(), 1e-12);
+        }
+    }
+}
+
+TEST_F(EigenUtilsTest, batch_3x3_random) {
+    const size_t n = 1000;
+    MatrixFr Ms = MatrixFr::Random(n, 6);
+    Ms.row(0) << 1.0, 1.0, 1.0, 0.0, 0.0, 0.0;
+    Ms.row(1) << 1.0, 1.0, 1.0, 1.0, 1.0, 1.0;
+    Ms.row(2) << 2.0, 2.0, 2.0, 1.0, 0.0, 0.0;
+    Ms.row(3) << 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+    Ms.row(4) << 1e8, 1.0, 1e-8, 1e-3, 1e-6, 1e2;
+    VectorF flattened = Eigen::Map<VectorF>(Ms.data(), n * 6);
+    m_solver.compute_batch_symmetric(3, flattened);
+    VectorF aos_values = m_solver.get_eigen_values();
+    MatrixF aos_vectors = m_solver.get_eigen_vectors();
+    ASSERT_EQ(n*3, aos_values.size());
+    ASSERT_EQ(n*3, aos_vectors.rows());
+    ASSERT_EQ(3, aos_vectors.cols());
+
+    for (size_t i=0; i<n; i++) {
+        Matrix3F M;
+        M << Ms(i, 0), Ms(i, 5), Ms(i, 4),
+             Ms(i, 5), Ms(i, 1), Ms(i, 3),
+             Ms(i, 4), Ms(i, 3), Ms(i, 2);
+        const Float scale = std::max(Float(1.0), M.norm());
+        Eigen::SelfAdjointEigenSolver<Matrix3F> solver(M);
+        const MatrixF V = aos_vectors.block(i*3, 0, 3, 3);
+        ASSERT_NEAR(0.0, (V.transpose() * V - Matrix3F::Identity()).norm(),
+                1e-12);
+        for (size_t k=0; k<3; k++) {
+            const Float value = aos_values[i*3+k];
+            if (k > 0) ASSERT_LE(aos_values[i*3+k-1], value);
+            ASSERT_NEAR(solver.eigenvalues()[k], value, 1e-12 * scale);
+            ASSERT_NEAR(0.0, (M * V.col(k) - value * V.col(k)).norm(),
+                    1e-12 * scale);
+        }
+    }
+}
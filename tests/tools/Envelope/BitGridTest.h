@@ -0,0 +1,145 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Core/EigenTypedef.h>
+#include <Envelope/BitGrid.h>
+
+#include <TestBase.h>
+
+class BitGridTest : public TestBase {
+    protected:
+        typedef BitGrid<2> BitGrid2D;
+        typedef BitGrid<3> BitGrid3D;
+
+        template<int DIM>
+        BitGrid<DIM> init(const typename BitGrid<DIM>::Vector_i& size) {
+            typedef typename BitGrid<DIM>::Vector_f Vector_f;
+            BitGrid<DIM> grid(0.5);
+            grid.initialize(size, Vector_f::Zero());
+            return grid;
+        }
+
+        /**
+         * Fill all cells within [min_idx, max_idx].
+         */
+        void fill_box(BitGrid3D& grid,
+                const Vector3I& min_idx, const Vector3I& max_idx) {
+            for (int i=min_idx[0]; i<=max_idx[0]; i++) {
+                for (int j=min_idx[1]; j<=max_idx[1]; j++) {
+                    for (int k=min_idx[2]; k<=max_idx[2]; k++) {
+                        grid.set(Vector3I(i, j, k), true);
+                    }
+                }
+            }
+        }
+};
+
+TEST_F(BitGridTest, Assignment2D) {
+    BitGrid2D grid = init<2>(Vector2I(3, 100));
+    ASSERT_EQ(0, grid.get_num_occupied_cells());
+
+    grid.set(Vector2I(1, 63), true);
+    grid.set(Vector2I(1, 64), true);
+    grid.set(Vector2I(2, 99), true);
+    ASSERT_TRUE(grid(Vector2I(1, 63)));
+    ASSERT_TRUE(grid(Vector2I(1, 64)));
+    ASSERT_TRUE(grid(Vector2I(2, 99)));
+    ASSERT_FALSE(grid(Vector2I(1, 65)));
+    ASSERT_EQ(3, grid.get_num_occupied_cells());
+
+    grid.set(Vector2I(1, 64), false);
+    ASSERT_FALSE(grid(Vector2I(1, 64)));
+    ASSERT_EQ(2, grid.get_num_occupied_cells());
+}
+
+TEST_F(BitGridTest, Lookup3D) {
+    BitGrid3D grid = init<3>(Vector3I(2, 2, 2));
+    grid.set_at(grid.base_coordinates(), true);
+    ASSERT_TRUE(grid.lookup(grid.base_coordinates()));
+    ASSERT_FALSE(grid.lookup(grid.base_coordinates() + grid.cell_size()));
+}
+
+TEST_F(BitGridTest, Visit) {
+    BitGrid3D grid = init<3>(Vector3I(4, 5, 130));
+    grid.set(Vector3I(0, 0, 0), true);
+    grid.set(Vector3I(3, 4, 129), true);
+    grid.set(Vector3I(2, 1, 64), true);
+
+    size_t count = 0;
+    grid.for_each_occupied_cell([&](const Vector3I& index) {
+        ASSERT_TRUE(grid(index));
+        count++;
+    });
+    ASSERT_EQ(3, count);
+}
+
+TEST_F(BitGridTest, Dilation) {
+    BitGrid3D grid = init<3>(Vector3I(5, 5, 100));
+    grid.set(Vector3I(2, 2, 64), true);
+    grid.set(Vector3I(0, 0, 0), true);
+    grid.dilate_cells(1);
+
+    // Interior cell grows into a full 3x3x3 block across a word boundary,
+    // the corner cell is clipped by the grid boundary.
+    ASSERT_EQ(27 + 8, grid.get_num_occupied_cells());
+    ASSERT_TRUE(grid(Vector3I(1, 1, 63)));
+    ASSERT_TRUE(grid(Vector3I(3, 3, 65)));
+    ASSERT_FALSE(grid(Vector3I(2, 2, 66)));
+}
+
+TEST_F(BitGridTest, Erosion) {
+    BitGrid3D grid = init<3>(Vector3I(6, 6, 70));
+    fill_box(grid, Vector3I(1, 1, 1), Vector3I(4, 4, 68));
+    grid.erode_cells(1);
+    ASSERT_EQ(2 * 2 * 66, grid.get_num_occupied_cells());
+    ASSERT_TRUE(grid(Vector3I(2, 2, 2)));
+    ASSERT_FALSE(grid(Vector3I(1, 2, 2)));
+}
+
+TEST_F(BitGridTest, ErosionAtBoundary) {
+    // Cells outside of the grid are ignored, so a full grid stays full.
+    BitGrid2D grid = init<2>(Vector2I(3, 65));
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<65; j++) {
+            grid.set(Vector2I(i, j), true);
+        }
+    }
+    grid.erode_cells(3);
+    ASSERT_EQ(3 * 65, grid.get_num_occupied_cells());
+}
+
+TEST_F(BitGridTest, FillCavities) {
+    BitGrid3D grid = init<3>(Vector3I(8, 8, 80));
+    fill_box(grid, Vector3I(1, 1, 1), Vector3I(6, 6, 78));
+    const size_t num_solid = grid.get_num_occupied_cells();
+
+    // Hollow out the box.
+    BitGrid3D hollow = init<3>(Vector3I(8, 8, 80));
+    fill_box(hollow, Vector3I(1, 1, 1), Vector3I(6, 6, 78));
+    for (int i=2; i<=5; i++) {
+        for (int j=2; j<=5; j++) {
+            for (int k=2; k<=77; k++) {
+                hollow.set(Vector3I(i, j, k), false);
+            }
+        }
+    }
+    ASSERT_LT(hollow.get_num_occupied_cells(), num_solid);
+
+    hollow.fill_cavities();
+    ASSERT_EQ(num_solid, hollow.get_num_occupied_cells());
+
+    // Opening a tunnel to the exterior keeps the interior empty.
+    BitGrid3D open_box = init<3>(Vector3I(8, 8, 80));
+    fill_box(open_box, Vector3I(1, 1, 1), Vector3I(6, 6, 78));
+    for (int i=2; i<=5; i++) {
+        for (int j=2; j<=5; j++) {
+            for (int k=2; k<=77; k++) {
+                open_box.set(Vector3I(i, j, k), false);
+            }
+        }
+    }
+    open_box.set(Vector3I(3, 3, 78), false);
+    const size_t num_open = open_box.get_num_occupied_cells();
+    open_box.fill_cavities();
+    ASSERT_EQ(num_open, open_box.get_num_occupied_cells());
+}
@@ -0,0 +1,133 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Core/EigenTypedef.h>
+#include <Envelope/BitGrid.h>
+#include <Envelope/SparseBitGrid.h>
+
+#include <TestBase.h>
+
+class SparseBitGridTest : public TestBase {
+    protected:
+        typedef SparseBitGrid<2> SparseBitGrid2D;
+        typedef SparseBitGrid<3> SparseBitGrid3D;
+
+        template<typename GridType>
+        GridType init(const typename GridType::Vector_i& size) {
+            typedef typename GridType::Vector_f Vector_f;
+            GridType grid(0.5);
+            grid.initialize(size, Vector_f::Zero());
+            return grid;
+        }
+
+        /**
+         * Spherical shell of thickness 1 cell centered in the grid.
+         */
+        template<typename GridType>
+        void fill_shell(GridType& grid, Float radius) {
+            const Vector3I size = grid.size();
+            const Vector3F center = size.cast<Float>() * 0.5;
+            for (int i=0; i<size[0]; i++) {
+                for (int j=0; j<size[1]; j++) {
+                    for (int k=0; k<size[2]; k++) {
+                        const Float d = (Vector3F(i, j, k) - center).norm();
+                        if (fabs(d - radius) < 1.0) {
+                            grid.set(Vector3I(i, j, k), true);
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename GridType>
+        void assert_same(const BitGrid<3>& dense, const GridType& sparse) {
+            const Vector3I size = dense.size();
+            ASSERT_EQ(dense.get_num_occupied_cells(),
+                    sparse.get_num_occupied_cells());
+            for (int i=0; i<size[0]; i++) {
+                for (int j=0; j<size[1]; j++) {
+                    for (int k=0; k<size[2]; k++) {
+                        Vector3I index(i, j, k);
+                        ASSERT_EQ(dense(index), sparse(index));
+                    }
+                }
+            }
+        }
+};
+
+TEST_F(SparseBitGridTest, Assignment2D) {
+    SparseBitGrid2D grid = init<SparseBitGrid2D>(Vector2I(20, 13));
+    ASSERT_EQ(0, grid.get_num_occupied_cells());
+    ASSERT_EQ(0, grid.get_num_allocated_blocks());
+
+    grid.set(Vector2I(7, 8), true);
+    grid.set(Vector2I(19, 12), true);
+    ASSERT_TRUE(grid(Vector2I(7, 8)));
+    ASSERT_TRUE(grid(Vector2I(19, 12)));
+    ASSERT_FALSE(grid(Vector2I(8, 7)));
+    ASSERT_EQ(2, grid.get_num_occupied_cells());
+    ASSERT_EQ(2, grid.get_num_allocated_blocks());
+
+    grid.set(Vector2I(7, 8), false);
+    ASSERT_FALSE(grid(Vector2I(7, 8)));
+    ASSERT_EQ(1, grid.get_num_allocated_blocks());
+}
+
+TEST_F(SparseBitGridTest, FullBlock) {
+    SparseBitGrid3D grid = init<SparseBitGrid3D>(Vector3I(10, 10, 10));
+    for (int i=0; i<8; i++) {
+        for (int j=0; j<8; j++) {
+            for (int k=0; k<8; k++) {
+                grid.set(Vector3I(i, j, k), true);
+            }
+        }
+    }
+    // Fully occupied blocks are not stored explicitly.
+    ASSERT_EQ(512, grid.get_num_occupied_cells());
+    ASSERT_EQ(0, grid.get_num_allocated_blocks());
+
+    grid.set(Vector3I(3, 4, 5), false);
+    ASSERT_EQ(511, grid.get_num_occupied_cells());
+    ASSERT_EQ(1, grid.get_num_allocated_blocks());
+    ASSERT_FALSE(grid(Vector3I(3, 4, 5)));
+}
+
+TEST_F(SparseBitGridTest, Dilation) {
+    const Vector3I size(30, 27, 33);
+    BitGrid<3> dense = init<BitGrid<3> >(size);
+    SparseBitGrid3D sparse = init<SparseBitGrid3D>(size);
+    fill_shell(dense, 10);
+    fill_shell(sparse, 10);
+
+    dense.dilate_cells(2);
+    sparse.dilate_cells(2);
+    assert_same(dense, sparse);
+}
+
+TEST_F(SparseBitGridTest, Erosion) {
+    const Vector3I size(30, 27, 33);
+    BitGrid<3> dense = init<BitGrid<3> >(size);
+    SparseBitGrid3D sparse = init<SparseBitGrid3D>(size);
+    fill_shell(dense, 10);
+    fill_shell(sparse, 10);
+    dense.dilate_cells(2);
+    sparse.dilate_cells(2);
+
+    dense.erode_cells(1);
+    sparse.erode_cells(1);
+    assert_same(dense, sparse);
+}
+
+TEST_F(SparseBitGridTest, FillCavities) {
+    const Vector3I size(30, 27, 33);
+    BitGrid<3> dense = init<BitGrid<3> >(size);
+    SparseBitGrid3D sparse = init<SparseBitGrid3D>(size);
+    fill_shell(dense, 10);
+    fill_shell(sparse, 10);
+
+    const size_t num_shell_cells = sparse.get_num_occupied_cells();
+    dense.fill_cavities();
+    sparse.fill_cavities();
+    assert_same(dense, sparse);
+    ASSERT_LT(num_shell_cells, sparse.get_num_occupied_cells());
+}
@@ -62,7 +62,7 @@ TEST_F(VoxelGridTest, exterior_2D) {
     for (size_t i=0; i<num_vertices; i++) {
         const Vector2F& n = normals.segment<2>(i*2);
         Vector2F p = mesh->get_vertex(i) + n * cell_size;
-        ASSERT_EQ(0, grid.lookup(p));
+        ASSERT_FALSE(grid.lookup(p));
     }
 }
 
@@ -80,7 +80,7 @@ TEST_F(VoxelGridTest, exterior_3D) {
     for (size_t i=0; i<num_vertices; i++) {
         const Vector3F& n = normals.segment<3>(i*3);
         Vector3F p = mesh->get_vertex(i) + n * cell_size;
-        ASSERT_EQ(0, grid.lookup(p));
+        ASSERT_FALSE(grid.lookup(p));
     }
 }
 
@@ -92,10 +92,7 @@ TEST_F(VoxelGridTest, VoxelMesh_2D) {
     grid.create_grid();
     MeshPtr quad_mesh = grid.get_voxel_mesh();
 
-    size_t num_occupied_cells = 0;
-    for (auto itr = grid.begin(); itr != grid.end(); itr++) {
-        if (*itr != 0) num_occupied_cells++;
-    }
+    size_t num_occupied_cells = grid.get_num_occupied_cells();
 
     ASSERT_EQ(2, quad_mesh->get_dim());
     ASSERT_EQ(4, quad_mesh->get_vertex_per_face());
@@ -111,10 +108,7 @@ TEST_F(VoxelGridTest, VoxelMesh_3D) {
     grid.create_grid();
     MeshPtr hex_mesh = grid.get_voxel_mesh();
 
-    size_t num_occupied_cells = 0;
-    for (auto itr = grid.begin(); itr != grid.end(); itr++) {
-        if (*itr != 0) num_occupied_cells++;
-    }
+    size_t num_occupied_cells = grid.get_num_occupied_cells();
 
     ASSERT_EQ(3, hex_mesh->get_dim());
     ASSERT_EQ(8, hex_mesh->get_vertex_per_voxel());
@@ -178,3 +172,49 @@ TEST_F(VoxelGridTest, erosion) {
     ASSERT_EQ(1, hex_mesh->get_num_voxels());
 }
 
+
+TEST_F(VoxelGridTest, sparse_dilation) {
+    MeshPtr mesh = load_mesh("cube.obj");
+    const Float cell_size = 1.0;
+    SparseVoxelGrid3D grid(cell_size);
+    grid.insert_mesh(mesh);
+    grid.create_grid();
+    grid.dilate(1);
+    MeshPtr hex_mesh = grid.get_voxel_mesh();
+
+    ASSERT_EQ(3, hex_mesh->get_dim());
+    ASSERT_EQ(8, hex_mesh->get_vertex_per_voxel());
+    ASSERT_EQ(125, hex_mesh->get_num_voxels());
+}
+
+TEST_F(VoxelGridTest, sparse_erosion) {
+    MeshPtr mesh = load_mesh("cube.obj");
+    const Float cell_size = 1.0;
+    SparseVoxelGrid3D grid(cell_size);
+    grid.insert_mesh(mesh);
+    grid.create_grid();
+    grid.erode(1);
+    MeshPtr hex_mesh = grid.get_voxel_mesh();
+
+    ASSERT_EQ(3, hex_mesh->get_dim());
+    ASSERT_EQ(8, hex_mesh->get_vertex_per_voxel());
+    ASSERT_EQ(1, hex_mesh->get_num_voxels());
+}
+
+TEST_F(VoxelGridTest, sparse_2D) {
+    MeshPtr mesh = load_mesh("square_2D.obj");
+    const Float cell_size = 0.5;
+    VoxelGrid2D dense_grid(cell_size);
+    dense_grid.insert_mesh(mesh);
+    dense_grid.create_grid();
+    SparseVoxelGrid2D sparse_grid(cell_size);
+    sparse_grid.insert_mesh(mesh);
+    sparse_grid.create_grid();
+
+    MeshPtr dense_mesh = dense_grid.get_voxel_mesh();
+    MeshPtr sparse_mesh = sparse_grid.get_voxel_mesh();
+    ASSERT_EQ(dense_grid.get_num_occupied_cells(),
+            sparse_grid.get_num_occupied_cells());
+    ASSERT_EQ(dense_mesh->get_num_faces(), sparse_mesh->get_num_faces());
+    ASSERT_EQ(dense_mesh->get_num_vertices(), sparse_mesh->get_num_vertices());
+}
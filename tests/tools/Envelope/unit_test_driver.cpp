@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "GridTest.h"
+#include "BitGridTest.h"
+#include "SparseBitGridTest.h"
 #include "VoxelGridTest.h"
 
 int main(int argc, char** argv) {
@@ -0,0 +1,214 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <set>
+#include <utility>
+
+#include <MeshUtils/IsotropicRemesher.h>
+#include <TestBase.h>
+
+class IsotropicRemesherTest : public TestBase {
+    protected:
+        /**
+         * Unit square split into n x n cells, each split along its diagonal.
+         */
+        void create_square(size_t n, size_t dim,
+                MatrixFr& vertices, MatrixIr& faces) {
+            vertices = MatrixFr::Zero((n+1)*(n+1), dim);
+            for (size_t i=0; i<=n; i++) {
+                for (size_t j=0; j<=n; j++) {
+                    vertices(i*(n+1)+j, 0) = Float(j) / n;
+                    vertices(i*(n+1)+j, 1) = Float(i) / n;
+                }
+            }
+            faces.resize(n*n*2, 3);
+            for (size_t i=0; i<n; i++) {
+                for (size_t j=0; j<n; j++) {
+                    const int v0 = i*(n+1)+j;
+                    const int v1 = v0 + 1;
+                    const int v2 = v0 + n + 2;
+                    const int v3 = v0 + n + 1;
+                    faces.row((i*n+j)*2  ) << v0, v1, v2;
+                    faces.row((i*n+j)*2+1) << v0, v2, v3;
+                }
+            }
+        }
+
+        void create_cube(MatrixFr& vertices, MatrixIr& faces) {
+            vertices.resize(8, 3);
+            vertices <<
+                -1, -1, -1,
+                 1, -1, -1,
+                 1,  1, -1,
+                -1,  1, -1,
+                -1, -1,  1,
+                 1, -1,  1,
+                 1,  1,  1,
+                -1,  1,  1;
+            faces.resize(12, 3);
+            faces <<
+                0, 2, 1,
+                0, 3, 2,
+                4, 5, 6,
+                4, 6, 7,
+                0, 1, 5,
+                0, 5, 4,
+                1, 2, 6,
+                1, 6, 5,
+                2, 3, 7,
+                2, 7, 6,
+                3, 0, 4,
+                3, 4, 7;
+        }
+
+        Vector3F get_normal(const MatrixFr& vertices, const VectorI& f) {
+            Vector3F corners[3];
+            for (size_t i=0; i<3; i++) {
+                corners[i].setZero();
+                corners[i].segment(0, vertices.cols()) = vertices.row(f[i]);
+            }
+            return (corners[1] - corners[0]).cross(corners[2] - corners[0]);
+        }
+
+        /**
+         * Smoothing after the last split may stretch edges slightly beyond
+         * 4/3 of the target length, so only a loose bound is checked.
+         */
+        void ASSERT_EDGE_LENGTHS(const MatrixFr& vertices,
+                const MatrixIr& faces, Float target_length) {
+            Float total_length = 0.0;
+            const size_t num_faces = faces.rows();
+            for (size_t i=0; i<num_faces; i++) {
+                for (size_t j=0; j<3; j++) {
+                    const VectorF e = vertices.row(faces(i,j)) -
+                        vertices.row(faces(i,(j+1)%3));
+                    ASSERT_LT(e.norm(), 1.5 * target_length);
+                    total_length += e.norm();
+                }
+            }
+            const Float ave_length = total_length / (num_faces * 3);
+            ASSERT_LT(0.7 * target_length, ave_length);
+            ASSERT_GT(1.3 * target_length, ave_length);
+        }
+
+        void ASSERT_UPWARD_UNIT_SQUARE(const MatrixFr& vertices,
+                const MatrixIr& faces) {
+            Float area = 0.0;
+            const size_t num_faces = faces.rows();
+            for (size_t i=0; i<num_faces; i++) {
+                const Vector3F n = get_normal(vertices, faces.row(i));
+                ASSERT_GT(n[2], 0.0);
+                area += 0.5 * n.norm();
+            }
+            ASSERT_NEAR(1.0, area, 1e-12);
+        }
+
+        void ASSERT_CLOSED(const MatrixFr& vertices, const MatrixIr& faces) {
+            std::set<std::pair<int, int> > edges;
+            const size_t num_faces = faces.rows();
+            for (size_t i=0; i<num_faces; i++) {
+                for (size_t j=0; j<3; j++) {
+                    auto e = std::make_pair(faces(i,j), faces(i,(j+1)%3));
+                    ASSERT_TRUE(edges.insert(e).second);
+                }
+            }
+            for (const auto& e : edges) {
+                ASSERT_EQ(1, edges.count({e.second, e.first}));
+            }
+            const int euler = vertices.rows() - edges.size() / 2 + num_faces;
+            ASSERT_EQ(2, euler);
+        }
+};
+
+TEST_F(IsotropicRemesherTest, square) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_square(1, 3, vertices, faces);
+
+    const Float target_length = 0.1;
+    IsotropicRemesher remesher(vertices, faces);
+    remesher.set_target_length(target_length);
+    remesher.run(5);
+
+    MatrixFr out_vertices = remesher.get_vertices();
+    MatrixIr out_faces = remesher.get_faces();
+    ASSERT_LT(100, out_faces.rows());
+    ASSERT_LT(0, remesher.get_num_splits());
+    ASSERT_EDGE_LENGTHS(out_vertices, out_faces, target_length);
+    ASSERT_UPWARD_UNIT_SQUARE(out_vertices, out_faces);
+    ASSERT_NEAR(0.0, out_vertices.col(2).cwiseAbs().maxCoeff(), 1e-12);
+    ASSERT_LE(0.0, out_vertices.minCoeff());
+    ASSERT_GE(1.0, out_vertices.maxCoeff());
+}
+
+TEST_F(IsotropicRemesherTest, coarsen_2D) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_square(20, 2, vertices, faces);
+
+    const Float target_length = 0.2;
+    IsotropicRemesher remesher(vertices, faces);
+    remesher.set_target_length(target_length);
+    remesher.run();
+
+    MatrixFr out_vertices = remesher.get_vertices();
+    MatrixIr out_faces = remesher.get_faces();
+    ASSERT_EQ(2, out_vertices.cols());
+    ASSERT_GT(faces.rows(), out_faces.rows() * 2);
+    ASSERT_LT(0, remesher.get_num_collapses());
+    ASSERT_UPWARD_UNIT_SQUARE(out_vertices, out_faces);
+}
+
+TEST_F(IsotropicRemesherTest, cube) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_cube(vertices, faces);
+
+    const Float target_length = 0.3;
+    IsotropicRemesher remesher(vertices, faces);
+    remesher.set_target_length(target_length);
+    remesher.run();
+
+    MatrixFr out_vertices = remesher.get_vertices();
+    MatrixIr out_faces = remesher.get_faces();
+    ASSERT_CLOSED(out_vertices, out_faces);
+    ASSERT_EDGE_LENGTHS(out_vertices, out_faces, target_length);
+    ASSERT_LT(0, remesher.get_num_flips());
+}
+
+TEST_F(IsotropicRemesherTest, sizing_field) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_square(4, 3, vertices, faces);
+
+    const size_t num_vertices = vertices.rows();
+    VectorF sizing(num_vertices);
+    for (size_t i=0; i<num_vertices; i++) {
+        sizing[i] = 0.05 + 0.2 * vertices(i, 0);
+    }
+
+    IsotropicRemesher remesher(vertices, faces);
+    remesher.set_sizing_field(sizing);
+    remesher.run();
+
+    MatrixFr out_vertices = remesher.get_vertices();
+    MatrixIr out_faces = remesher.get_faces();
+    ASSERT_UPWARD_UNIT_SQUARE(out_vertices, out_faces);
+
+    const size_t num_out_vertices = out_vertices.rows();
+    size_t num_fine = 0;
+    for (size_t i=0; i<num_out_vertices; i++) {
+        if (out_vertices(i, 0) < 0.5) num_fine++;
+    }
+    ASSERT_LT(num_out_vertices - num_fine, num_fine);
+}
+
+TEST_F(IsotropicRemesherTest, invalid_sizing_field) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    create_square(1, 3, vertices, faces);
+
+    IsotropicRemesher remesher(vertices, faces);
+    ASSERT_THROW(remesher.set_sizing_field(VectorF::Ones(3)), RuntimeError);
+    ASSERT_THROW(remesher.set_target_length(0.0), RuntimeError);
+}
@@ -119,3 +119,38 @@ TEST_F(MeshCheckerTest, hex) {
     ASSERT_TRUE(checker.is_oriented());
 }
 
+
+TEST_F(MeshCheckerTest, nonmanifold_vertex) {
+    // Two triangles sharing a single vertex.
+    MatrixFr vertices(6, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0,
+               -1.0, 0.0, 0.0,
+                0.0,-1.0, 0.0,
+                5.0, 5.0, 5.0;
+    MatrixIr faces(2, 3);
+    faces << 0, 1, 2,
+             0, 3, 4;
+    MatrixIr voxels(0, 4);
+
+    MeshChecker checker(vertices, faces, voxels);
+    ASSERT_FALSE(checker.is_vertex_manifold());
+    ASSERT_TRUE(checker.is_edge_manifold());
+    ASSERT_TRUE(checker.is_oriented());
+    ASSERT_EQ(6, checker.get_num_boundary_edges());
+    ASSERT_TRUE(checker.has_complex_boundary());
+    ASSERT_EQ(1, checker.get_num_isolated_vertices());
+    ASSERT_EQ(0, checker.get_num_duplicated_faces());
+    ASSERT_EQ(2, checker.get_euler_characteristic());
+
+    const MatrixIr boundary_edges = checker.get_boundary_edges();
+    for (size_t i=0; i<boundary_edges.rows(); i++) {
+        // Boundary edges follow the orientation of their face.
+        const int s = boundary_edges(i, 0);
+        const int d = boundary_edges(i, 1);
+        const bool in_f0 = (s==0 && d==1) || (s==1 && d==2) || (s==2 && d==0);
+        const bool in_f1 = (s==0 && d==3) || (s==3 && d==4) || (s==4 && d==0);
+        ASSERT_TRUE(in_f0 || in_f1);
+    }
+}
@@ -176,7 +176,113 @@ TEST_F(PointLocatorTest, MeshVertices) {
     }
 }
 
+TEST_F(PointLocatorTest, FarFromOrigin) {
+    MeshPtr cube = load_mesh("cube.msh");
+    const size_t num_vertices = cube->get_num_vertices();
+    VectorF offset(3);
+    offset << 1e10, -2e10, 3e10;
+    VectorF vertices = cube->get_vertices();
+    for (size_t i=0; i<num_vertices; i++) {
+        vertices.segment(i*3, 3) += offset;
+    }
+    MeshPtr mesh = load_data(vertices, cube->get_faces(), cube->get_voxels(),
+            3, cube->get_vertex_per_face(), cube->get_vertex_per_voxel());
+
+    // Barycentric coordinates are checked in the original frame.  Shifting
+    // the shifted points back is exact, which gives the reference points.
+    PointLocator locator(mesh);
+    MatrixF pts = uniform_samples(7, -0.99*VectorF::Ones(3), 0.99*VectorF::Ones(3));
+    pts.rowwise() += offset.transpose();
+    MatrixF samples = pts.rowwise() - offset.transpose();
+    size_t num_pts = pts.rows();
+
+    locator.locate(pts);
+    VectorI elem_indices = locator.get_enclosing_voxels();
+    MatrixF barycentric_coords = locator.get_barycentric_coords();
+
+    ASSERT_EQ(num_pts, elem_indices.size());
+    ASSERT_EQ(num_pts, barycentric_coords.rows());
+
+    for (size_t i=0; i<num_pts; i++) {
+        VectorI voxel = cube->get_voxel(elem_indices[i]);
+        ASSERT_LT(-1e-6, barycentric_coords.row(i).minCoeff());
+        VectorF p = VectorF::Zero(3);
+        for (size_t j=0; j<4; j++) {
+            p += cube->get_vertex(voxel[j]) * barycentric_coords(i, j);
+        }
+        ASSERT_NEAR(0.0, (p - samples.row(i).transpose()).norm(), 1e-9);
+    }
+}
+
+TEST_F(PointLocatorTest, SeparatedElements) {
+    MatrixFr vertices(8, 3);
+    vertices <<
+        0.0, 0.0, 0.0,
+        1.0, 0.0, 0.0,
+        0.0, 1.0, 0.0,
+        0.0, 0.0, 1.0,
+        100.0, 0.0, 0.0,
+        101.0, 0.0, 0.0,
+        100.0, 1.0, 0.0,
+        100.0, 0.0, 1.0;
+    MatrixIr faces(8, 3);
+    faces <<
+        0, 2, 1,
+        0, 1, 3,
+        0, 3, 2,
+        1, 2, 3,
+        4, 6, 5,
+        4, 5, 7,
+        4, 7, 6,
+        5, 6, 7;
+    MatrixIr voxels(2, 4);
+    voxels <<
+        0, 1, 2, 3,
+        4, 5, 6, 7;
+    MeshPtr mesh = load_data(vertices, faces, voxels);
+    PointLocator locator(mesh);
+
+    // Inside and just outside of the tets.
+    MatrixF pts(3, 3);
+    pts <<
+        0.2, 0.2, 0.2,
+        100.2, 0.2, 0.2,
+        -0.05, 0.2, 0.2;
+    locator.locate(pts);
+    VectorI elem_indices = locator.get_enclosing_voxels();
+    ASSERT_EQ(0, elem_indices[0]);
+    ASSERT_EQ(1, elem_indices[1]);
+    ASSERT_EQ(0, elem_indices[2]);
+
+    // Between the tets: the grid cells are far wider than the tets, but
+    // the point must not be extrapolated from either of them.
+    MatrixF between(1, 3);
+    between << 3.0, 0.2, 0.2;
+    ASSERT_THROW(locator.locate(between), RuntimeError);
+}
+
 TEST_F(PointLocatorTest, ZeroElements) {
     MeshPtr mesh = load_mesh("tet.obj");
     ASSERT_THROW(PointLocator locator(mesh), RuntimeError);
 }
+
+TEST_F(PointLocatorTest, ManyPoints) {
+    MeshPtr mesh = load_mesh("cube.msh");
+    PointLocator locator(mesh);
+    MatrixF pts = uniform_samples(40, -1*VectorF::Ones(3), VectorF::Ones(3));
+    size_t num_pts = pts.rows();
+
+    locator.locate(pts);
+    VectorI elem_indices = locator.get_enclosing_voxels();
+    MatrixF barycentric_coords = locator.get_barycentric_coords();
+
+    ASSERT_EQ(num_pts, elem_indices.size());
+    ASSERT_EQ(num_pts, barycentric_coords.rows());
+
+    for (size_t i=0; i<num_pts; i++) {
+        VectorI voxel = mesh->get_voxel(elem_indices[i]);
+        check_barycentric_coord(mesh, pts.row(i), voxel,
+                barycentric_coords.row(i));
+        ASSERT_LT(-1e-6, barycentric_coords.row(i).minCoeff());
+    }
+}
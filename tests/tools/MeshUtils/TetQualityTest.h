@@ -0,0 +1,191 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <MeshUtils/TetQuality.h>
+#include <TestBase.h>
+
+class TetQualityTest : public TestBase {
+    protected:
+        void create_regular_tet(MatrixFr& vertices, MatrixIr& tets) {
+            vertices.resize(4, 3);
+            vertices <<
+                 1,  1,  1,
+                -1, -1,  1,
+                -1,  1, -1,
+                 1, -1, -1;
+            tets.resize(1, 4);
+            tets << 0, 1, 2, 3;
+        }
+
+        Float reference_circumradius(const Vector3F& v0, const Vector3F& v1,
+                const Vector3F& v2, const Vector3F& v3) {
+            Matrix3F A;
+            A.row(0) = v1 - v0;
+            A.row(1) = v2 - v0;
+            A.row(2) = v3 - v0;
+            Vector3F rhs(
+                    0.5 * (v1 - v0).squaredNorm(),
+                    0.5 * (v2 - v0).squaredNorm(),
+                    0.5 * (v3 - v0).squaredNorm());
+            return A.fullPivLu().solve(rhs).norm();
+        }
+
+        Float reference_dihedral_angle(const Vector3F& e0, const Vector3F& e1,
+                const Vector3F& p0, const Vector3F& p1) {
+            const Vector3F e = (e1 - e0).normalized();
+            Vector3F u = p0 - e0;
+            Vector3F w = p1 - e0;
+            u -= u.dot(e) * e;
+            w -= w.dot(e) * e;
+            return atan2(u.cross(w).norm(), u.dot(w));
+        }
+};
+
+TEST_F(TetQualityTest, regular_tet) {
+    MatrixFr vertices;
+    MatrixIr tets;
+    create_regular_tet(vertices, tets);
+
+    TetQuality quality;
+    quality.run(vertices, tets);
+
+    const Float l = sqrt(8.0);
+    ASSERT_NEAR(l*l*l / (6.0 * sqrt(2.0)), quality.get_volumes()[0], 1e-12);
+    ASSERT_LT(0.0, quality.get_orientations()[0]);
+    ASSERT_NEAR(l / (2.0 * sqrt(6.0)), quality.get_inradii()[0], 1e-12);
+    ASSERT_NEAR(l * sqrt(6.0) / 4.0, quality.get_circumradii()[0], 1e-12);
+    ASSERT_NEAR(sqrt(6.0) / 4.0, quality.get_radius_edge_ratios()[0], 1e-12);
+    ASSERT_NEAR(l, quality.get_min_edge_lengths()[0], 1e-12);
+    ASSERT_NEAR(l, quality.get_max_edge_lengths()[0], 1e-12);
+    for (size_t i=0; i<6; i++) {
+        ASSERT_NEAR(acos(1.0 / 3.0), quality.get_dihedral_angles()(0, i), 1e-12);
+    }
+}
+
+TEST_F(TetQualityTest, inverted_and_degenerate) {
+    MatrixFr vertices(5, 3);
+    vertices <<
+        0.0, 0.0, 0.0,
+        1.0, 0.0, 0.0,
+        0.0, 1.0, 0.0,
+        0.0, 0.0, 1.0,
+        1.0, 1.0, 0.0;
+    MatrixIr tets(5, 4);
+    tets <<
+        0, 1, 2, 3,
+        1, 0, 2, 3,
+        0, 1, 2, 4,
+        0, 1, 0, 1,
+        3, 3, 3, 3;
+
+    TetQuality quality;
+    quality.run(vertices, tets);
+
+    const VectorF& volumes = quality.get_volumes();
+    const VectorF& orientations = quality.get_orientations();
+    ASSERT_NEAR( 1.0 / 6.0, volumes[0], 1e-12);
+    ASSERT_NEAR(-1.0 / 6.0, volumes[1], 1e-12);
+    ASSERT_EQ(0.0, volumes[2]);
+    ASSERT_LT(0.0, orientations[0]);
+    ASSERT_GT(0.0, orientations[1]);
+    ASSERT_EQ(0.0, orientations[2]);
+
+    ASSERT_NEAR(quality.get_inradii()[0], quality.get_inradii()[1], 1e-12);
+    ASSERT_EQ(0.0, quality.get_inradii()[2]);
+    ASSERT_EQ(std::numeric_limits<Float>::infinity(),
+            quality.get_radius_edge_ratios()[2]);
+
+    // Tets collapsed to a segment and to a point.
+    const Float infinity = std::numeric_limits<Float>::infinity();
+    for (size_t i=3; i<5; i++) {
+        ASSERT_EQ(0.0, volumes[i]);
+        ASSERT_EQ(0.0, orientations[i]);
+        ASSERT_EQ(0.0, quality.get_inradii()[i]);
+        ASSERT_EQ(infinity, quality.get_circumradii()[i]);
+        ASSERT_EQ(infinity, quality.get_radius_edge_ratios()[i]);
+        ASSERT_EQ(0.0, quality.get_min_edge_lengths()[i]);
+    }
+    ASSERT_NEAR(1.0, quality.get_max_edge_lengths()[3], 1e-12);
+    ASSERT_EQ(0.0, quality.get_max_edge_lengths()[4]);
+}
+
+TEST_F(TetQualityTest, random_tets) {
+    const size_t num_vertices = 50;
+    const size_t num_tets = 1000;
+    srand(1);
+    MatrixFr vertices = MatrixFr::Random(num_vertices, 3);
+    MatrixIr tets(num_tets, 4);
+    for (size_t i=0; i<num_tets; i++) {
+        const int v0 = i % num_vertices;
+        tets.row(i) << v0, (v0 + 1 + i*7) % num_vertices,
+                    (v0 + 2 + i*13) % num_vertices,
+                    (v0 + 3 + i*29) % num_vertices;
+    }
+
+    TetQuality quality;
+    quality.run(vertices, tets);
+
+    const size_t edges[6][2] = {{0,1}, {1,2}, {0,2}, {0,3}, {2,3}, {1,3}};
+    for (size_t i=0; i<num_tets; i++) {
+        const Vector4I tet = tets.row(i);
+        if (tet[0] == tet[1] || tet[0] == tet[2] || tet[0] == tet[3] ||
+                tet[1] == tet[2] || tet[1] == tet[3] || tet[2] == tet[3]) {
+            continue;
+        }
+        const Vector3F v[4] = {
+            vertices.row(tet[0]), vertices.row(tet[1]),
+            vertices.row(tet[2]), vertices.row(tet[3])};
+
+        const Float volume = (v[1]-v[0]).cross(v[2]-v[0]).dot(v[3]-v[0]) / 6.0;
+        ASSERT_NEAR(volume, quality.get_volumes()[i], 1e-12);
+        ASSERT_EQ(volume > 0, quality.get_orientations()[i] > 0);
+
+        const Float area =
+            (v[1]-v[0]).cross(v[2]-v[0]).norm() +
+            (v[1]-v[0]).cross(v[3]-v[0]).norm() +
+            (v[2]-v[0]).cross(v[3]-v[0]).norm() +
+            (v[2]-v[1]).cross(v[3]-v[1]).norm();
+        ASSERT_NEAR(3.0 * fabs(volume) / (0.5 * area),
+                quality.get_inradii()[i], 1e-9);
+
+        const Float circumradius = reference_circumradius(v[0], v[1], v[2], v[3]);
+        ASSERT_NEAR(1.0, quality.get_circumradii()[i] / circumradius, 1e-6);
+
+        Float min_length = std::numeric_limits<Float>::max();
+        for (size_t j=0; j<6; j++) {
+            const size_t a = edges[j][0];
+            const size_t b = edges[j][1];
+            min_length = std::min(min_length, (v[a] - v[b]).norm());
+
+            size_t others[2];
+            size_t count = 0;
+            for (size_t k=0; k<4; k++) {
+                if (k != a && k != b) others[count++] = k;
+            }
+            ASSERT_NEAR(reference_dihedral_angle(v[a], v[b],
+                        v[others[0]], v[others[1]]),
+                    quality.get_dihedral_angles()(i, j), 1e-9);
+        }
+        ASSERT_NEAR(1.0, quality.get_radius_edge_ratios()[i] *
+                min_length / circumradius, 1e-6);
+    }
+}
+
+TEST_F(TetQualityTest, histogram) {
+    VectorF values(8);
+    values << -1.0, 0.0, 0.1, 0.5, 0.99, 1.0, 2.0,
+           std::numeric_limits<Float>::quiet_NaN();
+
+    VectorI histogram = TetQuality::compute_histogram(values, 0.0, 1.0, 4);
+    ASSERT_EQ(4, histogram.size());
+    ASSERT_EQ(3, histogram[0]);
+    ASSERT_EQ(0, histogram[1]);
+    ASSERT_EQ(1, histogram[2]);
+    ASSERT_EQ(3, histogram[3]);
+
+    ASSERT_THROW(TetQuality::compute_histogram(values, 1.0, 1.0, 4),
+            RuntimeError);
+}
@@ -1,7 +1,10 @@
 /* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
 #pragma once
 
+#include <cmath>
+
 #include <MeshUtils/VoxelUtils.h>
+#include <Predicates/predicates.h>
 #include <TestBase.h>
 
 TEST(VoxelUtilsTest, simple) {
@@ -61,3 +64,95 @@ TEST(VoxelUtilsTest, delaunay) {
         ASSERT_EQ(-1, result[1]);
     }
 }
+
+TEST(VoxelUtilsTest, global_delaunay) {
+    using namespace PyMesh;
+    MatrixFr vertices(7, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0,
+                0.0, 0.0, 1.0,
+                1.0, 1.0, 1.0,
+                1.1, 1.1, 1.1,
+                0.9, 0.9, 0.9;
+    MatrixIr tets(4, 4);
+    tets << 0, 1, 2, 3, // Positive
+            1, 0, 2, 3, // Inverted
+            0, 0, 1, 2, // Degenerate
+            1, 2, 3, 5;
+
+    // Vertex 6 is not used by any tet, so it is only seen by the global
+    // check.
+    auto local_result = VoxelUtils::is_delaunay(vertices, tets);
+    ASSERT_EQ(1, local_result[3]);
+
+    auto result = VoxelUtils::is_globally_delaunay(vertices, tets);
+    ASSERT_EQ(4, result.size());
+    ASSERT_EQ(-1, result[0]);
+    ASSERT_EQ(-1, result[1]);
+    ASSERT_EQ(0, result[2]);
+    ASSERT_EQ(-1, result[3]);
+
+    MatrixFr cospherical = vertices.topRows(5);
+    result = VoxelUtils::is_globally_delaunay(cospherical, tets.topRows(2));
+    ASSERT_EQ(0, result[0]);
+    ASSERT_EQ(0, result[1]);
+}
+
+TEST(VoxelUtilsTest, global_delaunay_random) {
+    using namespace PyMesh;
+    const size_t num_vertices = 200;
+    const size_t num_tets = 5000;
+    srand(1);
+    MatrixFr vertices = MatrixFr::Random(num_vertices, 3);
+    // Many vertices nearly on a common sphere.
+    for (size_t i=0; i<num_vertices; i+=2) {
+        vertices.row(i).normalize();
+    }
+    MatrixIr tets(num_tets, 4);
+    for (size_t i=0; i<num_tets; i++) {
+        for (size_t j=0; j<4; j++) {
+            tets(i, j) = rand() % num_vertices;
+        }
+    }
+
+    auto result = VoxelUtils::is_globally_delaunay(vertices, tets);
+    auto orientations = VoxelUtils::get_tet_orientations(vertices, tets);
+    ASSERT_EQ(num_tets, result.size());
+    exactinit();
+    for (size_t i=0; i<num_tets; i++) {
+        const Vector4I tet = tets.row(i);
+        const Vector3F v0 = vertices.row(tet[0]);
+        const Vector3F v1 = vertices.row(tet[1]);
+        const Vector3F v2 = vertices.row(tet[2]);
+        const Vector3F v3 = vertices.row(tet[3]);
+        Float expected = 1;
+        if (orientations[i] == 0) {
+            expected = 0;
+        } else {
+            for (size_t j=0; j<num_vertices; j++) {
+                if (int(j) == tet[0] || int(j) == tet[1] ||
+                        int(j) == tet[2] || int(j) == tet[3]) continue;
+                Vector3F p = vertices.row(j);
+                Float r = insphere(
+                        const_cast<Float*>(v1.data()),
+                        const_cast<Float*>(v0.data()),
+                        const_cast<Float*>(v2.data()),
+                        const_cast<Float*>(v3.data()),
+                        p.data());
+                if (orientations[i] < 0) r = -r;
+                if (r > 0) {
+                    expected = -1;
+                    break;
+                } else if (r == 0) {
+                    expected = 0;
+                }
+            }
+        }
+        ASSERT_EQ(expected, result[i]);
+    }
+
+    auto partial = VoxelUtils::is_globally_delaunay(vertices, tets, true);
+    ASSERT_EQ(-1, partial[0]);
+    ASSERT_TRUE(std::isnan(partial[num_tets-1]));
+}
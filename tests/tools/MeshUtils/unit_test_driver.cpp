@@ -10,6 +10,7 @@
 #include "FinFaceRemovalTest.h"
 #include "IndexHeapTest.h"
 #include "IsolatedVertexRemovalTest.h"
+#include "IsotropicRemesherTest.h"
 #include "LoopSubdivisionTest.h"
 #include "LongEdgeRemovalTest.h"
 #include "MeshCheckerTest.h"
@@ -21,6 +22,7 @@
 #include "ShortEdgeRemovalTest.h"
 #include "SimpleSubdivisionTest.h"
 #include "SubMeshTest.h"
+#include "TetQualityTest.h"
 #include "TriangleMetricTest.h"
 #include "VoxelUtilsTest.h"
 
@@ -0,0 +1,123 @@
+/* This file is part of PyMesh. Copyright (c) 2019 by Qingnan Zhou */
+#pragma once
+
+#include <TestBase.h>
+#include <Predicates/BatchPredicates.h>
+extern "C" {
+#include <Predicates/predicates.h>
+}
+
+class BatchPredicatesTest : public TestBase {
+    protected:
+        virtual void SetUp() {
+            TestBase::SetUp();
+            exactinit();
+        }
+
+        int sign(Float val) {
+            return (val > 0.0) - (val < 0.0);
+        }
+
+        /**
+         * Random points snapped to a coarse lattice so that many queries are
+         * degenerate and have to go through the exact path.
+         */
+        MatrixFr random_points(size_t num_pts, size_t dim) {
+            MatrixFr pts = MatrixFr::Random(num_pts, dim);
+            return (pts * 4.0).array().round() / 4.0;
+        }
+};
+
+TEST_F(BatchPredicatesTest, Orient2D) {
+    const size_t N = 2000;
+    MatrixFr pa = random_points(N, 2);
+    MatrixFr pb = random_points(N, 2);
+    MatrixFr pc = random_points(N, 2);
+    VectorF result = BatchPredicates::orient2d(pa, pb, pc);
+    ASSERT_EQ(N, result.size());
+
+    size_t num_degenerate = 0;
+    for (size_t i=0; i<N; i++) {
+        Vector2F a = pa.row(i), b = pb.row(i), c = pc.row(i);
+        Float expected = orient2d(a.data(), b.data(), c.data());
+        ASSERT_EQ(sign(expected), sign(result[i]));
+        if (expected == 0.0) num_degenerate++;
+    }
+    ASSERT_LT(0, num_degenerate);
+}
+
+TEST_F(BatchPredicatesTest, Orient3D) {
+    const size_t N = 2000;
+    MatrixFr pa = random_points(N, 3);
+    MatrixFr pb = random_points(N, 3);
+    MatrixFr pc = random_points(N, 3);
+    MatrixFr pd = random_points(N, 3);
+    VectorF result = BatchPredicates::orient3d(pa, pb, pc, pd);
+    ASSERT_EQ(N, result.size());
+
+    for (size_t i=0; i<N; i++) {
+        Vector3F a = pa.row(i), b = pb.row(i), c = pc.row(i), d = pd.row(i);
+        Float expected = orient3d(a.data(), b.data(), c.data(), d.data());
+        ASSERT_EQ(sign(expected), sign(result[i]));
+    }
+}
+
+TEST_F(BatchPredicatesTest, InCircle) {
+    const size_t N = 2000;
+    MatrixFr pa = random_points(N, 2);
+    MatrixFr pb = random_points(N, 2);
+    MatrixFr pc = random_points(N, 2);
+    MatrixFr pd = random_points(N, 2);
+    VectorF result = BatchPredicates::incircle(pa, pb, pc, pd);
+    ASSERT_EQ(N, result.size());
+
+    for (size_t i=0; i<N; i++) {
+        Vector2F a = pa.row(i), b = pb.row(i), c = pc.row(i), d = pd.row(i);
+        Float expected = incircle(a.data(), b.data(), c.data(), d.data());
+        ASSERT_EQ(sign(expected), sign(result[i]));
+    }
+}
+
+TEST_F(BatchPredicatesTest, InSphere) {
+    const size_t N = 2000;
+    MatrixFr pa = random_points(N, 3);
+    MatrixFr pb = random_points(N, 3);
+    MatrixFr pc = random_points(N, 3);
+    MatrixFr pd = random_points(N, 3);
+    MatrixFr pe = random_points(N, 3);
+    VectorF result = BatchPredicates::insphere(pa, pb, pc, pd, pe);
+    ASSERT_EQ(N, result.size());
+
+    for (size_t i=0; i<N; i++) {
+        Vector3F a = pa.row(i), b = pb.row(i), c = pc.row(i), d = pd.row(i),
+                 e = pe.row(i);
+        Float expected = insphere(a.data(), b.data(), c.data(), d.data(),
+                e.data());
+        ASSERT_EQ(sign(expected), sign(result[i]));
+    }
+}
+
+TEST_F(BatchPredicatesTest, Broadcast) {
+    // Classify points against the plane z = 0.
+    MatrixFr pa(1, 3), pb(1, 3), pc(1, 3);
+    pa << 0.0, 0.0, 0.0;
+    pb << 1.0, 0.0, 0.0;
+    pc << 0.0, 1.0, 0.0;
+
+    const size_t N = 1000;
+    MatrixFr pts = MatrixFr::Random(N, 3);
+    pts.col(2).head(10).setZero();
+    VectorF result = BatchPredicates::orient3d(pa, pb, pc, pts);
+    ASSERT_EQ(N, result.size());
+    for (size_t i=0; i<N; i++) {
+        ASSERT_EQ(-sign(pts(i, 2)), sign(result[i]));
+    }
+}
+
+TEST_F(BatchPredicatesTest, SizeMismatch) {
+    MatrixFr pa = MatrixFr::Zero(3, 2);
+    MatrixFr pb = MatrixFr::Zero(4, 2);
+    ASSERT_THROW(BatchPredicates::orient2d(pa, pb, pb), RuntimeError);
+    ASSERT_THROW(BatchPredicates::orient2d(pa, pa, MatrixFr::Zero(3, 3)),
+            RuntimeError);
+}
@@ -1,6 +1,7 @@
 /* This file is part of PyMesh. Copyright (c) 2017 by Qingnan Zhou */
 #include <gtest/gtest.h>
 #include "predicates_test.h"
+#include "batch_predicates_test.h"
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
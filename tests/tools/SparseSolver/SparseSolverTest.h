@@ -64,6 +64,33 @@ class SparseSolverTest : public TestBase {
             }
         }
 
+        /**
+         * 5-point Laplacian with Dirichlet boundary on an n x n grid,
+         * replicated block_size times with interleaved unknowns.
+         */
+        void init_grid_laplacian(size_t n, size_t block_size=1) {
+            std::vector<T> entries;
+            auto index = [n, block_size](size_t i, size_t j, size_t c) {
+                return (i*n+j) * block_size + c;
+            };
+            for (size_t i=0; i<n; i++) {
+                for (size_t j=0; j<n; j++) {
+                    for (size_t c=0; c<block_size; c++) {
+                        const size_t k = index(i, j, c);
+                        entries.push_back(T(k, k, 4.0));
+                        if (i > 0) entries.push_back(T(k, index(i-1, j, c), -1.0));
+                        if (i+1 < n) entries.push_back(T(k, index(i+1, j, c), -1.0));
+                        if (j > 0) entries.push_back(T(k, index(i, j-1, c), -1.0));
+                        if (j+1 < n) entries.push_back(T(k, index(i, j+1, c), -1.0));
+                    }
+                }
+            }
+
+            const size_t size = n * n * block_size;
+            m_matrix.resize(size, size);
+            m_matrix.setFromTriplets(entries.begin(), entries.end());
+        }
+
         void ASSERT_VECTOR_EQ(const VectorF& v1, const VectorF& v2) {
             ASSERT_EQ(v1.size(), v2.size());
             ASSERT_NEAR(0.0, (v1-v2).norm(), 1e-6);
@@ -81,6 +108,20 @@ class SparseSolverTest : public TestBase {
             ASSERT_VECTOR_EQ(rhs, m_matrix * sol);
         }
 
+        void solve_grid_system(const std::string& type, size_t block_size=1) {
+            init_grid_laplacian(64, block_size);
+            SolverPtr solver = SparseSolver::create(type);
+            solver->set_tolerance(1e-12);
+            solver->set_block_size(block_size);
+            VectorF rhs = VectorF::Ones(m_matrix.rows());
+
+            solver->analyze_pattern(m_matrix);
+            solver->factorize(m_matrix);
+            VectorF sol = solver->solve(rhs);
+
+            ASSERT_VECTOR_EQ(rhs, m_matrix * sol);
+        }
+
         void solve_dense_system(const std::string& type) {
             init_dense_matrix();
             SolverPtr solver = SparseSolver::create(type);
@@ -112,6 +153,68 @@ TEST_F(SparseSolverTest, CG) {
     solve_dense_system("CG");
 }
 
+TEST_F(SparseSolverTest, PCG_Jacobi) {
+    solve_diagonal_system("PCG_Jacobi");
+    solve_dense_system("PCG_Jacobi");
+    solve_grid_system("PCG_Jacobi");
+}
+
+TEST_F(SparseSolverTest, PCG_IC) {
+    solve_diagonal_system("PCG_IC");
+    solve_dense_system("PCG_IC");
+    solve_grid_system("PCG_IC");
+}
+
+TEST_F(SparseSolverTest, PCG_AMG) {
+    solve_diagonal_system("PCG_AMG");
+    solve_dense_system("PCG_AMG");
+    solve_grid_system("PCG_AMG");
+    solve_grid_system("PCG_AMG", 3);
+}
+
+TEST_F(SparseSolverTest, MultipleRHS) {
+    init_grid_laplacian(32);
+    SolverPtr solver = SparseSolver::create("PCG_AMG");
+    solver->set_tolerance(1e-12);
+    solver->compute(m_matrix);
+
+    MatrixF rhs(m_matrix.rows(), 2);
+    rhs.col(0).setOnes();
+    rhs.col(1).setLinSpaced(-1.0, 1.0);
+    MatrixF sol = solver->solve(rhs);
+    ASSERT_EQ(2, sol.cols());
+    ASSERT_VECTOR_EQ(rhs.col(0), m_matrix * sol.col(0));
+    ASSERT_VECTOR_EQ(rhs.col(1), m_matrix * sol.col(1));
+}
+
+TEST_F(SparseSolverTest, MatrixFree) {
+    init_grid_laplacian(32);
+    const SMat& A = m_matrix;
+    SparseSolver::LinearOperator op = [&A](const VectorF& x, VectorF& y) {
+        y = A * x;
+    };
+    VectorF rhs = VectorF::Ones(m_matrix.rows());
+
+    SolverPtr solver = SparseSolver::create("PCG_Jacobi");
+    solver->set_tolerance(1e-12);
+    solver->set_linear_operator(m_matrix.rows(), op, m_matrix.diagonal());
+    VectorF sol = solver->solve(rhs);
+    ASSERT_VECTOR_EQ(rhs, m_matrix * sol);
+
+    // Without diagonal, the system is solved without preconditioning.
+    solver->set_linear_operator(m_matrix.rows(), op, VectorF());
+    sol = solver->solve(rhs);
+    ASSERT_VECTOR_EQ(rhs, m_matrix * sol);
+
+    SolverPtr amg_solver = SparseSolver::create("PCG_AMG");
+    ASSERT_THROW(amg_solver->set_linear_operator(
+                m_matrix.rows(), op, m_matrix.diagonal()), NotImplementedError);
+
+    SolverPtr direct_solver = SparseSolver::create("LDLT");
+    ASSERT_THROW(direct_solver->set_linear_operator(
+                m_matrix.rows(), op, m_matrix.diagonal()), NotImplementedError);
+}
+
 TEST_F(SparseSolverTest, SparseLU) {
     solve_diagonal_system("SparseLU");
     solve_dense_system("SparseLU");
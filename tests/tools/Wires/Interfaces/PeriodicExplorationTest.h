@@ -11,6 +11,8 @@
 #include <Wires/Interfaces/PeriodicExploration.h>
 #include <BVH/BVHEngine.h>
 
+#include <tbb/global_control.h>
+
 class PeriodicExplorationTest : public WireTest {
     protected:
         void ASSERT_ASSENDING_DIRECTION(const MatrixFr& delta_y, const MatrixFr& grad) {
@@ -589,3 +591,61 @@ TEST_F(PeriodicExplorationTest, shape_velocity) {
     save_mesh("shape_velocity_compare_normal.msh", normal_mesh,
             normal_mesh->get_attribute_names());
 }
+
+TEST_F(PeriodicExplorationTest, batch_inflate) {
+    PeriodicExploration explorer(
+            m_data_dir + "brick5.wire", 5, 0.5);
+    explorer.with_all_isotropic_parameters();
+    explorer.with_refinement("simple", 1);
+
+    const VectorF dofs = explorer.get_dofs();
+    const size_t num_dofs = explorer.get_num_dofs();
+    const size_t num_samples = 8;
+    MatrixFr samples(num_samples, num_dofs);
+    for (size_t i=0; i<num_samples; i++) {
+        for (size_t j=0; j<num_dofs; j++) {
+            if (explorer.is_thickness_dof(j)) {
+                samples(i, j) = dofs[j] * (1.0 + i * 0.05);
+            } else {
+                samples(i, j) = dofs[j];
+            }
+        }
+    }
+
+    // Force several workers even on single core machines so that concurrent
+    // inflation, Triangle and TetGen calls are actually exercised.
+    std::vector<bool> success;
+    std::vector<Mesh::Ptr> meshes;
+    {
+        tbb::global_control control(
+                tbb::global_control::max_allowed_parallelism, 4);
+        meshes = explorer.batch_inflate(samples, success);
+    }
+    ASSERT_EQ(num_samples, meshes.size());
+    ASSERT_EQ(num_samples, success.size());
+
+    // Batch inflation must not alter the explorer state.
+    ASSERT_FLOAT_EQ(0.0, (dofs - explorer.get_dofs()).norm());
+
+    for (size_t i=0; i<num_samples; i++) {
+        explorer.set_dofs(samples.row(i).transpose());
+        explorer.periodic_inflate();
+        const bool tetgen_success = explorer.run_tetgen();
+#if WITH_TETGEN
+        ASSERT_TRUE(tetgen_success);
+#endif
+        ASSERT_EQ(tetgen_success, success[i]);
+        ASSERT_TRUE(bool(meshes[i]));
+
+        Mesh::Ptr mesh = explorer.get_mesh();
+        ASSERT_EQ(mesh->get_num_vertices(), meshes[i]->get_num_vertices());
+        ASSERT_EQ(mesh->get_num_faces(), meshes[i]->get_num_faces());
+        ASSERT_EQ(mesh->get_num_voxels(), meshes[i]->get_num_voxels());
+        ASSERT_FLOAT_EQ(0.0,
+                (mesh->get_vertices() - meshes[i]->get_vertices()).norm());
+        ASSERT_TRUE((mesh->get_faces().array() ==
+                    meshes[i]->get_faces().array()).all());
+        ASSERT_TRUE((mesh->get_voxels().array() ==
+                    meshes[i]->get_voxels().array()).all());
+    }
+}
@@ -0,0 +1,149 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <set>
+#include <utility>
+
+#include <Core/EigenTypedef.h>
+#include <Math/MatrixUtils.h>
+#include <TestBase.h>
+
+#include <Wires/Misc/BoxClipper.h>
+
+class BoxClipperTest : public TestBase {
+    protected:
+        void load_cube(MatrixFr& vertices, MatrixIr& faces) {
+            MeshPtr mesh = load_mesh("cube.obj");
+            vertices = MatrixUtils::reshape<MatrixFr>(
+                    mesh->get_vertices(),
+                    mesh->get_num_vertices(),
+                    mesh->get_dim());
+            faces = MatrixUtils::reshape<MatrixIr>(
+                    mesh->get_faces(),
+                    mesh->get_num_faces(),
+                    mesh->get_vertex_per_face());
+        }
+
+        void ASSERT_WATERTIGHT(const MatrixIr& faces) {
+            std::set<std::pair<int, int> > edges;
+            const size_t num_faces = faces.rows();
+            for (size_t i=0; i<num_faces; i++) {
+                for (size_t j=0; j<3; j++) {
+                    auto e = std::make_pair(faces(i,j), faces(i,(j+1)%3));
+                    ASSERT_TRUE(edges.insert(e).second);
+                }
+            }
+            for (const auto& e : edges) {
+                ASSERT_EQ(1, edges.count({e.second, e.first}));
+            }
+        }
+
+        Float compute_volume(const MatrixFr& vertices, const MatrixIr& faces) {
+            Float volume = 0.0;
+            const size_t num_faces = faces.rows();
+            for (size_t i=0; i<num_faces; i++) {
+                const Vector3F& v0 = vertices.row(faces(i,0));
+                const Vector3F& v1 = vertices.row(faces(i,1));
+                const Vector3F& v2 = vertices.row(faces(i,2));
+                volume += v0.dot(v1.cross(v2)) / 6.0;
+            }
+            return volume;
+        }
+
+        void ASSERT_INSIDE_BOX(const MatrixFr& vertices,
+                const VectorF& bbox_min, const VectorF& bbox_max) {
+            VectorF v_min = vertices.colwise().minCoeff();
+            VectorF v_max = vertices.colwise().maxCoeff();
+            ASSERT_TRUE((v_min.array() >= bbox_min.array()).all());
+            ASSERT_TRUE((v_max.array() <= bbox_max.array()).all());
+        }
+};
+
+TEST_F(BoxClipperTest, no_clipping) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    load_cube(vertices, faces);
+
+    BoxClipper clipper(Vector3F(-2, -2, -2), Vector3F(2, 2, 2));
+    clipper.run(vertices, faces);
+
+    MatrixIr clipped_faces = clipper.get_faces();
+    VectorI face_sources = clipper.get_face_sources();
+    ASSERT_EQ(faces.rows(), clipped_faces.rows());
+    for (size_t i=0; i<face_sources.size(); i++) {
+        ASSERT_EQ(i, face_sources[i]);
+    }
+}
+
+TEST_F(BoxClipperTest, slab) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    load_cube(vertices, faces);
+
+    Vector3F bbox_min(-0.5, -2.0, -2.0);
+    Vector3F bbox_max( 0.5,  2.0,  2.0);
+    BoxClipper clipper(bbox_min, bbox_max);
+    clipper.run(vertices, faces);
+
+    MatrixFr clipped_vertices = clipper.get_vertices();
+    MatrixIr clipped_faces = clipper.get_faces();
+    ASSERT_WATERTIGHT(clipped_faces);
+    ASSERT_INSIDE_BOX(clipped_vertices, bbox_min, bbox_max);
+    ASSERT_NEAR(4.0, compute_volume(clipped_vertices, clipped_faces), 1e-12);
+}
+
+TEST_F(BoxClipperTest, corner) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    load_cube(vertices, faces);
+
+    Vector3F bbox_min(0.0, 0.0, 0.0);
+    Vector3F bbox_max(2.0, 2.0, 2.0);
+    BoxClipper clipper(bbox_min, bbox_max);
+    clipper.run(vertices, faces);
+
+    MatrixFr clipped_vertices = clipper.get_vertices();
+    MatrixIr clipped_faces = clipper.get_faces();
+    ASSERT_WATERTIGHT(clipped_faces);
+    ASSERT_INSIDE_BOX(clipped_vertices, bbox_min, bbox_max);
+    ASSERT_NEAR(1.0, compute_volume(clipped_vertices, clipped_faces), 1e-12);
+}
+
+TEST_F(BoxClipperTest, face_sources) {
+    MatrixFr vertices;
+    MatrixIr faces;
+    load_cube(vertices, faces);
+
+    Vector3F bbox_min(-0.5, -0.5, -2.0);
+    Vector3F bbox_max( 0.5,  2.0,  0.5);
+    BoxClipper clipper(bbox_min, bbox_max);
+    clipper.run(vertices, faces);
+
+    MatrixFr clipped_vertices = clipper.get_vertices();
+    MatrixIr clipped_faces = clipper.get_faces();
+    VectorI face_sources = clipper.get_face_sources();
+    ASSERT_EQ(clipped_faces.rows(), face_sources.size());
+
+    const size_t num_faces = clipped_faces.rows();
+    for (size_t i=0; i<num_faces; i++) {
+        const Vector3F& v0 = clipped_vertices.row(clipped_faces(i,0));
+        const Vector3F& v1 = clipped_vertices.row(clipped_faces(i,1));
+        const Vector3F& v2 = clipped_vertices.row(clipped_faces(i,2));
+        const Vector3F n = (v1-v0).cross(v2-v0).normalized();
+        if (face_sources[i] < 0) {
+            // Cap faces lie on the box.
+            const Vector3F c = (v0 + v1 + v2) / 3.0;
+            ASSERT_TRUE(
+                    (c - bbox_min).cwiseAbs().minCoeff() < 1e-12 ||
+                    (c - bbox_max).cwiseAbs().minCoeff() < 1e-12);
+        } else {
+            const Vector3I& f = faces.row(face_sources[i]);
+            const Vector3F& u0 = vertices.row(f[0]);
+            const Vector3F& u1 = vertices.row(f[1]);
+            const Vector3F& u2 = vertices.row(f[2]);
+            const Vector3F m = (u1-u0).cross(u2-u0).normalized();
+            ASSERT_NEAR(1.0, n.dot(m), 1e-12);
+            ASSERT_NEAR(0.0, (v0 - u0).dot(m), 1e-12);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
+#include <Wires/Parameters/Formula.h>
+
+using namespace PyMesh;
+
+class FormulaTest : public ::testing::Test {
+    protected:
+        Float eval(const std::string& expr) {
+            Formula formula(expr);
+            Formula::Variables vars;
+            return formula.evaluate(vars);
+        }
+};
+
+TEST_F(FormulaTest, Empty) {
+    Formula formula;
+    ASSERT_TRUE(formula.is_empty());
+    ASSERT_THROW(formula.evaluate(Formula::Variables()), RuntimeError);
+}
+
+TEST_F(FormulaTest, Arithmetic) {
+    ASSERT_FLOAT_EQ(7.0, eval("1 + 2 * 3"));
+    ASSERT_FLOAT_EQ(9.0, eval("(1 + 2) * 3"));
+    ASSERT_FLOAT_EQ(0.5, eval("1 / 2"));
+    ASSERT_FLOAT_EQ(-1.0, eval("2 - 3"));
+    ASSERT_FLOAT_EQ(1.0, eval("-(-1)"));
+    ASSERT_FLOAT_EQ(1.5e-3, eval("1.5e-3"));
+}
+
+TEST_F(FormulaTest, Power) {
+    ASSERT_FLOAT_EQ(512.0, eval("2^3^2"));
+    ASSERT_FLOAT_EQ(-4.0, eval("-2^2"));
+    ASSERT_FLOAT_EQ(0.25, eval("2^-2"));
+    ASSERT_FLOAT_EQ(8.0, eval("pow(2, 3)"));
+}
+
+TEST_F(FormulaTest, Functions) {
+    ASSERT_NEAR(0.0, eval("sin(pi)"), 1e-12);
+    ASSERT_FLOAT_EQ(-1.0, eval("cos(pi)"));
+    ASSERT_FLOAT_EQ(3.0, eval("sqrt(9)"));
+    ASSERT_FLOAT_EQ(2.0, eval("abs(-2)"));
+    ASSERT_FLOAT_EQ(1.0, eval("min(1, 2)"));
+    ASSERT_FLOAT_EQ(2.0, eval("max(1, 2)"));
+    ASSERT_FLOAT_EQ(0.5, eval("clamp(0.7, 0.1, 0.5)"));
+    ASSERT_FLOAT_EQ(M_PI / 4, eval("atan2(1, 1)"));
+}
+
+TEST_F(FormulaTest, Variables) {
+    Formula formula("0.5 + 0.1 * sin(2 * pi * x) * y");
+    const auto& names = formula.get_variable_names();
+    ASSERT_EQ(2, names.size());
+    ASSERT_EQ("x", names[0]);
+    ASSERT_EQ("y", names[1]);
+
+    Formula::Variables vars;
+    vars["x"] = 0.25;
+    vars["y"] = 2.0;
+    ASSERT_FLOAT_EQ(0.7, formula.evaluate(vars));
+
+    vars.erase("y");
+    ASSERT_THROW(formula.evaluate(vars), RuntimeError);
+}
+
+TEST_F(FormulaTest, SingleVariable) {
+    Formula formula("thickness");
+    Formula::Variables vars;
+    vars["thickness"] = 0.3;
+    ASSERT_FLOAT_EQ(0.3, formula.evaluate(vars));
+}
+
+TEST_F(FormulaTest, InvalidSyntax) {
+    ASSERT_THROW(Formula("1 +"), RuntimeError);
+    ASSERT_THROW(Formula("(1 + 2"), RuntimeError);
+    ASSERT_THROW(Formula("1 2"), RuntimeError);
+    ASSERT_THROW(Formula("foo(1)"), RuntimeError);
+    ASSERT_THROW(Formula("min(1)"), RuntimeError);
+    ASSERT_THROW(Formula("x $ y"), RuntimeError);
+}
+
+TEST_F(FormulaTest, Batch) {
+    Formula formula("x + 10 * y");
+    std::vector<std::string> names = {"y", "z", "x"};
+    const size_t num_rows = 1000;
+    MatrixFr values(num_rows, 3);
+    for (size_t i=0; i<num_rows; i++) {
+        values.row(i) << Float(i), -1.0, 0.5;
+    }
+
+    VectorF results = formula.evaluate_batch(names, values);
+    ASSERT_EQ(num_rows, results.size());
+    for (size_t i=0; i<num_rows; i++) {
+        ASSERT_FLOAT_EQ(0.5 + 10.0 * i, results[i]);
+    }
+
+    names[0] = "w";
+    ASSERT_THROW(formula.evaluate_batch(names, values), RuntimeError);
+}
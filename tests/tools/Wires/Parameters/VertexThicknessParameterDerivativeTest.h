@@ -61,3 +61,33 @@ TEST_F(VertexThicknessParameterDerivativeTest, brick5) {
 
     ASSERT_NE(0.0, flattened_derivative.norm());
 }
+
+TEST_F(VertexThicknessParameterDerivativeTest, velocity_tensor) {
+    WireNetwork::Ptr wire_network = load_wire_shared("brick5.wire");
+    wire_network->scale(Vector3F::Ones() * 2.5);
+    VectorI roi_0(4), roi_1(4);
+    roi_0 << 0, 1, 2, 3;
+    roi_1 << 4, 5, 6, 7;
+
+    ParameterManager::Ptr manager = ParameterManager::create_empty_manager(wire_network);
+    manager->set_thickness_type(ParameterCommon::VERTEX);
+    manager->add_thickness_parameter(roi_0, "", 1.5);
+    manager->add_thickness_parameter(roi_1, "", 1.0);
+
+    Mesh::Ptr mesh = inflate(wire_network, manager);
+    const size_t num_vertices = mesh->get_num_vertices();
+    const size_t dim = mesh->get_dim();
+
+    MatrixFr tensor = manager->compute_shape_velocity_tensor(mesh);
+    ASSERT_EQ(2 * num_vertices, tensor.rows());
+    ASSERT_EQ(dim, tensor.cols());
+
+    size_t count = 0;
+    for (auto param : manager->get_thickness_params()) {
+        VertexThicknessParameterDerivative derivative(mesh, param);
+        MatrixFr velocity = derivative.compute();
+        ASSERT_FLOAT_EQ(0.0, (velocity -
+                    tensor.block(count*num_vertices, 0, num_vertices, dim)).norm());
+        count++;
+    }
+}
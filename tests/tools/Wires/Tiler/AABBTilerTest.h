@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <set>
 
 #include <WireTest.h>
 #include <Wires/Tiler/AABBTiler.h>
@@ -164,6 +165,43 @@ class AABBTilerTest : public WireTest {
             check_edge_attribute_propagation("edge_periodic_index", *wire_network, *tiled_network);
         }
 
+        void run_unique_vertex_check(const std::string& wire_file) {
+            WireNetwork::Ptr wire_network = load_wire_shared(wire_file);
+            wire_network->center_at_origin();
+
+            const size_t dim = wire_network->get_dim();
+            VectorF bbox_min = VectorF::Zero(dim);
+            VectorF bbox_max = VectorF::Ones(dim)*4;
+            VectorI repetitions = VectorI::Ones(dim)*4;
+
+            AABBTiler tiler(wire_network, bbox_min, bbox_max, repetitions);
+            WireNetwork::Ptr tiled_network = tiler.tile();
+            ASSERT_VALID_EDGES(*tiled_network);
+            ASSERT_BBOX_SIZE(*tiled_network, bbox_max - bbox_min);
+
+            const MatrixFr& vertices = tiled_network->get_vertices();
+            const size_t num_vertices = vertices.rows();
+            HashGrid::Ptr grid = HashGrid::create(1e-6, dim);
+            for (size_t i=0; i<num_vertices; i++) {
+                const VectorF& v = vertices.row(i);
+                grid->insert(i, v);
+            }
+            for (size_t i=0; i<num_vertices; i++) {
+                const VectorF& v = vertices.row(i);
+                ASSERT_EQ(1, grid->get_items_near_point(v).size());
+            }
+
+            std::set<std::pair<int, int> > edge_set;
+            const MatrixIr& edges = tiled_network->get_edges();
+            const size_t num_edges = edges.rows();
+            for (size_t i=0; i<num_edges; i++) {
+                edge_set.insert(std::make_pair(
+                            std::min(edges(i,0), edges(i,1)),
+                            std::max(edges(i,0), edges(i,1))));
+            }
+            ASSERT_EQ(num_edges, edge_set.size());
+        }
+
         void run_min_angle_check(const std::string& wire_file) {
             WireNetwork::Ptr wire_network = load_wire_shared(wire_file);
             wire_network->compute_connectivity();
@@ -236,3 +274,11 @@ TEST_F(AABBTilerTest, EdgeAttributes) {
 TEST_F(AABBTilerTest, postive_min_angles) {
     run_min_angle_check("truncated_octahedron_s1.wire");
 }
+
+TEST_F(AABBTilerTest, shared_boundary_vertices) {
+    run_unique_vertex_check("square.wire");
+    run_unique_vertex_check("cube.wire");
+    run_unique_vertex_check("brick5.wire");
+    run_unique_vertex_check("diamond.wire");
+    run_unique_vertex_check("truncated_octahedron_s1.wire");
+}
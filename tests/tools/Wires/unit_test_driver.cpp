@@ -20,11 +20,13 @@
 #include "Interfaces/PeriodicExplorationTest.h"
 #include "Misc/BilinearInterpolationTest.h"
 #include "Misc/BoundaryRemesherTest.h"
+#include "Misc/BoxClipperTest.h"
 #include "Misc/BoxCheckerTest.h"
 #include "Misc/DistanceComputationTest.h"
 #include "Misc/SymmetryCheckerTest.h"
 #include "Misc/SymmetryOperatorsTest.h"
 #include "Misc/TrilinearInterpolationTest.h"
+#include "Parameters/FormulaTest.h"
 #include "Parameters/IsotropicDofExtractorTest.h"
 #include "Parameters/IsotropicTransformsTest.h"
 #include "Parameters/ThicknessParametersTest.h"
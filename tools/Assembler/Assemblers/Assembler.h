@@ -4,6 +4,8 @@
 #include <memory>
 
 #include <Assembler/FESetting/FESetting.h>
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
 #include <Math/ZSparseMatrix.h>
 
 namespace PyMesh {
@@ -16,6 +18,19 @@ class Assembler {
         static Ptr create(const std::string& matrix_name);
 
         virtual ZSparseMatrix assemble(FESettingPtr setting)=0;
+
+        /**
+         * Matrix-free y = A x, where A is the matrix assemble() would
+         * produce.
+         */
+        virtual void apply(FESettingPtr setting, const VectorF& x, VectorF& y) {
+            throw NotImplementedError(
+                    "Matrix-free application is not supported for this matrix");
+        }
+
+        virtual VectorF assemble_diagonal(FESettingPtr setting) {
+            return assemble(setting).diagonal();
+        }
 };
 
 }
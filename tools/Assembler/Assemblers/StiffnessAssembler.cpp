@@ -4,7 +4,10 @@
 #include <iostream>
 #include <vector>
 
+#include <tbb/tbb.h>
+
 #include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
 
 //#include <Assembler/Mesh/FEMeshAdaptor.h>
 #include <Assembler/ShapeFunctions/FEBasis.h>
@@ -54,3 +57,77 @@ ZSparseMatrix StiffnessAssembler::assemble(FESettingPtr setting) {
 
     return K;
 }
+
+void StiffnessAssembler::apply(FESettingPtr setting,
+        const VectorF& x, VectorF& y) {
+    typedef FESetting::FEMeshPtr FEMeshPtr;
+    typedef FESetting::FEBasisPtr FEBasisPtr;
+    typedef FESetting::MaterialPtr MaterialPtr;
+
+    FEMeshPtr mesh = setting->get_mesh();
+    FEBasisPtr basis = setting->get_basis();
+    MaterialPtr material = setting->get_material();
+
+    const size_t dim = mesh->getDim();
+    const size_t num_nodes = mesh->getNbrNodes();
+    const size_t num_elements = mesh->getNbrElements();
+    const size_t nodes_per_element = mesh->getNodePerElement();
+    if (size_t(x.size()) != num_nodes * dim) {
+        throw RuntimeError("Input vector size does not match stiffness matrix");
+    }
+
+    // Each thread accumulates into its own copy of y.
+    tbb::combinable<VectorF> partial_results([&]() {
+            return VectorF::Zero(num_nodes * dim).eval(); });
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_elements),
+            [&](const tbb::blocked_range<size_t>& r) {
+                VectorF& result = partial_results.local();
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const VectorI elem = mesh->getElement(i);
+                    VectorF coord = mesh->getElementCenter(i);
+                    Float density = material->get_density(coord);
+
+                    for (size_t j=0; j<nodes_per_element; j++) {
+                        for (size_t k=0; k<nodes_per_element; k++) {
+                            MatrixF coeff = basis->integrate_material_contraction(
+                                    i, j, k, material);
+                            result.segment(elem[j]*dim, dim) += density *
+                                coeff * x.segment(elem[k]*dim, dim);
+                        }
+                    }
+                }
+            });
+
+    y = VectorF::Zero(num_nodes * dim);
+    partial_results.combine_each([&](const VectorF& result) { y += result; });
+}
+
+VectorF StiffnessAssembler::assemble_diagonal(FESettingPtr setting) {
+    typedef FESetting::FEMeshPtr FEMeshPtr;
+    typedef FESetting::FEBasisPtr FEBasisPtr;
+    typedef FESetting::MaterialPtr MaterialPtr;
+
+    FEMeshPtr mesh = setting->get_mesh();
+    FEBasisPtr basis = setting->get_basis();
+    MaterialPtr material = setting->get_material();
+
+    const size_t dim = mesh->getDim();
+    const size_t num_nodes = mesh->getNbrNodes();
+    const size_t num_elements = mesh->getNbrElements();
+    const size_t nodes_per_element = mesh->getNodePerElement();
+
+    VectorF diagonal = VectorF::Zero(num_nodes * dim);
+    for (size_t i=0; i<num_elements; i++) {
+        const VectorI elem = mesh->getElement(i);
+        VectorF coord = mesh->getElementCenter(i);
+        Float density = material->get_density(coord);
+
+        for (size_t j=0; j<nodes_per_element; j++) {
+            MatrixF coeff = basis->integrate_material_contraction(
+                    i, j, j, material);
+            diagonal.segment(elem[j]*dim, dim) +=
+                density * coeff.diagonal();
+        }
+    }
+    return diagonal;
+}
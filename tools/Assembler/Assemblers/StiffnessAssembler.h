@@ -7,6 +7,14 @@ namespace PyMesh {
 class StiffnessAssembler : public Assembler {
     public:
         virtual ZSparseMatrix assemble(FESettingPtr setting);
+
+        /**
+         * Element by element y = K x.  Local stiffness blocks are
+         * recomputed on every call, so the memory footprint is independent
+         * of the number of non-zeros in K.
+         */
+        virtual void apply(FESettingPtr setting, const VectorF& x, VectorF& y);
+        virtual VectorF assemble_diagonal(FESettingPtr setting);
 };
 
 }
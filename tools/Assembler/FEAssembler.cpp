@@ -32,3 +32,17 @@ ZSparseMatrix FEAssembler::assemble(const std::string& matrix_name) {
     Assembler::Ptr assembler = Assembler::create(matrix_name);
     return assembler->assemble(m_setting);
 }
+
+FEAssembler::LinearOperator FEAssembler::get_linear_operator(
+        const std::string& matrix_name) {
+    Assembler::Ptr assembler = Assembler::create(matrix_name);
+    FESetting::Ptr setting = m_setting;
+    return [assembler, setting](const VectorF& x, VectorF& y) {
+        assembler->apply(setting, x, y);
+    };
+}
+
+VectorF FEAssembler::assemble_diagonal(const std::string& matrix_name) {
+    Assembler::Ptr assembler = Assembler::create(matrix_name);
+    return assembler->assemble_diagonal(m_setting);
+}
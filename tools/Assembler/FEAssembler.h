@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include <Mesh.h>
 
+#include <Core/EigenTypedef.h>
 #include <Math/ZSparseMatrix.h>
 #include <Assembler/Materials/Material.h>
 #include <Assembler/FESetting/FESetting.h>
@@ -11,12 +13,27 @@
 namespace PyMesh {
 
 class FEAssembler {
+    public:
+        /**
+         * Same signature as SparseSolver::LinearOperator.
+         */
+        typedef std::function<void(const VectorF& x, VectorF& y)> LinearOperator;
+
     public:
         static FEAssembler create(Mesh::Ptr mesh, Material::Ptr material);
         static FEAssembler create_from_name(Mesh::Ptr mesh, const std::string& name);
 
     public:
         ZSparseMatrix assemble(const std::string& matrix_name);
+
+        /**
+         * Matrix-free counterpart of assemble(), for use with
+         * SparseSolver::set_linear_operator().  Only "stiffness" is
+         * supported.
+         */
+        LinearOperator get_linear_operator(const std::string& matrix_name);
+        VectorF assemble_diagonal(const std::string& matrix_name);
+
         void set_material(Material::Ptr material) {
             m_setting->set_material(material);
         }
@@ -0,0 +1,316 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "AttributeTransfer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <unordered_set>
+
+#include <tbb/tbb.h>
+
+#include <Core/Exception.h>
+
+using namespace PyMesh;
+
+namespace AttributeTransferHelper {
+    /**
+     * Number of query points per closest point lookup.  This bounds the
+     * size of the temporary lookup results.
+     */
+    const size_t CHUNK_SIZE = 1 << 18;
+
+    template<typename T>
+    T convert(Float value);
+
+    template<>
+    Float convert<Float>(Float value) { return value; }
+
+    template<>
+    int convert<int>(Float value) { return int(std::round(value)); }
+
+    /**
+     * dst[c] = sum_j weights[j] * src[j][c] for c in [0, width).
+     */
+    template<typename S, typename D>
+    void interpolate(const S* const src[3], const Float weights[3],
+            size_t width, D* dst) {
+        for (size_t c=0; c<width; c++) {
+            const Float value =
+                src[0][c] * weights[0] +
+                src[1][c] * weights[1] +
+                src[2][c] * weights[2];
+            dst[c] = convert<D>(value);
+        }
+    }
+
+    /**
+     * Each target attribute is resized while the channels are set up, so a
+     * name listed twice would leave a dangling pointer in an earlier channel.
+     */
+    void check_unique_names(
+            const std::vector<const AttributeTransfer::Names*>& name_lists) {
+        std::unordered_set<std::string> visited;
+        for (const auto names : name_lists) {
+            for (const auto& name : *names) {
+                if (!visited.insert(name).second) {
+                    throw RuntimeError("Attribute \"" + name +
+                            "\" is listed more than once");
+                }
+            }
+        }
+    }
+}
+using namespace AttributeTransferHelper;
+
+AttributeTransfer::AttributeTransfer(Mesh::Ptr source, BVHEngine::Ptr bvh)
+    : m_source(source), m_bvh(bvh), m_dim(source->get_dim()) {
+    if (m_source->get_vertex_per_face() != 3) {
+        throw NotImplementedError(
+                "Attribute transfer only supports triangle source mesh");
+    }
+    if (!m_bvh) {
+        const size_t num_vertices = m_source->get_num_vertices();
+        const size_t num_faces = m_source->get_num_faces();
+        const MatrixFr vertices = Eigen::Map<const MatrixFr>(
+                m_source->get_vertices().data(), num_vertices, m_dim);
+        const MatrixIr faces = Eigen::Map<const MatrixIr>(
+                m_source->get_faces().data(), num_faces, 3);
+
+        m_bvh = BVHEngine::create("auto", m_dim);
+        m_bvh->set_mesh(vertices, faces);
+        m_bvh->build();
+    }
+}
+
+void AttributeTransfer::transfer(Mesh::Ptr target,
+        const Names& vertex_attributes,
+        const Names& face_attributes,
+        const Names& corner_attributes) {
+    const size_t dim = m_dim;
+    if (target->get_dim() != dim) {
+        throw RuntimeError("Source and target mesh dimension mismatch");
+    }
+    if (target == m_source) {
+        throw RuntimeError("Source and target mesh must be different");
+    }
+    check_unique_names({&vertex_attributes, &face_attributes,
+            &corner_attributes});
+    const bool has_corner_attributes = !corner_attributes.empty();
+    if (has_corner_attributes && target->get_vertex_per_face() != 3) {
+        throw NotImplementedError(
+                "Corner attribute transfer only supports triangle target mesh");
+    }
+
+    const VectorF& target_vertices = target->get_vertices();
+    const VectorI& target_faces = target->get_faces();
+    const size_t num_target_vertices = target->get_num_vertices();
+    const size_t num_target_faces = target->get_num_faces();
+    const size_t target_vertex_per_face = target->get_vertex_per_face();
+
+    const auto vertex_channels = init_channels(target, vertex_attributes,
+            m_source->get_num_vertices(), num_target_vertices);
+    const auto face_channels = init_channels(target, face_attributes,
+            m_source->get_num_faces(), num_target_faces);
+    const auto corner_channels = init_channels(target, corner_attributes,
+            m_source->get_num_faces() * 3, num_target_faces * 3);
+
+    const VectorI& source_faces = m_source->get_faces();
+    VectorI closest_faces;
+    MatrixFr closest_points;
+
+    // Vertex pass: interpolate vertex attributes and record closest points
+    // of target vertices for the corner attributes.
+    MatrixFr vertex_closest_points;
+    if (has_corner_attributes) {
+        vertex_closest_points.resize(num_target_vertices, dim);
+    }
+    if (!vertex_channels.empty() || has_corner_attributes) {
+        for (size_t begin=0; begin<num_target_vertices; begin+=CHUNK_SIZE) {
+            const size_t n = std::min(CHUNK_SIZE, num_target_vertices-begin);
+            const MatrixFr queries = Eigen::Map<const MatrixFr>(
+                    target_vertices.data() + begin*dim, n, dim);
+            lookup(queries, closest_faces, closest_points);
+
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                        Float weights[3];
+                        for (size_t i=r.begin(); i!=r.end(); i++) {
+                            const int fi = closest_faces[i];
+                            const int* f = source_faces.data() + fi*3;
+                            compute_weights(fi, closest_points.row(i).data(),
+                                    weights);
+                            for (const auto& ch : vertex_channels) {
+                                const size_t w = ch.width;
+                                const size_t vi = begin + i;
+                                if (ch.src_f != nullptr) {
+                                    const Float* src[3] = {
+                                        ch.src_f + f[0]*w,
+                                        ch.src_f + f[1]*w,
+                                        ch.src_f + f[2]*w };
+                                    interpolate(src, weights, w, ch.dst_f + vi*w);
+                                } else {
+                                    const int* src[3] = {
+                                        ch.src_i + f[0]*w,
+                                        ch.src_i + f[1]*w,
+                                        ch.src_i + f[2]*w };
+                                    interpolate(src, weights, w, ch.dst_i + vi*w);
+                                }
+                            }
+                            if (has_corner_attributes) {
+                                vertex_closest_points.row(begin+i) =
+                                    closest_points.row(i);
+                            }
+                        }
+                    });
+        }
+    }
+
+    // Face pass: lookup target face centroids.
+    if (face_channels.empty() && corner_channels.empty()) return;
+    for (size_t begin=0; begin<num_target_faces; begin+=CHUNK_SIZE) {
+        const size_t n = std::min(CHUNK_SIZE, num_target_faces-begin);
+        MatrixFr queries(n, dim);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const int* f = target_faces.data() +
+                            (begin+i)*target_vertex_per_face;
+                        queries.row(i).setZero();
+                        for (size_t j=0; j<target_vertex_per_face; j++) {
+                            queries.row(i) += Eigen::Map<const VectorF>(
+                                    target_vertices.data() + f[j]*dim,
+                                    dim).transpose();
+                        }
+                        queries.row(i) /= Float(target_vertex_per_face);
+                    }
+                });
+        lookup(queries, closest_faces, closest_points);
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    Float weights[3];
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const int fi = closest_faces[i];
+                        const size_t ti = begin + i;
+                        for (const auto& ch : face_channels) {
+                            const size_t w = ch.width;
+                            if (ch.src_f != nullptr) {
+                                std::copy(ch.src_f + fi*w, ch.src_f + (fi+1)*w,
+                                        ch.dst_f + ti*w);
+                            } else {
+                                std::copy(ch.src_i + fi*w, ch.src_i + (fi+1)*w,
+                                        ch.dst_i + ti*w);
+                            }
+                        }
+
+                        if (!has_corner_attributes) continue;
+                        const int* f = target_faces.data() + ti*3;
+                        for (size_t k=0; k<3; k++) {
+                            compute_weights(fi,
+                                    vertex_closest_points.row(f[k]).data(),
+                                    weights);
+                            for (const auto& ch : corner_channels) {
+                                const size_t w = ch.width;
+                                const size_t ci = ti*3 + k;
+                                if (ch.src_f != nullptr) {
+                                    const Float* src[3] = {
+                                        ch.src_f + (fi*3  )*w,
+                                        ch.src_f + (fi*3+1)*w,
+                                        ch.src_f + (fi*3+2)*w };
+                                    interpolate(src, weights, w, ch.dst_f + ci*w);
+                                } else {
+                                    const int* src[3] = {
+                                        ch.src_i + (fi*3  )*w,
+                                        ch.src_i + (fi*3+1)*w,
+                                        ch.src_i + (fi*3+2)*w };
+                                    interpolate(src, weights, w, ch.dst_i + ci*w);
+                                }
+                            }
+                        }
+                    }
+                });
+    }
+}
+
+std::vector<AttributeTransfer::Channel> AttributeTransfer::init_channels(
+        Mesh::Ptr target, const Names& names,
+        size_t num_src_entries, size_t num_dst_entries) {
+    std::vector<Channel> channels;
+    for (const auto& name : names) {
+        if (!m_source->has_attribute(name)) {
+            throw RuntimeError("Source mesh does not have attribute \""
+                    + name + "\"");
+        }
+        const bool is_float = m_source->has_float_attribute(name);
+        const size_t size = is_float ?
+            m_source->get_float_attribute(name).size() :
+            m_source->get_int_attribute(name).size();
+        if (num_src_entries == 0 || size % num_src_entries != 0) {
+            std::stringstream err_msg;
+            err_msg << "Attribute \"" << name << "\" has " << size
+                << " entries, which is not a multiple of " << num_src_entries;
+            throw RuntimeError(err_msg.str());
+        }
+
+        Channel ch;
+        ch.width = size / num_src_entries;
+        if (is_float) {
+            if (target->has_int_attribute(name)) {
+                target->remove_attribute(name);
+            }
+            if (!target->has_float_attribute(name)) {
+                target->add_empty_float_attribute(name);
+            }
+            VectorF& values = target->get_float_attribute(name);
+            values.resize(num_dst_entries * ch.width);
+            ch.src_f = m_source->get_float_attribute(name).data();
+            ch.dst_f = values.data();
+        } else {
+            if (target->has_float_attribute(name)) {
+                target->remove_attribute(name);
+            }
+            if (!target->has_int_attribute(name)) {
+                target->add_empty_int_attribute(name);
+            }
+            VectorI& values = target->get_int_attribute(name);
+            values.resize(num_dst_entries * ch.width);
+            ch.src_i = m_source->get_int_attribute(name).data();
+            ch.dst_i = values.data();
+        }
+        channels.push_back(ch);
+    }
+    return channels;
+}
+
+void AttributeTransfer::lookup(const MatrixFr& points,
+        VectorI& closest_faces, MatrixFr& closest_points) const {
+    VectorF squared_distances;
+    m_bvh->lookup(points, squared_distances, closest_faces, closest_points);
+}
+
+void AttributeTransfer::compute_weights(int fi, const Float* p,
+        Float* weights) const {
+    const size_t dim = m_dim;
+    const VectorF& vertices = m_source->get_vertices();
+    const int* f = m_source->get_faces().data() + fi*3;
+
+    // The weight of each corner is the area of the opposite sub-triangle.
+    Float areas[3];
+    for (size_t j=0; j<3; j++) {
+        const Float* v1 = vertices.data() + f[(j+1)%3]*dim;
+        const Float* v2 = vertices.data() + f[(j+2)%3]*dim;
+        if (dim == 3) {
+            const Vector3F e1(v1[0]-p[0], v1[1]-p[1], v1[2]-p[2]);
+            const Vector3F e2(v2[0]-p[0], v2[1]-p[1], v2[2]-p[2]);
+            areas[j] = e1.cross(e2).norm();
+        } else {
+            areas[j] = std::abs((v1[0]-p[0]) * (v2[1]-p[1]) -
+                    (v1[1]-p[1]) * (v2[0]-p[0]));
+        }
+    }
+
+    const Float total = areas[0] + areas[1] + areas[2];
+    for (size_t j=0; j<3; j++) {
+        weights[j] = total > 0.0 ? areas[j] / total : 1.0 / 3.0;
+    }
+}
@@ -0,0 +1,91 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Mesh.h>
+#include <Core/EigenTypedef.h>
+
+#include "BVHEngine.h"
+
+namespace PyMesh {
+
+/**
+ * Transfer attributes from a source triangle mesh to a target mesh based on
+ * closest points.
+ *
+ *   - Vertex attributes are interpolated at the closest point of each target
+ *     vertex.
+ *   - Face attributes are copied from the face closest to each target face
+ *     centroid.
+ *   - Corner (per-vertex per-face) attributes are interpolated on the face
+ *     closest to the target face centroid at the closest point of each
+ *     target corner.
+ *
+ * Closest point queries are issued in chunks and every attribute is
+ * interpolated in the same parallel pass over the chunk, writing directly
+ * into the target mesh attributes.  Integer attributes are rounded.
+ */
+class AttributeTransfer {
+    public:
+        typedef std::shared_ptr<AttributeTransfer> Ptr;
+        typedef std::vector<std::string> Names;
+
+        /**
+         * If bvh is not provided, a BVH is built from source with the "auto"
+         * engine.
+         */
+        AttributeTransfer(Mesh::Ptr source, BVHEngine::Ptr bvh=nullptr);
+
+    public:
+        /**
+         * An attribute name may appear at most once across the three lists.
+         */
+        void transfer(Mesh::Ptr target,
+                const Names& vertex_attributes,
+                const Names& face_attributes,
+                const Names& corner_attributes);
+
+        void transfer_vertex_attributes(Mesh::Ptr target, const Names& names) {
+            transfer(target, names, {}, {});
+        }
+
+        void transfer_face_attributes(Mesh::Ptr target, const Names& names) {
+            transfer(target, {}, names, {});
+        }
+
+        void transfer_corner_attributes(Mesh::Ptr target, const Names& names) {
+            transfer(target, {}, {}, names);
+        }
+
+    private:
+        /**
+         * Raw pointers to the source values and destination storage of a
+         * single attribute.  Exactly one of src_f and src_i is set.
+         */
+        struct Channel {
+            const Float* src_f = nullptr;
+            const int* src_i = nullptr;
+            Float* dst_f = nullptr;
+            int* dst_i = nullptr;
+            size_t width = 0;
+        };
+
+        std::vector<Channel> init_channels(Mesh::Ptr target,
+                const Names& names, size_t num_src_entries,
+                size_t num_dst_entries);
+
+        void lookup(const MatrixFr& points,
+                VectorI& closest_faces, MatrixFr& closest_points) const;
+
+        void compute_weights(int fi, const Float* p, Float* weights) const;
+
+    private:
+        Mesh::Ptr m_source;
+        BVHEngine::Ptr m_bvh;
+        size_t m_dim;
+};
+
+}
@@ -29,8 +29,8 @@ class BooleanEngine {
             convert_mesh_to_native_format(MeshSelection::SECOND);
         }
 
-        const MatrixFr get_vertices() const { return m_vertices; }
-        const MatrixIr get_faces() const { return m_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
         void clean_up();
 
     public:
@@ -0,0 +1,56 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#ifdef WITH_IGL_AND_CGAL
+#include "IGLNaryBooleanEngine.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <igl/copyleft/cgal/BinaryWindingNumberOperations.h>
+#include <igl/copyleft/cgal/mesh_boolean.h>
+
+using namespace PyMesh;
+
+void IGLNaryBooleanEngine::run() {
+    const size_t num_meshes = m_vertices_list.size();
+    size_t num_vertices = 0;
+    size_t num_faces = 0;
+    for (size_t i=0; i<num_meshes; i++) {
+        num_vertices += m_vertices_list[i].rows();
+        num_faces += m_faces_list[i].rows();
+    }
+
+    MatrixFr vertices(num_vertices, 3);
+    MatrixIr faces(num_faces, 3);
+    VectorI sizes(num_meshes);
+    size_t vertex_offset = 0;
+    size_t face_offset = 0;
+    for (size_t i=0; i<num_meshes; i++) {
+        const MatrixFr& V = m_vertices_list[i];
+        const MatrixIr& F = m_faces_list[i];
+        vertices.block(vertex_offset, 0, V.rows(), 3) = V;
+        faces.block(face_offset, 0, F.rows(), 3) =
+            F.array() + int(vertex_offset);
+        sizes[i] = F.rows();
+        vertex_offset += V.rows();
+        face_offset += F.rows();
+    }
+
+    const std::function<int(const Eigen::Matrix<int, 1, Eigen::Dynamic>)>
+        wind_num_op = [this](const Eigen::Matrix<int, 1, Eigen::Dynamic> w) {
+            return is_inside(w.data()) ? 1 : 0;
+        };
+    const std::function<int(const int, const int)> keep =
+        igl::copyleft::cgal::KeepInside();
+
+    MatrixEr exact_vertices;
+    igl::copyleft::cgal::mesh_boolean(vertices, faces, sizes,
+            wind_num_op, keep, exact_vertices, m_faces, m_face_sources);
+
+    m_vertices.resize(exact_vertices.rows(), exact_vertices.cols());
+    std::transform(exact_vertices.data(),
+            exact_vertices.data() + exact_vertices.size(),
+            m_vertices.data(), [](const MatrixEr::Scalar& val)
+            { return CGAL::to_double(val); });
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+#ifdef WITH_IGL_AND_CGAL
+
+#include <Boolean/NaryBooleanEngine.h>
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+
+namespace PyMesh {
+
+/**
+ * N-ary boolean based on libigl's mesh arrangement: the intersections of
+ * all operands are resolved once with exact arithmetic, and the winding
+ * number of every operand is propagated over the cells.
+ */
+class IGLNaryBooleanEngine : public NaryBooleanEngine {
+    public:
+        virtual ~IGLNaryBooleanEngine() = default;
+
+    public:
+        typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
+        typedef Eigen::Matrix<
+            Kernel::FT,
+            Eigen::Dynamic,
+            Eigen::Dynamic,
+            Eigen::RowMajor> MatrixEr;
+
+    protected:
+        virtual void run() override;
+};
+
+}
+
+#endif
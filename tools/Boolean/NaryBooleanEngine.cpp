@@ -0,0 +1,242 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "NaryBooleanEngine.h"
+
+#ifdef WITH_IGL_AND_CGAL
+#include "IGL/IGLNaryBooleanEngine.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+using namespace PyMesh;
+
+namespace NaryBooleanEngineHelper {
+    enum Operator {
+        UNION = -1,
+        INTERSECTION = -2,
+        DIFFERENCE = -3,
+        SYMMETRIC_DIFFERENCE = -4
+    };
+
+    /**
+     * Recursive descent parser producing postfix code.
+     *   expr   := term (('|' | '-' | '^') term)*
+     *   term   := factor ('&' factor)*
+     *   factor := INDEX | '(' expr ')'
+     */
+    class ExpressionParser {
+        public:
+            ExpressionParser(const std::string& expression)
+                : m_expr(expression), m_pos(0) {}
+
+            std::vector<int> parse() {
+                std::vector<int> code;
+                parse_expr(code);
+                skip_spaces();
+                if (m_pos != m_expr.size()) {
+                    error("Unexpected character");
+                }
+                return code;
+            }
+
+        private:
+            void parse_expr(std::vector<int>& code) {
+                parse_term(code);
+                while (true) {
+                    skip_spaces();
+                    if (m_pos >= m_expr.size()) return;
+                    const char c = m_expr[m_pos];
+                    int op;
+                    if (c == '|') op = UNION;
+                    else if (c == '-') op = DIFFERENCE;
+                    else if (c == '^') op = SYMMETRIC_DIFFERENCE;
+                    else return;
+                    m_pos++;
+                    parse_term(code);
+                    code.push_back(op);
+                }
+            }
+
+            void parse_term(std::vector<int>& code) {
+                parse_factor(code);
+                while (true) {
+                    skip_spaces();
+                    if (m_pos >= m_expr.size() || m_expr[m_pos] != '&') return;
+                    m_pos++;
+                    parse_factor(code);
+                    code.push_back(INTERSECTION);
+                }
+            }
+
+            void parse_factor(std::vector<int>& code) {
+                skip_spaces();
+                if (m_pos >= m_expr.size()) {
+                    error("Unexpected end of expression");
+                }
+                if (m_expr[m_pos] == '(') {
+                    m_pos++;
+                    parse_expr(code);
+                    skip_spaces();
+                    if (m_pos >= m_expr.size() || m_expr[m_pos] != ')') {
+                        error("Missing \")\"");
+                    }
+                    m_pos++;
+                } else if (std::isdigit(m_expr[m_pos])) {
+                    int index = 0;
+                    while (m_pos < m_expr.size() && std::isdigit(m_expr[m_pos])) {
+                        index = index * 10 + (m_expr[m_pos] - '0');
+                        m_pos++;
+                    }
+                    code.push_back(index);
+                } else {
+                    error("Expecting operand index or \"(\"");
+                }
+            }
+
+            void skip_spaces() {
+                while (m_pos < m_expr.size() && std::isspace(m_expr[m_pos])) {
+                    m_pos++;
+                }
+            }
+
+            void error(const std::string& msg) const {
+                std::stringstream err_msg;
+                err_msg << msg << " at position " << m_pos
+                    << " of boolean expression \"" << m_expr << "\"";
+                throw RuntimeError(err_msg.str());
+            }
+
+        private:
+            const std::string& m_expr;
+            size_t m_pos;
+    };
+
+    std::vector<int> nary_program(size_t num_operands, int op) {
+        std::vector<int> code;
+        for (size_t i=0; i<num_operands; i++) {
+            code.push_back(i);
+            if (i > 0) code.push_back(op);
+        }
+        return code;
+    }
+}
+using namespace NaryBooleanEngineHelper;
+
+NaryBooleanEngine::Ptr NaryBooleanEngine::create(
+        const std::string& engine_name) {
+#ifdef WITH_IGL_AND_CGAL
+    if (engine_name == "auto" || engine_name == "igl") {
+        return Ptr(new IGLNaryBooleanEngine());
+    }
+#endif
+    std::stringstream err_msg;
+    err_msg << "N-ary boolean engine \"" << engine_name
+        << "\" is not supported.";
+    throw NotImplementedError(err_msg.str());
+}
+
+size_t NaryBooleanEngine::add_mesh(
+        const MatrixFr& vertices, const MatrixIr& faces) {
+    if (vertices.cols() != 3 || faces.cols() != 3) {
+        throw NotImplementedError(
+                "N-ary boolean only supports 3D triangle meshes");
+    }
+    m_vertices_list.push_back(vertices);
+    m_faces_list.push_back(faces);
+    return m_vertices_list.size() - 1;
+}
+
+void NaryBooleanEngine::clear() {
+    m_vertices_list.clear();
+    m_faces_list.clear();
+    m_program.clear();
+}
+
+void NaryBooleanEngine::set_expression(const std::string& expression) {
+    m_program = ExpressionParser(expression).parse();
+}
+
+void NaryBooleanEngine::compute() {
+    if (m_program.empty()) {
+        throw RuntimeError("Boolean expression is not set");
+    }
+    const int num_meshes = get_num_meshes();
+    for (int code : m_program) {
+        if (code >= num_meshes) {
+            std::stringstream err_msg;
+            err_msg << "Boolean expression refers to operand " << code
+                << ", but only " << num_meshes << " operands are given";
+            throw RuntimeError(err_msg.str());
+        }
+    }
+    run();
+}
+
+void NaryBooleanEngine::compute_union() {
+    if (get_num_meshes() == 0) {
+        throw RuntimeError("No operand is given");
+    }
+    m_program = nary_program(get_num_meshes(), UNION);
+    run();
+}
+
+void NaryBooleanEngine::compute_intersection() {
+    if (get_num_meshes() == 0) {
+        throw RuntimeError("No operand is given");
+    }
+    m_program = nary_program(get_num_meshes(), INTERSECTION);
+    run();
+}
+
+VectorI NaryBooleanEngine::get_mesh_sources() const {
+    std::vector<int> offsets = {0};
+    for (const auto& faces : m_faces_list) {
+        offsets.push_back(offsets.back() + faces.rows());
+    }
+
+    const size_t num_faces = m_face_sources.size();
+    VectorI mesh_sources(num_faces);
+    for (size_t i=0; i<num_faces; i++) {
+        auto itr = std::upper_bound(offsets.begin(), offsets.end(),
+                m_face_sources[i]);
+        mesh_sources[i] = std::distance(offsets.begin(), itr) - 1;
+    }
+    return mesh_sources;
+}
+
+bool NaryBooleanEngine::is_inside(const int* winding_numbers) const {
+    std::vector<char> stack;
+    auto pop = [&stack]() {
+        const bool value = stack.back();
+        stack.pop_back();
+        return value;
+    };
+    auto push = [&stack](bool value) { stack.push_back(value); };
+
+    for (int code : m_program) {
+        if (code >= 0) {
+            push(winding_numbers[code] > 0);
+        } else {
+            const bool b = pop();
+            const bool a = pop();
+            switch (code) {
+                case UNION:
+                    push(a || b);
+                    break;
+                case INTERSECTION:
+                    push(a && b);
+                    break;
+                case DIFFERENCE:
+                    push(a && !b);
+                    break;
+                case SYMMETRIC_DIFFERENCE:
+                    push(a != b);
+                    break;
+                default:
+                    throw RuntimeError("Invalid boolean operator");
+            }
+        }
+    }
+    return pop();
+}
@@ -0,0 +1,102 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
+
+namespace PyMesh {
+
+/**
+ * Boolean operations over any number of operands.
+ *
+ * Unlike BooleanEngine, all operands are handed over at once so that their
+ * intersections are resolved a single time.  Each cell of the resulting
+ * arrangement is labeled with the winding number of every operand, and the
+ * boolean expression is evaluated on these labels to decide which cells
+ * form the output.
+ *
+ * Expressions refer to operands by index and use the following operators:
+ *   - "a | b": union,
+ *   - "a & b": intersection,
+ *   - "a - b": difference,
+ *   - "a ^ b": symmetric difference.
+ * "&" binds tighter than the other operators, which are left associative.
+ * Parentheses may be used for grouping, e.g. "(0 | 1 | 2) - 3".
+ */
+class NaryBooleanEngine {
+    public:
+        typedef std::shared_ptr<NaryBooleanEngine> Ptr;
+        static Ptr create(const std::string& engine_name);
+
+    public:
+        virtual ~NaryBooleanEngine() = default;
+
+    public:
+        /**
+         * Returns the index of the new operand.
+         */
+        size_t add_mesh(const MatrixFr& vertices, const MatrixIr& faces);
+        size_t get_num_meshes() const { return m_vertices_list.size(); }
+        void clear();
+
+        void set_expression(const std::string& expression);
+
+        /**
+         * Evaluate the expression set by set_expression().
+         */
+        void compute();
+
+        /**
+         * Union or intersection of all operands.
+         */
+        void compute_union();
+        void compute_intersection();
+
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+
+        /**
+         * Index of the input face each output face comes from, in the
+         * concatenation of all operands' faces.
+         */
+        const VectorI& get_face_sources() const { return m_face_sources; }
+
+        /**
+         * Index of the operand each output face comes from.
+         */
+        VectorI get_mesh_sources() const;
+
+    public:
+        /**
+         * Whether a cell with the given per operand winding numbers is
+         * part of the output.  A cell is inside an operand if its winding
+         * number is positive.
+         */
+        bool is_inside(const int* winding_numbers) const;
+
+    protected:
+        /**
+         * Resolve the arrangement of all operands and extract the boundary
+         * of the cells for which is_inside() is true.
+         */
+        virtual void run() = 0;
+
+    protected:
+        std::vector<MatrixFr> m_vertices_list;
+        std::vector<MatrixIr> m_faces_list;
+
+        MatrixFr m_vertices;
+        MatrixIr m_faces;
+        VectorI m_face_sources;
+
+    private:
+        // Expression in postfix order: non-negative entries are operand
+        // indices, negative entries are operators.
+        std::vector<int> m_program;
+};
+
+}
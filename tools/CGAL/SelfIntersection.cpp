@@ -2,12 +2,14 @@
 #ifdef WITH_CGAL
 #include "SelfIntersection.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 #include <Math/MatrixUtils.h>
 
-#include <boost/function.hpp>
-#include <boost/bind.hpp>
-
 #include <CGAL/box_intersection_d.h>
 
 using namespace PyMesh;
@@ -31,10 +33,11 @@ namespace SelfIntersectionHelper {
             ID m_id;
     };
 
-    void handle_intersection_candidate(
-            SelfIntersection* self, const Box& a, const Box& b) {
-        self->handle_intersection_candidate(a.id(), b.id());
-    }
+    /**
+     * Minimum number of boxes per slab before parallel detection kicks in.
+     */
+    const size_t MIN_BOXES_PER_SLAB = 4096;
+    const size_t MAX_NUM_SLABS = 256;
 
     Vector2I get_opposite_edge(const Vector3I& f, size_t v) {
         if (f[0] == v) {
@@ -61,22 +64,85 @@ namespace SelfIntersectionHelper {
     std::vector<Box> get_triangle_bboxes(
             const SelfIntersection::Points& pts, const MatrixIr& faces) {
         const size_t num_faces = faces.rows();
+        std::vector<Box> all_boxes(num_faces);
+        std::vector<char> valid(num_faces, false);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_faces),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i<r.end(); i++) {
+                        const Vector3I f = faces.row(i);
+                        if (CGAL::collinear(pts[f[0]], pts[f[1]], pts[f[2]])) {
+                            // Triangle is degenerated.
+                            continue;
+                        }
+                        all_boxes[i] = Box(pts[f[0]].bbox() +
+                                pts[f[1]].bbox() + pts[f[2]].bbox());
+                        all_boxes[i].set_id(i);
+                        valid[i] = true;
+                    }
+                });
+
         std::vector<Box> boxes;
         boxes.reserve(num_faces);
         for (size_t i=0; i<num_faces; i++) {
-            const Vector3I f = faces.row(i);
-            const std::vector<SelfIntersection::Point_3> corners{
-                pts[f[0]], pts[f[1]], pts[f[2]]
-            };
-            if (CGAL::collinear(pts[f[0]], pts[f[1]], pts[f[2]])) {
-                // Triangle is degenerated.
-                continue;
-            }
-            boxes.emplace_back(CGAL::bbox_3(corners.begin(), corners.end()));
-            boxes.back().set_id(i);
+            if (valid[i]) boxes.push_back(all_boxes[i]);
         }
         return boxes;
     }
+
+    size_t get_longest_axis(const std::vector<Box>& boxes) {
+        Vector3F bbox_min, bbox_max;
+        for (size_t i=0; i<3; i++) {
+            bbox_min[i] = boxes.front().min_coord(i);
+            bbox_max[i] = boxes.front().max_coord(i);
+        }
+        for (const auto& box : boxes) {
+            for (size_t i=0; i<3; i++) {
+                bbox_min[i] = std::min(bbox_min[i], Float(box.min_coord(i)));
+                bbox_max[i] = std::max(bbox_max[i], Float(box.max_coord(i)));
+            }
+        }
+        size_t axis;
+        (bbox_max - bbox_min).maxCoeff(&axis);
+        return axis;
+    }
+
+    /**
+     * Split boxes into slabs along the given axis.  Slab boundaries are
+     * chosen at quantiles of the box lower bounds so slabs are balanced.  A
+     * box is assigned to every slab it overlaps.
+     */
+    std::vector<std::vector<Box> > split_into_slabs(
+            const std::vector<Box>& boxes, size_t axis, size_t num_slabs,
+            std::vector<Float>& slab_bounds) {
+        const size_t num_boxes = boxes.size();
+        std::vector<Float> lower_bounds(num_boxes);
+        for (size_t i=0; i<num_boxes; i++) {
+            lower_bounds[i] = boxes[i].min_coord(axis);
+        }
+        std::sort(lower_bounds.begin(), lower_bounds.end());
+
+        slab_bounds.resize(num_slabs+1);
+        slab_bounds[0] = -std::numeric_limits<Float>::infinity();
+        for (size_t i=1; i<num_slabs; i++) {
+            slab_bounds[i] = lower_bounds[i * num_boxes / num_slabs];
+        }
+        slab_bounds[num_slabs] = std::numeric_limits<Float>::infinity();
+
+        auto get_slab = [&slab_bounds](Float x) {
+            return size_t(std::upper_bound(slab_bounds.begin(),
+                        slab_bounds.end(), x) - slab_bounds.begin()) - 1;
+        };
+
+        std::vector<std::vector<Box> > slabs(num_slabs);
+        for (const auto& box : boxes) {
+            const size_t first = get_slab(box.min_coord(axis));
+            const size_t last = get_slab(box.max_coord(axis));
+            for (size_t i=first; i<=last; i++) {
+                slabs[i].push_back(box);
+            }
+        }
+        return slabs;
+    }
 }
 using namespace SelfIntersectionHelper;
 
@@ -108,10 +174,47 @@ SelfIntersection::SelfIntersection(
 void SelfIntersection::detect_self_intersection() {
     clear();
     std::vector<Box> boxes = get_triangle_bboxes(m_points, m_faces);
-    boost::function<void(const Box& a, const Box& b)> cb =
-        boost::bind(SelfIntersectionHelper::handle_intersection_candidate,
-                this, _1, _2);
-    CGAL::box_self_intersection_d(boxes.begin(), boxes.end(), cb);
+    if (boxes.empty()) return;
+
+    const size_t num_slabs = std::max(size_t(1), std::min(
+                boxes.size() / MIN_BOXES_PER_SLAB, MAX_NUM_SLABS));
+    const size_t axis = get_longest_axis(boxes);
+    std::vector<Float> slab_bounds;
+    auto slabs = split_into_slabs(boxes, axis, num_slabs, slab_bounds);
+
+    std::vector<std::vector<Vector2I> > slab_pairs(num_slabs);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_slabs, 1),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                    std::vector<Box>& slab_boxes = slabs[i];
+                    const Float slab_min = slab_bounds[i];
+                    const Float slab_max = slab_bounds[i+1];
+                    auto& pairs = slab_pairs[i];
+                    auto cb = [&](const Box& a, const Box& b) {
+                        // A pair overlapping several slabs is reported by the
+                        // slab containing the lower end of the overlap.
+                        const Float key = std::max(
+                                a.min_coord(axis), b.min_coord(axis));
+                        if (key < slab_min || key >= slab_max) return;
+                        if (is_intersecting(a.id(), b.id())) {
+                            pairs.emplace_back(
+                                    std::min(a.id(), b.id()),
+                                    std::max(a.id(), b.id()));
+                        }
+                    };
+                    CGAL::box_self_intersection_d(
+                            slab_boxes.begin(), slab_boxes.end(), cb);
+                }
+            });
+
+    for (const auto& pairs : slab_pairs) {
+        m_intersecting_pairs.insert(m_intersecting_pairs.end(),
+                pairs.begin(), pairs.end());
+    }
+    std::sort(m_intersecting_pairs.begin(), m_intersecting_pairs.end(),
+            [](const Vector2I& a, const Vector2I& b) {
+                return std::make_pair(a[0], a[1]) < std::make_pair(b[0], b[1]);
+            });
 }
 
 void SelfIntersection::clear() {
@@ -120,13 +223,20 @@ void SelfIntersection::clear() {
 
 void SelfIntersection::handle_intersection_candidate(
         size_t f_idx_1, size_t f_idx_2) {
+    if (is_intersecting(f_idx_1, f_idx_2)) {
+        m_intersecting_pairs.emplace_back(f_idx_1, f_idx_2);
+    }
+}
+
+bool SelfIntersection::is_intersecting(
+        size_t f_idx_1, size_t f_idx_2) const {
     auto duplicated_vertices = topological_overlap(f_idx_1, f_idx_2);
     const Vector3I f1 = m_faces.row(f_idx_1);
     const Vector3I f2 = m_faces.row(f_idx_2);
     const Triangle_3 t1(m_points[f1[0]], m_points[f1[1]], m_points[f1[2]]);
     const Triangle_3 t2(m_points[f2[0]], m_points[f2[1]], m_points[f2[2]]);
 
-    bool is_intersecting = false;
+    bool result = false;
     const size_t num_duplicated_vertices = duplicated_vertices.size();
     switch (num_duplicated_vertices) {
         case 0:
@@ -137,15 +247,15 @@ void SelfIntersection::handle_intersection_candidate(
                 if (t1_degenerate || t2_degenerate) {
                     // Degenerated triangles are considered as
                     // self-intersecting.
-                    is_intersecting = true;
+                    result = true;
                 } else {
-                    is_intersecting = CGAL::do_intersect(t1, t2);
+                    result = CGAL::do_intersect(t1, t2);
                 }
             }
             break;
         case 3:
             // duplicated face
-            is_intersecting = true;
+            result = true;
             break;
         case 1:
             {
@@ -155,7 +265,7 @@ void SelfIntersection::handle_intersection_candidate(
                 Vector2I opp_edge_2 = get_opposite_edge(f2, shared_vertex);
                 Segment_3 seg_1(m_points[opp_edge_1[0]], m_points[opp_edge_1[1]]);
                 Segment_3 seg_2(m_points[opp_edge_2[0]], m_points[opp_edge_2[1]]);
-                is_intersecting =
+                result =
                     CGAL::do_intersect(t1, seg_2) ||
                     CGAL::do_intersect(t2, seg_1);
             }
@@ -173,16 +283,16 @@ void SelfIntersection::handle_intersection_candidate(
                 const auto& p4 = m_points[shared_edge[1]];
                 if (CGAL::coplanar(p1, p2, p3, p4)) {
                     if (CGAL::collinear(p3, p4, p1)) {
-                        is_intersecting = true;
+                        result = true;
                     } else if (CGAL::collinear(p3, p4, p2)) {
-                        is_intersecting = true;
+                        result = true;
                     } else {
                         switch (CGAL::coplanar_orientation(p3, p4, p1, p2)) {
                             case CGAL::POSITIVE:
-                                is_intersecting = true;
+                                result = true;
                                 break;
                             case CGAL::NEGATIVE:
-                                is_intersecting = false;
+                                result = false;
                                 break;
                             case CGAL::COLLINEAR:
                                 throw RuntimeError(
@@ -191,7 +301,7 @@ void SelfIntersection::handle_intersection_candidate(
                         }
                     }
                 } else {
-                    is_intersecting = false;
+                    result = false;
                 }
             }
             break;
@@ -200,9 +310,7 @@ void SelfIntersection::handle_intersection_candidate(
                     "Two triangles sharing more than 3 vertices? Something is very wrong");
     }
 
-    if (is_intersecting) {
-        m_intersecting_pairs.emplace_back(f_idx_1, f_idx_2);
-    }
+    return result;
 }
 
 std::vector<size_t> SelfIntersection::topological_overlap(size_t id1, size_t id2) const {
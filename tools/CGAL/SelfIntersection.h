@@ -26,6 +26,11 @@ class SelfIntersection {
     public:
         /**
          * Detect triangle-triangle intersections for non-degenerated triangles.
+         *
+         * Large inputs are split into slabs along the longest axis and the
+         * slabs are processed in parallel.  Each candidate pair is reported
+         * by exactly one slab.  Output pairs are sorted with the smaller face
+         * index first, so the result does not depend on scheduling.
          */
         void detect_self_intersection();
 
@@ -41,6 +46,13 @@ class SelfIntersection {
     public:
         void handle_intersection_candidate(size_t f_idx_1, size_t f_idx_2);
 
+        /**
+         * Exact intersection test between two faces.  Adjacent faces are
+         * only intersecting if they overlap beyond the shared vertex/edge.
+         * This method is thread safe.
+         */
+        bool is_intersecting(size_t f_idx_1, size_t f_idx_2) const;
+
     private:
         std::vector<size_t> topological_overlap(size_t id1, size_t id2) const;
 
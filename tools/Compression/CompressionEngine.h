@@ -1,6 +1,7 @@
 /* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include <Mesh.h>
@@ -25,7 +26,66 @@ class CompressionEngine {
         virtual Mesh::Ptr decompress(const std::string& data) const {
             throw NotImplementedError("Decompression algorithm is not implemented");
         }
+
+    public:
+        /**
+         * Speed trade off in [0, 10].  0 gives the best compression ratio,
+         * 10 is the fastest.  -1 uses the engine default.
+         */
+        void set_speed(int encoding_speed, int decoding_speed) {
+            if (encoding_speed < -1 || encoding_speed > 10 ||
+                    decoding_speed < -1 || decoding_speed > 10) {
+                throw RuntimeError("Speed must be in the range [0, 10]!");
+            }
+            m_encoding_speed = encoding_speed;
+            m_decoding_speed = decoding_speed;
+        }
+
+        /**
+         * Number of quantization bits for vertex positions.  0 disables
+         * quantization, i.e. positions are encoded losslessly.
+         */
+        void set_position_quantization_bits(int bits) {
+            validate_quantization_bits(bits);
+            m_position_quantization_bits = bits;
+        }
+
+        /**
+         * Number of quantization bits for the named attribute.  0 disables
+         * quantization.  Only float attributes can be quantized; compressing
+         * a mesh whose int attribute has nonzero bits throws.
+         */
+        void set_attribute_quantization_bits(const std::string& name, int bits) {
+            validate_quantization_bits(bits);
+            m_attribute_quantization_bits[name] = bits;
+        }
+
+        int get_attribute_quantization_bits(const std::string& name) const {
+            auto itr = m_attribute_quantization_bits.find(name);
+            return itr == m_attribute_quantization_bits.end() ? 0 : itr->second;
+        }
+
+        /**
+         * Meshes with more than chunk_size faces (points for point clouds)
+         * are split spatially into chunks that are compressed and
+         * decompressed independently in parallel.  0 disables chunking.
+         */
+        void set_chunk_size(size_t chunk_size) { m_chunk_size = chunk_size; }
+
+    private:
+        void validate_quantization_bits(int bits) const {
+            if (bits < 0 || bits > 30) {
+                throw RuntimeError(
+                        "Quantization bits must be in the range [0, 30]!");
+            }
+        }
+
+    protected:
+        int m_encoding_speed = -1;
+        int m_decoding_speed = -1;
+        int m_position_quantization_bits = 0;
+        std::map<std::string, int> m_attribute_quantization_bits;
+        size_t m_chunk_size = 0;
 };
 
 }
-
@@ -8,39 +8,92 @@
 #include <MeshFactory.h>
 
 #include <draco/attributes/geometry_attribute.h>
-#include <draco/compression/encode.h>
 #include <draco/compression/decode.h>
+#include <draco/compression/expert_encode.h>
 #include <draco/mesh/mesh.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
+
+#include <tbb/tbb.h>
 
 using namespace PyMesh;
 
 namespace DracoCompressionEngineHelper {
 
+/**
+ * (attribute id, quantization bits) pairs passed on to the encoder.
+ */
+using Quantization = std::vector<std::pair<int, int> >;
+
+/**
+ * Name of the per-vertex attribute storing original vertex indices in
+ * chunked streams.
+ */
+const std::string CHUNK_VERTEX_INDEX = "__chunk_vertex_index";
+
+/**
+ * Chunked streams start with this tag followed by the number of chunks and
+ * the byte size of each chunk as little endian uint64 values.  Regular
+ * Draco streams start with "DRACO".
+ */
+const std::string CHUNK_MAGIC = "PYMESHDC";
+
+/**
+ * Draco only quantizes 32 bit float attributes, so attributes that are
+ * quantized are stored in single precision.
+ */
+void init_float_attribute(draco::GeometryAttribute& attr,
+        draco::GeometryAttribute::Type type, size_t num_cols,
+        bool single_precision) {
+    if (single_precision) {
+        attr.Init(type, nullptr, num_cols, draco::DT_FLOAT32, false,
+                sizeof(float) * num_cols, 0);
+    } else {
+        attr.Init(type, nullptr, num_cols, draco::DT_FLOAT64, false,
+                sizeof(Float) * num_cols, 0);
+    }
+}
+
+void set_float_values(draco::PointAttribute* attr, const Float* values,
+        size_t num_rows, size_t num_cols, bool single_precision) {
+    std::vector<float> row(num_cols);
+    for (size_t i=0; i<num_rows; i++) {
+        if (single_precision) {
+            std::copy(values + i*num_cols, values + (i+1)*num_cols,
+                    row.begin());
+            attr->SetAttributeValue(draco::AttributeValueIndex(i), row.data());
+        } else {
+            attr->SetAttributeValue(draco::AttributeValueIndex(i),
+                    values + i*num_cols);
+        }
+    }
+}
+
 template <typename DracoMesh>
-void copy_vertices(Mesh::Ptr mesh, std::unique_ptr<DracoMesh>& draco_mesh) {
+void copy_vertices(Mesh::Ptr mesh, std::unique_ptr<DracoMesh>& draco_mesh,
+        int quantization_bits, Quantization& quantization) {
     const auto dim = mesh->get_dim();
     const auto num_vertices = mesh->get_num_vertices();
+    const bool single_precision = quantization_bits > 0;
     draco_mesh->set_num_points(num_vertices);
     draco::GeometryAttribute positions;
-    positions.Init(draco::GeometryAttribute::POSITION, // Attribute type
-            nullptr,                                   // data buffer
-            dim,                                       // number of components
-            draco::DT_FLOAT64,                         // data type
-            false,                                     // normalized
-            sizeof(Float) * dim,                       // byte stride
-            0);                                        // byte offset
+    init_float_attribute(positions, draco::GeometryAttribute::POSITION, dim,
+            single_precision);
     auto pos_att_id = draco_mesh->AddAttribute(
             positions,      // attribute object
             true,           // identity mapping
             num_vertices);  // num attribute values
 
-    for (int i = 0; i < num_vertices; ++i) {
-        draco_mesh->attribute(pos_att_id)->SetAttributeValue(
-                draco::AttributeValueIndex(i), mesh->get_vertex(i).data());
+    set_float_values(draco_mesh->attribute(pos_att_id),
+            mesh->get_vertices().data(), num_vertices, dim, single_precision);
+    if (single_precision) {
+        quantization.emplace_back(pos_att_id, quantization_bits);
     }
 }
 
@@ -59,7 +112,9 @@ void copy_faces(Mesh::Ptr mesh, std::unique_ptr<DracoMesh>& draco_mesh) {
 
 template <typename DracoMesh>
 void copy_vertex_attributes(Mesh::Ptr mesh,
-        std::unique_ptr<DracoMesh>& draco_mesh) {
+        std::unique_ptr<DracoMesh>& draco_mesh,
+        const CompressionEngine& engine,
+        Quantization& quantization) {
     const auto num_vertices = mesh->get_num_vertices();
 
     const auto& float_attribute_names = mesh->get_float_attribute_names();
@@ -68,27 +123,27 @@ void copy_vertex_attributes(Mesh::Ptr mesh,
         if (values.size() % num_vertices != 0) continue;
         const auto num_rows = num_vertices;
         const auto num_cols = values.size() / num_vertices;
+        const int bits = engine.get_attribute_quantization_bits(name);
+        const bool single_precision = bits > 0;
         draco::GeometryAttribute attr;
         if (name == "vertex_normal") {
-            attr.Init(draco::GeometryAttribute::NORMAL, nullptr,
-                    num_cols, draco::DT_FLOAT64, false,
-                    sizeof(Float) * num_cols, 0);
+            init_float_attribute(attr, draco::GeometryAttribute::NORMAL,
+                    num_cols, single_precision);
         } else if (name == "vertex_texture") {
-            attr.Init(draco::GeometryAttribute::TEX_COORD, nullptr,
-                    num_cols, draco::DT_FLOAT64, false,
-                    sizeof(Float) * num_cols, 0);
+            init_float_attribute(attr, draco::GeometryAttribute::TEX_COORD,
+                    num_cols, single_precision);
         } else if (name.substr(0, 6) == "vertex"){
-            attr.Init(draco::GeometryAttribute::GENERIC, nullptr,
-                    num_cols, draco::DT_FLOAT64, false,
-                    sizeof(Float) * num_cols, 0);
+            init_float_attribute(attr, draco::GeometryAttribute::GENERIC,
+                    num_cols, single_precision);
         } else {
             // Not a vertex attribute.
             continue;
         }
         const auto id = draco_mesh->AddAttribute(attr, true, num_rows);
-        for (size_t i=0; i<num_rows; i++) {
-            draco_mesh->attribute(id)->SetAttributeValue(
-                    draco::AttributeValueIndex(i), values.data() +i*num_cols);
+        set_float_values(draco_mesh->attribute(id), values.data(),
+                num_rows, num_cols, single_precision);
+        if (single_precision) {
+            quantization.emplace_back(id, bits);
         }
 
         std::unique_ptr<draco::AttributeMetadata> metadata =
@@ -113,6 +168,11 @@ void copy_vertex_attributes(Mesh::Ptr mesh,
             // Not a vertex attribute.
             continue;
         }
+        if (engine.get_attribute_quantization_bits(name) > 0) {
+            throw RuntimeError("Attribute \"" + name +
+                    "\" is an int attribute, only float attributes can be"
+                    " quantized.");
+        }
         const auto id = draco_mesh->AddAttribute(attr, true, num_rows);
         for (size_t i=0; i<num_rows; i++) {
             draco_mesh->attribute(id)->SetAttributeValue(
@@ -194,7 +254,30 @@ void copy_face_attributes(Mesh::Ptr mesh,
     }
 }
 
+template <typename DracoMesh>
+void add_vertex_indices(const VectorI& indices,
+        std::unique_ptr<DracoMesh>& draco_mesh) {
+    const size_t num_rows = indices.size();
+    draco::GeometryAttribute attr;
+    attr.Init(draco::GeometryAttribute::GENERIC, nullptr, 1,
+            draco::DT_INT32, false, sizeof(int), 0);
+    const auto id = draco_mesh->AddAttribute(attr, true, num_rows);
+    for (size_t i=0; i<num_rows; i++) {
+        draco_mesh->attribute(id)->SetAttributeValue(
+                draco::AttributeValueIndex(i), indices.data() + i);
+    }
+
+    std::unique_ptr<draco::AttributeMetadata> metadata =
+        std::make_unique<draco::AttributeMetadata>();
+    metadata->AddEntryString("name", CHUNK_VERTEX_INDEX);
+    metadata->AddEntryString("type", "int");
+    draco_mesh->AddAttributeMetadata(id, std::move(metadata));
+}
+
 std::unique_ptr<draco::Mesh> to_draco_mesh(Mesh::Ptr mesh,
+        int position_quantization_bits,
+        const CompressionEngine& engine,
+        Quantization& quantization,
         bool with_attributes=true) {
     std::unique_ptr<draco::Mesh> draco_mesh(new draco::Mesh());
 
@@ -204,11 +287,11 @@ std::unique_ptr<draco::Mesh> to_draco_mesh(Mesh::Ptr mesh,
                 "Draco encoding only supports triangle mesh.");
     }
 
-    copy_vertices(mesh, draco_mesh);
+    copy_vertices(mesh, draco_mesh, position_quantization_bits, quantization);
     copy_faces(mesh, draco_mesh);
 
     if (with_attributes) {
-        copy_vertex_attributes(mesh, draco_mesh);
+        copy_vertex_attributes(mesh, draco_mesh, engine, quantization);
         //copy_face_attributes(mesh, draco_mesh);
     }
 
@@ -216,13 +299,16 @@ std::unique_ptr<draco::Mesh> to_draco_mesh(Mesh::Ptr mesh,
 }
 
 std::unique_ptr<draco::PointCloud> to_draco_point_cloud(Mesh::Ptr mesh,
+        int position_quantization_bits,
+        const CompressionEngine& engine,
+        Quantization& quantization,
         bool with_attributes=true) {
     std::unique_ptr<draco::PointCloud> draco_mesh(new draco::PointCloud());
     assert(mesh->get_num_faces() == 0);
-    copy_vertices(mesh, draco_mesh);
+    copy_vertices(mesh, draco_mesh, position_quantization_bits, quantization);
 
     if (with_attributes) {
-        copy_vertex_attributes(mesh, draco_mesh);
+        copy_vertex_attributes(mesh, draco_mesh, engine, quantization);
     }
 
     return draco_mesh;
@@ -236,25 +322,17 @@ VectorF extract_vertices(std::unique_ptr<DracoMesh>& draco_mesh, size_t& dim) {
     assert(positions->IsValid());
     dim = positions->num_components();
 
-    VectorF vertices(num_vertices * dim);
-    if (dim == 2) {
-        for (size_t i=0; i<num_vertices; i++) {
-            const auto p = positions->template GetValue<Float, 2>(
-                    draco::AttributeValueIndex(i));
-            vertices(i*2  ) = p[0];
-            vertices(i*2+1) = p[1];
-        }
-    } else if (dim == 3) {
-        for (size_t i=0; i<num_vertices; i++) {
-            const auto p = positions->template GetValue<Float, 3>(
-                    draco::AttributeValueIndex(i));
-            vertices(i*3  ) = p[0];
-            vertices(i*3+1) = p[1];
-            vertices(i*3+2) = p[2];
-        }
-    } else {
+    if (dim != 2 && dim != 3) {
         throw NotImplementedError("Draco mesh encodes high dimensional data");
     }
+
+    // Quantized positions are decoded in single precision, ConvertValue
+    // handles both cases.
+    VectorF vertices(num_vertices * dim);
+    for (size_t i=0; i<num_vertices; i++) {
+        positions->ConvertValue(draco::AttributeValueIndex(i),
+                vertices.data() + i*dim);
+    }
     return vertices;
 }
 
@@ -332,40 +410,177 @@ Mesh::Ptr from_draco_point_cloud(std::unique_ptr<draco::PointCloud> draco_pc) {
     return mesh;
 }
 
+template<typename DracoMesh>
+std::string encode_draco(const DracoMesh& draco_mesh,
+        const Quantization& quantization,
+        int encoding_speed, int decoding_speed) {
+    draco::ExpertEncoder encoder(draco_mesh);
+    if (encoding_speed >= 0 || decoding_speed >= 0) {
+        encoder.SetSpeedOptions(encoding_speed, decoding_speed);
+    }
+    for (const auto& entry : quantization) {
+        encoder.SetAttributeQuantization(entry.first, entry.second);
+    }
+
+    draco::EncoderBuffer buffer;
+    const auto status = encoder.EncodeToBuffer(&buffer);
+    if (!status.ok()) {
+        throw RuntimeError("Draco encoding error!");
+    }
+    return std::string(buffer.data(), buffer.size());
+}
+
+void write_uint64(std::string& out, uint64_t value) {
+    for (size_t i=0; i<8; i++) {
+        out.push_back(char((value >> (8*i)) & 0xff));
+    }
 }
 
+uint64_t read_uint64(const char* data) {
+    uint64_t value = 0;
+    for (size_t i=0; i<8; i++) {
+        value |= uint64_t(uint8_t(data[i])) << (8*i);
+    }
+    return value;
+}
+
+/**
+ * Sort items into spatially coherent chunks of at most chunk_size items by
+ * recursively splitting at the median of the longest axis.  On return,
+ * chunk i consists of order[boundaries[i]] to order[boundaries[i+1]-1].
+ */
+std::vector<size_t> split_spatially(const MatrixFr& centers,
+        size_t chunk_size, std::vector<int>& order) {
+    const size_t num_items = centers.rows();
+    order.resize(num_items);
+    for (size_t i=0; i<num_items; i++) order[i] = i;
+
+    std::vector<size_t> boundaries;
+    std::vector<std::pair<size_t, size_t> > ranges;
+    ranges.emplace_back(0, num_items);
+    while (!ranges.empty()) {
+        const auto range = ranges.back();
+        ranges.pop_back();
+        const size_t begin = range.first;
+        const size_t end = range.second;
+        if (end - begin <= chunk_size) {
+            boundaries.push_back(begin);
+            continue;
+        }
+
+        VectorF bbox_min = centers.row(order[begin]).transpose();
+        VectorF bbox_max = bbox_min;
+        for (size_t i=begin+1; i<end; i++) {
+            bbox_min = bbox_min.cwiseMin(centers.row(order[i]).transpose());
+            bbox_max = bbox_max.cwiseMax(centers.row(order[i]).transpose());
+        }
+        int axis;
+        (bbox_max - bbox_min).maxCoeff(&axis);
+
+        const size_t mid = (begin + end) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid,
+                order.begin() + end, [&](int a, int b) {
+                    return centers(a, axis) < centers(b, axis); });
+
+        // Right half is pushed first so chunks are emitted in order.
+        ranges.emplace_back(mid, end);
+        ranges.emplace_back(begin, mid);
+    }
+    boundaries.push_back(num_items);
+    return boundaries;
+}
+
+/**
+ * Raw pointer to the values of a per-vertex attribute.  Exactly one of
+ * values_f and values_i is set.
+ */
+struct VertexAttribute {
+    std::string name;
+    size_t width = 0;
+    const Float* values_f = nullptr;
+    const int* values_i = nullptr;
+};
+
+std::vector<VertexAttribute> get_vertex_attributes(Mesh::Ptr mesh) {
+    const size_t num_vertices = mesh->get_num_vertices();
+    std::vector<VertexAttribute> attributes;
+    for (const auto& name : mesh->get_float_attribute_names()) {
+        const auto& values = mesh->get_float_attribute(name);
+        if (name.substr(0, 6) != "vertex" ||
+                values.size() % num_vertices != 0) continue;
+        VertexAttribute attr;
+        attr.name = name;
+        attr.width = values.size() / num_vertices;
+        attr.values_f = values.data();
+        attributes.push_back(attr);
+    }
+    for (const auto& name : mesh->get_int_attribute_names()) {
+        const auto& values = mesh->get_int_attribute(name);
+        if (name.substr(0, 6) != "vertex" ||
+                values.size() % num_vertices != 0) continue;
+        VertexAttribute attr;
+        attr.name = name;
+        attr.width = values.size() / num_vertices;
+        attr.values_i = values.data();
+        attributes.push_back(attr);
+    }
+    return attributes;
+}
+
+}
+using namespace DracoCompressionEngineHelper;
+
 std::string DracoCompressionEngine::compress(Mesh::Ptr mesh) const {
     const size_t num_faces = mesh->get_num_faces();
+    const size_t num_items = num_faces > 0 ? num_faces : mesh->get_num_vertices();
+    if (m_chunk_size > 0 && num_items > m_chunk_size) {
+        return compress_chunked(mesh);
+    } else {
+        return encode(mesh);
+    }
+}
 
-    draco::EncoderBuffer buffer;
-    draco::Encoder encoder;
+Mesh::Ptr DracoCompressionEngine::decompress(const std::string& data) const {
+    if (data.compare(0, CHUNK_MAGIC.size(), CHUNK_MAGIC) == 0) {
+        return decompress_chunked(data);
+    } else {
+        return decode(data.c_str(), data.size());
+    }
+}
+
+std::string DracoCompressionEngine::encode(Mesh::Ptr mesh,
+        const VectorI* vertex_indices) const {
+    const size_t num_faces = mesh->get_num_faces();
+
+    Quantization quantization;
     if (num_faces > 0) {
-        auto draco_mesh = DracoCompressionEngineHelper::to_draco_mesh(mesh);
-        const auto status = encoder.EncodeMeshToBuffer(*draco_mesh, &buffer);
-        if (!status.ok()) {
-            throw RuntimeError("Draco encoding error!");
+        auto draco_mesh = DracoCompressionEngineHelper::to_draco_mesh(mesh,
+                m_position_quantization_bits, *this, quantization);
+        if (vertex_indices != nullptr) {
+            add_vertex_indices(*vertex_indices, draco_mesh);
         }
-        return std::string(buffer.data(), buffer.size());
+        return encode_draco(*draco_mesh, quantization,
+                m_encoding_speed, m_decoding_speed);
     } else {
-        auto draco_mesh = DracoCompressionEngineHelper::to_draco_point_cloud(mesh);
-        const auto status = encoder.EncodePointCloudToBuffer(*draco_mesh, &buffer);
-        if (!status.ok()) {
-            throw RuntimeError("Draco encoding error!");
+        auto draco_mesh = DracoCompressionEngineHelper::to_draco_point_cloud(
+                mesh, m_position_quantization_bits, *this, quantization);
+        if (vertex_indices != nullptr) {
+            add_vertex_indices(*vertex_indices, draco_mesh);
         }
-        return std::string(buffer.data(), buffer.size());
+        return encode_draco(*draco_mesh, quantization,
+                m_encoding_speed, m_decoding_speed);
     }
 }
 
-Mesh::Ptr DracoCompressionEngine::decompress(const std::string& data) const {
+Mesh::Ptr DracoCompressionEngine::decode(const char* data, size_t size) const {
     draco::DecoderBuffer buffer;
-    buffer.Init(data.c_str(), data.size());
+    buffer.Init(data, size);
     auto type_statusor = draco::Decoder::GetEncodedGeometryType(&buffer);
     if (!type_statusor.ok()) {
         throw RuntimeError("Failed to decode Draco buffer.");
     }
 
     draco::Decoder decoder;
-    draco::Mesh* draco_mesh = nullptr;
     const draco::EncodedGeometryType geom_type = type_statusor.value();
     if (geom_type == draco::TRIANGULAR_MESH) {
         auto statusor = decoder.DecodeMeshFromBuffer(&buffer);
@@ -392,4 +607,243 @@ Mesh::Ptr DracoCompressionEngine::decompress(const std::string& data) const {
     }
 }
 
+/**
+ * Faces (points for point clouds) are split into spatially coherent chunks.
+ * Each chunk is encoded as an independent Draco stream together with the
+ * original indices of its vertices, which are used to weld chunks back
+ * together on decompression.
+ */
+std::string DracoCompressionEngine::compress_chunked(Mesh::Ptr mesh) const {
+    const size_t dim = mesh->get_dim();
+    const size_t num_vertices = mesh->get_num_vertices();
+    const size_t num_faces = mesh->get_num_faces();
+    const VectorF& vertices = mesh->get_vertices();
+    const VectorI& faces = mesh->get_faces();
+    const bool is_point_cloud = num_faces == 0;
+    if (!is_point_cloud && mesh->get_vertex_per_face() != 3) {
+        throw NotImplementedError(
+                "Draco encoding only supports triangle mesh.");
+    }
+
+    MatrixFr centers;
+    if (is_point_cloud) {
+        centers = Eigen::Map<const MatrixFr>(vertices.data(), num_vertices, dim);
+    } else {
+        centers.resize(num_faces, dim);
+        for (size_t i=0; i<num_faces; i++) {
+            centers.row(i) = (
+                    vertices.segment(faces[i*3  ]*dim, dim) +
+                    vertices.segment(faces[i*3+1]*dim, dim) +
+                    vertices.segment(faces[i*3+2]*dim, dim)).transpose() / 3.0;
+        }
+    }
+
+    std::vector<int> order;
+    const auto boundaries = split_spatially(centers, m_chunk_size, order);
+    const size_t num_chunks = boundaries.size() - 1;
+    const auto attributes = get_vertex_attributes(mesh);
+
+    std::vector<std::string> chunks(num_chunks);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t ci=r.begin(); ci!=r.end(); ci++) {
+                    const size_t begin = boundaries[ci];
+                    const size_t end = boundaries[ci+1];
+
+                    std::vector<int> vertex_ids;
+                    VectorI chunk_faces;
+                    if (is_point_cloud) {
+                        vertex_ids.assign(order.begin() + begin,
+                                order.begin() + end);
+                    } else {
+                        chunk_faces.resize((end - begin) * 3);
+                        for (size_t i=begin; i<end; i++) {
+                            chunk_faces.segment<3>((i-begin)*3) =
+                                faces.segment<3>(order[i]*3);
+                        }
+                        vertex_ids.assign(chunk_faces.data(),
+                                chunk_faces.data() + chunk_faces.size());
+                        std::sort(vertex_ids.begin(), vertex_ids.end());
+                        vertex_ids.erase(std::unique(vertex_ids.begin(),
+                                    vertex_ids.end()), vertex_ids.end());
+                        for (size_t i=0; i<chunk_faces.size(); i++) {
+                            chunk_faces[i] = std::lower_bound(
+                                    vertex_ids.begin(), vertex_ids.end(),
+                                    chunk_faces[i]) - vertex_ids.begin();
+                        }
+                    }
+
+                    const size_t n = vertex_ids.size();
+                    VectorI global_ids(n);
+                    VectorF chunk_vertices(n * dim);
+                    for (size_t i=0; i<n; i++) {
+                        global_ids[i] = vertex_ids[i];
+                        chunk_vertices.segment(i*dim, dim) =
+                            vertices.segment(vertex_ids[i]*dim, dim);
+                    }
+                    VectorI voxels;
+                    auto chunk = MeshFactory().load_data(chunk_vertices,
+                            chunk_faces, voxels, dim, 3, 4).create();
+
+                    for (const auto& attr : attributes) {
+                        const size_t w = attr.width;
+                        if (attr.values_f != nullptr) {
+                            VectorF values(n * w);
+                            for (size_t i=0; i<n; i++) {
+                                std::copy(attr.values_f + vertex_ids[i]*w,
+                                        attr.values_f + (vertex_ids[i]+1)*w,
+                                        values.data() + i*w);
+                            }
+                            chunk->add_empty_float_attribute(attr.name);
+                            chunk->set_float_attribute(attr.name, values);
+                        } else {
+                            VectorI values(n * w);
+                            for (size_t i=0; i<n; i++) {
+                                std::copy(attr.values_i + vertex_ids[i]*w,
+                                        attr.values_i + (vertex_ids[i]+1)*w,
+                                        values.data() + i*w);
+                            }
+                            chunk->add_empty_int_attribute(attr.name);
+                            chunk->set_int_attribute(attr.name, values);
+                        }
+                    }
+
+                    chunks[ci] = encode(chunk, &global_ids);
+                }
+            });
+
+    std::string data = CHUNK_MAGIC;
+    write_uint64(data, num_chunks);
+    for (const auto& chunk : chunks) {
+        write_uint64(data, chunk.size());
+    }
+    for (const auto& chunk : chunks) {
+        data += chunk;
+    }
+    return data;
+}
+
+Mesh::Ptr DracoCompressionEngine::decompress_chunked(
+        const std::string& data) const {
+    const size_t header_size = CHUNK_MAGIC.size() + 8;
+    if (data.size() < header_size) {
+        throw RuntimeError("Invalid chunked Draco buffer.");
+    }
+    const size_t num_chunks = read_uint64(data.data() + CHUNK_MAGIC.size());
+    if (num_chunks == 0 || (data.size() - header_size) / 8 < num_chunks) {
+        throw RuntimeError("Invalid chunked Draco buffer.");
+    }
+    std::vector<size_t> offsets(num_chunks+1);
+    offsets[0] = header_size + num_chunks * 8;
+    for (size_t i=0; i<num_chunks; i++) {
+        const size_t size = read_uint64(data.data() + header_size + i*8);
+        if (size > data.size() - offsets[i]) {
+            throw RuntimeError("Invalid chunked Draco buffer.");
+        }
+        offsets[i+1] = offsets[i] + size;
+    }
+
+    std::vector<Mesh::Ptr> chunks(num_chunks);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    chunks[i] = decode(data.data() + offsets[i],
+                            offsets[i+1] - offsets[i]);
+                }
+            });
+
+    // Vertices not referenced by any chunk were dropped during compression,
+    // the remaining vertices keep their relative order.
+    const size_t dim = chunks[0]->get_dim();
+    std::vector<const VectorI*> chunk_ids(num_chunks);
+    int max_id = -1;
+    for (size_t i=0; i<num_chunks; i++) {
+        if (!chunks[i]->has_int_attribute(CHUNK_VERTEX_INDEX)) {
+            throw RuntimeError("Chunk is missing vertex indices.");
+        }
+        chunk_ids[i] = &chunks[i]->get_int_attribute(CHUNK_VERTEX_INDEX);
+        if (chunk_ids[i]->size() > 0) {
+            max_id = std::max(max_id, chunk_ids[i]->maxCoeff());
+        }
+    }
+    std::vector<int> index_map(max_id+1, -1);
+    for (const auto ids : chunk_ids) {
+        for (size_t i=0; i<ids->size(); i++) {
+            index_map[(*ids)[i]] = 0;
+        }
+    }
+    size_t num_vertices = 0;
+    for (auto& id : index_map) {
+        if (id >= 0) id = num_vertices++;
+    }
+
+    // CHUNK_VERTEX_INDEX is skipped as it does not start with "vertex".
+    const auto attributes = get_vertex_attributes(chunks[0]);
+    std::vector<VectorF> float_values(attributes.size());
+    std::vector<VectorI> int_values(attributes.size());
+    for (size_t j=0; j<attributes.size(); j++) {
+        if (attributes[j].values_f != nullptr) {
+            float_values[j].resize(num_vertices * attributes[j].width);
+        } else {
+            int_values[j].resize(num_vertices * attributes[j].width);
+        }
+    }
+
+    VectorF vertices(num_vertices * dim);
+    std::vector<size_t> face_offsets(num_chunks+1, 0);
+    for (size_t i=0; i<num_chunks; i++) {
+        const VectorF& chunk_vertices = chunks[i]->get_vertices();
+        const VectorI& ids = *chunk_ids[i];
+        for (size_t k=0; k<ids.size(); k++) {
+            vertices.segment(index_map[ids[k]]*dim, dim) =
+                chunk_vertices.segment(k*dim, dim);
+        }
+        for (size_t j=0; j<attributes.size(); j++) {
+            const auto& name = attributes[j].name;
+            const size_t w = attributes[j].width;
+            if (attributes[j].values_f != nullptr) {
+                const VectorF& values = chunks[i]->get_float_attribute(name);
+                for (size_t k=0; k<ids.size(); k++) {
+                    float_values[j].segment(index_map[ids[k]]*w, w) =
+                        values.segment(k*w, w);
+                }
+            } else {
+                const VectorI& values = chunks[i]->get_int_attribute(name);
+                for (size_t k=0; k<ids.size(); k++) {
+                    int_values[j].segment(index_map[ids[k]]*w, w) =
+                        values.segment(k*w, w);
+                }
+            }
+        }
+        face_offsets[i+1] = face_offsets[i] + chunks[i]->get_num_faces();
+    }
+
+    VectorI faces(face_offsets[num_chunks] * 3);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const VectorI& chunk_faces = chunks[i]->get_faces();
+                    const VectorI& ids = *chunk_ids[i];
+                    for (size_t k=0; k<chunk_faces.size(); k++) {
+                        faces[face_offsets[i]*3 + k] =
+                            index_map[ids[chunk_faces[k]]];
+                    }
+                }
+            });
+
+    VectorI voxels;
+    auto mesh = MeshFactory().load_data(vertices, faces, voxels, dim, 3, 4).create();
+    for (size_t j=0; j<attributes.size(); j++) {
+        const auto& name = attributes[j].name;
+        if (attributes[j].values_f != nullptr) {
+            mesh->add_empty_float_attribute(name);
+            mesh->set_float_attribute(name, float_values[j]);
+        } else {
+            mesh->add_empty_int_attribute(name);
+            mesh->set_int_attribute(name, int_values[j]);
+        }
+    }
+    return mesh;
+}
+
 #endif
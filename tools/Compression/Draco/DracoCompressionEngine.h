@@ -12,6 +12,19 @@ class DracoCompressionEngine : public CompressionEngine {
     public:
         virtual std::string compress(Mesh::Ptr mesh) const;
         virtual Mesh::Ptr decompress(const std::string& data) const;
+
+    private:
+        /**
+         * Encode mesh as a single Draco stream.  If vertex_indices is
+         * provided, it is stored as an extra per-vertex attribute so that
+         * chunks can be stitched back together.
+         */
+        std::string encode(Mesh::Ptr mesh,
+                const VectorI* vertex_indices=nullptr) const;
+        Mesh::Ptr decode(const char* data, size_t size) const;
+
+        std::string compress_chunked(Mesh::Ptr mesh) const;
+        Mesh::Ptr decompress_chunked(const std::string& data) const;
 };
 
 }
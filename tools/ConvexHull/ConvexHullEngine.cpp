@@ -6,6 +6,8 @@
 
 #include <Core/Exception.h>
 
+#include "Incremental/IncrementalConvexHull.h"
+
 #ifdef WITH_CGAL
 #include "CGAL/CGALConvexHull2D.h"
 #include "CGAL/CGALConvexHull3D.h"
@@ -51,6 +53,11 @@ ConvexHullEngine::Ptr ConvexHullEngine::create(
 #elif WITH_TETGEN
         if (dim == 3) return ConvexHullEngine::create(dim, "tetgen");
 #endif
+        return ConvexHullEngine::create(dim, "incremental");
+    }
+
+    if (library_name == "incremental") {
+        return std::make_shared<IncrementalConvexHull>();
     }
 
 #ifdef WITH_QHULL
@@ -105,6 +112,7 @@ ConvexHullEngine::Ptr ConvexHullEngine::create(
 
 bool ConvexHullEngine::supports(
         const std::string& library_name) {
+    if ((library_name) == "incremental") return true;
 #ifdef WITH_QHULL
     if ((library_name) == "qhull") return true;
 #endif
@@ -122,6 +130,7 @@ bool ConvexHullEngine::supports(
 
 std::vector<std::string> ConvexHullEngine::get_available_engines() {
     std::vector<std::string> engine_names;
+    engine_names.push_back("incremental");
 #ifdef WITH_QHULL
     engine_names.push_back("qhull");
 #endif
@@ -32,9 +32,9 @@ class ConvexHullEngine {
             throw NotImplementedError("This function is not implemented");
         }
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_index_map() const { return m_index_map; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_index_map() const { return m_index_map; }
 
     protected:
         void reorient_faces();
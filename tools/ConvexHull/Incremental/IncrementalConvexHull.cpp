@@ -0,0 +1,236 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "IncrementalConvexHull.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <Core/Exception.h>
+
+using namespace PyMesh;
+
+namespace IncrementalConvexHullHelper {
+    /**
+     * Tolerance relative to the bbox diagonal of the input.
+     */
+    const Float REL_TOL = 1e-10;
+
+    Float compute_scale(const MatrixFr& points) {
+        const Float scale = (points.colwise().maxCoeff() -
+                points.colwise().minCoeff()).norm();
+        if (scale == 0.0) {
+            throw RuntimeError("Convex hull input points are all identical.");
+        }
+        return scale;
+    }
+
+    Float cross(const Vector2F& o, const Vector2F& a, const Vector2F& b) {
+        return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+    }
+
+    struct Facet {
+        std::array<int, 3> v;
+        Vector3F normal;
+        Float offset;
+        bool visible;
+    };
+
+    Facet create_facet(const std::vector<Vector3F>& pts, int a, int b, int c) {
+        Facet f;
+        f.v = {{a, b, c}};
+        f.normal = (pts[b] - pts[a]).cross(pts[c] - pts[a]);
+        const Float len = f.normal.norm();
+        if (len > 0.0) f.normal /= len;
+        f.offset = f.normal.dot(pts[a]);
+        f.visible = false;
+        return f;
+    }
+
+    size_t find_farthest(size_t num_pts,
+            const std::function<Float(size_t)>& distance) {
+        size_t result = 0;
+        Float max_dist = -1.0;
+        for (size_t i=0; i<num_pts; i++) {
+            const Float d = distance(i);
+            if (d > max_dist) {
+                max_dist = d;
+                result = i;
+            }
+        }
+        return result;
+    }
+}
+
+using namespace IncrementalConvexHullHelper;
+
+void IncrementalConvexHull::run(const MatrixFr& points) {
+    const size_t dim = points.cols();
+    if (dim == 2) {
+        run_2D(points);
+    } else if (dim == 3) {
+        run_3D(points);
+    } else {
+        std::stringstream err_msg;
+        err_msg << "Incremental convex hull does not support dim=" << dim;
+        throw NotImplementedError(err_msg.str());
+    }
+}
+
+void IncrementalConvexHull::run_2D(const MatrixFr& points) {
+    const size_t num_pts = points.rows();
+    const Float scale = compute_scale(points);
+    const Float tol = REL_TOL * scale * scale;
+
+    std::vector<Vector2F> pts(num_pts);
+    std::vector<int> order(num_pts);
+    for (size_t i=0; i<num_pts; i++) {
+        pts[i] = points.row(i).transpose();
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](int i, int j) {
+            return pts[i][0] < pts[j][0] ||
+            (pts[i][0] == pts[j][0] && pts[i][1] < pts[j][1]); });
+
+    // Lower chain followed by upper chain, both counterclockwise.
+    std::vector<int> hull(2 * num_pts);
+    size_t k = 0;
+    for (size_t i=0; i<num_pts; i++) {
+        while (k >= 2 && cross(pts[hull[k-2]], pts[hull[k-1]],
+                    pts[order[i]]) <= tol) k--;
+        hull[k++] = order[i];
+    }
+    for (size_t i=num_pts-1, lower_size=k+1; i>0; i--) {
+        while (k >= lower_size && cross(pts[hull[k-2]], pts[hull[k-1]],
+                    pts[order[i-1]]) <= tol) k--;
+        hull[k++] = order[i-1];
+    }
+    const size_t num_hull_vertices = k - 1;
+    if (num_hull_vertices < 3) {
+        throw RuntimeError("Convex hull input points are collinear.");
+    }
+
+    MatrixIr faces(num_hull_vertices, 2);
+    for (size_t i=0; i<num_hull_vertices; i++) {
+        faces(i, 0) = hull[i];
+        faces(i, 1) = hull[(i+1) % num_hull_vertices];
+    }
+    extract_hull(points, faces);
+}
+
+void IncrementalConvexHull::run_3D(const MatrixFr& points) {
+    const size_t num_pts = points.rows();
+    const Float tol = REL_TOL * compute_scale(points);
+
+    std::vector<Vector3F> pts(num_pts);
+    for (size_t i=0; i<num_pts; i++) {
+        pts[i] = points.row(i).transpose();
+    }
+
+    // Initial simplex from extreme points.
+    const int i0 = find_farthest(num_pts,
+            [&](size_t i) { return -pts[i][0]; });
+    const int i1 = find_farthest(num_pts,
+            [&](size_t i) { return (pts[i] - pts[i0]).squaredNorm(); });
+    const Vector3F axis = (pts[i1] - pts[i0]).normalized();
+    const int i2 = find_farthest(num_pts, [&](size_t i) {
+            return axis.cross(pts[i] - pts[i0]).squaredNorm(); });
+    const Vector3F plane_normal =
+        (pts[i1] - pts[i0]).cross(pts[i2] - pts[i0]).normalized();
+    const int i3 = find_farthest(num_pts, [&](size_t i) {
+            return std::abs(plane_normal.dot(pts[i] - pts[i0])); });
+    if (std::abs(plane_normal.dot(pts[i3] - pts[i0])) <= tol) {
+        throw RuntimeError("Convex hull input points are coplanar.");
+    }
+
+    std::vector<Facet> facets;
+    const std::array<int, 4> simplex{{i0, i1, i2, i3}};
+    for (size_t i=0; i<4; i++) {
+        int a = simplex[(i+1)%4];
+        int b = simplex[(i+2)%4];
+        int c = simplex[(i+3)%4];
+        const Vector3F& opposite = pts[simplex[i]];
+        if ((pts[b] - pts[a]).cross(pts[c] - pts[a]).dot(
+                    opposite - pts[a]) > 0.0) {
+            std::swap(b, c);
+        }
+        facets.push_back(create_facet(pts, a, b, c));
+    }
+
+    std::vector<std::pair<int, int> > edges;
+    for (size_t i=0; i<num_pts; i++) {
+        if (std::find(simplex.begin(), simplex.end(), int(i)) != simplex.end())
+            continue;
+
+        const Vector3F& p = pts[i];
+        bool is_outside = false;
+        for (auto& f : facets) {
+            f.visible = f.normal.dot(p) - f.offset > tol;
+            is_outside = is_outside || f.visible;
+        }
+        if (!is_outside) continue;
+
+        // Horizon edges are edges of visible facets whose twin belongs to
+        // a hidden facet.
+        edges.clear();
+        for (const auto& f : facets) {
+            if (!f.visible) continue;
+            for (size_t j=0; j<3; j++) {
+                edges.emplace_back(f.v[j], f.v[(j+1)%3]);
+            }
+        }
+        std::vector<std::pair<int, int> > horizon;
+        for (const auto& e : edges) {
+            if (std::find(edges.begin(), edges.end(),
+                        std::make_pair(e.second, e.first)) == edges.end()) {
+                horizon.push_back(e);
+            }
+        }
+
+        facets.erase(std::remove_if(facets.begin(), facets.end(),
+                    [](const Facet& f) { return f.visible; }), facets.end());
+        for (const auto& e : horizon) {
+            facets.push_back(create_facet(pts, e.first, e.second, i));
+        }
+    }
+
+    const size_t num_facets = facets.size();
+    MatrixIr faces(num_facets, 3);
+    for (size_t i=0; i<num_facets; i++) {
+        for (size_t j=0; j<3; j++) {
+            faces(i, j) = facets[i].v[j];
+        }
+    }
+    extract_hull(points, faces);
+}
+
+void IncrementalConvexHull::extract_hull(
+        const MatrixFr& points, const MatrixIr& faces) {
+    const size_t num_pts = points.rows();
+    const size_t dim = points.cols();
+
+    VectorI vertex_map = VectorI::Constant(num_pts, -1);
+    for (size_t i=0; i<size_t(faces.size()); i++) {
+        vertex_map[faces.data()[i]] = 0;
+    }
+    size_t num_hull_vertices = 0;
+    for (size_t i=0; i<num_pts; i++) {
+        if (vertex_map[i] >= 0) vertex_map[i] = num_hull_vertices++;
+    }
+
+    m_vertices.resize(num_hull_vertices, dim);
+    m_index_map.resize(num_hull_vertices);
+    for (size_t i=0; i<num_pts; i++) {
+        if (vertex_map[i] < 0) continue;
+        m_vertices.row(vertex_map[i]) = points.row(i);
+        m_index_map[vertex_map[i]] = i;
+    }
+
+    m_faces.resize(faces.rows(), faces.cols());
+    for (size_t i=0; i<size_t(faces.size()); i++) {
+        m_faces.data()[i] = vertex_map[faces.data()[i]];
+    }
+}
@@ -0,0 +1,30 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <ConvexHull/ConvexHullEngine.h>
+
+namespace PyMesh {
+
+/**
+ * Dependency free convex hull meant for small point sets, such as the points
+ * around a single wire joint.  2D hulls use Andrew's monotone chain and 3D
+ * hulls are built incrementally in O(n^2) time.  Unlike qhull, this engine
+ * keeps no global state, so separate instances can run concurrently.
+ *
+ * Points that lie on the hull but are not hull vertices (e.g. in the middle
+ * of a facet) are dropped, which matches the behavior of qhull.
+ */
+class IncrementalConvexHull : public ConvexHullEngine {
+    public:
+        IncrementalConvexHull(): ConvexHullEngine() { }
+
+    public:
+        virtual void run(const MatrixFr& points);
+
+    protected:
+        void run_2D(const MatrixFr& points);
+        void run_3D(const MatrixFr& points);
+        void extract_hull(const MatrixFr& points, const MatrixIr& faces);
+};
+
+}
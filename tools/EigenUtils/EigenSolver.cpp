@@ -1,17 +1,200 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "EigenSolver.h"
+#include <cmath>
+#include <limits>
 #include <sstream>
+
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 
 using namespace PyMesh;
 
+namespace EigenSolverHelper {
+    /**
+     * Matrices are decomposed LANES at a time.  All loops over lanes are
+     * branch free so that the compiler can map them onto SIMD registers.
+     */
+    const size_t LANES = 8;
+    const size_t MAX_SWEEPS = 10;
+
+    /**
+     * Jacobi rotation annihilating a_pq (Numerical Recipes, section 11.1).
+     * Returns t = tan(angle); the rotation is the identity if a_pq == 0.
+     */
+    inline Float rotation_tangent(Float app, Float aqq, Float apq) {
+        const bool zero = (apq == 0.0);
+        const Float theta = (aqq - app) / (2.0 * (zero ? 1.0 : apq));
+        Float t = 1.0 / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        t = theta < 0.0 ? -t : t;
+        return zero ? 0.0 : t;
+    }
+
+    /**
+     * Compare and swap eigen pair i and j so that d[i] <= d[j].
+     */
+    template<size_t DIM>
+    inline void sort_pair(Float* d, Float* v, size_t i, size_t j) {
+        const bool swap = d[j] < d[i];
+        const Float di = d[i], dj = d[j];
+        d[i] = swap ? dj : di;
+        d[j] = swap ? di : dj;
+        for (size_t k=0; k<DIM; k++) {
+            const Float vi = v[k*DIM+i], vj = v[k*DIM+j];
+            v[k*DIM+i] = swap ? vj : vi;
+            v[k*DIM+j] = swap ? vi : vj;
+        }
+    }
+
+    /**
+     * A 2x2 symmetric matrix is diagonalized exactly by a single Jacobi
+     * rotation.
+     */
+    void decompose_2x2(const Float* matrices, size_t begin, size_t end,
+            size_t num_matrices, Float* values, Float* vectors) {
+        for (size_t base=begin; base<end; base+=LANES) {
+            const size_t count = std::min(LANES, end - base);
+            Float a[3][LANES], d[LANES][2], v[LANES][4];
+            for (size_t l=0; l<LANES; l++) {
+                for (size_t k=0; k<3; k++) {
+                    a[k][l] = l < count ? matrices[(base+l)*3+k] : 0.0;
+                }
+            }
+
+            for (size_t l=0; l<LANES; l++) {
+                const Float t = rotation_tangent(a[0][l], a[1][l], a[2][l]);
+                const Float c = 1.0 / std::sqrt(t*t + 1.0);
+                const Float s = t * c;
+                d[l][0] = a[0][l] - t * a[2][l];
+                d[l][1] = a[1][l] + t * a[2][l];
+                v[l][0] = c; v[l][1] = s;
+                v[l][2] =-s; v[l][3] = c;
+                sort_pair<2>(d[l], v[l], 0, 1);
+            }
+
+            for (size_t l=0; l<count; l++) {
+                const size_t i = base + l;
+                for (size_t k=0; k<2; k++) {
+                    values[k*num_matrices + i] = d[l][k];
+                    for (size_t j=0; j<2; j++) {
+                        vectors[(k*2+j)*num_matrices + i] = v[l][j*2+k];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Cyclic Jacobi on 3x3 symmetric matrices.  Entries are stored as
+     * a[0..5] = (xx, yy, zz, yz, xz, xy).
+     */
+    void decompose_3x3(const Float* matrices, size_t begin, size_t end,
+            size_t num_matrices, Float* values, Float* vectors) {
+        // (p, q, r, index of a_pq, index of a_rp, index of a_rq)
+        const size_t pairs[3][6] = {
+            {0, 1, 2, 5, 4, 3},
+            {0, 2, 1, 4, 5, 3},
+            {1, 2, 0, 3, 5, 4}
+        };
+        const Float eps = std::numeric_limits<Float>::epsilon();
+
+        for (size_t base=begin; base<end; base+=LANES) {
+            const size_t count = std::min(LANES, end - base);
+            Float a[6][LANES], v[9][LANES];
+            for (size_t l=0; l<LANES; l++) {
+                for (size_t k=0; k<6; k++) {
+                    a[k][l] = l < count ? matrices[(base+l)*6+k] : 0.0;
+                }
+                for (size_t k=0; k<9; k++) {
+                    v[k][l] = (k % 4 == 0) ? 1.0 : 0.0;
+                }
+            }
+
+            for (size_t sweep=0; sweep<MAX_SWEEPS; sweep++) {
+                bool converged = true;
+                for (size_t l=0; l<LANES; l++) {
+                    const Float off = a[3][l]*a[3][l] + a[4][l]*a[4][l] +
+                        a[5][l]*a[5][l];
+                    const Float diag = a[0][l]*a[0][l] + a[1][l]*a[1][l] +
+                        a[2][l]*a[2][l];
+                    converged &= (off <= eps * eps * diag);
+                }
+                if (converged) break;
+
+                for (const auto& pair : pairs) {
+                    const size_t p = pair[0], q = pair[1];
+                    const size_t pq = pair[3], rp = pair[4], rq = pair[5];
+                    for (size_t l=0; l<LANES; l++) {
+                        const Float apq = a[pq][l];
+                        const Float t = rotation_tangent(a[p][l], a[q][l], apq);
+                        const Float c = 1.0 / std::sqrt(t*t + 1.0);
+                        const Float s = t * c;
+
+                        a[p][l] -= t * apq;
+                        a[q][l] += t * apq;
+                        a[pq][l] = 0.0;
+                        const Float arp = a[rp][l], arq = a[rq][l];
+                        a[rp][l] = c * arp - s * arq;
+                        a[rq][l] = s * arp + c * arq;
+
+                        for (size_t k=0; k<3; k++) {
+                            const Float vkp = v[k*3+p][l], vkq = v[k*3+q][l];
+                            v[k*3+p][l] = c * vkp - s * vkq;
+                            v[k*3+q][l] = s * vkp + c * vkq;
+                        }
+                    }
+                }
+            }
+
+            for (size_t l=0; l<count; l++) {
+                Float d[3] = {a[0][l], a[1][l], a[2][l]};
+                Float w[9];
+                for (size_t k=0; k<9; k++) w[k] = v[k][l];
+                sort_pair<3>(d, w, 0, 1);
+                sort_pair<3>(d, w, 1, 2);
+                sort_pair<3>(d, w, 0, 1);
+
+                const size_t i = base + l;
+                for (size_t k=0; k<3; k++) {
+                    values[k*num_matrices + i] = d[k];
+                    for (size_t j=0; j<3; j++) {
+                        vectors[(k*3+j)*num_matrices + i] = w[j*3+k];
+                    }
+                }
+            }
+        }
+    }
+}
+using namespace EigenSolverHelper;
+
 void EigenSolver::compute(const MatrixF& matrix) {
     m_solver.compute(matrix);
     m_eigen_values = m_solver.eigenvalues().real();
     m_eigen_vectors = m_solver.eigenvectors().real();
 }
 
-void EigenSolver::compute_batch_symmetric(size_t dim, VectorF matrices) {
+void EigenSolver::compute_batch_symmetric(size_t dim, const VectorF& matrices) {
+    compute_batch_symmetric_soa(dim, matrices);
+
+    const size_t num_matrices = m_batch_eigen_values.cols();
+    m_eigen_values.resize(num_matrices * dim);
+    m_eigen_vectors.resize(num_matrices * dim, dim);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_matrices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    for (size_t k=0; k<dim; k++) {
+                        m_eigen_values[i*dim+k] = m_batch_eigen_values(k, i);
+                        for (size_t j=0; j<dim; j++) {
+                            m_eigen_vectors(i*dim+j, k) =
+                                m_batch_eigen_vectors(k*dim+j, i);
+                        }
+                    }
+                }
+            });
+}
+
+void EigenSolver::compute_batch_symmetric_soa(size_t dim,
+        const VectorF& matrices) {
     if (dim == 2) {
         compute_batch_symmetric_2x2(matrices);
     } else if (dim == 3) {
@@ -26,39 +209,33 @@ void EigenSolver::compute_batch_symmetric(size_t dim, VectorF matrices) {
 void EigenSolver::compute_batch_symmetric_2x2(const VectorF& matrices) {
     const size_t dim = 2;
     const size_t flatten_size = 3;
-    const size_t num_matrices = matrices.size() / flatten_size;
-    m_eigen_values = VectorF(num_matrices * dim);
-    m_eigen_vectors = MatrixF(num_matrices * dim, dim);
-    for (size_t i=0; i<num_matrices; i++) {
-        const VectorF& entries = matrices.segment(i*flatten_size, flatten_size);
-        MatrixF M(dim, dim);
-        size_t base_idx = i*flatten_size;
-        M << matrices[base_idx  ], matrices[base_idx+2],
-             matrices[base_idx+2], matrices[base_idx+1],
-        m_solver.compute(M);
-        m_eigen_values.segment(i*dim, dim) = m_solver.eigenvalues().real();
-        m_eigen_vectors.block(i*dim, 0, dim, dim) =
-            m_solver.eigenvectors().real();
+    if (matrices.size() % flatten_size != 0) {
+        throw RuntimeError("Batch size is not a multiple of 3");
     }
+    const size_t num_matrices = matrices.size() / flatten_size;
+    m_batch_eigen_values.resize(dim, num_matrices);
+    m_batch_eigen_vectors.resize(dim * dim, num_matrices);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_matrices, LANES * 64),
+            [&](const tbb::blocked_range<size_t>& r) {
+                decompose_2x2(matrices.data(), r.begin(), r.end(),
+                        num_matrices, m_batch_eigen_values.data(),
+                        m_batch_eigen_vectors.data());
+            });
 }
 
 void EigenSolver::compute_batch_symmetric_3x3(const VectorF& matrices) {
     const size_t dim = 3;
     const size_t flatten_size = 6;
-    const size_t num_matrices = matrices.size() / flatten_size;
-    m_eigen_values = VectorF(num_matrices * dim);
-    m_eigen_vectors = MatrixF(num_matrices * dim, dim);
-    for (size_t i=0; i<num_matrices; i++) {
-        const VectorF& entries = matrices.segment(i*flatten_size, flatten_size);
-        MatrixF M(dim, dim);
-        size_t base_idx = i*flatten_size;
-        M << matrices[base_idx  ], matrices[base_idx+5], matrices[base_idx+4],
-             matrices[base_idx+5], matrices[base_idx+1], matrices[base_idx+3],
-             matrices[base_idx+4], matrices[base_idx+3], matrices[base_idx+2];
-        m_solver.compute(M);
-        m_eigen_values.segment(i*dim, dim) = m_solver.eigenvalues().real();
-        m_eigen_vectors.block(i*dim, 0, dim, dim) =
-            m_solver.eigenvectors().real();
+    if (matrices.size() % flatten_size != 0) {
+        throw RuntimeError("Batch size is not a multiple of 6");
     }
+    const size_t num_matrices = matrices.size() / flatten_size;
+    m_batch_eigen_values.resize(dim, num_matrices);
+    m_batch_eigen_vectors.resize(dim * dim, num_matrices);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_matrices, LANES * 32),
+            [&](const tbb::blocked_range<size_t>& r) {
+                decompose_3x3(matrices.data(), r.begin(), r.end(),
+                        num_matrices, m_batch_eigen_values.data(),
+                        m_batch_eigen_vectors.data());
+            });
 }
-
@@ -14,11 +14,36 @@ class EigenSolver {
 
         void compute(const MatrixF& matrix);
 
-        void compute_batch_symmetric(size_t dim, VectorF matrices);
+        /**
+         * Eigen decomposition of a batch of symmetric 2x2 or 3x3 matrices,
+         * flattened as (xx, yy, xy) in 2D and (xx, yy, zz, yz, xz, xy) in 3D.
+         * Eigen values are sorted in ascending order.  Results are stored in
+         * the per-matrix layout of get_eigen_values() and
+         * get_eigen_vectors(), i.e. rows [i*dim, (i+1)*dim) hold the
+         * decomposition of matrix i with eigen vectors as columns.
+         */
+        void compute_batch_symmetric(size_t dim, const VectorF& matrices);
+
+        /**
+         * Same as compute_batch_symmetric(), but results are stored in
+         * structure of arrays layout with one column per matrix:
+         *   - get_batch_eigen_values() is dim x #matrices, row k holds the
+         *     k-th smallest eigen value.
+         *   - get_batch_eigen_vectors() is dim*dim x #matrices, row k*dim+j
+         *     holds the j-th coordinate of the k-th eigen vector.
+         */
+        void compute_batch_symmetric_soa(size_t dim, const VectorF& matrices);
 
         VectorF get_eigen_values() const { return m_eigen_values; }
         MatrixF get_eigen_vectors() const { return m_eigen_vectors; }
 
+        const MatrixFr& get_batch_eigen_values() const {
+            return m_batch_eigen_values;
+        }
+        const MatrixFr& get_batch_eigen_vectors() const {
+            return m_batch_eigen_vectors;
+        }
+
     private:
         void compute_batch_symmetric_2x2(const VectorF& matrices);
         void compute_batch_symmetric_3x3(const VectorF& matrices);
@@ -31,6 +56,8 @@ class EigenSolver {
         Solver m_solver;
         VectorF m_eigen_values;
         MatrixF m_eigen_vectors;
+        MatrixFr m_batch_eigen_values;
+        MatrixFr m_batch_eigen_vectors;
 };
 
 }
@@ -0,0 +1,128 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
+
+namespace PyMesh {
+
+/**
+ * Bit-packed occupancy grid.
+ *
+ * Cells are stored as rows of 64-bit words along the last axis, i.e. cell
+ * (i, j, k) lives in bit k%64 of word k/64 of row (i, j).  Morphology
+ * operations are implemented as separable word-parallel passes and are
+ * distributed over rows with TBB.
+ */
+template<int DIM>
+class BitGrid {
+    public:
+        typedef uint64_t Word;
+        typedef Eigen::Matrix<Float, DIM, 1> Vector_f;
+        typedef Eigen::Matrix<int, DIM, 1> Vector_i;
+        typedef std::function<void(const Vector_i&)> CellVisitor;
+
+        static const size_t WORD_SIZE = 64;
+
+        BitGrid(const Float cell_size) {
+            m_cell_size = Vector_f::Ones() * cell_size;
+            m_grid_size.setZero();
+            m_grid_base_coord.setZero();
+            m_num_rows = 0;
+            m_words_per_row = 0;
+            m_tail_mask = 0;
+        }
+        virtual ~BitGrid() = default;
+
+        void initialize(const Vector_i& size, const Vector_f& base_coord);
+
+        const Vector_i& size() const { return m_grid_size; }
+        const Vector_f& base_coordinates() const { return m_grid_base_coord; }
+        const Vector_f& cell_size() const { return m_cell_size; }
+
+        bool is_valid_index(const Vector_i& index) const {
+            return ((index.array()>=0).all() && (index.array()<m_grid_size.array()).all());
+        }
+
+        bool is_inside(const Vector_f& coordinates) const {
+            return is_valid_index(coordinate_to_index(coordinates));
+        }
+
+        bool operator()(const Vector_i& index) const;
+        void set(const Vector_i& index, bool value);
+
+        bool lookup(const Vector_f& coordinates) const {
+            return this->operator()(coordinate_to_index(coordinates));
+        }
+        void set_at(const Vector_f& coordinates, bool value) {
+            set(coordinate_to_index(coordinates), value);
+        }
+
+        size_t get_num_occupied_cells() const;
+        void for_each_occupied_cell(const CellVisitor& visitor) const;
+
+    public:
+        /**
+         * Each cell becomes the AND of its 3^DIM neighborhood.  Neighbors
+         * outside of the grid are ignored.
+         */
+        void erode_cells(size_t iterations);
+
+        /**
+         * Each cell becomes the OR of its 3^DIM neighborhood.  Neighbors
+         * outside of the grid are ignored.
+         */
+        void dilate_cells(size_t iterations);
+
+        /**
+         * Flood the empty cells 6-connected (4-connected in 2D) to the base
+         * cell and mark every other empty cell as occupied.
+         */
+        void fill_cavities();
+
+    protected:
+        typedef std::vector<Word> WordArray;
+
+        Vector_i coordinate_to_index(const Vector_f& coordinates) const {
+            return (coordinates - m_grid_base_coord)
+                .cwiseQuotient(m_cell_size)
+                .unaryExpr([](Float x) { return std::round(x); })
+                .template cast<int>();
+        }
+
+        Vector_f get_cell_center(const Vector_i& index) const {
+            return m_grid_base_coord + m_cell_size.cwiseProduct(
+                    index.template cast<Float>());
+        }
+
+        size_t row_index(const Vector_i& index) const;
+        size_t row_stride(size_t axis) const;
+
+        void morph_along_rows(const WordArray& in, WordArray& out,
+                bool is_erosion) const;
+        void morph_across_rows(size_t axis, const WordArray& in,
+                WordArray& out, bool is_erosion) const;
+        void morph(size_t iterations, bool is_erosion);
+
+        bool fill_row(Word* reach, const Word* open) const;
+        void sweep(size_t axis, bool forward,
+                WordArray& reach, const WordArray& open) const;
+        size_t count_bits(const WordArray& words) const;
+
+    protected:
+        WordArray m_bits;
+        Vector_i m_grid_size;
+        Vector_f m_grid_base_coord;
+        Vector_f m_cell_size;
+        size_t m_num_rows;
+        size_t m_words_per_row;
+        Word m_tail_mask;
+};
+
+}
+
+#include "BitGrid.inl"
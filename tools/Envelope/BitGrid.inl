@@ -0,0 +1,339 @@
+#include <cassert>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+using namespace PyMesh;
+
+namespace BitGridHelper {
+    typedef uint64_t Word;
+    const Word ALL_ONES = ~Word(0);
+
+    inline size_t popcount(Word w) {
+        return __builtin_popcountll(w);
+    }
+
+    /**
+     * Propagate seed bits towards higher bit positions through consecutive
+     * bits of mask (Kogge-Stone occluded fill).
+     */
+    inline Word fill_up(Word seeds, Word mask) {
+        seeds |= mask & (seeds << 1);  mask &= (mask << 1);
+        seeds |= mask & (seeds << 2);  mask &= (mask << 2);
+        seeds |= mask & (seeds << 4);  mask &= (mask << 4);
+        seeds |= mask & (seeds << 8);  mask &= (mask << 8);
+        seeds |= mask & (seeds << 16); mask &= (mask << 16);
+        seeds |= mask & (seeds << 32);
+        return seeds;
+    }
+
+    inline Word fill_down(Word seeds, Word mask) {
+        seeds |= mask & (seeds >> 1);  mask &= (mask >> 1);
+        seeds |= mask & (seeds >> 2);  mask &= (mask >> 2);
+        seeds |= mask & (seeds >> 4);  mask &= (mask >> 4);
+        seeds |= mask & (seeds >> 8);  mask &= (mask >> 8);
+        seeds |= mask & (seeds >> 16); mask &= (mask >> 16);
+        seeds |= mask & (seeds >> 32);
+        return seeds;
+    }
+}
+
+template<int DIM>
+void BitGrid<DIM>::initialize(const Vector_i& size, const Vector_f& base_coord) {
+    if ((size.array() <= 0).any()) {
+        std::stringstream err_msg;
+        err_msg << "Invalid grid size: " << size.transpose();
+        throw RuntimeError(err_msg.str());
+    }
+    m_grid_size = size;
+    m_grid_base_coord = base_coord;
+
+    const size_t row_length = m_grid_size[DIM-1];
+    m_num_rows = 1;
+    for (size_t i=0; i<DIM-1; i++) m_num_rows *= m_grid_size[i];
+    m_words_per_row = (row_length + WORD_SIZE - 1) / WORD_SIZE;
+    const size_t tail_bits = row_length % WORD_SIZE;
+    m_tail_mask = (tail_bits == 0) ?
+        BitGridHelper::ALL_ONES : ((Word(1) << tail_bits) - 1);
+
+    m_bits = WordArray(m_num_rows * m_words_per_row, 0);
+}
+
+template<int DIM>
+bool BitGrid<DIM>::operator()(const Vector_i& index) const {
+    assert(is_valid_index(index));
+    const size_t k = index[DIM-1];
+    const Word w = m_bits[row_index(index) * m_words_per_row + k / WORD_SIZE];
+    return (w >> (k % WORD_SIZE)) & 1;
+}
+
+template<int DIM>
+void BitGrid<DIM>::set(const Vector_i& index, bool value) {
+    assert(is_valid_index(index));
+    const size_t k = index[DIM-1];
+    Word& w = m_bits[row_index(index) * m_words_per_row + k / WORD_SIZE];
+    const Word bit = Word(1) << (k % WORD_SIZE);
+    if (value) w |= bit;
+    else w &= ~bit;
+}
+
+template<int DIM>
+size_t BitGrid<DIM>::get_num_occupied_cells() const {
+    return count_bits(m_bits);
+}
+
+template<int DIM>
+void BitGrid<DIM>::for_each_occupied_cell(const CellVisitor& visitor) const {
+    Vector_i index;
+    for (size_t r=0; r<m_num_rows; r++) {
+        size_t row = r;
+        for (int i=DIM-2; i>=0; i--) {
+            index[i] = row % m_grid_size[i];
+            row /= m_grid_size[i];
+        }
+        const Word* words = m_bits.data() + r * m_words_per_row;
+        for (size_t w=0; w<m_words_per_row; w++) {
+            Word bits = words[w];
+            while (bits != 0) {
+                const size_t b = __builtin_ctzll(bits);
+                index[DIM-1] = w * WORD_SIZE + b;
+                visitor(index);
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+template<int DIM>
+void BitGrid<DIM>::erode_cells(size_t iterations) {
+    morph(iterations, true);
+}
+
+template<int DIM>
+void BitGrid<DIM>::dilate_cells(size_t iterations) {
+    morph(iterations, false);
+}
+
+template<int DIM>
+void BitGrid<DIM>::fill_cavities() {
+    if (m_bits.empty()) return;
+    const size_t num_words = m_bits.size();
+    const size_t last_word = m_words_per_row - 1;
+
+    WordArray open(num_words);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t row=r.begin(); row<r.end(); row++) {
+                    const size_t offset = row * m_words_per_row;
+                    for (size_t w=0; w<m_words_per_row; w++) {
+                        open[offset+w] = ~m_bits[offset+w];
+                    }
+                    open[offset+last_word] &= m_tail_mask;
+                }
+            });
+
+    // Seed at the base cell.
+    WordArray reach(num_words, 0);
+    reach[0] = open[0] & 1;
+
+    // Alternate row fills and axis sweeps until the reachable set stops
+    // growing.  Sweeps are Gauss-Seidel style, so a front travels across the
+    // whole grid in a single pass and only turns cost extra rounds.
+    fill_row(reach.data(), open.data());
+    size_t num_reached = count_bits(reach);
+    while (true) {
+        for (size_t axis=0; axis+1<DIM; axis++) {
+            sweep(axis, true, reach, open);
+            sweep(axis, false, reach, open);
+        }
+        const size_t count = count_bits(reach);
+        if (count == num_reached) break;
+        num_reached = count;
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t row=r.begin(); row<r.end(); row++) {
+                    const size_t offset = row * m_words_per_row;
+                    for (size_t w=0; w<m_words_per_row; w++) {
+                        m_bits[offset+w] = ~reach[offset+w];
+                    }
+                    m_bits[offset+last_word] &= m_tail_mask;
+                }
+            });
+}
+
+template<int DIM>
+size_t BitGrid<DIM>::row_index(const Vector_i& index) const {
+    size_t row = 0;
+    for (size_t i=0; i<DIM-1; i++) {
+        row *= m_grid_size[i];
+        row += index[i];
+    }
+    return row;
+}
+
+template<int DIM>
+size_t BitGrid<DIM>::row_stride(size_t axis) const {
+    assert(axis < DIM-1);
+    size_t stride = 1;
+    for (size_t i=axis+1; i<DIM-1; i++) stride *= m_grid_size[i];
+    return stride;
+}
+
+template<int DIM>
+void BitGrid<DIM>::morph_along_rows(const WordArray& in, WordArray& out,
+        bool is_erosion) const {
+    using namespace BitGridHelper;
+    const size_t last_word = m_words_per_row - 1;
+    // Neighbors outside of the grid are ignored, i.e. treated as the
+    // identity of the reduction: ones for erosion and zeros for dilation.
+    const Word pad = is_erosion ? ALL_ONES : 0;
+    const Word tail_pad = is_erosion ? ~m_tail_mask : 0;
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t row=r.begin(); row<r.end(); row++) {
+                    const Word* src = in.data() + row * m_words_per_row;
+                    Word* dst = out.data() + row * m_words_per_row;
+                    for (size_t w=0; w<=last_word; w++) {
+                        const Word prev = (w > 0) ? src[w-1] : pad;
+                        const Word curr = src[w] | (w == last_word ? tail_pad : 0);
+                        const Word next = (w < last_word) ? src[w+1] : pad;
+                        const Word lower = (curr << 1) | (prev >> 63);
+                        const Word upper = (curr >> 1) | (next << 63);
+                        if (is_erosion) {
+                            dst[w] = curr & lower & upper;
+                        } else {
+                            dst[w] = curr | lower | upper;
+                        }
+                    }
+                    dst[last_word] &= m_tail_mask;
+                }
+            });
+}
+
+template<int DIM>
+void BitGrid<DIM>::morph_across_rows(size_t axis, const WordArray& in,
+        WordArray& out, bool is_erosion) const {
+    const size_t stride = row_stride(axis);
+    const size_t extent = m_grid_size[axis];
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t row=r.begin(); row<r.end(); row++) {
+                    const size_t coord = (row / stride) % extent;
+                    const Word* src = in.data() + row * m_words_per_row;
+                    const Word* prev = (coord > 0) ?
+                        src - stride * m_words_per_row : nullptr;
+                    const Word* next = (coord+1 < extent) ?
+                        src + stride * m_words_per_row : nullptr;
+                    Word* dst = out.data() + row * m_words_per_row;
+                    for (size_t w=0; w<m_words_per_row; w++) {
+                        Word value = src[w];
+                        if (is_erosion) {
+                            if (prev != nullptr) value &= prev[w];
+                            if (next != nullptr) value &= next[w];
+                        } else {
+                            if (prev != nullptr) value |= prev[w];
+                            if (next != nullptr) value |= next[w];
+                        }
+                        dst[w] = value;
+                    }
+                }
+            });
+}
+
+template<int DIM>
+void BitGrid<DIM>::morph(size_t iterations, bool is_erosion) {
+    if (m_bits.empty()) return;
+    WordArray buffer(m_bits.size());
+    for (size_t i=0; i<iterations; i++) {
+        // The 3^DIM box is the product of 1D windows, so one pass per axis
+        // is enough.
+        morph_along_rows(m_bits, buffer, is_erosion);
+        std::swap(m_bits, buffer);
+        for (size_t axis=0; axis+1<DIM; axis++) {
+            morph_across_rows(axis, m_bits, buffer, is_erosion);
+            std::swap(m_bits, buffer);
+        }
+    }
+}
+
+/**
+ * Flood reach within its row through open cells.  Returns true if any bit
+ * is added.
+ */
+template<int DIM>
+bool BitGrid<DIM>::fill_row(Word* reach, const Word* open) const {
+    using namespace BitGridHelper;
+    bool changed = false;
+    Word carry = 0;
+    for (size_t w=0; w<m_words_per_row; w++) {
+        const Word seeds = reach[w] | (carry & open[w]);
+        const Word filled = fill_up(seeds, open[w]);
+        changed = changed || (filled != reach[w]);
+        reach[w] = filled;
+        carry = filled >> 63;
+    }
+    carry = 0;
+    for (size_t w=m_words_per_row; w>0; w--) {
+        const Word seeds = reach[w-1] | (carry & open[w-1]);
+        const Word filled = fill_down(seeds, open[w-1]);
+        changed = changed || (filled != reach[w-1]);
+        reach[w-1] = filled;
+        carry = (filled & 1) << 63;
+    }
+    return changed;
+}
+
+/**
+ * Propagate reach along the given row axis.  Lines parallel to the axis are
+ * independent and processed concurrently.
+ */
+template<int DIM>
+void BitGrid<DIM>::sweep(size_t axis, bool forward,
+        WordArray& reach, const WordArray& open) const {
+    const size_t stride = row_stride(axis);
+    const size_t extent = m_grid_size[axis];
+    const size_t num_lines = m_num_rows / extent;
+    const size_t words_per_step = stride * m_words_per_row;
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_lines),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t line=r.begin(); line<r.end(); line++) {
+                    const size_t first_row =
+                        (line / stride) * stride * extent + line % stride;
+                    for (size_t t=1; t<extent; t++) {
+                        const size_t step = forward ? t : extent - 1 - t;
+                        const size_t row = first_row + step * stride;
+                        Word* curr = reach.data() + row * m_words_per_row;
+                        const Word* src = forward ?
+                            curr - words_per_step : curr + words_per_step;
+                        const Word* mask = open.data() + row * m_words_per_row;
+
+                        bool grown = false;
+                        for (size_t w=0; w<m_words_per_row; w++) {
+                            const Word added = src[w] & mask[w] & ~curr[w];
+                            if (added != 0) {
+                                curr[w] |= added;
+                                grown = true;
+                            }
+                        }
+                        if (grown) fill_row(curr, mask);
+                    }
+                }
+            });
+}
+
+template<int DIM>
+size_t BitGrid<DIM>::count_bits(const WordArray& words) const {
+    return tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, words.size()), size_t(0),
+            [&words](const tbb::blocked_range<size_t>& r, size_t count) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                    count += BitGridHelper::popcount(words[i]);
+                }
+                return count;
+            }, std::plus<size_t>());
+}
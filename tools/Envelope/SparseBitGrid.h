@@ -0,0 +1,141 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
+
+namespace PyMesh {
+
+/**
+ * Sparse bit-packed occupancy grid.
+ *
+ * The grid is tiled into leaf blocks of 8^DIM cells.  Partially occupied
+ * blocks are stored in a hash map keyed by their linearized block index,
+ * fully occupied blocks are only flagged in a per-block bit vector and
+ * empty blocks are not stored at all.  Within a block, the local cell index
+ * is row major (last axis fastest), i.e. a 3D block is 8 words of 8x8 slabs
+ * and a 2D block is a single word.
+ *
+ * The interface mirrors BitGrid so that VoxelGrid can use either storage.
+ */
+template<int DIM>
+class SparseBitGrid {
+    public:
+        typedef uint64_t Word;
+        typedef Eigen::Matrix<Float, DIM, 1> Vector_f;
+        typedef Eigen::Matrix<int, DIM, 1> Vector_i;
+        typedef std::function<void(const Vector_i&)> CellVisitor;
+
+        static const size_t WORD_SIZE = 64;
+        static const size_t BLOCK_WIDTH = 8;
+        static const size_t BLOCK_CELLS = DIM == 3 ? 512 : 64;
+        static const size_t BLOCK_WORDS = BLOCK_CELLS / WORD_SIZE;
+        typedef std::array<Word, BLOCK_WORDS> Block;
+
+        SparseBitGrid(const Float cell_size) {
+            static_assert(DIM == 2 || DIM == 3, "Only 2D and 3D are supported");
+            m_cell_size = Vector_f::Ones() * cell_size;
+            m_grid_size.setZero();
+            m_grid_base_coord.setZero();
+            m_num_blocks.setZero();
+        }
+        virtual ~SparseBitGrid() = default;
+
+        void initialize(const Vector_i& size, const Vector_f& base_coord);
+
+        const Vector_i& size() const { return m_grid_size; }
+        const Vector_f& base_coordinates() const { return m_grid_base_coord; }
+        const Vector_f& cell_size() const { return m_cell_size; }
+
+        bool is_valid_index(const Vector_i& index) const {
+            return ((index.array()>=0).all() && (index.array()<m_grid_size.array()).all());
+        }
+
+        bool is_inside(const Vector_f& coordinates) const {
+            return is_valid_index(coordinate_to_index(coordinates));
+        }
+
+        bool operator()(const Vector_i& index) const;
+        void set(const Vector_i& index, bool value);
+
+        bool lookup(const Vector_f& coordinates) const {
+            return this->operator()(coordinate_to_index(coordinates));
+        }
+        void set_at(const Vector_f& coordinates, bool value) {
+            set(coordinate_to_index(coordinates), value);
+        }
+
+        size_t get_num_occupied_cells() const;
+        size_t get_num_allocated_blocks() const { return m_blocks.size(); }
+        void for_each_occupied_cell(const CellVisitor& visitor) const;
+
+    public:
+        /**
+         * Each cell becomes the AND of its 3^DIM neighborhood.  Neighbors
+         * outside of the grid are ignored.
+         */
+        void erode_cells(size_t iterations);
+
+        /**
+         * Each cell becomes the OR of its 3^DIM neighborhood.  Neighbors
+         * outside of the grid are ignored.
+         */
+        void dilate_cells(size_t iterations);
+
+        /**
+         * Flood the empty cells 6-connected (4-connected in 2D) to the base
+         * cell and mark every other empty cell as occupied.
+         */
+        void fill_cavities();
+
+    protected:
+        typedef std::unordered_map<size_t, Block> BlockMap;
+
+        Vector_i coordinate_to_index(const Vector_f& coordinates) const {
+            return (coordinates - m_grid_base_coord)
+                .cwiseQuotient(m_cell_size)
+                .unaryExpr([](Float x) { return std::round(x); })
+                .template cast<int>();
+        }
+
+        Vector_f get_cell_center(const Vector_i& index) const {
+            return m_grid_base_coord + m_cell_size.cwiseProduct(
+                    index.template cast<Float>());
+        }
+
+        size_t block_key(const Vector_i& block_index) const;
+        Vector_i block_index(size_t key) const;
+        size_t local_index(const Vector_i& local_coordinates) const;
+        Vector_i local_coordinates(size_t l) const;
+        bool get_neighbor_key(size_t key, size_t axis, bool forward,
+                size_t& neighbor_key) const;
+
+        /**
+         * Cells of the block that lie within the grid.
+         */
+        Block get_inside_mask(const Vector_i& block_index) const;
+        Block get_block(size_t key) const;
+        void store_block(size_t key, const Block& block, const Block& inside);
+        std::vector<size_t> get_occupied_blocks() const;
+
+        void morph_along_axis(size_t axis, bool is_erosion);
+        void morph(size_t iterations, bool is_erosion);
+
+    protected:
+        BlockMap m_blocks;
+        std::vector<bool> m_full_blocks;
+        Vector_i m_grid_size;
+        Vector_i m_num_blocks;
+        Vector_f m_grid_base_coord;
+        Vector_f m_cell_size;
+};
+
+}
+
+#include "SparseBitGrid.inl"
@@ -0,0 +1,514 @@
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+using namespace PyMesh;
+
+namespace SparseBitGridHelper {
+    typedef uint64_t Word;
+    const Word ALL_ONES = ~Word(0);
+
+    template<typename Block>
+    Block make_block(Word value) {
+        Block block;
+        block.fill(value);
+        return block;
+    }
+
+    template<typename Block>
+    bool is_zero(const Block& block) {
+        for (const auto w : block) {
+            if (w != 0) return false;
+        }
+        return true;
+    }
+
+    template<typename Block>
+    size_t count_bits(const Block& block) {
+        size_t count = 0;
+        for (const auto w : block) {
+            count += __builtin_popcountll(w);
+        }
+        return count;
+    }
+
+    /**
+     * Number of bits between consecutive cells along the given axis within
+     * a block.
+     */
+    template<int DIM>
+    size_t get_axis_stride(size_t axis) {
+        size_t stride = 1;
+        for (size_t i=axis+1; i<DIM; i++) stride *= 8;
+        return stride;
+    }
+
+    /**
+     * Bits within a word whose local coordinate along the axis is 0.
+     */
+    inline Word get_first_slab_mask(size_t stride) {
+        Word mask = 0;
+        for (size_t i=0; i<64; i++) {
+            if ((i / stride) % 8 == 0) mask |= Word(1) << i;
+        }
+        return mask;
+    }
+
+    /**
+     * Each cell takes the value of its predecessor along the axis.  Cells at
+     * local coordinate 0 take the value of the last slab of prev.
+     */
+    template<int DIM, typename Block>
+    Block shift_from_prev(const Block& in, const Block& prev, size_t axis) {
+        const size_t stride = get_axis_stride<DIM>(axis);
+        const size_t num_words = in.size();
+        Block out;
+        if (stride < 64) {
+            const Word first = get_first_slab_mask(stride);
+            for (size_t i=0; i<num_words; i++) {
+                out[i] = ((in[i] << stride) & ~first) |
+                    ((prev[i] >> (7*stride)) & first);
+            }
+        } else {
+            const size_t word_stride = stride / 64;
+            for (size_t i=0; i<num_words; i++) {
+                const size_t coord = (i / word_stride) % 8;
+                out[i] = (coord > 0) ?
+                    in[i - word_stride] : prev[i + 7*word_stride];
+            }
+        }
+        return out;
+    }
+
+    /**
+     * Each cell takes the value of its successor along the axis.  Cells at
+     * local coordinate 7 take the value of the first slab of next.
+     */
+    template<int DIM, typename Block>
+    Block shift_from_next(const Block& in, const Block& next, size_t axis) {
+        const size_t stride = get_axis_stride<DIM>(axis);
+        const size_t num_words = in.size();
+        Block out;
+        if (stride < 64) {
+            const Word last = get_first_slab_mask(stride) << (7*stride);
+            for (size_t i=0; i<num_words; i++) {
+                out[i] = ((in[i] >> stride) & ~last) |
+                    ((next[i] << (7*stride)) & last);
+            }
+        } else {
+            const size_t word_stride = stride / 64;
+            for (size_t i=0; i<num_words; i++) {
+                const size_t coord = (i / word_stride) % 8;
+                out[i] = (coord < 7) ?
+                    in[i + word_stride] : next[i - 7*word_stride];
+            }
+        }
+        return out;
+    }
+
+    /**
+     * Flood reach through open cells within a single block.
+     */
+    template<int DIM, typename Block>
+    Block flood_block(Block reach, const Block& open) {
+        const Block zero = make_block<Block>(0);
+        while (true) {
+            Block grown = reach;
+            for (size_t axis=0; axis<DIM; axis++) {
+                const Block prev = shift_from_prev<DIM>(reach, zero, axis);
+                const Block next = shift_from_next<DIM>(reach, zero, axis);
+                for (size_t i=0; i<grown.size(); i++) {
+                    grown[i] |= (prev[i] | next[i]) & open[i];
+                }
+            }
+            if (grown == reach) break;
+            reach = grown;
+        }
+        return reach;
+    }
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::initialize(const Vector_i& size, const Vector_f& base_coord) {
+    if ((size.array() <= 0).any()) {
+        std::stringstream err_msg;
+        err_msg << "Invalid grid size: " << size.transpose();
+        throw RuntimeError(err_msg.str());
+    }
+    m_grid_size = size;
+    m_grid_base_coord = base_coord;
+    m_num_blocks = (m_grid_size.array() + int(BLOCK_WIDTH - 1)) / int(BLOCK_WIDTH);
+
+    size_t total_num_blocks = 1;
+    for (size_t i=0; i<DIM; i++) total_num_blocks *= m_num_blocks[i];
+
+    m_blocks.clear();
+    m_full_blocks.assign(total_num_blocks, false);
+}
+
+template<int DIM>
+bool SparseBitGrid<DIM>::operator()(const Vector_i& index) const {
+    assert(is_valid_index(index));
+    const Vector_i bi = index / int(BLOCK_WIDTH);
+    const size_t key = block_key(bi);
+    if (m_full_blocks[key]) return true;
+
+    auto itr = m_blocks.find(key);
+    if (itr == m_blocks.end()) return false;
+    const size_t l = local_index(index - bi * int(BLOCK_WIDTH));
+    return (itr->second[l / WORD_SIZE] >> (l % WORD_SIZE)) & 1;
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::set(const Vector_i& index, bool value) {
+    assert(is_valid_index(index));
+    const Vector_i bi = index / int(BLOCK_WIDTH);
+    const size_t key = block_key(bi);
+    const size_t l = local_index(index - bi * int(BLOCK_WIDTH));
+    const Word bit = Word(1) << (l % WORD_SIZE);
+
+    Block block = get_block(key);
+    if (value) block[l / WORD_SIZE] |= bit;
+    else block[l / WORD_SIZE] &= ~bit;
+
+    m_blocks.erase(key);
+    m_full_blocks[key] = false;
+    store_block(key, block, get_inside_mask(bi));
+}
+
+template<int DIM>
+size_t SparseBitGrid<DIM>::get_num_occupied_cells() const {
+    size_t count = 0;
+    for (const auto& entry : m_blocks) {
+        count += SparseBitGridHelper::count_bits(entry.second);
+    }
+    const size_t total_num_blocks = m_full_blocks.size();
+    for (size_t key=0; key<total_num_blocks; key++) {
+        if (m_full_blocks[key]) {
+            count += SparseBitGridHelper::count_bits(
+                    get_inside_mask(block_index(key)));
+        }
+    }
+    return count;
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::for_each_occupied_cell(const CellVisitor& visitor) const {
+    const std::vector<size_t> keys = get_occupied_blocks();
+    for (const auto key : keys) {
+        const Vector_i offset = block_index(key) * int(BLOCK_WIDTH);
+        const Block block = get_block(key);
+        for (size_t w=0; w<BLOCK_WORDS; w++) {
+            Word bits = block[w];
+            while (bits != 0) {
+                const size_t l = w * WORD_SIZE + __builtin_ctzll(bits);
+                visitor(offset + local_coordinates(l));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::erode_cells(size_t iterations) {
+    morph(iterations, true);
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::dilate_cells(size_t iterations) {
+    morph(iterations, false);
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::fill_cavities() {
+    using namespace SparseBitGridHelper;
+    const size_t total_num_blocks = m_full_blocks.size();
+    if (total_num_blocks == 0) return;
+
+    // Blocks that are not allocated are entirely empty, so they are tracked
+    // with a single flag.  Partial blocks keep a per-cell reach mask.
+    std::vector<bool> reached_empty(total_num_blocks, false);
+    BlockMap reach;
+    std::queue<size_t> Q;
+
+    auto get_open_mask = [this](size_t key, const Block& bits) {
+        Block open = get_inside_mask(block_index(key));
+        for (size_t i=0; i<BLOCK_WORDS; i++) open[i] &= ~bits[i];
+        return open;
+    };
+
+    // Seed at the base cell.
+    const size_t seed_key = 0;
+    if (!m_full_blocks[seed_key]) {
+        auto itr = m_blocks.find(seed_key);
+        if (itr == m_blocks.end()) {
+            reached_empty[seed_key] = true;
+            Q.push(seed_key);
+        } else if ((itr->second[0] & 1) == 0) {
+            Block seed = make_block<Block>(0);
+            seed[0] = 1;
+            reach[seed_key] = flood_block<DIM>(seed,
+                    get_open_mask(seed_key, itr->second));
+            Q.push(seed_key);
+        }
+    }
+
+    const Block zero = make_block<Block>(0);
+    while (!Q.empty()) {
+        const size_t key = Q.front();
+        Q.pop();
+        const Block curr_reach = reached_empty[key] ?
+            get_inside_mask(block_index(key)) : reach[key];
+
+        for (size_t axis=0; axis<DIM; axis++) {
+            for (size_t forward=0; forward<2; forward++) {
+                size_t neighbor_key;
+                if (!get_neighbor_key(key, axis, forward, neighbor_key)) continue;
+                if (m_full_blocks[neighbor_key]) continue;
+
+                const Block seeds = forward ?
+                    shift_from_prev<DIM>(zero, curr_reach, axis) :
+                    shift_from_next<DIM>(zero, curr_reach, axis);
+                if (is_zero(seeds)) continue;
+
+                auto itr = m_blocks.find(neighbor_key);
+                if (itr == m_blocks.end()) {
+                    if (!reached_empty[neighbor_key]) {
+                        reached_empty[neighbor_key] = true;
+                        Q.push(neighbor_key);
+                    }
+                    continue;
+                }
+
+                const Block open = get_open_mask(neighbor_key, itr->second);
+                Block& neighbor_reach = reach.emplace(
+                        neighbor_key, zero).first->second;
+                bool grown = false;
+                for (size_t i=0; i<BLOCK_WORDS; i++) {
+                    if ((seeds[i] & open[i] & ~neighbor_reach[i]) != 0) {
+                        grown = true;
+                        break;
+                    }
+                }
+                if (!grown) continue;
+                for (size_t i=0; i<BLOCK_WORDS; i++) {
+                    neighbor_reach[i] |= seeds[i] & open[i];
+                }
+                neighbor_reach = flood_block<DIM>(neighbor_reach, open);
+                Q.push(neighbor_key);
+            }
+        }
+    }
+
+    // Everything not reached from the base cell is solid.
+    BlockMap filled;
+    std::vector<bool> full_blocks(total_num_blocks, false);
+    for (size_t key=0; key<total_num_blocks; key++) {
+        if (m_full_blocks[key]) {
+            full_blocks[key] = true;
+            continue;
+        }
+        const Block inside = get_inside_mask(block_index(key));
+        if (m_blocks.find(key) == m_blocks.end()) {
+            if (!reached_empty[key]) full_blocks[key] = true;
+            continue;
+        }
+        auto itr = reach.find(key);
+        Block block = inside;
+        if (itr != reach.end()) {
+            for (size_t i=0; i<BLOCK_WORDS; i++) block[i] &= ~itr->second[i];
+        }
+        if (block == inside) full_blocks[key] = true;
+        else filled[key] = block;
+    }
+    m_blocks.swap(filled);
+    m_full_blocks.swap(full_blocks);
+}
+
+template<int DIM>
+size_t SparseBitGrid<DIM>::block_key(const Vector_i& block_index) const {
+    size_t key = 0;
+    for (size_t i=0; i<DIM; i++) {
+        key *= m_num_blocks[i];
+        key += block_index[i];
+    }
+    return key;
+}
+
+template<int DIM>
+typename SparseBitGrid<DIM>::Vector_i SparseBitGrid<DIM>::block_index(
+        size_t key) const {
+    Vector_i index;
+    for (int i=DIM-1; i>=0; i--) {
+        index[i] = key % m_num_blocks[i];
+        key /= m_num_blocks[i];
+    }
+    return index;
+}
+
+template<int DIM>
+size_t SparseBitGrid<DIM>::local_index(const Vector_i& local_coordinates) const {
+    size_t l = 0;
+    for (size_t i=0; i<DIM; i++) {
+        l *= BLOCK_WIDTH;
+        l += local_coordinates[i];
+    }
+    return l;
+}
+
+template<int DIM>
+typename SparseBitGrid<DIM>::Vector_i SparseBitGrid<DIM>::local_coordinates(
+        size_t l) const {
+    Vector_i coordinates;
+    for (int i=DIM-1; i>=0; i--) {
+        coordinates[i] = l % BLOCK_WIDTH;
+        l /= BLOCK_WIDTH;
+    }
+    return coordinates;
+}
+
+template<int DIM>
+bool SparseBitGrid<DIM>::get_neighbor_key(size_t key, size_t axis,
+        bool forward, size_t& neighbor_key) const {
+    Vector_i index = block_index(key);
+    index[axis] += forward ? 1 : -1;
+    if (index[axis] < 0 || index[axis] >= m_num_blocks[axis]) return false;
+    neighbor_key = block_key(index);
+    return true;
+}
+
+template<int DIM>
+typename SparseBitGrid<DIM>::Block SparseBitGrid<DIM>::get_inside_mask(
+        const Vector_i& block_index) const {
+    using namespace SparseBitGridHelper;
+    const Vector_i limit = (m_grid_size - block_index * int(BLOCK_WIDTH))
+        .cwiseMin(Vector_i::Ones() * int(BLOCK_WIDTH));
+    if ((limit.array() == int(BLOCK_WIDTH)).all()) {
+        return make_block<Block>(ALL_ONES);
+    }
+
+    Block mask = make_block<Block>(0);
+    for (size_t l=0; l<BLOCK_CELLS; l++) {
+        if ((local_coordinates(l).array() < limit.array()).all()) {
+            mask[l / WORD_SIZE] |= Word(1) << (l % WORD_SIZE);
+        }
+    }
+    return mask;
+}
+
+template<int DIM>
+typename SparseBitGrid<DIM>::Block SparseBitGrid<DIM>::get_block(
+        size_t key) const {
+    using namespace SparseBitGridHelper;
+    if (m_full_blocks[key]) return get_inside_mask(block_index(key));
+    auto itr = m_blocks.find(key);
+    if (itr == m_blocks.end()) return make_block<Block>(0);
+    return itr->second;
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::store_block(size_t key, const Block& block,
+        const Block& inside) {
+    if (SparseBitGridHelper::is_zero(block)) return;
+    if (block == inside) {
+        m_full_blocks[key] = true;
+    } else {
+        m_blocks[key] = block;
+    }
+}
+
+template<int DIM>
+std::vector<size_t> SparseBitGrid<DIM>::get_occupied_blocks() const {
+    std::vector<size_t> keys;
+    keys.reserve(m_blocks.size());
+    for (const auto& entry : m_blocks) {
+        keys.push_back(entry.first);
+    }
+    const size_t total_num_blocks = m_full_blocks.size();
+    for (size_t key=0; key<total_num_blocks; key++) {
+        if (m_full_blocks[key]) keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::morph_along_axis(size_t axis, bool is_erosion) {
+    using namespace SparseBitGridHelper;
+    std::vector<size_t> keys = get_occupied_blocks();
+    if (!is_erosion) {
+        // Dilation may spill into the neighboring blocks.
+        const size_t num_occupied = keys.size();
+        for (size_t i=0; i<num_occupied; i++) {
+            size_t neighbor_key;
+            if (get_neighbor_key(keys[i], axis, false, neighbor_key))
+                keys.push_back(neighbor_key);
+            if (get_neighbor_key(keys[i], axis, true, neighbor_key))
+                keys.push_back(neighbor_key);
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+
+    // Neighbors outside of the grid are ignored, i.e. treated as the
+    // identity of the reduction: ones for erosion and zeros for dilation.
+    const Block pad = make_block<Block>(is_erosion ? ALL_ONES : 0);
+    auto load = [&](size_t key) {
+        Block block = get_block(key);
+        if (is_erosion) {
+            const Block inside = get_inside_mask(block_index(key));
+            for (size_t i=0; i<BLOCK_WORDS; i++) block[i] |= ~inside[i];
+        }
+        return block;
+    };
+
+    const size_t num_keys = keys.size();
+    std::vector<Block> results(num_keys);
+    std::vector<Block> inside_masks(num_keys);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_keys),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                    const size_t key = keys[i];
+                    size_t prev_key, next_key;
+                    const Block curr = load(key);
+                    const Block prev = get_neighbor_key(key, axis, false, prev_key) ?
+                        load(prev_key) : pad;
+                    const Block next = get_neighbor_key(key, axis, true, next_key) ?
+                        load(next_key) : pad;
+                    const Block from_prev = shift_from_prev<DIM>(curr, prev, axis);
+                    const Block from_next = shift_from_next<DIM>(curr, next, axis);
+
+                    const Block inside = get_inside_mask(block_index(key));
+                    Block& out = results[i];
+                    for (size_t j=0; j<BLOCK_WORDS; j++) {
+                        if (is_erosion) {
+                            out[j] = curr[j] & from_prev[j] & from_next[j];
+                        } else {
+                            out[j] = curr[j] | from_prev[j] | from_next[j];
+                        }
+                        out[j] &= inside[j];
+                    }
+                    inside_masks[i] = inside;
+                }
+            });
+
+    m_blocks.clear();
+    m_full_blocks.assign(m_full_blocks.size(), false);
+    for (size_t i=0; i<num_keys; i++) {
+        store_block(keys[i], results[i], inside_masks[i]);
+    }
+}
+
+template<int DIM>
+void SparseBitGrid<DIM>::morph(size_t iterations, bool is_erosion) {
+    for (size_t i=0; i<iterations; i++) {
+        // The 3^DIM box is the product of 1D windows, so one pass per axis
+        // is enough.
+        for (size_t axis=0; axis<DIM; axis++) {
+            morph_along_axis(axis, is_erosion);
+        }
+    }
+}
@@ -7,17 +7,22 @@
 #include <Mesh.h>
 #include <Misc/HashGrid.h>
 
-#include "Grid.h"
+#include "BitGrid.h"
+#include "SparseBitGrid.h"
 
 namespace PyMesh {
 
-template<int DIM>
-class VoxelGrid : public Grid<DIM, short>{
+/**
+ * Storage is either BitGrid (dense) or SparseBitGrid (8^DIM leaf blocks,
+ * only blocks containing solid voxels are stored).
+ */
+template<int DIM, typename Storage=BitGrid<DIM> >
+class VoxelGrid : public Storage {
     public:
-        std::shared_ptr<VoxelGrid<DIM> > Ptr;
-        typedef Grid<DIM, short> Parent;
-        typedef typename Grid<DIM, short>::Vector_f Vector_f;
-        typedef typename Grid<DIM, short>::Vector_i Vector_i;
+        std::shared_ptr<VoxelGrid<DIM, Storage> > Ptr;
+        typedef Storage Parent;
+        typedef typename Storage::Vector_f Vector_f;
+        typedef typename Storage::Vector_i Vector_i;
 
     public:
         VoxelGrid(Float cell_size);
@@ -32,14 +37,9 @@ class VoxelGrid : public Grid<DIM, short>{
         void remove_cavities();
 
     protected:
-        typedef Grid<DIM, bool> Mask;
-
         void insert_triangle_mesh(Mesh::Ptr mesh);
         void insert_quad_mesh(Mesh::Ptr mesh);
 
-        Mask create_mask() const;
-        void flood_from_base_cell(Mask& mask);
-
     private:
         size_t m_margin;
         HashGrid::Ptr m_hash_grid;
@@ -52,5 +52,7 @@ class VoxelGrid : public Grid<DIM, short>{
 namespace PyMesh {
 typedef VoxelGrid<2> VoxelGrid2D;
 typedef VoxelGrid<3> VoxelGrid3D;
+typedef VoxelGrid<2, SparseBitGrid<2> > SparseVoxelGrid2D;
+typedef VoxelGrid<3, SparseBitGrid<3> > SparseVoxelGrid3D;
 }
 
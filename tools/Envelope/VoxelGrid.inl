@@ -1,14 +1,11 @@
 #include <cassert>
 #include <sstream>
 #include <functional>
-#include <queue>
 
 #include <Core/Exception.h>
 #include <MeshFactory.h>
 #include <MeshUtils/DuplicatedVertexRemoval.h>
 
-#include "Eroder.h"
-
 using namespace PyMesh;
 
 namespace VoxelGridHelper {
@@ -83,14 +80,14 @@ namespace VoxelGridHelper {
 
 using namespace VoxelGridHelper;
 
-template<int DIM>
-VoxelGrid<DIM>::VoxelGrid(Float cell_size)
-    : VoxelGrid<DIM>::Parent(cell_size), m_margin(1) {
+template<int DIM, typename Storage>
+VoxelGrid<DIM, Storage>::VoxelGrid(Float cell_size)
+    : VoxelGrid<DIM, Storage>::Parent(cell_size), m_margin(1) {
         m_hash_grid = HashGrid::create(cell_size, DIM);
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::insert_mesh(Mesh::Ptr mesh) {
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::insert_mesh(Mesh::Ptr mesh) {
     if (mesh->get_dim() != DIM) {
         std::stringstream err_msg;
         err_msg << "Expect dim equals " << DIM << ", but mesh has dim " << mesh->get_dim();
@@ -106,8 +103,8 @@ void VoxelGrid<DIM>::insert_mesh(Mesh::Ptr mesh) {
     }
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::create_grid() {
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::create_grid() {
     MatrixFr centers = m_hash_grid->get_occupied_cell_centers();
     const size_t num_occupied_cells = centers.rows();
 
@@ -122,68 +119,36 @@ void VoxelGrid<DIM>::create_grid() {
     this->initialize(grid_size, grid_base_coord);
 
     for (size_t i=0; i<num_occupied_cells; i++) {
-        this->lookup(centers.row(i)) += 1;
+        this->set_at(centers.row(i), true);
     }
 
     remove_cavities();
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::dilate(size_t iterations) {
-    // Dilate the solid regions is equivalent to erode the void reigions.
-    // mask(idx) == true iff idx is void.
-    Mask mask = create_mask();
-    std::transform(mask.begin(), mask.end(), mask.begin(),
-            std::logical_not<bool>());
-
-    Eroder<DIM> eroder(mask);
-    eroder.erode(iterations);
-
-    mask = eroder.get_mask();
-
-    auto mask_itr = mask.begin();
-    auto data_itr = this->begin();
-    for (; mask_itr != mask.end(); mask_itr++, data_itr++) {
-        if (!*mask_itr) { *data_itr = 1; }
-        else { *data_itr = 0; }
-    }
-    assert(data_itr == this->end());
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::dilate(size_t iterations) {
+    this->dilate_cells(iterations);
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::erode(size_t iterations) {
-    Mask solid = create_mask();
-
-    Eroder<DIM> eroder(solid);
-    eroder.erode(iterations);
-
-    solid = eroder.get_mask();
-
-    auto solid_itr = solid.begin();
-    auto data_itr = this->begin();
-    for (; solid_itr != solid.end(); solid_itr++, data_itr++) {
-        if (*solid_itr) { *data_itr = 1; }
-        else { *data_itr = 0; }
-    }
-    assert(data_itr == this->end());
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::erode(size_t iterations) {
+    this->erode_cells(iterations);
 }
 
-template<int DIM>
-Mesh::Ptr VoxelGrid<DIM>::get_voxel_mesh() {
+template<int DIM, typename Storage>
+Mesh::Ptr VoxelGrid<DIM, Storage>::get_voxel_mesh() {
     const Vector_f half_cell_size = this->m_cell_size * 0.5;
 
     std::vector<Vector_f> vertices;
     std::vector<VectorI> elements;
 
     size_t num_vertices = 0;
-    for (auto itr=this->begin(); itr!=this->end(); itr++) {
-        if (*itr == 0) continue;
-        size_t i = itr - this->begin();
-        Vector_f cell_center = this->get_cell_center(i);
+    this->for_each_occupied_cell([&](const Vector_i& index) {
+        Vector_f cell_center = this->get_cell_center(index);
         VectorI indices = append_cell_corners<DIM>(cell_center, half_cell_size, vertices);
         elements.push_back(indices + VectorI::Ones(indices.size()) * num_vertices);
         num_vertices += indices.size();
-    }
+    });
 
     if (vertices.empty() || elements.empty()) {
         throw RuntimeError("Voxel grid does not contain any solid voxels.");
@@ -211,22 +176,14 @@ Mesh::Ptr VoxelGrid<DIM>::get_voxel_mesh() {
     return form_mesh(DIM, vec_vertices, vec_elements);
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::remove_cavities() {
-    Mask mask = create_mask();
-
-    flood_from_base_cell(mask);
-    auto mask_itr = mask.begin();
-    auto data_itr = this->begin();
-    for (; mask_itr != mask.end(); mask_itr++, data_itr++) {
-        if (!*mask_itr) { *data_itr = 1; }
-    }
-    assert(data_itr == this->end());
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::remove_cavities() {
+    this->fill_cavities();
 }
 
 
-template<int DIM>
-void VoxelGrid<DIM>::insert_triangle_mesh(Mesh::Ptr mesh) {
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::insert_triangle_mesh(Mesh::Ptr mesh) {
     const VectorF& vertices = mesh->get_vertices();
     const VectorI& faces = mesh->get_faces();
     const size_t num_faces = mesh->get_num_faces();
@@ -242,8 +199,8 @@ void VoxelGrid<DIM>::insert_triangle_mesh(Mesh::Ptr mesh) {
     }
 }
 
-template<int DIM>
-void VoxelGrid<DIM>::insert_quad_mesh(Mesh::Ptr mesh) {
+template<int DIM, typename Storage>
+void VoxelGrid<DIM, Storage>::insert_quad_mesh(Mesh::Ptr mesh) {
     const VectorF& vertices = mesh->get_vertices();
     const VectorI& faces = mesh->get_faces();
     const size_t num_faces = mesh->get_num_faces();
@@ -269,45 +226,3 @@ void VoxelGrid<DIM>::insert_quad_mesh(Mesh::Ptr mesh) {
         m_hash_grid->insert_triangle(i, corners);
     }
 }
-
-template<int DIM>
-typename VoxelGrid<DIM>::Mask VoxelGrid<DIM>::create_mask() const {
-    Mask mask(this->m_cell_size[0]);
-    assert((mask.cell_size().array() == this->m_cell_size.array()).all());
-    mask.initialize(this->size(), this->base_coordinates());
-    std::transform(this->begin(), this->end(), mask.begin(),
-            [](short i) { return i!=0; });
-    return mask;
-}
-
-template<int DIM>
-void VoxelGrid<DIM>::flood_from_base_cell(VoxelGrid<DIM>::Mask& mask) {
-    const Vector_f& p = mask.base_coordinates();
-    assert(this->is_inside(p));
-    const Vector_i seed_idx = this->coordinate_to_index(p);
-    if (mask(seed_idx)) return;
-
-    mask(seed_idx) = true;
-    std::queue<Vector_i> Q;
-    Q.push(seed_idx);
-    while (!Q.empty()) {
-        const Vector_i idx = Q.front();
-        Q.pop();
-        assert(mask(idx));
-
-        for (size_t i=0; i<DIM; i++) {
-            Vector_i prev(idx); prev[i] -= 1;
-            Vector_i next(idx); next[i] += 1;
-            if (this->is_valid_index(prev) && !mask(prev)) {
-                mask(prev) = true;
-                Q.push(prev);
-            }
-            if (this->is_valid_index(next) && !mask(next)) {
-                mask(next) = true;
-                Q.push(next);
-            }
-        }
-    }
-}
-
-
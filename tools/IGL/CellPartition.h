@@ -20,18 +20,18 @@ class CellPartition {
 
         void run();
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_source_faces() const { return m_source_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_source_faces() const { return m_source_faces; }
 
         size_t get_num_cells() const;
         MatrixIr get_cell_faces(const size_t cell_id) const;
-        MatrixIr get_cells() const { return m_cells; }
+        const MatrixIr& get_cells() const { return m_cells; }
 
         size_t get_num_patches() const;
-        VectorI get_patches() const { return m_patches; }
+        const VectorI& get_patches() const { return m_patches; }
 
-        MatrixIr get_winding_number() const { return m_winding_number; }
+        const MatrixIr& get_winding_number() const { return m_winding_number; }
 
     private:
         MatrixFr m_vertices;
@@ -3,8 +3,11 @@
 #include "HarmonicSolver.h"
 #include <Core/Exception.h>
 #include <Math/MatrixUtils.h>
+#include <igl/cotmatrix.h>
 #include <igl/harmonic.h>
+#include <igl/massmatrix.h>
 #include <iostream>
+#include <vector>
 
 using namespace PyMesh;
 
@@ -55,10 +58,105 @@ void HarmonicSolver::pre_process() {
         throw NotImplementedError("Harmonic solver does not support mesh with dimention " +
                 std::to_string(dim));
     }
+
+    const size_t num_nodes = m_nodes.rows();
+    const size_t num_bd_nodes = m_bd_indices.size();
+    if (num_bd_nodes == 0) {
+        throw RuntimeError("Harmonic solver requires boundary indices");
+    }
+
+    // index_map maps boundary nodes to their index in m_bd_indices and
+    // interior nodes to their index in m_interior_indices.
+    std::vector<int> index_map(num_nodes, -1);
+    std::vector<bool> is_boundary(num_nodes, false);
+    for (size_t i=0; i<num_bd_nodes; i++) {
+        const int vi = m_bd_indices[i];
+        if (vi < 0 || size_t(vi) >= num_nodes) {
+            throw RuntimeError("Boundary index out of bound: " +
+                    std::to_string(vi));
+        }
+        if (is_boundary[vi]) {
+            throw RuntimeError("Duplicated boundary index: " +
+                    std::to_string(vi));
+        }
+        is_boundary[vi] = true;
+        index_map[vi] = i;
+    }
+    const size_t num_interior_nodes = num_nodes - num_bd_nodes;
+    m_interior_indices.resize(num_interior_nodes);
+    for (size_t i=0, count=0; i<num_nodes; i++) {
+        if (!is_boundary[i]) {
+            m_interior_indices[count] = i;
+            index_map[i] = count;
+            count++;
+        }
+    }
+
+    // Same system as igl::harmonic: Q = -L (L M^-1 L)^(k-1).
+    Eigen::SparseMatrix<Float> L, Q;
+    igl::cotmatrix(m_nodes, m_elements, L);
+    if (m_order > 1) {
+        Eigen::SparseMatrix<Float> M;
+        igl::massmatrix(m_nodes, m_elements, igl::MASSMATRIX_TYPE_DEFAULT, M);
+        igl::harmonic(L, M, m_order, Q);
+    } else {
+        Q = -L;
+    }
+
+    // Split Q into interior-interior and interior-boundary blocks.
+    std::vector<Eigen::Triplet<Float> > ii_entries, ib_entries;
+    for (int k=0; k<Q.outerSize(); k++) {
+        for (Eigen::SparseMatrix<Float>::InnerIterator it(Q, k); it; ++it) {
+            const int row = it.row();
+            if (is_boundary[row]) continue;
+            if (is_boundary[k]) {
+                ib_entries.emplace_back(index_map[row], index_map[k], it.value());
+            } else {
+                ii_entries.emplace_back(index_map[row], index_map[k], it.value());
+            }
+        }
+    }
+    ZSparseMatrix interior_block(num_interior_nodes, num_interior_nodes);
+    interior_block.setFromTriplets(ii_entries.begin(), ii_entries.end());
+    m_interior_boundary_block.resize(num_interior_nodes, num_bd_nodes);
+    m_interior_boundary_block.setFromTriplets(
+            ib_entries.begin(), ib_entries.end());
+
+    m_solver = SparseSolver::create(m_solver_type);
+    if (num_interior_nodes > 0) {
+        m_solver->analyze_pattern(interior_block);
+        m_solver->factorize(interior_block);
+    }
+    m_factorized = true;
 }
 
 void HarmonicSolver::solve() {
-    igl::harmonic(m_nodes, m_elements, m_bd_indices, m_bd_values, m_order, m_solution);
+    if (!m_factorized) {
+        pre_process();
+    }
+
+    const size_t num_nodes = m_nodes.rows();
+    const size_t num_bd_nodes = m_bd_indices.size();
+    const size_t num_interior_nodes = m_interior_indices.size();
+    const size_t num_cols = m_bd_values.size() / num_bd_nodes;
+    if (num_cols == 0 || m_bd_values.size() != num_bd_nodes * num_cols) {
+        throw RuntimeError("Boundary values do not match boundary indices");
+    }
+    // A single boundary condition may be given as a row vector.
+    const MatrixF bd_values = Eigen::Map<const MatrixFr>(
+            m_bd_values.data(), num_bd_nodes, num_cols);
+
+    m_solution.resize(num_nodes, num_cols);
+    for (size_t i=0; i<num_bd_nodes; i++) {
+        m_solution.row(m_bd_indices[i]) = bd_values.row(i);
+    }
+    if (num_interior_nodes == 0) return;
+
+    const MatrixF rhs = -(m_interior_boundary_block * bd_values);
+    const MatrixF x = m_solver->solve(rhs);
+    for (size_t i=0; i<num_interior_nodes; i++) {
+        m_solution.row(m_interior_indices[i]) = x.row(i);
+    }
 }
 
 #endif
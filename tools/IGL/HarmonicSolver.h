@@ -3,12 +3,25 @@
 #ifdef WITH_IGL
 #include <memory>
 #include <iostream>
+#include <string>
 
 #include <Core/EigenTypedef.h>
+#include <Math/ZSparseMatrix.h>
 #include <Mesh.h>
+#include <SparseSolver/SparseSolver.h>
 
 namespace PyMesh {
 
+/**
+ * Solve the k-harmonic equation with Dirichlet boundary conditions.
+ *
+ * pre_process() assembles the system and factorizes its interior block.
+ * The factorization is kept until nodes, elements, order, boundary indices
+ * or solver type change, so solve() can be called repeatedly with new
+ * boundary values at the cost of a back substitution.  Each column of the
+ * boundary values is an independent boundary condition, and all columns
+ * are solved at once.
+ */
 class HarmonicSolver {
     public:
         using Ptr = std::shared_ptr<HarmonicSolver>;
@@ -17,10 +30,12 @@ class HarmonicSolver {
 
     public:
         HarmonicSolver(const MatrixFr& nodes, const MatrixIr& elements):
-            m_order(1), m_nodes(nodes), m_elements(elements) {}
+            m_order(1), m_nodes(nodes), m_elements(elements),
+            m_solver_type("LDLT"), m_factorized(false) {}
 
         void set_nodes(const MatrixFr& nodes) {
             m_nodes = nodes;
+            m_factorized = false;
         }
         const MatrixFr& get_nodes() const {
             return m_nodes;
@@ -28,16 +43,21 @@ class HarmonicSolver {
 
         void set_elements(const MatrixIr& elements) {
             m_elements = elements;
+            m_factorized = false;
         }
         const MatrixIr& get_elements() const {
             return m_elements;
         }
 
-        void set_order(size_t order) { m_order = order; }
+        void set_order(size_t order) {
+            m_order = order;
+            m_factorized = false;
+        }
         size_t get_order() const { return m_order; }
 
         void set_boundary_indices(const VectorI& bd_indices) {
             m_bd_indices = bd_indices;
+            m_factorized = false;
         }
         const VectorI& get_boundary_indices() const {
             return m_bd_indices;
@@ -50,7 +70,23 @@ class HarmonicSolver {
             return m_bd_values;
         }
 
+        /**
+         * Any solver supported by SparseSolver::create().  The system is
+         * symmetric positive definite, default is "LDLT".
+         */
+        void set_solver_type(const std::string& solver_type) {
+            m_solver_type = solver_type;
+            m_factorized = false;
+        }
+        const std::string& get_solver_type() const {
+            return m_solver_type;
+        }
+
         void pre_process();
+
+        /**
+         * Calls pre_process() if the cached factorization is out of date.
+         */
         void solve();
 
         const MatrixFr& get_solution() const {
@@ -64,6 +100,12 @@ class HarmonicSolver {
         VectorI m_bd_indices;
         MatrixFr m_bd_values;
         MatrixFr m_solution;
+
+        std::string m_solver_type;
+        bool m_factorized;
+        SparseSolver::Ptr m_solver;
+        VectorI m_interior_indices;
+        ZSparseMatrix m_interior_boundary_block;
 };
 
 }
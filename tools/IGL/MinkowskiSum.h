@@ -20,8 +20,8 @@ class MinkowskiSum {
 
         void run(const MatrixFr& path);
 
-        MatrixFr get_vertices() const { return m_out_vertices; }
-        MatrixIr get_faces() const { return m_out_faces; }
+        const MatrixFr& get_vertices() const { return m_out_vertices; }
+        const MatrixIr& get_faces() const { return m_out_faces; }
 
     private:
         MatrixFr m_vertices;
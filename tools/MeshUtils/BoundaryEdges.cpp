@@ -6,6 +6,7 @@
 #include <set>
 
 #include <Mesh.h>
+#include <Connectivity/HalfEdgeMesh.h>
 #include <Misc/Multiplet.h>
 #include <Misc/MultipletMap.h>
 
@@ -43,6 +44,11 @@ VectorI BoundaryEdges::get_boundary_nodes() const {
 }
 
 void BoundaryEdges::extract_boundary(const Mesh& mesh) {
+    if (mesh.get_vertex_per_face() == 3) {
+        extract_triangle_boundary(mesh);
+        return;
+    }
+
     typedef Duplet Edge;
     typedef DupletMap<size_t> EdgeFaceMap;
     EdgeFaceMap edge_face_map;
@@ -77,6 +83,21 @@ void BoundaryEdges::extract_boundary(const Mesh& mesh) {
             m_boundary_faces.data());
 }
 
+void BoundaryEdges::extract_triangle_boundary(const Mesh& mesh) {
+    HalfEdgeMesh half_edge_mesh(mesh);
+    std::vector<int> bd_half_edges = half_edge_mesh.get_boundary_half_edges();
+
+    const size_t num_boundaries = bd_half_edges.size();
+    m_boundaries.resize(num_boundaries, 2);
+    m_boundary_faces.resize(num_boundaries);
+    for (size_t i=0; i<num_boundaries; i++) {
+        const int h = bd_half_edges[i];
+        m_boundaries(i, 0) = half_edge_mesh.tail(h);
+        m_boundaries(i, 1) = half_edge_mesh.head(h);
+        m_boundary_faces[i] = HalfEdgeMesh::face(h);
+    }
+}
+
 void BoundaryEdges::extract_boundary_nodes() {
     size_t num_entries = m_boundaries.rows() * m_boundaries.cols();
     std::set<size_t> vertex_set(m_boundaries.data(),
@@ -19,6 +19,7 @@ class BoundaryEdges : public Boundary {
 
     private:
         void extract_boundary(const Mesh& mesh);
+        void extract_triangle_boundary(const Mesh& mesh);
         void extract_boundary_nodes();
 
     private:
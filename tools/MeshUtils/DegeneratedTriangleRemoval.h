@@ -13,9 +13,9 @@ class DegeneratedTriangleRemoval {
     public:
         void run(size_t num_iteraitons=5);
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_ori_face_indices() const { return m_ori_face_indices; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_ori_face_indices() const { return m_ori_face_indices; }
 
     private:
         void init_ori_face_indices();
@@ -14,8 +14,8 @@ class DuplicatedVertexRemoval {
 
     public:
         size_t run(Float tol);
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
 
         /**
          * Assign an integer importance per vertex.  Vertex with high importance
@@ -28,7 +28,7 @@ class DuplicatedVertexRemoval {
          * index map maps the input vertex index to an output vertex index.
          * i.e. it specifies where each input vertex ends up in the output.
          */
-        VectorI get_index_map() const { return m_index_map; }
+        const VectorI& get_index_map() const { return m_index_map; }
 
     private:
         MatrixFr m_vertices;
@@ -20,8 +20,8 @@ class EdgeSplitter {
         typedef std::function<bool(const VectorF& v1, const VectorF& v2)> IndicatorFunc;
         void run(IndicatorFunc split_indicator, Float max_length);
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
 
     private:
         void clear_intermediate_data();
@@ -37,9 +37,9 @@ class FinFaceRemoval {
          * removed.  This is necessary in removing "fins".
          */
         size_t run();
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_face_indices() const { return m_face_indices; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_indices() const { return m_face_indices; }
 
     private:
         bool     m_fins_only;
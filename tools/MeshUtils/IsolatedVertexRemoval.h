@@ -9,9 +9,9 @@ class IsolatedVertexRemoval {
         IsolatedVertexRemoval(const MatrixFr& vertices, const MatrixIr& faces);
     public:
         size_t run();
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI get_ori_vertex_indices() const { return m_ori_vertex_indices; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI& get_ori_vertex_indices() const { return m_ori_vertex_indices; }
 
     private:
         MatrixFr m_vertices;
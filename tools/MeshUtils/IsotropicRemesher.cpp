@@ -0,0 +1,590 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "IsotropicRemesher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+#include <Core/Exception.h>
+
+using namespace PyMesh;
+
+namespace IsotropicRemesherHelper {
+    const Float SPLIT_RATIO = 4.0 / 3.0;
+    const Float COLLAPSE_RATIO = 4.0 / 5.0;
+    const Float SMOOTHING_WEIGHT = 0.5;
+
+    Vector3F get_point(const HalfEdgeMesh& mesh, int vi) {
+        Vector3F p = Vector3F::Zero();
+        p.segment(0, mesh.get_dim()) = mesh.get_vertex(vi);
+        return p;
+    }
+
+    VectorF to_vertex(const HalfEdgeMesh& mesh, const Vector3F& p) {
+        return p.segment(0, mesh.get_dim());
+    }
+
+    Vector3F compute_normal(const Vector3F& v0, const Vector3F& v1,
+            const Vector3F& v2) {
+        return (v1 - v0).cross(v2 - v0);
+    }
+
+    struct Collapse {
+        int half_edge;
+        Float ratio;
+        Vector3F position;
+        Float sizing;
+    };
+
+    struct Flip {
+        int half_edge;
+        int gain;
+    };
+}
+
+using namespace IsotropicRemesherHelper;
+
+IsotropicRemesher::IsotropicRemesher(
+        const MatrixFr& vertices, const MatrixIr& faces) :
+    m_vertices(vertices), m_faces(faces), m_mesh(vertices, faces),
+    m_target_length(0.0),
+    m_num_splits(0), m_num_collapses(0), m_num_flips(0) {
+    const size_t dim = vertices.cols();
+    if (dim != 2 && dim != 3) {
+        throw NotImplementedError("Only 2D and 3D meshes are supported");
+    }
+
+    const size_t num_half_edges = m_mesh.get_num_half_edges();
+    Float total_length = 0.0;
+    for (size_t i=0; i<num_half_edges; i++) {
+        total_length += get_edge_length(i);
+    }
+    if (num_half_edges > 0) {
+        m_target_length = total_length / num_half_edges;
+    }
+}
+
+void IsotropicRemesher::set_target_length(Float target_length) {
+    if (target_length <= 0.0) {
+        throw RuntimeError("Target edge length must be positive");
+    }
+    m_target_length = target_length;
+    m_sizing.clear();
+}
+
+void IsotropicRemesher::set_sizing_field(const VectorF& sizing) {
+    const size_t num_vertices = m_mesh.get_num_vertices();
+    if (size_t(sizing.size()) != num_vertices) {
+        std::stringstream err_msg;
+        err_msg << "Sizing field has " << sizing.size()
+            << " entries, expecting " << num_vertices;
+        throw RuntimeError(err_msg.str());
+    }
+    if (num_vertices > 0 && sizing.minCoeff() <= 0.0) {
+        throw RuntimeError("Sizing field must be positive");
+    }
+    m_sizing.assign(sizing.data(), sizing.data() + num_vertices);
+}
+
+void IsotropicRemesher::run(size_t num_iterations) {
+    m_num_splits = 0;
+    m_num_collapses = 0;
+    m_num_flips = 0;
+    if (m_sizing.empty() && m_target_length <= 0.0) {
+        throw RuntimeError("Target edge length is not set");
+    }
+
+    for (size_t i=0; i<num_iterations; i++) {
+        m_num_splits += split_long_edges();
+        m_num_collapses += collapse_short_edges();
+        m_num_flips += flip_edges();
+        smooth_vertices();
+        collect_garbage();
+    }
+
+    m_vertices = m_mesh.get_vertices();
+    m_faces = m_mesh.get_faces();
+}
+
+/**
+ * Classify vertices.  A vertex is non-manifold if it touches a non-manifold
+ * edge or if its faces do not form a single fan, in which case traversals
+ * around it are incomplete and it is left untouched.
+ */
+void IsotropicRemesher::update_vertex_types() {
+    const size_t num_vertices = m_mesh.get_num_vertices();
+    const size_t num_half_edges = m_mesh.get_num_half_edges();
+    std::vector<int> num_adj_faces(num_vertices, 0);
+    m_vertex_types.assign(num_vertices, INTERIOR);
+
+    for (size_t i=0; i<num_half_edges; i++) {
+        if (m_mesh.is_face_deleted(HalfEdgeMesh::face(i))) continue;
+        const int v0 = m_mesh.tail(i);
+        const int v1 = m_mesh.head(i);
+        num_adj_faces[v0]++;
+        if (!m_mesh.is_manifold_half_edge(i)) {
+            m_vertex_types[v0] = NON_MANIFOLD;
+            m_vertex_types[v1] = NON_MANIFOLD;
+        } else if (m_mesh.is_boundary_half_edge(i)) {
+            if (m_vertex_types[v0] == INTERIOR) m_vertex_types[v0] = BOUNDARY;
+            if (m_vertex_types[v1] == INTERIOR) m_vertex_types[v1] = BOUNDARY;
+        }
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    if (m_vertex_types[i] == NON_MANIFOLD) continue;
+                    if (m_mesh.is_vertex_deleted(i)) continue;
+                    const size_t fan_size =
+                        m_mesh.get_vertex_adjacent_faces(i).size();
+                    if (fan_size != size_t(num_adj_faces[i])) {
+                        m_vertex_types[i] = NON_MANIFOLD;
+                    }
+                }
+            });
+}
+
+/**
+ * Split all edges longer than 4/3 of their target length at their mid
+ * points until there is none left.  Splitting appends to the shared arrays,
+ * so only the search for long edges runs in parallel.
+ */
+size_t IsotropicRemesher::split_long_edges() {
+    size_t num_splits = 0;
+    while (true) {
+        const size_t num_half_edges = m_mesh.get_num_half_edges();
+        std::vector<Float> ratios(num_half_edges, 0.0);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        if (m_mesh.is_face_deleted(HalfEdgeMesh::face(i)))
+                            continue;
+                        if (!m_mesh.is_manifold_half_edge(i)) continue;
+                        const int t = m_mesh.twin(i);
+                        if (t >= 0 && size_t(t) < i) continue;
+                        ratios[i] = get_edge_length(i) / get_target_length(
+                                m_mesh.tail(i), m_mesh.head(i));
+                    }
+                });
+
+        std::vector<int> candidates;
+        for (size_t i=0; i<num_half_edges; i++) {
+            if (ratios[i] > SPLIT_RATIO) candidates.push_back(i);
+        }
+        tbb::parallel_sort(candidates.begin(), candidates.end(),
+                [&](int h0, int h1) { return ratios[h0] > ratios[h1]; });
+
+        // Splitting an edge rewires the half-edges of its neighbors, so
+        // candidates are looked up again by their end points.
+        std::vector<std::pair<int, int> > edges;
+        for (int h : candidates) {
+            edges.emplace_back(m_mesh.tail(h), m_mesh.head(h));
+        }
+
+        size_t count = 0;
+        for (const auto& e : edges) {
+            const int h = m_mesh.find_half_edge(e.first, e.second);
+            if (h == HalfEdgeMesh::INVALID) continue;
+            const VectorF p = 0.5 * (m_mesh.get_vertex(e.first) +
+                    m_mesh.get_vertex(e.second));
+            m_mesh.split_edge(h, p);
+            if (!m_sizing.empty()) {
+                m_sizing.push_back(
+                        0.5 * (m_sizing[e.first] + m_sizing[e.second]));
+            }
+            count++;
+        }
+
+        num_splits += count;
+        if (count == 0) break;
+    }
+    return num_splits;
+}
+
+/**
+ * Collapse interior edges shorter than 4/5 of their target length, as long
+ * as no edge longer than 4/3 of the target length is created and no face
+ * is flipped.  Interior vertices are merged into boundary vertices, and two
+ * interior vertices are merged at their mid point.
+ */
+size_t IsotropicRemesher::collapse_short_edges() {
+    update_vertex_types();
+    const size_t num_vertices = m_mesh.get_num_vertices();
+    const size_t num_half_edges = m_mesh.get_num_half_edges();
+    std::vector<Collapse> collapses(num_half_edges);
+    std::vector<char> dirty_vertices(num_vertices, true);
+
+    size_t num_collapses = 0;
+    while (true) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        if (!is_edge_dirty(i, dirty_vertices)) continue;
+                        collapses[i].half_edge = HalfEdgeMesh::INVALID;
+                        if (m_mesh.is_face_deleted(HalfEdgeMesh::face(i)))
+                            continue;
+                        const int t = m_mesh.twin(i);
+                        if (t < 0 || size_t(t) < i) continue;
+
+                        int h = i;
+                        const int v0 = m_mesh.tail(h);
+                        const int v1 = m_mesh.head(h);
+                        const Float ratio = get_edge_length(h) /
+                            get_target_length(v0, v1);
+                        if (ratio >= COLLAPSE_RATIO) continue;
+
+                        const VertexType type_0 = m_vertex_types[v0];
+                        const VertexType type_1 = m_vertex_types[v1];
+                        const int c = m_mesh.tail(HalfEdgeMesh::prev(h));
+                        const int d = m_mesh.tail(HalfEdgeMesh::prev(t));
+                        if (type_0 == NON_MANIFOLD || type_1 == NON_MANIFOLD ||
+                                m_vertex_types[c] == NON_MANIFOLD ||
+                                m_vertex_types[d] == NON_MANIFOLD) continue;
+                        if (type_0 != INTERIOR && type_1 != INTERIOR) continue;
+
+                        Vector3F p;
+                        Float sizing = m_target_length;
+                        if (type_1 != INTERIOR) {
+                            h = t;
+                            p = get_point(m_mesh, v1);
+                            if (!m_sizing.empty()) sizing = m_sizing[v1];
+                        } else if (type_0 != INTERIOR) {
+                            p = get_point(m_mesh, v0);
+                            if (!m_sizing.empty()) sizing = m_sizing[v0];
+                        } else {
+                            p = 0.5 * (get_point(m_mesh, v0) +
+                                    get_point(m_mesh, v1));
+                            if (!m_sizing.empty())
+                                sizing = 0.5 * (m_sizing[v0] + m_sizing[v1]);
+                        }
+                        if (!m_mesh.is_collapsible(h)) continue;
+
+                        bool valid = true;
+                        for (int v : {v0, v1}) {
+                            for (int u : m_mesh.get_vertex_adjacent_vertices(v)) {
+                                if (u == v0 || u == v1) continue;
+                                const Float max_length = SPLIT_RATIO * (
+                                        m_sizing.empty() ? m_target_length :
+                                        0.5 * (sizing + m_sizing[u]));
+                                if ((get_point(m_mesh, u) - p).norm() >
+                                        max_length) {
+                                    valid = false;
+                                    break;
+                                }
+                            }
+                            if (!valid) break;
+
+                            for (int fi : m_mesh.get_vertex_adjacent_faces(v)) {
+                                if (fi == HalfEdgeMesh::face(i) ||
+                                        fi == HalfEdgeMesh::face(t)) continue;
+                                Vector3F corners[3];
+                                for (size_t j=0; j<3; j++) {
+                                    corners[j] = get_point(m_mesh,
+                                            m_mesh.tail(m_mesh.half_edge(fi, j)));
+                                }
+                                const Vector3F n0 = compute_normal(
+                                        corners[0], corners[1], corners[2]);
+                                for (size_t j=0; j<3; j++) {
+                                    const int u = m_mesh.tail(
+                                            m_mesh.half_edge(fi, j));
+                                    if (u == v0 || u == v1) corners[j] = p;
+                                }
+                                const Vector3F n1 = compute_normal(
+                                        corners[0], corners[1], corners[2]);
+                                if (n0.dot(n1) <= 0.0) {
+                                    valid = false;
+                                    break;
+                                }
+                            }
+                            if (!valid) break;
+                        }
+                        if (!valid) continue;
+
+                        collapses[i] = {h, ratio, p, sizing};
+                    }
+                });
+
+        std::vector<int> candidates;
+        for (size_t i=0; i<num_half_edges; i++) {
+            if (collapses[i].half_edge != HalfEdgeMesh::INVALID) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.empty()) break;
+        tbb::parallel_sort(candidates.begin(), candidates.end(),
+                [&](int i, int j) {
+                return collapses[i].ratio < collapses[j].ratio ||
+                (collapses[i].ratio == collapses[j].ratio && i < j); });
+
+        std::vector<Quad> footprints;
+        for (int i : candidates) {
+            footprints.push_back(get_quad(collapses[i].half_edge));
+        }
+        const auto selected = select_independent_set(footprints);
+
+        std::vector<int> survivors(selected.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, selected.size()),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const auto& c = collapses[candidates[selected[i]]];
+                        const int v = m_mesh.collapse_edge(c.half_edge,
+                                to_vertex(m_mesh, c.position));
+                        if (!m_sizing.empty()) m_sizing[v] = c.sizing;
+                        survivors[i] = v;
+                    }
+                });
+        num_collapses += selected.size();
+
+        // Only edges near the survivors need to be evaluated again.
+        std::fill(dirty_vertices.begin(), dirty_vertices.end(), false);
+        for (int v : survivors) {
+            dirty_vertices[v] = true;
+            for (int u : m_mesh.get_vertex_adjacent_vertices(v)) {
+                dirty_vertices[u] = true;
+            }
+        }
+    }
+    return num_collapses;
+}
+
+/**
+ * Flip interior edges whenever it reduces the total deviation of the 4
+ * vertices involved from their ideal valence, 6 for interior vertices and
+ * 4 for boundary vertices.
+ */
+size_t IsotropicRemesher::flip_edges() {
+    update_vertex_types();
+    const size_t num_vertices = m_mesh.get_num_vertices();
+    std::vector<int> valences(num_vertices, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    valences[i] =
+                        m_mesh.get_vertex_adjacent_vertices(i).size();
+                }
+            });
+    auto deviation = [&](int v, int valence) {
+        const int ideal = (m_vertex_types[v] == BOUNDARY) ? 4 : 6;
+        return std::abs(valence - ideal);
+    };
+
+    const size_t num_half_edges = m_mesh.get_num_half_edges();
+    std::vector<Flip> flips(num_half_edges);
+    std::vector<char> dirty_vertices(num_vertices, true);
+
+    size_t num_flips = 0;
+    while (true) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        if (!is_edge_dirty(i, dirty_vertices)) continue;
+                        flips[i].half_edge = HalfEdgeMesh::INVALID;
+                        if (m_mesh.is_face_deleted(HalfEdgeMesh::face(i)))
+                            continue;
+                        const int t = m_mesh.twin(i);
+                        if (t < 0 || size_t(t) < i) continue;
+
+                        const int a = m_mesh.tail(i);
+                        const int b = m_mesh.head(i);
+                        const int c = m_mesh.tail(HalfEdgeMesh::prev(i));
+                        const int d = m_mesh.tail(HalfEdgeMesh::prev(t));
+                        if (c == d) continue;
+                        if (m_vertex_types[a] == NON_MANIFOLD ||
+                                m_vertex_types[b] == NON_MANIFOLD ||
+                                m_vertex_types[c] == NON_MANIFOLD ||
+                                m_vertex_types[d] == NON_MANIFOLD) continue;
+                        if (valences[a] <= 3 || valences[b] <= 3) continue;
+
+                        const int before =
+                            deviation(a, valences[a]) +
+                            deviation(b, valences[b]) +
+                            deviation(c, valences[c]) +
+                            deviation(d, valences[d]);
+                        const int after =
+                            deviation(a, valences[a] - 1) +
+                            deviation(b, valences[b] - 1) +
+                            deviation(c, valences[c] + 1) +
+                            deviation(d, valences[d] + 1);
+                        if (after >= before) continue;
+
+                        if (m_mesh.find_half_edge(c, d) !=
+                                HalfEdgeMesh::INVALID ||
+                                m_mesh.find_half_edge(d, c) !=
+                                HalfEdgeMesh::INVALID) continue;
+
+                        const Vector3F pa = get_point(m_mesh, a);
+                        const Vector3F pb = get_point(m_mesh, b);
+                        const Vector3F pc = get_point(m_mesh, c);
+                        const Vector3F pd = get_point(m_mesh, d);
+                        const Vector3F n0 = compute_normal(pa, pb, pc) +
+                            compute_normal(pb, pa, pd);
+                        const Vector3F n1 = compute_normal(pc, pd, pb);
+                        const Vector3F n2 = compute_normal(pd, pc, pa);
+                        if (n0.dot(n1) <= 0.0 || n0.dot(n2) <= 0.0 ||
+                                n1.dot(n2) <= 0.0) continue;
+
+                        flips[i] = {int(i), before - after};
+                    }
+                });
+
+        std::vector<int> candidates;
+        for (size_t i=0; i<num_half_edges; i++) {
+            if (flips[i].half_edge != HalfEdgeMesh::INVALID) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.empty()) break;
+        tbb::parallel_sort(candidates.begin(), candidates.end(),
+                [&](int i, int j) {
+                return flips[i].gain > flips[j].gain ||
+                (flips[i].gain == flips[j].gain && i < j); });
+
+        std::vector<Quad> footprints;
+        for (int i : candidates) {
+            footprints.push_back(get_quad(i));
+        }
+        const auto selected = select_independent_set(footprints);
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, selected.size()),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const auto& quad = footprints[selected[i]];
+                        m_mesh.flip_edge(candidates[selected[i]]);
+                        valences[quad[0]]--;
+                        valences[quad[1]]--;
+                        valences[quad[2]]++;
+                        valences[quad[3]]++;
+                    }
+                });
+        num_flips += selected.size();
+
+        std::fill(dirty_vertices.begin(), dirty_vertices.end(), false);
+        for (size_t i : selected) {
+            for (int v : footprints[i]) dirty_vertices[v] = true;
+        }
+    }
+    return num_flips;
+}
+
+/**
+ * Move each interior vertex half way towards the centroid of its one ring
+ * neighbors, restricted to the tangent plane.  All new positions are
+ * computed before any vertex moves.
+ */
+void IsotropicRemesher::smooth_vertices() {
+    update_vertex_types();
+    const size_t num_vertices = m_mesh.get_num_vertices();
+    std::vector<Vector3F> positions(num_vertices);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    positions[i] = get_point(m_mesh, i);
+                    if (m_vertex_types[i] != INTERIOR) continue;
+                    if (m_mesh.is_vertex_deleted(i)) continue;
+
+                    const auto ring = m_mesh.get_vertex_adjacent_vertices(i);
+                    Vector3F centroid = Vector3F::Zero();
+                    for (int v : ring) {
+                        centroid += get_point(m_mesh, v);
+                    }
+                    centroid /= ring.size();
+
+                    Vector3F normal = Vector3F::Zero();
+                    for (int fi : m_mesh.get_vertex_adjacent_faces(i)) {
+                        normal += compute_normal(
+                                get_point(m_mesh, m_mesh.tail(m_mesh.half_edge(fi, 0))),
+                                get_point(m_mesh, m_mesh.tail(m_mesh.half_edge(fi, 1))),
+                                get_point(m_mesh, m_mesh.tail(m_mesh.half_edge(fi, 2))));
+                    }
+                    const Float normal_length = normal.norm();
+                    if (normal_length == 0.0) continue;
+                    normal /= normal_length;
+
+                    Vector3F step = centroid - positions[i];
+                    step -= normal.dot(step) * normal;
+                    positions[i] += SMOOTHING_WEIGHT * step;
+                }
+            });
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    if (m_vertex_types[i] != INTERIOR) continue;
+                    if (m_mesh.is_vertex_deleted(i)) continue;
+                    m_mesh.set_vertex(i, to_vertex(m_mesh, positions[i]));
+                }
+            });
+}
+
+void IsotropicRemesher::collect_garbage() {
+    const VectorI vertex_map = m_mesh.collect_garbage();
+    if (m_sizing.empty()) return;
+
+    std::vector<Float> sizing(m_mesh.get_num_vertices());
+    const size_t num_vertices = vertex_map.size();
+    for (size_t i=0; i<num_vertices; i++) {
+        if (vertex_map[i] == HalfEdgeMesh::INVALID) continue;
+        sizing[vertex_map[i]] = m_sizing[i];
+    }
+    m_sizing.swap(sizing);
+}
+
+/**
+ * The faces adjacent to two vertices overlap exactly when the vertices are
+ * equal or adjacent.  So each selected quad blocks the closed one rings of
+ * its vertices, and a candidate is free if none of its vertices is blocked.
+ */
+std::vector<size_t> IsotropicRemesher::select_independent_set(
+        const std::vector<Quad>& footprints) const {
+    const size_t num_candidates = footprints.size();
+    std::vector<bool> blocked(m_mesh.get_num_vertices(), false);
+    std::vector<size_t> selected;
+    for (size_t i=0; i<num_candidates; i++) {
+        const auto& quad = footprints[i];
+        const bool is_free = std::none_of(quad.begin(), quad.end(),
+                [&](int v) { return blocked[v]; });
+        if (!is_free) continue;
+        for (int v : quad) {
+            blocked[v] = true;
+            for (int u : m_mesh.get_vertex_adjacent_vertices(v)) {
+                blocked[u] = true;
+            }
+        }
+        selected.push_back(i);
+    }
+    return selected;
+}
+
+IsotropicRemesher::Quad IsotropicRemesher::get_quad(int h) const {
+    const int t = m_mesh.twin(h);
+    return {{m_mesh.tail(h), m_mesh.head(h),
+        m_mesh.tail(HalfEdgeMesh::prev(h)),
+        m_mesh.tail(HalfEdgeMesh::prev(t))}};
+}
+
+/**
+ * An edge has to be evaluated again if any vertex of its quad is dirty or
+ * if it has been deleted.
+ */
+bool IsotropicRemesher::is_edge_dirty(int h,
+        const std::vector<char>& dirty_vertices) const {
+    if (m_mesh.is_face_deleted(HalfEdgeMesh::face(h))) return true;
+    if (dirty_vertices[m_mesh.tail(h)] || dirty_vertices[m_mesh.head(h)])
+        return true;
+    if (dirty_vertices[m_mesh.tail(HalfEdgeMesh::prev(h))]) return true;
+    const int t = m_mesh.twin(h);
+    return t >= 0 && dirty_vertices[m_mesh.tail(HalfEdgeMesh::prev(t))];
+}
+
+Float IsotropicRemesher::get_target_length(int v0, int v1) const {
+    if (m_sizing.empty()) return m_target_length;
+    return 0.5 * (m_sizing[v0] + m_sizing[v1]);
+}
+
+Float IsotropicRemesher::get_edge_length(int h) const {
+    return (m_mesh.get_vertex(m_mesh.tail(h)) -
+            m_mesh.get_vertex(m_mesh.head(h))).norm();
+}
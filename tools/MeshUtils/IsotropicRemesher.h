@@ -0,0 +1,97 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+#include <Connectivity/HalfEdgeMesh.h>
+
+namespace PyMesh {
+
+/**
+ * Isotropic (or adaptive) remeshing of triangle meshes.
+ *
+ * Each iteration splits edges longer than 4/3 of the target length,
+ * collapses edges shorter than 4/5 of the target length, flips edges to
+ * bring vertex valences closer to 6 (4 on the boundary) and relaxes
+ * vertices tangentially.  All passes work in place on the same
+ * HalfEdgeMesh.
+ *
+ * Collapses and flips are scheduled in batches of operations whose face
+ * neighborhoods do not overlap, and each batch is applied in parallel.
+ *
+ * Boundary vertices and vertices adjacent to non-manifold edges never move,
+ * and boundary edges are only split.  Isolated vertices are removed.
+ */
+class IsotropicRemesher {
+    public:
+        IsotropicRemesher(const MatrixFr& vertices, const MatrixIr& faces);
+
+    public:
+        /**
+         * Uniform target edge length.  Defaults to the average input edge
+         * length.
+         */
+        void set_target_length(Float target_length);
+
+        /**
+         * Target edge length per input vertex.  Overrides the uniform target
+         * length.  The target length of an edge is the average of its end
+         * points.
+         */
+        void set_sizing_field(const VectorF& sizing);
+
+        void run(size_t num_iterations=10);
+
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+
+        size_t get_num_splits() const { return m_num_splits; }
+        size_t get_num_collapses() const { return m_num_collapses; }
+        size_t get_num_flips() const { return m_num_flips; }
+
+    private:
+        enum VertexType { INTERIOR, BOUNDARY, NON_MANIFOLD };
+        typedef std::array<int, 4> Quad;
+
+        void update_vertex_types();
+        size_t split_long_edges();
+        size_t collapse_short_edges();
+        size_t flip_edges();
+        void smooth_vertices();
+        void collect_garbage();
+
+        /**
+         * Greedily pick candidates (in the given order) whose footprints,
+         * the faces adjacent to the quad vertices, are pairwise disjoint.
+         */
+        std::vector<size_t> select_independent_set(
+                const std::vector<Quad>& footprints) const;
+
+        /**
+         * End points of the interior edge h followed by its 2 opposite
+         * vertices.
+         */
+        Quad get_quad(int h) const;
+        bool is_edge_dirty(int h,
+                const std::vector<char>& dirty_vertices) const;
+
+        Float get_target_length(int v0, int v1) const;
+        Float get_edge_length(int h) const;
+
+    private:
+        MatrixFr m_vertices;
+        MatrixIr m_faces;
+
+        HalfEdgeMesh m_mesh;
+        Float m_target_length;
+        std::vector<Float> m_sizing;
+        std::vector<VertexType> m_vertex_types;
+
+        size_t m_num_splits;
+        size_t m_num_collapses;
+        size_t m_num_flips;
+};
+
+}
@@ -15,10 +15,10 @@ class LongEdgeRemoval {
     public:
         void run(Float max_length, bool recursive=true);
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
 
-        VectorI get_ori_faces() const { return m_ori_faces; }
+        const VectorI& get_ori_faces() const { return m_ori_faces; }
 
     private:
         void init_edge_map();
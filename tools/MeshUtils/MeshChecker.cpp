@@ -1,82 +1,178 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "MeshChecker.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <numeric>
 #include <sstream>
-#include <unordered_map>
+#include <utility>
+
+#include <tbb/tbb.h>
 
 #include <Core/EigenTypedef.h>
 #include <Core/Exception.h>
-#include <Misc/Multiplet.h>
-#include <Math/MatrixUtils.h>
 
-#include "Boundary.h"
 #include "EdgeUtils.h"
 #include "MeshSeparator.h"
 
 using namespace PyMesh;
 
+namespace MeshCheckerHelper {
+    uint64_t edge_key(int v0, int v1) {
+        if (v0 > v1) std::swap(v0, v1);
+        return (uint64_t(uint32_t(v0)) << 32) | uint64_t(uint32_t(v1));
+    }
+
+    /**
+     * Return true iff fn(i) is true for some i in [0, n).
+     */
+    template<typename Fn>
+    bool any_of(size_t n, const Fn& fn) {
+        return tbb::parallel_reduce(tbb::blocked_range<size_t>(0, n), false,
+                [&](const tbb::blocked_range<size_t>& r, bool found) {
+                    if (found) return true;
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        if (fn(i)) return true;
+                    }
+                    return false;
+                }, std::logical_or<bool>());
+    }
+
+    /**
+     * Count the number of distinct vertices referenced by any of elements.
+     */
+    size_t count_used_vertices(size_t num_vertices,
+            const std::vector<const MatrixIr*>& elements) {
+        std::vector<std::atomic<bool> > used(num_vertices);
+        for (const auto e : elements) {
+            const int* data = e->data();
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, e->size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                        for (size_t i=r.begin(); i!=r.end(); i++) {
+                            used[data[i]].store(true, std::memory_order_relaxed);
+                        }
+                    });
+        }
+        return tbb::parallel_reduce(
+                tbb::blocked_range<size_t>(0, num_vertices), size_t(0),
+                [&](const tbb::blocked_range<size_t>& r, size_t count) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        if (used[i].load(std::memory_order_relaxed)) count++;
+                    }
+                    return count;
+                }, std::plus<size_t>());
+    }
+
+    /**
+     * Return true iff the directed edges form a single simple chain or a
+     * single simple loop.  This is the link condition of a manifold vertex.
+     */
+    bool is_single_chain(const std::vector<std::pair<int, int> >& edges) {
+        std::vector<int> nodes;
+        nodes.reserve(edges.size() * 2);
+        for (const auto& e : edges) {
+            nodes.push_back(e.first);
+            nodes.push_back(e.second);
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        const size_t num_nodes = nodes.size();
+        const size_t num_edges = edges.size();
+        if (num_edges != num_nodes && num_edges + 1 != num_nodes) return false;
+
+        auto local_index = [&](int v) {
+            return std::lower_bound(nodes.begin(), nodes.end(), v)
+                - nodes.begin();
+        };
+        std::vector<int> next(num_nodes, -1);
+        std::vector<bool> has_prev(num_nodes, false);
+        for (const auto& e : edges) {
+            const int s = local_index(e.first);
+            const int t = local_index(e.second);
+            if (next[s] >= 0 || has_prev[t]) return false;
+            next[s] = t;
+            has_prev[t] = true;
+        }
+
+        // A chain starts at its only node without predecessor.
+        int start = 0;
+        if (num_edges + 1 == num_nodes) {
+            start = std::find(has_prev.begin(), has_prev.end(), false)
+                - has_prev.begin();
+        }
+        size_t num_steps = 0;
+        int curr = start;
+        while (num_steps < num_edges) {
+            curr = next[curr];
+            if (curr < 0) break;
+            num_steps++;
+            if (curr == start) break;
+        }
+        return num_steps == num_edges;
+    }
+}
+using namespace MeshCheckerHelper;
+
 MeshChecker::MeshChecker(const MatrixFr& vertices, const MatrixIr& faces,
         const MatrixIr& voxels)
     : m_vertices(vertices), m_faces(faces), m_voxels(voxels) {
+        init_edges();
         init_boundary();
         init_boundary_loops();
-        init_edge_face_adjacency();
 }
 
 bool MeshChecker::is_vertex_manifold() const {
     const size_t num_vertices = m_vertices.rows();
     const size_t num_faces = m_faces.rows();
     const size_t vertex_per_face = m_faces.cols();
-
-    std::vector<std::vector<VectorI> > opposite_edges(num_vertices);
-    if (vertex_per_face == 3) {
-        for (size_t i=0; i<num_faces; i++) {
-            const auto& f = m_faces.row(i);
-            opposite_edges[f[0]].push_back(Vector2I(f[1], f[2]));
-            opposite_edges[f[1]].push_back(Vector2I(f[2], f[0]));
-            opposite_edges[f[2]].push_back(Vector2I(f[0], f[1]));
-        }
-    } else if (vertex_per_face == 4) {
-        for (size_t i=0; i<num_faces; i++) {
-            const auto& f = m_faces.row(i);
-            opposite_edges[f[0]].push_back(Vector2I(f[1], f[2]));
-            opposite_edges[f[0]].push_back(Vector2I(f[2], f[3]));
-            opposite_edges[f[1]].push_back(Vector2I(f[2], f[3]));
-            opposite_edges[f[1]].push_back(Vector2I(f[3], f[0]));
-            opposite_edges[f[2]].push_back(Vector2I(f[3], f[0]));
-            opposite_edges[f[2]].push_back(Vector2I(f[0], f[1]));
-            opposite_edges[f[3]].push_back(Vector2I(f[0], f[1]));
-            opposite_edges[f[3]].push_back(Vector2I(f[1], f[2]));
-        }
-    } else {
+    if (vertex_per_face != 3 && vertex_per_face != 4) {
         std::stringstream err_msg;
         err_msg << "Vertex manifold check does not support face with "
             << vertex_per_face << " vertices.";
         throw NotImplementedError(err_msg.str());
     }
 
-    for (const auto& entries: opposite_edges) {
-        if (entries.empty()) continue;
-        try {
-            auto edge_loops = EdgeUtils::chain_edges(
-                    MatrixUtils::rowstack(entries));
-            if (edge_loops.size() != 1) return false;
-        } catch (...) {
-            return false;
-        }
+    // Group face corners by vertex.
+    const size_t num_corners = num_faces * vertex_per_face;
+    const int* corner_vertices = m_faces.data();
+    std::vector<size_t> offsets(num_vertices+1, 0);
+    for (size_t i=0; i<num_corners; i++) {
+        offsets[corner_vertices[i]+1]++;
     }
-    return true;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int> corners(num_corners);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end()-1);
+    for (size_t i=0; i<num_corners; i++) {
+        corners[cursor[corner_vertices[i]]++] = i;
+    }
+
+    // The link of a vertex consists of the edges of its adjacent faces
+    // that are not incident to it.
+    return !any_of(num_vertices, [&](size_t vi) {
+        if (offsets[vi] == offsets[vi+1]) return false;
+        std::vector<std::pair<int, int> > link;
+        for (size_t k=offsets[vi]; k<offsets[vi+1]; k++) {
+            const int* f = m_faces.data() +
+                (corners[k] / vertex_per_face) * vertex_per_face;
+            const size_t j = corners[k] % vertex_per_face;
+            for (size_t l=1; l+1<vertex_per_face; l++) {
+                link.emplace_back(
+                        f[(j+l) % vertex_per_face],
+                        f[(j+l+1) % vertex_per_face]);
+            }
+        }
+        return !is_single_chain(link);
+    });
 }
 
 bool MeshChecker::is_edge_manifold() const {
-    for (auto adj : m_edge_face_adjacency) {
-        if (adj.second.size() > 2) {
-            return false;
-        }
-    }
-    return true;
+    return !any_of(get_num_edges(), [&](size_t ei) {
+        return get_edge_valance(ei) > 2;
+    });
 }
 
 bool MeshChecker::is_oriented() const {
@@ -85,32 +181,22 @@ bool MeshChecker::is_oriented() const {
     // are equal.
     //
     // Boundary edges are skipped.
-    const size_t num_vertex_per_face = m_faces.cols();
-    for (auto adj : m_edge_face_adjacency) {
-        if (adj.second.size() == 1) continue;
-
-        const auto& e = adj.first.get_ori_data();
-        if (e[0] == e[1]) {
-            // It is impossible to determine the orientaiton of faces such as
-            // [a, b, b] or [a, a, a].
-            return false;
-        } else {
-            int consistent_count = 0;
-            for (auto fid : adj.second) {
-                VectorI f = m_faces.row(fid);
-                for (size_t i=0; i<num_vertex_per_face; i++) {
-                    if (f[i] == e[0] && f[(i+1)%num_vertex_per_face] == e[1]) {
-                        consistent_count++;
-                    } else if (f[i] == e[1] &&
-                            f[(i+1)%num_vertex_per_face] == e[0]) {
-                        consistent_count--;
-                    }
-                }
+    return !any_of(get_num_edges(), [&](size_t ei) {
+        if (get_edge_valance(ei) == 1) return false;
+
+        int consistent_count = 0;
+        for (size_t k=m_edge_offsets[ei]; k<m_edge_offsets[ei+1]; k++) {
+            const int s = get_half_edge_source(m_half_edges[k]);
+            const int d = get_half_edge_target(m_half_edges[k]);
+            if (s == d) {
+                // It is impossible to determine the orientaiton of faces
+                // such as [a, b, b] or [a, a, a].
+                return true;
             }
-            if (consistent_count != 0) return false;
+            consistent_count += s < d ? 1 : -1;
         }
-    }
-    return true;
+        return consistent_count != 0;
+    });
 }
 
 bool MeshChecker::is_closed() const {
@@ -118,12 +204,9 @@ bool MeshChecker::is_closed() const {
 }
 
 bool MeshChecker::has_edge_with_odd_adj_faces() const {
-    for (auto adj : m_edge_face_adjacency) {
-        if (adj.second.size() % 2 != 0) {
-            return true;
-        }
-    }
-    return false;
+    return any_of(get_num_edges(), [&](size_t ei) {
+        return get_edge_valance(ei) % 2 != 0;
+    });
 }
 
 size_t MeshChecker::get_num_boundary_edges() const {
@@ -149,13 +232,9 @@ int MeshChecker::get_euler_characteristic() const {
     int num_vertices = m_vertices.rows();
     if (m_voxels.rows() > 0) {
         // Only count surface vertices.
-        std::vector<bool> on_surface(num_vertices, false);
-        std::for_each(m_faces.data(), m_faces.data() + m_faces.size(),
-                [&](int i) { on_surface[i] = true; } );
-        num_vertices = std::accumulate(on_surface.begin(),
-                on_surface.end(), 0);
+        num_vertices = count_used_vertices(num_vertices, {&m_faces});
     }
-    const int num_edges = m_edge_face_adjacency.size();
+    const int num_edges = get_num_edges();
     const int num_faces = m_faces.rows();
     return num_vertices - num_edges + num_faces;
 }
@@ -180,51 +259,44 @@ size_t MeshChecker::get_num_connected_volume_components() const {
 
 size_t MeshChecker::get_num_isolated_vertices() const {
     const size_t num_vertices = m_vertices.rows();
-    std::vector<bool> visited(num_vertices, false);
-    const size_t num_faces = m_faces.rows();
-    const size_t vertex_per_face = m_faces.cols();
-    for (size_t i=0; i<num_faces; i++) {
-        for (size_t j=0; j<vertex_per_face; j++) {
-            visited[m_faces(i,j)] = true;
-        }
-    }
-
-    const size_t num_voxels = m_voxels.rows();
-    const size_t vertex_per_voxel = m_voxels.cols();
-    for (size_t i=0; i<num_voxels; i++) {
-        for (size_t j=0; j<vertex_per_voxel; j++) {
-            visited[m_voxels(i,j)] = true;
-        }
-    }
-    return std::count(visited.begin(), visited.end(), false);
+    return num_vertices -
+        count_used_vertices(num_vertices, {&m_faces, &m_voxels});
 }
 
+/**
+ * Faces are duplicates if they consist of the same set of vertices,
+ * regardless of order.  Faces are sorted by their sorted vertex indices so
+ * that duplicates become adjacent.
+ */
 size_t MeshChecker::get_num_duplicated_faces() const {
     const size_t num_faces = m_faces.rows();
-    auto hash_fn = [](const VectorI& key) -> size_t {
-        const size_t size = key.size();
-        size_t hash = 0;
-        for (size_t i=0; i<size; i++)
-            hash += std::hash<int>()(key[i]);
-        return hash;
+    const size_t vertex_per_face = m_faces.cols();
+    MatrixIr sorted_faces = m_faces;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_faces),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    int* f = sorted_faces.data() + i*vertex_per_face;
+                    std::sort(f, f + vertex_per_face);
+                }
+            });
+
+    auto face_less = [&](int i, int j) {
+        const int* fi = sorted_faces.data() + i*vertex_per_face;
+        const int* fj = sorted_faces.data() + j*vertex_per_face;
+        return std::lexicographical_compare(fi, fi + vertex_per_face,
+                fj, fj + vertex_per_face);
     };
-    typedef std::unordered_map<VectorI, size_t, decltype(hash_fn)> FaceMap;
-    FaceMap face_counts( num_faces, hash_fn);
-
-    for (size_t i=0; i<num_faces; i++) {
-        const auto& f = m_faces.row(i);
-        Vector3I key(f.minCoeff(), f.maxCoeff(), f.sum());
-        auto itr = face_counts.find(key);
-        if (itr == face_counts.end()) {
-            face_counts.insert(itr, std::make_pair(key, 1));
-        } else {
-            itr->second ++;
-        }
+    std::vector<int> order(num_faces);
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(order.begin(), order.end(), face_less);
+
+    size_t num_duplicated_faces = 0;
+    for (size_t i=1; i<num_faces; i++) {
+        const bool same_as_prev = !face_less(order[i-1], order[i]);
+        const bool prev_is_dup = i > 1 && !face_less(order[i-2], order[i-1]);
+        if (same_as_prev && !prev_is_dup) num_duplicated_faces++;
     }
-
-    return std::count_if(face_counts.begin(), face_counts.end(),
-            [](FaceMap::value_type& p) {
-            return p.second != 1; });
+    return num_duplicated_faces;
 }
 
 Float MeshChecker::compute_signed_volume_from_surface() const {
@@ -283,10 +355,44 @@ Float MeshChecker::compute_signed_volume_from_surface() const {
     return volume / 6.0;
 }
 
+void MeshChecker::init_edges() {
+    const size_t num_faces = m_faces.rows();
+    const size_t vertex_per_face = m_faces.cols();
+    const size_t num_half_edges = num_faces * vertex_per_face;
+
+    std::vector<std::pair<uint64_t, int> > keys(num_half_edges);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_half_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    keys[i] = {edge_key(get_half_edge_source(i),
+                            get_half_edge_target(i)), i};
+                }
+            });
+    tbb::parallel_sort(keys.begin(), keys.end());
+
+    m_half_edges.resize(num_half_edges);
+    m_edge_offsets.clear();
+    for (size_t i=0; i<num_half_edges; i++) {
+        m_half_edges[i] = keys[i].second;
+        if (i == 0 || keys[i].first != keys[i-1].first) {
+            m_edge_offsets.push_back(i);
+        }
+    }
+    m_edge_offsets.push_back(num_half_edges);
+}
+
 void MeshChecker::init_boundary() {
-    Boundary::Ptr bd = Boundary::extract_surface_boundary_raw(
-            m_vertices, m_faces);
-    m_boundary_edges = bd->get_boundaries();
+    std::vector<int> boundary_edges;
+    const size_t num_edges = get_num_edges();
+    for (size_t i=0; i<num_edges; i++) {
+        if (get_edge_valance(i) != 1) continue;
+        const int hi = m_half_edges[m_edge_offsets[i]];
+        boundary_edges.push_back(get_half_edge_source(hi));
+        boundary_edges.push_back(get_half_edge_target(hi));
+    }
+    m_boundary_edges.resize(boundary_edges.size() / 2, 2);
+    std::copy(boundary_edges.begin(), boundary_edges.end(),
+            m_boundary_edges.data());
 }
 
 void MeshChecker::init_boundary_loops() {
@@ -298,8 +404,3 @@ void MeshChecker::init_boundary_loops() {
         std::cerr << "Warning: " << e.what() << std::endl;
     }
 }
-
-void MeshChecker::init_edge_face_adjacency() {
-    m_edge_face_adjacency = EdgeUtils::compute_edge_face_adjacency(m_faces);
-}
-
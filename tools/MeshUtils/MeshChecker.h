@@ -4,10 +4,14 @@
 #include <vector>
 
 #include <Core/EigenTypedef.h>
-#include <Misc/MultipletMap.h>
 
 namespace PyMesh {
 
+/**
+ * All edge and face incidence queries are derived from a single array of
+ * half edges sorted by their undirected edge, and most checks are evaluated
+ * in parallel over it.
+ */
 class MeshChecker {
     public:
         MeshChecker(const MatrixFr& vertices, const MatrixIr& faces,
@@ -56,7 +60,7 @@ class MeshChecker {
 
         size_t get_num_boundary_loops() const;
 
-        MatrixIr get_boundary_edges() const {
+        const MatrixIr& get_boundary_edges() const {
             return m_boundary_edges;
         }
 
@@ -90,16 +94,35 @@ class MeshChecker {
         Float compute_signed_volume_from_surface() const;
 
     private:
+        void init_edges();
         void init_boundary();
         void init_boundary_loops();
-        void init_edge_face_adjacency();
+
+        size_t get_num_edges() const { return m_edge_offsets.size() - 1; }
+        size_t get_edge_valance(size_t ei) const {
+            return m_edge_offsets[ei+1] - m_edge_offsets[ei];
+        }
+        int get_half_edge_source(int hi) const { return m_faces.data()[hi]; }
+        int get_half_edge_target(int hi) const {
+            const int vertex_per_face = m_faces.cols();
+            const int corner = hi % vertex_per_face;
+            return m_faces.data()[hi - corner + (corner+1) % vertex_per_face];
+        }
 
     private:
         MatrixFr m_vertices;
         MatrixIr m_faces;
         MatrixIr m_voxels;
         MatrixIr m_boundary_edges;
-        DupletMap<size_t> m_edge_face_adjacency;
+
+        /**
+         * Half edge i*vertex_per_face+j goes from corner j to corner j+1 of
+         * face i.  Half edges are sorted by undirected edge, the half edges
+         * of edge k are m_half_edges[m_edge_offsets[k]] to
+         * m_half_edges[m_edge_offsets[k+1]-1].
+         */
+        std::vector<int> m_half_edges;
+        std::vector<size_t> m_edge_offsets;
         std::vector<VectorI> m_boundary_loops;
         bool m_complex_bd;
 };
@@ -22,7 +22,13 @@ using namespace ObtuseTriangleRemovalHelper;
 
 ObtuseTriangleRemoval::ObtuseTriangleRemoval(
         const MatrixFr& vertices, const MatrixIr& faces)
-    : m_vertices(vertices), m_faces(faces) { }
+    : m_vertices(vertices), m_faces(faces) {
+        const size_t num_faces = m_faces.rows();
+        m_face_indices.resize(num_faces);
+        for (size_t i=0; i<num_faces; i++) {
+            m_face_indices[i] = i;
+        }
+    }
 
 size_t ObtuseTriangleRemoval::run(Float max_angle_allowed, size_t max_iterations) {
     size_t total_num_split = 0;
@@ -53,6 +59,7 @@ void ObtuseTriangleRemoval::clear_intermediate_data() {
     m_edge_faces.clear();
     m_new_vertices.clear();
     m_new_faces.clear();
+    m_new_face_indices.clear();
 }
 
 void ObtuseTriangleRemoval::set_all_faces_as_valid() {
@@ -153,6 +160,8 @@ void ObtuseTriangleRemoval::split_triangle(size_t ext_idx) {
 
         m_new_faces.push_back(f1);
         m_new_faces.push_back(f2);
+        m_new_face_indices.push_back(m_face_indices[f_idx]);
+        m_new_face_indices.push_back(m_face_indices[f_idx]);
 
         m_valid[f_idx] = false;
     }
@@ -192,14 +201,22 @@ void ObtuseTriangleRemoval::finalize_faces() {
     typedef std::vector<Vector3I> FaceArray;
     const size_t num_ori_f = m_faces.rows();
     FaceArray valid_faces;
+    std::vector<int> valid_face_indices;
     valid_faces.reserve(num_ori_f);
+    valid_face_indices.reserve(num_ori_f);
     for (size_t i=0; i<num_ori_f; i++) {
         if (m_valid[i]) {
             valid_faces.push_back(m_faces.row(i));
+            valid_face_indices.push_back(m_face_indices[i]);
         }
     }
     valid_faces.insert(valid_faces.end(),
             m_new_faces.begin(), m_new_faces.end());
+    valid_face_indices.insert(valid_face_indices.end(),
+            m_new_face_indices.begin(), m_new_face_indices.end());
     assert(valid_faces.size() > 0);
     m_faces = MatrixUtils::rowstack(valid_faces);
+    m_face_indices.resize(valid_face_indices.size());
+    std::copy(valid_face_indices.begin(), valid_face_indices.end(),
+            m_face_indices.data());
 }
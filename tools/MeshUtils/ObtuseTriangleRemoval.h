@@ -13,8 +13,9 @@ class ObtuseTriangleRemoval {
     public:
         // Angle in radian
         size_t run(Float max_angle_allowed, size_t max_iterations=1);
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_indices() const { return m_face_indices; }
 
     private:
         void clear_intermediate_data();
@@ -44,8 +45,10 @@ class ObtuseTriangleRemoval {
         EdgeMapI m_edge_faces;
         std::vector<Vector3F> m_new_vertices;
         std::vector<Vector3I> m_new_faces;
+        std::vector<int> m_new_face_indices;
 
         MatrixFr m_vertices;
         MatrixIr m_faces;
+        VectorI  m_face_indices;
 };
 }
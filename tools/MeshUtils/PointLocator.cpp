@@ -1,63 +1,91 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "PointLocator.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
 #include <sstream>
+#include <utility>
+
+#include <tbb/tbb.h>
 
 #include <Core/Exception.h>
-#include <Misc/HashGrid.h>
 
 using namespace PyMesh;
 
+namespace PointLocatorHelper {
+    /**
+     * Maximum number of grid cells per element.
+     */
+    const size_t CELLS_PER_ELEMENT = 8;
+
+    template<int DIM>
+    using Solver = Eigen::Matrix<Float, DIM, DIM+1, Eigen::RowMajor>;
+
+    template<int DIM>
+    using Point = Eigen::Matrix<Float, DIM, 1>;
+
+    template<int DIM>
+    using BarycentricCoord = Eigen::Matrix<Float, DIM+1, 1>;
+
+    /**
+     * Largest distance from a point to the supporting planes of the element
+     * faces it lies outside of.  Row j of the solver is the gradient of
+     * barycentric coordinate j, and the gradient of the last coordinate is
+     * minus their sum.
+     */
+    template<int DIM>
+    Float compute_outside_distance(
+            const Eigen::Map<const Solver<DIM> >& solver,
+            const BarycentricCoord<DIM>& coord) {
+        Float dist = 0.0;
+        for (size_t j=0; j<DIM; j++) {
+            if (coord[j] < 0.0) {
+                dist = std::max(dist, -coord[j] /
+                        solver.row(j).template head<DIM>().norm());
+            }
+        }
+        if (coord[DIM] < 0.0) {
+            dist = std::max(dist, -coord[DIM] /
+                    solver.template leftCols<DIM>().colwise().sum().norm());
+        }
+        return dist;
+    }
+}
+using namespace PointLocatorHelper;
+
 PointLocator::PointLocator(Mesh::Ptr mesh) : m_mesh(mesh) {
     init_elements();
     init_barycentric_solvers();
-    init_hash_grid();
+    init_grid();
 }
 
 void PointLocator::locate(const MatrixFr& points) {
-    const Float eps = 1e-6;
     const size_t num_pts = points.rows();
+    if (num_pts > 0 && size_t(points.cols()) != m_dim) {
+        throw RuntimeError("Query points have the wrong dimension");
+    }
     m_voxel_idx = VectorI::Zero(num_pts);
     m_barycentric_coords = MatrixFr::Zero(num_pts, m_vertex_per_element);
 
-    for (size_t i=0; i<num_pts; i++) {
-        VectorF v = points.row(i);
-        VectorI candidate_elems = m_grid->get_items_near_point(v);
-
-        VectorF barycentric_coord;
-        VectorF best_barycentric_coord;
-
-        bool found = false;
-        Float least_negative_coordinate = -std::numeric_limits<Float>::max();
-        const size_t num_candidates = candidate_elems.size();
-        for (size_t j=0; j<num_candidates; j++) {
-            barycentric_coord = compute_barycentric_coord(
-                    v, candidate_elems[j]);
-            Float min_barycentric_coord = barycentric_coord.minCoeff();
-            if (min_barycentric_coord > least_negative_coordinate) {
-                found = true;
-                least_negative_coordinate = min_barycentric_coord;
-                m_voxel_idx[i] = candidate_elems[j];
-                best_barycentric_coord = barycentric_coord;
-                if (min_barycentric_coord >= -eps) {
-                    break;
-                }
-            }
-        }
+    std::vector<char> found(num_pts, false);
+    if (m_dim == 2) {
+        locate_points<2>(points, found);
+    } else {
+        locate_points<3>(points, found);
+    }
 
-        if (!found) {
+    for (size_t i=0; i<num_pts; i++) {
+        if (!found[i]) {
             std::stringstream err_msg;
             err_msg << "Point ( ";
-            for (size_t i=0; i<m_mesh->get_dim(); i++) {
-                err_msg << v[i] << " ";
+            for (size_t j=0; j<m_dim; j++) {
+                err_msg << points(i, j) << " ";
             }
             err_msg << ") is not inside of any voxels" << std::endl;
             throw RuntimeError(err_msg.str());
         }
-
-        m_barycentric_coords.row(i) = best_barycentric_coord;
     }
 }
 
@@ -92,72 +120,245 @@ void PointLocator::init_elements() {
     } else {
         throw NotImplementedError("Only 2D and 3D mesh are supported");
     }
+
+    m_dim = dim;
+    m_num_elements = m_elements.size() / m_vertex_per_element;
 }
 
 void PointLocator::init_barycentric_solvers() {
-    const size_t dim = m_mesh->get_dim();
+    const size_t dim = m_dim;
+    const size_t stride = dim * (dim+1);
+    const VectorF& vertices = m_mesh->get_vertices();
 
-    const size_t num_elements = m_elements.size() / m_vertex_per_element;
-    m_barycentric_solvers = MatrixF::Zero(num_elements*dim, dim);
-    m_last_vertices = MatrixF::Zero(num_elements, dim);
+    m_barycentric_solvers.resize(m_num_elements * stride);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_elements),
+            [&](const tbb::blocked_range<size_t>& r) {
+                MatrixFr M(dim, dim);
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const int* elem = m_elements.data() + i*m_vertex_per_element;
+                    const VectorF last_v = vertices.segment(elem[dim]*dim, dim);
+                    for (size_t j=0; j<dim; j++) {
+                        M.row(j) = vertices.segment(elem[j]*dim, dim) - last_v;
+                    }
+                    const MatrixF solver = M.transpose().inverse();
 
-    for (size_t i=0; i<num_elements; i++) {
-        VectorI elem = m_elements.segment(i*m_vertex_per_element, m_vertex_per_element);
-        VectorF last_v = m_mesh->get_vertex(elem[dim]);
-        MatrixFr M(dim, dim);
-        for (size_t j=0; j<dim; j++) {
-            M.row(j) = m_mesh->get_vertex(elem[j]) - last_v;
-        }
-        m_barycentric_solvers.block(i*dim, 0, dim, dim) = M.transpose().inverse();
-        m_last_vertices.row(i) = last_v;
-    }
+                    Float* entry = m_barycentric_solvers.data() + i*stride;
+                    for (size_t j=0; j<dim; j++) {
+                        for (size_t k=0; k<dim; k++) {
+                            entry[j*(dim+1) + k] = solver(j, k);
+                        }
+                        entry[j*(dim+1) + dim] = last_v[j];
+                    }
+                }
+            });
 }
 
-void PointLocator::init_hash_grid() {
-    const size_t dim = m_mesh->get_dim();
-    const size_t num_elements = m_elements.size() / m_vertex_per_element;
+void PointLocator::init_grid() {
+    const size_t dim = m_dim;
+    const VectorF& vertices = m_mesh->get_vertices();
+    const size_t num_vertices = m_mesh->get_num_vertices();
+
+    VectorF bbox_min = VectorF::Constant(dim, std::numeric_limits<Float>::max());
+    VectorF bbox_max = VectorF::Constant(dim, std::numeric_limits<Float>::lowest());
+    for (size_t i=0; i<num_vertices; i++) {
+        const VectorF v = vertices.segment(i*dim, dim);
+        bbox_min = bbox_min.cwiseMin(v);
+        bbox_max = bbox_max.cwiseMax(v);
+    }
 
-    Float cell_size = compute_cell_size();
-    m_grid = HashGrid::create(cell_size, dim);
+    // Points within a tenth of the average edge length from the mesh are
+    // still assigned to the closest boundary cell.
+    const Float ave_edge_len = compute_ave_edge_length();
+    const Float margin = 0.1 * ave_edge_len;
+    m_margin = margin;
+    m_grid_min = bbox_min - VectorF::Constant(dim, margin);
+    const VectorF extent = bbox_max - bbox_min + VectorF::Constant(dim, 2*margin);
 
-    MatrixF elem_vtx(m_vertex_per_element, dim);
-    for (size_t i=0; i<num_elements; i++) {
-        VectorI elem = m_elements.segment(i*m_vertex_per_element, m_vertex_per_element);
-        for (size_t j=0; j<m_vertex_per_element; j++) {
-            elem_vtx.row(j) = m_mesh->get_vertex(elem[j]);
+    // Cells are roughly the size of an element, but the total number of
+    // cells is bounded by the number of elements.
+    const size_t max_num_cells = CELLS_PER_ELEMENT * m_num_elements;
+    m_cell_size = ave_edge_len > 0.0 ? ave_edge_len : 1.0;
+    m_cell_size = std::max(m_cell_size, extent.maxCoeff() / max_num_cells);
+    size_t num_cells;
+    while (true) {
+        m_grid_size.resize(dim);
+        num_cells = 1;
+        for (size_t i=0; i<dim; i++) {
+            m_grid_size[i] = std::max(1, int(std::ceil(extent[i] / m_cell_size)));
+            num_cells *= m_grid_size[i];
         }
-        m_grid->insert_bbox(i, elem_vtx);
+        if (num_cells <= max_num_cells) break;
+        m_cell_size *= std::pow(Float(num_cells) / Float(max_num_cells),
+                1.0 / dim) * 1.01;
+    }
+
+    // Cell range covered by the bounding box of each element.
+    MatrixIr cell_ranges(m_num_elements, dim*2);
+    std::vector<size_t> num_entries(m_num_elements+1, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_elements),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const int* elem = m_elements.data() + i*m_vertex_per_element;
+                    size_t count = 1;
+                    for (size_t j=0; j<dim; j++) {
+                        Float lo = std::numeric_limits<Float>::max();
+                        Float hi = std::numeric_limits<Float>::lowest();
+                        for (size_t k=0; k<m_vertex_per_element; k++) {
+                            const Float x = vertices[elem[k]*dim+j];
+                            lo = std::min(lo, x);
+                            hi = std::max(hi, x);
+                        }
+                        const int lo_idx = std::max(0, int(std::floor(
+                                        (lo - m_grid_min[j]) / m_cell_size)));
+                        const int hi_idx = std::min(m_grid_size[j]-1, int(std::floor(
+                                        (hi - m_grid_min[j]) / m_cell_size)));
+                        cell_ranges(i, j*2) = lo_idx;
+                        cell_ranges(i, j*2+1) = hi_idx;
+                        count *= size_t(hi_idx - lo_idx + 1);
+                    }
+                    num_entries[i+1] = count;
+                }
+            });
+    for (size_t i=0; i<m_num_elements; i++) {
+        num_entries[i+1] += num_entries[i];
+    }
+
+    std::vector<std::pair<size_t, int> > entries(num_entries.back());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_num_elements),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    size_t count = num_entries[i];
+                    if (dim == 2) {
+                        for (int x=cell_ranges(i,0); x<=cell_ranges(i,1); x++) {
+                            for (int y=cell_ranges(i,2); y<=cell_ranges(i,3); y++) {
+                                const size_t cell = size_t(x) * m_grid_size[1] + y;
+                                entries[count++] = {cell, int(i)};
+                            }
+                        }
+                    } else {
+                        for (int x=cell_ranges(i,0); x<=cell_ranges(i,1); x++) {
+                            for (int y=cell_ranges(i,2); y<=cell_ranges(i,3); y++) {
+                                for (int z=cell_ranges(i,4); z<=cell_ranges(i,5); z++) {
+                                    const size_t cell = (size_t(x) * m_grid_size[1]
+                                            + y) * m_grid_size[2] + z;
+                                    entries[count++] = {cell, int(i)};
+                                }
+                            }
+                        }
+                    }
+                    assert(count == num_entries[i+1]);
+                }
+            });
+    tbb::parallel_sort(entries.begin(), entries.end());
+
+    m_cell_offsets.assign(num_cells+1, 0);
+    m_cell_elements.resize(entries.size());
+    for (size_t i=0; i<entries.size(); i++) {
+        m_cell_offsets[entries[i].first+1]++;
+        m_cell_elements[i] = entries[i].second;
+    }
+    for (size_t i=0; i<num_cells; i++) {
+        m_cell_offsets[i+1] += m_cell_offsets[i];
     }
 }
 
-Float PointLocator::compute_cell_size() const {
-    const size_t num_elements = m_elements.size() / m_vertex_per_element;
+Float PointLocator::compute_ave_edge_length() const {
+    const size_t dim = m_dim;
+    const VectorF& vertices = m_mesh->get_vertices();
 
     Float total_edge_len = 0.0;
-
-    for (size_t i=0; i<num_elements; i++) {
-        VectorI elem = m_elements.segment(i*m_vertex_per_element, m_vertex_per_element);
+    for (size_t i=0; i<m_num_elements; i++) {
+        const int* elem = m_elements.data() + i*m_vertex_per_element;
         for (size_t j=0; j<m_vertex_per_element; j++) {
             Float edge_len = (
-                    m_mesh->get_vertex(elem[j]) -
-                    m_mesh->get_vertex(elem[(j+1)%m_vertex_per_element])).norm();
+                    vertices.segment(elem[j]*dim, dim) -
+                    vertices.segment(elem[(j+1)%m_vertex_per_element]*dim, dim)
+                    ).norm();
             total_edge_len += edge_len;
         }
     }
 
-    Float ave_edge_len = total_edge_len / (num_elements * m_vertex_per_element);
-    return 0.1 * ave_edge_len;
+    return total_edge_len / (m_num_elements * m_vertex_per_element);
 }
 
-VectorF PointLocator::compute_barycentric_coord(const VectorF& v,
-        size_t elem_idx) {
-    const size_t dim = m_mesh->get_dim();
-    MatrixF solver = m_barycentric_solvers.block(elem_idx*dim, 0, dim, dim);
-    VectorF last_v = m_last_vertices.row(elem_idx);
-    VectorF sol = solver * (v - last_v);
-    VectorF barycentric_coord(m_vertex_per_element);
-    barycentric_coord.segment(0, dim) = sol;
-    barycentric_coord[dim] = 1.0 - sol.sum();
-    return barycentric_coord;
+template<int DIM>
+void PointLocator::locate_points(const MatrixFr& points,
+        std::vector<char>& found) {
+    const Float eps = 1e-6;
+    const size_t num_pts = points.rows();
+    const Float* solvers = m_barycentric_solvers.data();
+    const size_t stride = DIM * (DIM+1);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_pts),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Point<DIM> v = points.row(i).transpose();
+                    size_t begin, end;
+                    if (!get_candidates<DIM>(v.data(), begin, end)) {
+                        continue;
+                    }
+
+                    BarycentricCoord<DIM> barycentric_coord;
+                    BarycentricCoord<DIM> best_barycentric_coord;
+                    int best_elem = -1;
+                    Float least_negative_coordinate =
+                        -std::numeric_limits<Float>::max();
+                    for (size_t j=begin; j<end; j++) {
+                        const int elem_idx = m_cell_elements[j];
+                        const Eigen::Map<const Solver<DIM> > solver(
+                                solvers + elem_idx*stride);
+                        barycentric_coord.template head<DIM>() =
+                            solver.template leftCols<DIM>() *
+                            (v - solver.col(DIM));
+                        barycentric_coord[DIM] = 1.0 -
+                            barycentric_coord.template head<DIM>().sum();
+
+                        const Float min_barycentric_coord =
+                            barycentric_coord.minCoeff();
+                        if (min_barycentric_coord > least_negative_coordinate) {
+                            least_negative_coordinate = min_barycentric_coord;
+                            best_elem = elem_idx;
+                            best_barycentric_coord = barycentric_coord;
+                            if (min_barycentric_coord >= -eps) {
+                                break;
+                            }
+                        }
+                    }
+
+                    // Cells can be much larger than elements, so a point
+                    // outside of every candidate is only accepted if it is
+                    // within the grid margin of the best one.
+                    if (best_elem >= 0 && least_negative_coordinate < -eps) {
+                        const Eigen::Map<const Solver<DIM> > solver(
+                                solvers + best_elem*stride);
+                        if (compute_outside_distance<DIM>(solver,
+                                    best_barycentric_coord) > m_margin) {
+                            best_elem = -1;
+                        }
+                    }
+
+                    if (best_elem >= 0) {
+                        found[i] = true;
+                        m_voxel_idx[i] = best_elem;
+                        m_barycentric_coords.row(i) =
+                            best_barycentric_coord.transpose();
+                    }
+                }
+            });
 }
 
+template<int DIM>
+bool PointLocator::get_candidates(const Float* p,
+        size_t& begin, size_t& end) const {
+    size_t cell = 0;
+    for (size_t i=0; i<DIM; i++) {
+        const Float x = std::floor((p[i] - m_grid_min[i]) / m_cell_size);
+        if (!(x >= 0.0 && x < m_grid_size[i])) {
+            return false;
+        }
+        cell = cell * m_grid_size[i] + size_t(x);
+    }
+    begin = m_cell_offsets[cell];
+    end = m_cell_offsets[cell+1];
+    return begin < end;
+}
@@ -3,11 +3,19 @@
 
 #include <vector>
 #include <Core/EigenTypedef.h>
-#include <Misc/HashGrid.h>
 #include <Mesh.h>
 
 namespace PyMesh {
 
+/**
+ * Locate the triangle/tet enclosing each query point.
+ *
+ * Elements are binned into a read-only uniform grid stored in compressed
+ * row format, and the affine map from position to barycentric coordinates
+ * of each element is precomputed and stored contiguously.  Queries are
+ * independent and are distributed over threads with TBB.  Points farther
+ * than 0.1x the average edge length from every element are not located.
+ */
 class PointLocator {
     public:
         PointLocator(Mesh::Ptr mesh);
@@ -18,11 +26,11 @@ class PointLocator {
          */
         void locate(const MatrixFr& points);
 
-        VectorI get_enclosing_voxels() const {
+        const VectorI& get_enclosing_voxels() const {
             return m_voxel_idx;
         }
 
-        MatrixFr get_barycentric_coords() const {
+        const MatrixFr& get_barycentric_coords() const {
             return m_barycentric_coords;
         }
 
@@ -31,21 +39,44 @@ class PointLocator {
     private:
         void init_elements();
         void init_barycentric_solvers();
-        void init_hash_grid();
+        void init_grid();
 
-        Float compute_cell_size() const;
-        VectorF compute_barycentric_coord(const VectorF& v, size_t elem_idx);
+        Float compute_ave_edge_length() const;
+
+        template<int DIM>
+        void locate_points(const MatrixFr& points,
+                std::vector<char>& found);
+
+        template<int DIM>
+        bool get_candidates(const Float* p,
+                size_t& begin, size_t& end) const;
 
     private:
         Mesh::Ptr m_mesh;
 
         VectorI m_elements;
+        size_t m_dim;
+        size_t m_num_elements;
         size_t m_vertex_per_element;
 
-        MatrixF m_barycentric_solvers;
-        MatrixF m_last_vertices;
+        /**
+         * Per element row major DIM x (DIM+1) matrix [A | u] such that the
+         * first DIM barycentric coordinates of point v are A*(v - u), where
+         * u is the last vertex of the element.  Working relative to u avoids
+         * the cancellation of A*v - A*u for elements far from the origin.
+         */
+        std::vector<Float> m_barycentric_solvers;
 
-        HashGrid::Ptr m_grid;
+        /**
+         * Points outside of all elements are still located if they are
+         * within this distance of the closest candidate element.
+         */
+        Float m_margin;
+        Float m_cell_size;
+        VectorF m_grid_min;
+        VectorI m_grid_size;
+        std::vector<size_t> m_cell_offsets;
+        std::vector<int> m_cell_elements;
 
         VectorI m_voxel_idx;
         MatrixFr m_barycentric_coords;
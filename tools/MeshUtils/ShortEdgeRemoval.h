@@ -31,8 +31,8 @@ class ShortEdgeRemoval {
          */
         size_t run(Float threshold);
         MatrixFr get_vertices() const;
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_face_indices() const { return m_face_indices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_indices() const { return m_face_indices; }
 
     private:
         using Edge = Duplet;
@@ -38,32 +38,32 @@ class SubMesh {
         void finalize();
 
         // Selected geometry
-        MatrixFr get_selected_vertices() const {
+        const MatrixFr& get_selected_vertices() const {
             check_validity(); return m_selected_vertices;
         }
-        MatrixIr get_selected_faces() const {
+        const MatrixIr& get_selected_faces() const {
             check_validity(); return m_selected_faces;
         }
 
-        VectorI get_selected_vertex_indices() const {
+        const VectorI& get_selected_vertex_indices() const {
             check_validity(); return m_selected_vertex_indices;
         }
-        VectorI get_selected_face_indices() const {
+        const VectorI& get_selected_face_indices() const {
             check_validity(); return m_selected_face_indices;
         }
 
         // Unselected geometry
-        MatrixFr get_unselected_vertices() const {
+        const MatrixFr& get_unselected_vertices() const {
             check_validity(); return m_unselected_vertices;
         }
-        MatrixIr get_unselected_faces() const {
+        const MatrixIr& get_unselected_faces() const {
             check_validity(); return m_unselected_faces;
         }
 
-        VectorI get_unselected_vertex_indices() const {
+        const VectorI& get_unselected_vertex_indices() const {
             check_validity(); return m_unselected_vertex_indices;
         }
-        VectorI get_unselected_face_indices() const {
+        const VectorI& get_unselected_face_indices() const {
             check_validity(); return m_unselected_face_indices;
         }
 
@@ -27,9 +27,9 @@ class Subdivision {
         virtual const std::vector<ZSparseMatrix>& get_subdivision_matrices() const=0;
 
     public:
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_face_indices() const { return m_face_indices; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_indices() const { return m_face_indices; }
 
         size_t get_num_vertices() const { return m_vertices.rows(); }
         size_t get_num_faces() const { return m_faces.rows(); }
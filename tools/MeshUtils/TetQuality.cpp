@@ -0,0 +1,305 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "TetQuality.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <tbb/tbb.h>
+
+#include <Core/Exception.h>
+#include <Predicates/predicates.h>
+
+using namespace PyMesh;
+
+namespace TetQualityHelper {
+    /**
+     * Number of tets processed together.
+     */
+    const size_t BLOCK_SIZE = 256;
+
+    typedef std::array<Float, BLOCK_SIZE> Lane;
+
+    /**
+     * Structure of arrays holding one block of tets: coords[i*3+j][k] is
+     * coordinate j of vertex i of the k-th tet in the block.  The remaining
+     * lanes hold intermediate values and per-tet measures.  normals[i*3+j]
+     * is coordinate j of the outward normal of face i (opposite to vertex i)
+     * scaled by twice the face area.
+     */
+    struct Block {
+        std::array<Lane, 12> coords;
+        std::array<Lane, 12> normals;
+        std::array<Lane, 6> normal_dots;
+        std::array<Lane, 6> normal_crosses;
+        Lane dets;
+        Lane circumcenter_sq_norms;
+        Lane area_sums;
+        Lane volumes;
+        Lane inradii;
+        Lane circumradii;
+        Lane radius_edge_ratios;
+        Lane min_edge_lengths;
+        Lane max_edge_lengths;
+    };
+
+    /**
+     * Pairs of faces adjacent to the edges (0,1), (1,2), (0,2), (0,3),
+     * (2,3), (1,3), where face i is opposite to vertex i.
+     */
+    const size_t EDGE_FACES[6][2] = {
+        {2, 3}, {0, 3}, {1, 3}, {1, 2}, {0, 1}, {0, 2}
+    };
+
+    /**
+     * Compute all measures but orientations and dihedral angles of the
+     * first n tets of a block.
+     *
+     * Every loop below is a flat loop over the tets of the block without
+     * branches: degenerate cases are handled by selects on values that are
+     * computed unconditionally, so that the compiler can vectorize them.
+     */
+    void compute_block(Block& block, size_t n) {
+        const Float infinity = std::numeric_limits<Float>::infinity();
+        const Lane& x0 = block.coords[0];
+        const Lane& y0 = block.coords[1];
+        const Lane& z0 = block.coords[2];
+        const Lane& x1 = block.coords[3];
+        const Lane& y1 = block.coords[4];
+        const Lane& z1 = block.coords[5];
+        const Lane& x2 = block.coords[6];
+        const Lane& y2 = block.coords[7];
+        const Lane& z2 = block.coords[8];
+        const Lane& x3 = block.coords[9];
+        const Lane& y3 = block.coords[10];
+        const Lane& z3 = block.coords[11];
+
+        // Shortest and longest edges.
+        for (size_t k=0; k<n; k++) {
+            const Float ax = x1[k]-x0[k], ay = y1[k]-y0[k], az = z1[k]-z0[k];
+            const Float bx = x2[k]-x0[k], by = y2[k]-y0[k], bz = z2[k]-z0[k];
+            const Float cx = x3[k]-x0[k], cy = y3[k]-y0[k], cz = z3[k]-z0[k];
+            const Float dx = x2[k]-x1[k], dy = y2[k]-y1[k], dz = z2[k]-z1[k];
+            const Float ex = x3[k]-x1[k], ey = y3[k]-y1[k], ez = z3[k]-z1[k];
+            const Float fx = x3[k]-x2[k], fy = y3[k]-y2[k], fz = z3[k]-z2[k];
+            const Float la = ax*ax + ay*ay + az*az;
+            const Float lb = bx*bx + by*by + bz*bz;
+            const Float lc = cx*cx + cy*cy + cz*cz;
+            const Float ld = dx*dx + dy*dy + dz*dz;
+            const Float le = ex*ex + ey*ey + ez*ez;
+            const Float lf = fx*fx + fy*fy + fz*fz;
+            block.min_edge_lengths[k] = std::sqrt(std::min(
+                        std::min(std::min(la, lb), std::min(lc, ld)),
+                        std::min(le, lf)));
+            block.max_edge_lengths[k] = std::sqrt(std::max(
+                        std::max(std::max(la, lb), std::max(lc, ld)),
+                        std::max(le, lf)));
+        }
+
+        // Face normals, determinant and circumcenter.  With a, b, c the
+        // edges from v0, the circumcenter relative to v0 is
+        //   (|a|^2 b x c + |b|^2 c x a + |c|^2 a x b) / (2 det).
+        for (size_t k=0; k<n; k++) {
+            const Float ax = x1[k]-x0[k], ay = y1[k]-y0[k], az = z1[k]-z0[k];
+            const Float bx = x2[k]-x0[k], by = y2[k]-y0[k], bz = z2[k]-z0[k];
+            const Float cx = x3[k]-x0[k], cy = y3[k]-y0[k], cz = z3[k]-z0[k];
+            const Float dx = x2[k]-x1[k], dy = y2[k]-y1[k], dz = z2[k]-z1[k];
+            const Float ex = x3[k]-x1[k], ey = y3[k]-y1[k], ez = z3[k]-z1[k];
+            const Float la = ax*ax + ay*ay + az*az;
+            const Float lb = bx*bx + by*by + bz*bz;
+            const Float lc = cx*cx + cy*cy + cz*cz;
+
+            const Float bcx = by*cz - bz*cy, bcy = bz*cx - bx*cz, bcz = bx*cy - by*cx;
+            const Float cax = cy*az - cz*ay, cay = cz*ax - cx*az, caz = cx*ay - cy*ax;
+            const Float abx = ay*bz - az*by, aby = az*bx - ax*bz, abz = ax*by - ay*bx;
+
+            block.normals[0][k] = dy*ez - dz*ey;
+            block.normals[1][k] = dz*ex - dx*ez;
+            block.normals[2][k] = dx*ey - dy*ex;
+            block.normals[3][k] = -bcx;
+            block.normals[4][k] = -bcy;
+            block.normals[5][k] = -bcz;
+            block.normals[6][k] = -cax;
+            block.normals[7][k] = -cay;
+            block.normals[8][k] = -caz;
+            block.normals[9][k] = -abx;
+            block.normals[10][k] = -aby;
+            block.normals[11][k] = -abz;
+
+            const Float ux = la*bcx + lb*cax + lc*abx;
+            const Float uy = la*bcy + lb*cay + lc*aby;
+            const Float uz = la*bcz + lb*caz + lc*abz;
+            block.dets[k] = ax*bcx + ay*bcy + az*bcz;
+            block.circumcenter_sq_norms[k] = ux*ux + uy*uy + uz*uz;
+        }
+
+        // Sum of twice the face areas.
+        for (size_t k=0; k<n; k++) {
+            const Float n0x = block.normals[0][k], n0y = block.normals[1][k], n0z = block.normals[2][k];
+            const Float n1x = block.normals[3][k], n1y = block.normals[4][k], n1z = block.normals[5][k];
+            const Float n2x = block.normals[6][k], n2y = block.normals[7][k], n2z = block.normals[8][k];
+            const Float n3x = block.normals[9][k], n3y = block.normals[10][k], n3z = block.normals[11][k];
+            block.area_sums[k] =
+                std::sqrt(n0x*n0x + n0y*n0y + n0z*n0z) +
+                std::sqrt(n1x*n1x + n1y*n1y + n1z*n1z) +
+                std::sqrt(n2x*n2x + n2y*n2y + n2z*n2z) +
+                std::sqrt(n3x*n3x + n3y*n3y + n3z*n3z);
+        }
+
+        // Dot products and cross product norms of the normals adjacent to
+        // each edge.  The loop over edges is outside so that the inner loop
+        // only touches fixed lanes.
+        for (size_t i=0; i<6; i++) {
+            const Lane& px = block.normals[EDGE_FACES[i][0]*3  ];
+            const Lane& py = block.normals[EDGE_FACES[i][0]*3+1];
+            const Lane& pz = block.normals[EDGE_FACES[i][0]*3+2];
+            const Lane& qx = block.normals[EDGE_FACES[i][1]*3  ];
+            const Lane& qy = block.normals[EDGE_FACES[i][1]*3+1];
+            const Lane& qz = block.normals[EDGE_FACES[i][1]*3+2];
+            Lane& dots = block.normal_dots[i];
+            Lane& crosses = block.normal_crosses[i];
+            for (size_t k=0; k<n; k++) {
+                const Float sx = py[k]*qz[k] - pz[k]*qy[k];
+                const Float sy = pz[k]*qx[k] - px[k]*qz[k];
+                const Float sz = px[k]*qy[k] - py[k]*qx[k];
+                dots[k] = px[k]*qx[k] + py[k]*qy[k] + pz[k]*qz[k];
+                crosses[k] = std::sqrt(sx*sx + sy*sy + sz*sz);
+            }
+        }
+
+        // Degenerate tets have infinite circumradius and radius edge ratio,
+        // and 0 inradius.  A zero det yields x/0 = inf or, if the tet
+        // collapsed to a point or segment, 0/0 = NaN.  Comparisons with NaN
+        // are false, so the min/max below map NaN to inf and 0 respectively.
+        for (size_t k=0; k<n; k++) {
+            const Float det = block.dets[k];
+            const Float abs_det = std::abs(det);
+            const Float circumradius = std::min(infinity,
+                    std::sqrt(block.circumcenter_sq_norms[k]) / (2.0 * abs_det));
+            block.volumes[k] = det / 6.0;
+            block.circumradii[k] = circumradius;
+            block.inradii[k] = std::max(Float(0.0),
+                    abs_det / block.area_sums[k]);
+            block.radius_edge_ratios[k] =
+                circumradius / block.min_edge_lengths[k];
+        }
+    }
+}
+
+using namespace TetQualityHelper;
+
+void TetQuality::run(const MatrixFr& vertices, const MatrixIr& tets) {
+    const size_t dim = vertices.cols();
+    const size_t num_tets = tets.rows();
+    if (dim != 3) {
+        throw RuntimeError("Tet quality is only defined for 3D meshes.");
+    }
+    if (num_tets > 0 && tets.cols() != 4) {
+        throw RuntimeError("Tet quality expects a tet mesh.");
+    }
+
+    m_volumes.resize(num_tets);
+    m_orientations.resize(num_tets);
+    m_dihedral_angles.resize(num_tets, 6);
+    m_inradii.resize(num_tets);
+    m_circumradii.resize(num_tets);
+    m_radius_edge_ratios.resize(num_tets);
+    m_min_edge_lengths.resize(num_tets);
+    m_max_edge_lengths.resize(num_tets);
+
+    exactinit();
+    const size_t num_blocks = (num_tets + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks),
+            [&](const tbb::blocked_range<size_t>& r) {
+                std::unique_ptr<Block> block_ptr(new Block);
+                Block& block = *block_ptr;
+                for (size_t bi=r.begin(); bi!=r.end(); bi++) {
+                    const size_t begin = bi * BLOCK_SIZE;
+                    const size_t n = std::min(BLOCK_SIZE, num_tets - begin);
+                    for (size_t k=0; k<n; k++) {
+                        for (size_t i=0; i<4; i++) {
+                            const int vi = tets(begin+k, i);
+                            block.coords[i*3  ][k] = vertices(vi, 0);
+                            block.coords[i*3+1][k] = vertices(vi, 1);
+                            block.coords[i*3+2][k] = vertices(vi, 2);
+                        }
+                    }
+
+                    compute_block(block, n);
+
+                    std::copy_n(block.volumes.begin(), n,
+                            m_volumes.data() + begin);
+                    std::copy_n(block.inradii.begin(), n,
+                            m_inradii.data() + begin);
+                    std::copy_n(block.circumradii.begin(), n,
+                            m_circumradii.data() + begin);
+                    std::copy_n(block.radius_edge_ratios.begin(), n,
+                            m_radius_edge_ratios.data() + begin);
+                    std::copy_n(block.min_edge_lengths.begin(), n,
+                            m_min_edge_lengths.data() + begin);
+                    std::copy_n(block.max_edge_lengths.begin(), n,
+                            m_max_edge_lengths.data() + begin);
+
+                    // atan2 and the exact predicate are not vectorizable.
+                    for (size_t k=0; k<n; k++) {
+                        for (size_t i=0; i<6; i++) {
+                            m_dihedral_angles(begin+k, i) = M_PI - atan2(
+                                    block.normal_crosses[i][k],
+                                    block.normal_dots[i][k]);
+                        }
+                    }
+
+                    // NOTE: orient3d(a,b,c,d) is positive if d is below
+                    // triangle (a,b,c), so a and b are swapped to follow the
+                    // MSH ordering (see VoxelUtils::get_tet_orientations).
+                    for (size_t k=0; k<n; k++) {
+                        Float p[4][3];
+                        for (size_t i=0; i<4; i++) {
+                            for (size_t j=0; j<3; j++) {
+                                p[i][j] = block.coords[i*3+j][k];
+                            }
+                        }
+                        m_orientations[begin+k] = orient3d(p[1], p[0], p[2], p[3]);
+                    }
+                }
+            });
+}
+
+VectorI TetQuality::compute_histogram(const VectorF& values,
+        Float min_value, Float max_value, size_t num_bins) {
+    if (num_bins == 0) {
+        throw RuntimeError("Histogram needs at least 1 bin.");
+    }
+    if (!(max_value > min_value)) {
+        throw RuntimeError("Histogram range is empty.");
+    }
+
+    const size_t num_values = values.size();
+    const Float bin_size = (max_value - min_value) / num_bins;
+    tbb::enumerable_thread_specific<std::vector<int> > counts(
+            std::vector<int>(num_bins, 0));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_values),
+            [&](const tbb::blocked_range<size_t>& r) {
+                auto& local_counts = counts.local();
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Float value = values[i];
+                    if (std::isnan(value)) continue;
+                    const Float bin = std::floor((value - min_value) / bin_size);
+                    const size_t index = (bin <= 0.0) ? 0 :
+                        std::min(size_t(std::min(bin, Float(num_bins))),
+                                num_bins - 1);
+                    local_counts[index]++;
+                }
+            });
+
+    VectorI histogram = VectorI::Zero(num_bins);
+    for (const auto& local_counts : counts) {
+        for (size_t i=0; i<num_bins; i++) {
+            histogram[i] += local_counts[i];
+        }
+    }
+    return histogram;
+}
@@ -0,0 +1,67 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Core/EigenTypedef.h>
+
+namespace PyMesh {
+
+/**
+ * Quality measures of all tets of a tet mesh, computed in a single parallel
+ * sweep.
+ *
+ * Tets are processed in blocks.  The coordinates of a block are gathered
+ * into a structure of arrays, and every measure is computed by a flat loop
+ * over the block, with selects instead of branches for degenerate tets.
+ * These loops vectorize (TetQuality.cpp is built with -fno-math-errno for
+ * the square roots), except for the final atan2 of the dihedral angles and
+ * the exact orientation predicate, which remain scalar.
+ *
+ * Conventions follow the voxel attributes:
+ *   * volume is positive if v3 is above triangle (v0, v1, v2) (MSH order).
+ *   * orientation has the sign of the exact orient3d predicate, positive for
+ *     positively oriented tets.
+ *   * dihedral angles are listed for edges (0,1), (1,2), (0,2), (0,3),
+ *     (2,3), (1,3).
+ *   * radius edge ratio is circumradius over shortest edge length.
+ *   * degenerate tets, including tets collapsed to a point, have infinite
+ *     circumradius and radius edge ratio, and 0 inradius.
+ */
+class TetQuality {
+    public:
+        void run(const MatrixFr& vertices, const MatrixIr& tets);
+
+        const VectorF& get_volumes() const { return m_volumes; }
+        const VectorF& get_orientations() const { return m_orientations; }
+        const MatrixFr& get_dihedral_angles() const { return m_dihedral_angles; }
+        const VectorF& get_inradii() const { return m_inradii; }
+        const VectorF& get_circumradii() const { return m_circumradii; }
+        const VectorF& get_radius_edge_ratios() const {
+            return m_radius_edge_ratios;
+        }
+        const VectorF& get_min_edge_lengths() const {
+            return m_min_edge_lengths;
+        }
+        const VectorF& get_max_edge_lengths() const {
+            return m_max_edge_lengths;
+        }
+
+        /**
+         * Count values in num_bins equal bins spanning [min_value,
+         * max_value].  Values outside of the range are counted in the first
+         * or the last bin, NaNs are ignored.
+         */
+        static VectorI compute_histogram(const VectorF& values,
+                Float min_value, Float max_value, size_t num_bins);
+
+    private:
+        VectorF m_volumes;
+        VectorF m_orientations;
+        MatrixFr m_dihedral_angles;
+        VectorF m_inradii;
+        VectorF m_circumradii;
+        VectorF m_radius_edge_ratios;
+        VectorF m_min_edge_lengths;
+        VectorF m_max_edge_lengths;
+};
+
+}
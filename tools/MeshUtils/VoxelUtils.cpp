@@ -1,12 +1,243 @@
 /* This file is part of PyMesh. Copyright (c) 2017 by Qingnan Zhou */
 #include "VoxelUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
-#include <Predicates/predicates.h>
-#include <Misc/MultipletMap.h>
+#include <Predicates/BatchPredicates.h>
 
 using namespace PyMesh;
 
+namespace VoxelUtilsHelper {
+    /**
+     * Number of tets checked before looking for an early exit.
+     */
+    const size_t TET_CHUNK_SIZE = 4096;
+
+    /**
+     * Maximum number of insphere queries evaluated in one batch.
+     */
+    const size_t QUERY_CHUNK_SIZE = 1 << 16;
+
+    /**
+     * Relative tolerance used when pruning vertices against a floating point
+     * circumsphere.  Vertices passing the pruning are classified exactly.
+     */
+    const Float SPHERE_TOLERANCE = 1e-6;
+
+    typedef std::pair<int, int> Query;
+
+    void check_tets(const MatrixFr& vertices, const MatrixIr& tets) {
+        if (vertices.cols() != 3) {
+            throw RuntimeError("Delaunay property is only defined for 3D meshes.");
+        }
+        if (tets.rows() > 0 && tets.cols() != 4) {
+            throw RuntimeError("Delaunay property expects a tet mesh.");
+        }
+    }
+
+    /**
+     * Evaluate insphere(v1, v0, v2, v3, q) for each (tet, q) query.  Note
+     * that the orientation of the sphere/tet is different from the
+     * orientation defined by the MSH format, so v0 and v1 are swapped.
+     */
+    VectorF insphere(const MatrixFr& vertices, const MatrixIr& tets,
+            const std::vector<Query>& queries, size_t begin, size_t end) {
+        const size_t num_queries = end - begin;
+        std::array<MatrixFr, 5> args;
+        for (auto& arg : args) {
+            arg.resize(num_queries, 3);
+        }
+        const int order[4] = {1, 0, 2, 3};
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_queries),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const Query& query = queries[begin+i];
+                        for (size_t j=0; j<4; j++) {
+                            args[j].row(i) = vertices.row(
+                                    tets(query.first, order[j]));
+                        }
+                        args[4].row(i) = vertices.row(query.second);
+                    }
+                });
+        return BatchPredicates::insphere(
+                args[0], args[1], args[2], args[3], args[4]);
+    }
+
+    /**
+     * Classify tets in chunks.  generate_queries(begin, end, queries) appends
+     * the (tet, vertex) pairs to check for tets in [begin, end).  The sign
+     * of each insphere value is multiplied by the sign of the tet.
+     */
+    template<typename QueryGenerator>
+    VectorF classify_tets(const MatrixFr& vertices, const MatrixIr& tets,
+            const VectorF& signs, bool early_exit,
+            QueryGenerator generate_queries) {
+        const size_t num_tets = tets.rows();
+        VectorF result(num_tets);
+        result.setConstant(1);
+
+        std::vector<Query> queries;
+        for (size_t begin=0; begin<num_tets; begin+=TET_CHUNK_SIZE) {
+            const size_t end = std::min(begin + TET_CHUNK_SIZE, num_tets);
+            queries.clear();
+            generate_queries(begin, end, queries);
+
+            bool violated = false;
+            for (size_t i=0; i<queries.size(); i+=QUERY_CHUNK_SIZE) {
+                const size_t j = std::min(i + QUERY_CHUNK_SIZE, queries.size());
+                const VectorF r = insphere(vertices, tets, queries, i, j);
+                for (size_t k=i; k<j; k++) {
+                    const int tet_id = queries[k].first;
+                    const Float s = r[k-i] * signs[tet_id];
+                    if (s > 0) {
+                        result[tet_id] = -1;
+                        violated = true;
+                    } else if (s == 0 && result[tet_id] > 0) {
+                        result[tet_id] = 0;
+                    }
+                }
+            }
+
+            if (early_exit && violated) {
+                result.segment(end, num_tets-end).setConstant(
+                        std::numeric_limits<Float>::quiet_NaN());
+                break;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Uniform grid over vertices stored in compressed row format.
+     */
+    class VertexGrid {
+        public:
+            VertexGrid(const MatrixFr& vertices) {
+                const size_t num_vertices = vertices.rows();
+                m_min = vertices.colwise().minCoeff().transpose();
+                const Vector3F extent =
+                    vertices.colwise().maxCoeff().transpose() - m_min;
+
+                // About 2 vertices per cell.
+                const size_t max_num_cells = std::max<size_t>(1, num_vertices / 2);
+                const Float diag = extent.norm();
+                m_cell_size = diag > 0.0 ?
+                    std::max(diag * 1e-6, std::cbrt(
+                                extent.cwiseMax(diag * 1e-3).prod() / max_num_cells)) :
+                    1.0;
+                size_t num_cells;
+                while (true) {
+                    num_cells = 1;
+                    for (size_t i=0; i<3; i++) {
+                        m_size[i] = std::max(1, int(std::ceil(extent[i] / m_cell_size)));
+                        num_cells *= m_size[i];
+                    }
+                    if (num_cells <= max_num_cells) break;
+                    m_cell_size *= std::cbrt(Float(num_cells) / Float(max_num_cells)) * 1.01;
+                }
+
+                std::vector<std::pair<size_t, int> > entries(num_vertices);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+                        [&](const tbb::blocked_range<size_t>& r) {
+                            for (size_t i=r.begin(); i!=r.end(); i++) {
+                                size_t cell = 0;
+                                for (size_t j=0; j<3; j++) {
+                                    cell = cell * m_size[j] +
+                                        get_cell_index(vertices(i, j), j);
+                                }
+                                entries[i] = {cell, int(i)};
+                            }
+                        });
+                tbb::parallel_sort(entries.begin(), entries.end());
+
+                m_offsets.assign(num_cells+1, 0);
+                m_vertices.resize(num_vertices);
+                for (size_t i=0; i<num_vertices; i++) {
+                    m_offsets[entries[i].first+1]++;
+                    m_vertices[i] = entries[i].second;
+                }
+                for (size_t i=0; i<num_cells; i++) {
+                    m_offsets[i+1] += m_offsets[i];
+                }
+            }
+
+            /**
+             * Call f(vi) for each vertex in the cells overlapping the
+             * bounding box of the ball (center, radius).  An infinite
+             * radius covers the entire grid.
+             */
+            template<typename Func>
+            void for_each_vertex_near(const Vector3F& center, Float radius,
+                    Func f) const {
+                int lo[3], hi[3];
+                for (size_t i=0; i<3; i++) {
+                    if (std::isfinite(radius)) {
+                        lo[i] = get_cell_index(center[i] - radius, i);
+                        hi[i] = get_cell_index(center[i] + radius, i);
+                    } else {
+                        lo[i] = 0;
+                        hi[i] = m_size[i] - 1;
+                    }
+                }
+                for (int x=lo[0]; x<=hi[0]; x++) {
+                    for (int y=lo[1]; y<=hi[1]; y++) {
+                        const size_t row = (size_t(x) * m_size[1] + y) * m_size[2];
+                        const size_t begin = m_offsets[row + lo[2]];
+                        const size_t end = m_offsets[row + hi[2] + 1];
+                        for (size_t i=begin; i<end; i++) {
+                            f(m_vertices[i]);
+                        }
+                    }
+                }
+            }
+
+        private:
+            int get_cell_index(Float x, size_t axis) const {
+                const Float index = std::floor((x - m_min[axis]) / m_cell_size);
+                if (!(index > 0.0)) return 0;
+                return int(std::min(index, Float(m_size[axis] - 1)));
+            }
+
+        private:
+            Vector3F m_min;
+            Float m_cell_size;
+            int m_size[3];
+            std::vector<size_t> m_offsets;
+            std::vector<int> m_vertices;
+    };
+
+    /**
+     * Floating point circumsphere of a tet.  The radius is infinite if the
+     * tet is (numerically) flat.
+     */
+    void get_circumsphere(const Vector3F& v0, const Vector3F& v1,
+            const Vector3F& v2, const Vector3F& v3,
+            Vector3F& center, Float& radius) {
+        const Vector3F a = v1 - v0;
+        const Vector3F b = v2 - v0;
+        const Vector3F c = v3 - v0;
+        const Float det = a.dot(b.cross(c));
+        const Vector3F u = a.squaredNorm() * b.cross(c) +
+            b.squaredNorm() * c.cross(a) + c.squaredNorm() * a.cross(b);
+        if (det != 0.0) {
+            center = v0 + u / (2.0 * det);
+            radius = u.norm() / (2.0 * std::abs(det));
+        } else {
+            center = v0;
+            radius = std::numeric_limits<Float>::infinity();
+        }
+    }
+}
+
+using namespace VoxelUtilsHelper;
+
 VectorF VoxelUtils::get_tet_orientations(
         const MatrixFr& vertices,
         const MatrixIr& voxels) {
@@ -20,111 +251,177 @@ VectorF VoxelUtils::get_tet_orientations(
         throw RuntimeError("Degenerate tet expect a tet mesh.");
     }
 
-    exactinit();
-    VectorF results(num_tets);
-    results.setZero();
-    for (size_t i=0; i<num_tets; i++) {
-        const Vector4I tet = voxels.row(i);
-        Float a[3]{
-            vertices(tet[0], 0),
-            vertices(tet[0], 1),
-            vertices(tet[0], 2)};
-        Float b[3]{
-            vertices(tet[1], 0),
-            vertices(tet[1], 1),
-            vertices(tet[1], 2)};
-        Float c[3]{
-            vertices(tet[2], 0),
-            vertices(tet[2], 1),
-            vertices(tet[2], 2)};
-        Float d[3]{
-            vertices(tet[3], 0),
-            vertices(tet[3], 1),
-            vertices(tet[3], 2)};
-
-        // NOTE:
-        //
-        // orient3d(a,b,c,d) returns positive if d is below the plane defined by
-        // triangle (a, b, c).  The tet vertex ordering used by MSH format is
-        // the opposite (i.e. d is above the triangle (a,b,c)), so this check
-        // switch the ordering of a and b to return positive if tet is not
-        // inverted.
-        results[i] = orient3d(b, a, c, d);
+    std::array<MatrixFr, 4> corners;
+    for (auto& corner : corners) {
+        corner.resize(num_tets, 3);
     }
-    return results;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_tets),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    for (size_t j=0; j<4; j++) {
+                        corners[j].row(i) = vertices.row(voxels(i, j));
+                    }
+                }
+            });
+
+    // NOTE:
+    //
+    // orient3d(a,b,c,d) returns positive if d is below the plane defined by
+    // triangle (a, b, c).  The tet vertex ordering used by MSH format is
+    // the opposite (i.e. d is above the triangle (a,b,c)), so this check
+    // switch the ordering of a and b to return positive if tet is not
+    // inverted.
+    return BatchPredicates::orient3d(
+            corners[1], corners[0], corners[2], corners[3]);
 }
 
 VectorF VoxelUtils::is_delaunay(
         const MatrixFr& vertices,
-        const MatrixIr& tets) {
+        const MatrixIr& tets,
+        bool early_exit) {
+    check_tets(vertices, tets);
     const size_t num_tets = tets.rows();
-    VectorF result(num_tets);
-    result.setConstant(1);
 
-    MultipletMap<Triplet, size_t> adj_list;
-    for (size_t i=0; i<num_tets; i++) {
-        adj_list.insert({tets(i,0), tets(i,1), tets(i,2)}, i);
-        adj_list.insert({tets(i,1), tets(i,2), tets(i,3)}, i);
-        adj_list.insert({tets(i,2), tets(i,3), tets(i,0)}, i);
-        adj_list.insert({tets(i,3), tets(i,0), tets(i,1)}, i);
-    }
+    // Sort tet faces by their vertex set so that adjacent tets are next to
+    // each other.  Each entry also records the tet and the opposite vertex.
+    typedef std::pair<std::array<int, 3>, Query> FaceEntry;
+    std::vector<FaceEntry> faces(num_tets * 4);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_tets),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    for (size_t j=0; j<4; j++) {
+                        std::array<int, 3> key{
+                            tets(i, (j+1)%4), tets(i, (j+2)%4), tets(i, (j+3)%4)};
+                        std::sort(key.begin(), key.end());
+                        faces[i*4+j] = {key, {int(i), tets(i, j)}};
+                    }
+                }
+            });
+    tbb::parallel_sort(faces.begin(), faces.end());
 
-    constexpr int INVALID = std::numeric_limits<int>::max();
-    auto get_opposite_vertex = [&tets](size_t index, const Triplet& f) {
-        for (size_t i=0; i<4; i++) {
-            const int val = tets(index, i);
-            if (val != f.get_data()[0] &&
-                val != f.get_data()[1] &&
-                val != f.get_data()[2]) {
-                return val;
+    // Vertices opposite to each face of each tet, grouped by tet.
+    std::vector<size_t> offsets(num_tets+1, 0);
+    std::vector<int> opposite_vertices;
+    {
+        std::vector<Query> adjacency;
+        const size_t num_faces = faces.size();
+        size_t begin = 0;
+        while (begin < num_faces) {
+            size_t end = begin + 1;
+            while (end < num_faces && faces[end].first == faces[begin].first) {
+                end++;
+            }
+            for (size_t i=begin; i<end; i++) {
+                for (size_t j=begin; j<end; j++) {
+                    const int tet_i = faces[i].second.first;
+                    const int tet_j = faces[j].second.first;
+                    const int oppo = faces[j].second.second;
+                    const auto& key = faces[j].first;
+                    if (tet_i == tet_j) continue;
+                    // Tet j is topologically degenerate.
+                    if (std::find(key.begin(), key.end(), oppo) != key.end())
+                        continue;
+                    adjacency.emplace_back(tet_i, oppo);
+                }
             }
+            begin = end;
         }
-        // Tet is topologically degenerate.
-        return INVALID;
+        tbb::parallel_sort(adjacency.begin(), adjacency.end());
+        opposite_vertices.resize(adjacency.size());
+        for (size_t i=0; i<adjacency.size(); i++) {
+            offsets[adjacency[i].first+1]++;
+            opposite_vertices[i] = adjacency[i].second;
+        }
+        for (size_t i=0; i<num_tets; i++) {
+            offsets[i+1] += offsets[i];
+        }
+    }
+
+    const VectorF signs = VectorF::Ones(num_tets);
+    return classify_tets(vertices, tets, signs, early_exit,
+            [&](size_t begin, size_t end, std::vector<Query>& queries) {
+                for (size_t i=begin; i<end; i++) {
+                    for (size_t j=offsets[i]; j<offsets[i+1]; j++) {
+                        queries.emplace_back(int(i), opposite_vertices[j]);
+                    }
+                }
+            });
+}
+
+VectorF VoxelUtils::is_globally_delaunay(
+        const MatrixFr& vertices,
+        const MatrixIr& tets,
+        bool early_exit) {
+    check_tets(vertices, tets);
+    const size_t num_tets = tets.rows();
+    if (num_tets == 0) return VectorF::Zero(0);
+
+    const VectorF orientations = get_tet_orientations(vertices, tets);
+    const VectorF signs = orientations.unaryExpr([](Float x) {
+            return Float((x > 0) - (x < 0)); });
+    const VertexGrid grid(vertices);
+
+    // Call f(vi) for each vertex vi that may lie inside of the circumsphere
+    // of tet i.
+    auto for_each_candidate = [&](size_t i, auto f) {
+        if (signs[i] == 0) return;
+        const Vector4I tet = tets.row(i);
+        const Vector3F v[4] = {
+            vertices.row(tet[0]), vertices.row(tet[1]),
+            vertices.row(tet[2]), vertices.row(tet[3])};
+        Vector3F center;
+        Float radius;
+        get_circumsphere(v[0], v[1], v[2], v[3], center, radius);
+        const Float max_edge_length = std::max({
+                (v[1]-v[0]).norm(), (v[2]-v[0]).norm(), (v[3]-v[0]).norm(),
+                (v[2]-v[1]).norm(), (v[3]-v[1]).norm(), (v[3]-v[2]).norm()});
+        const Float tol_radius = radius +
+            SPHERE_TOLERANCE * (radius + max_edge_length);
+        const Float tol_radius_sq = tol_radius * tol_radius;
+        grid.for_each_vertex_near(center, tol_radius, [&](int vi) {
+                if (vi == tet[0] || vi == tet[1] ||
+                    vi == tet[2] || vi == tet[3]) return;
+                if (std::isfinite(tol_radius) &&
+                    (vertices.row(vi).transpose() - center).squaredNorm() >
+                    tol_radius_sq) return;
+                f(vi);
+            });
     };
 
-    for (size_t i=0; i<num_tets; i++) {
-        const int i0 = tets(i,0);
-        const int i1 = tets(i,1);
-        const int i2 = tets(i,2);
-        const int i3 = tets(i,3);
-        const Vector3F v0 = vertices.row(i0);
-        const Vector3F v1 = vertices.row(i1);
-        const Vector3F v2 = vertices.row(i2);
-        const Vector3F v3 = vertices.row(i3);
-
-        std::vector<Triplet> faces = {
-            {i0, i1, i2},
-            {i1, i2, i3},
-            {i2, i3, i0},
-            {i3, i0, i1}
-        };
-
-        for (const auto& f : faces) {
-            if (result[i] < 0) break;
-            const auto& adj_tets = adj_list[f];
-            for (auto j : adj_tets) {
-                if (i==j) continue;
-                if (result[i] < 0) break;
-                const int oppo = get_opposite_vertex(j, f);
-                const Vector3F vo = vertices.row(oppo);
-                // Note that the orientation of the sphere/tet is different from
-                // the orientation defined by the MSH format.  Swapping v0 and
-                // v1 to ensure consistency.
-                auto r = insphere(
-                        const_cast<double*>(v1.data()),
-                        const_cast<double*>(v0.data()),
-                        const_cast<double*>(v2.data()),
-                        const_cast<double*>(v3.data()),
-                        const_cast<double*>(vo.data()));
-                if (r > 0) {
-                    result[i] = -1;
-                } else if (r == 0) {
-                    result[i] = 0;
+    // Candidates are counted first so that each tet writes its own range of
+    // the query array.
+    std::vector<size_t> offsets(TET_CHUNK_SIZE+1);
+    VectorF result = classify_tets(vertices, tets, signs, early_exit,
+            [&](size_t begin, size_t end, std::vector<Query>& queries) {
+                const size_t n = end - begin;
+                offsets[0] = 0;
+                tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+                        [&](const tbb::blocked_range<size_t>& r) {
+                            for (size_t i=r.begin(); i!=r.end(); i++) {
+                                size_t count = 0;
+                                for_each_candidate(i, [&](int) { count++; });
+                                offsets[i-begin+1] = count;
+                            }
+                        });
+                for (size_t i=0; i<n; i++) {
+                    offsets[i+1] += offsets[i];
                 }
-            }
-        }
+                const size_t base = queries.size();
+                queries.resize(base + offsets[n]);
+                tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+                        [&](const tbb::blocked_range<size_t>& r) {
+                            for (size_t i=r.begin(); i!=r.end(); i++) {
+                                size_t count = base + offsets[i-begin];
+                                for_each_candidate(i, [&](int vi) {
+                                        queries[count++] = {int(i), vi};
+                                    });
+                            }
+                        });
+            });
+
+    // Flat tets have no well defined circumsphere.
+    for (size_t i=0; i<num_tets; i++) {
+        if (signs[i] == 0 && !std::isnan(result[i])) result[i] = 0;
     }
     return result;
 }
-
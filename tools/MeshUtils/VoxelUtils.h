@@ -17,8 +17,32 @@ namespace VoxelUtils {
             const MatrixFr& vertices, 
             const MatrixIr& tets);
 
+    /**
+     * Return whether each tet is locally Delaunay, i.e. the vertices
+     * opposite to its faces in adjacent tets lie outside of its circumsphere.
+     * Tets are assumed to be positively oriented.
+     *
+     *   *  1 means tet is strictly locally Delaunay.
+     *   *  0 means tet is cospherical with an adjacent tet.
+     *   * -1 means tet is not locally Delaunay.
+     *
+     * If early_exit is true, checking stops shortly after the first
+     * violation is found, and tets that are not checked are set to NaN.
+     */
     VectorF is_delaunay(
             const MatrixFr& vertices,
-            const MatrixIr& tets);
+            const MatrixIr& tets,
+            bool early_exit=false);
+
+    /**
+     * Same as is_delaunay, but each tet is checked against all vertices.
+     * Vertices are binned into a uniform grid, so only vertices near the
+     * circumsphere are passed to the exact insphere predicate.  Inverted
+     * tets are handled, and degenerate tets are reported as 0.
+     */
+    VectorF is_globally_delaunay(
+            const MatrixFr& vertices,
+            const MatrixIr& tets,
+            bool early_exit=false);
 }
 }
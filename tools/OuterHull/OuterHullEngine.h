@@ -25,11 +25,11 @@ class OuterHullEngine {
             m_faces = faces;
         }
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_outer_hull_layers() const { return m_layers; }
-        VectorI  get_face_is_flipped() const { return m_face_is_flipped; }
-        VectorI  get_ori_face_indices() const { return m_ori_face_indices; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_outer_hull_layers() const { return m_layers; }
+        const VectorI&  get_face_is_flipped() const { return m_face_is_flipped; }
+        const VectorI&  get_ori_face_indices() const { return m_ori_face_indices; }
 
     protected:
         void remove_isolated_vertices();
@@ -0,0 +1,300 @@
+/* This file is part of PyMesh. Copyright (c) 2019 by Qingnan Zhou */
+#include "BatchPredicates.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+#include <Core/Exception.h>
+
+extern "C" {
+#include "predicates.h"
+}
+
+using namespace PyMesh;
+
+namespace BatchPredicatesHelper {
+    /**
+     * Number of queries filtered together.
+     */
+    const size_t BLOCK_SIZE = 256;
+
+    /**
+     * Error bound coefficients of the stage A filters in predicates.c,
+     * where epsilon = 2^-53 is the unit roundoff of double.
+     */
+    const Float EPSILON = std::ldexp(1.0, -53);
+    const Float CCW_ERRBOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+    const Float O3D_ERRBOUND = (7.0 + 56.0 * EPSILON) * EPSILON;
+    const Float ICC_ERRBOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+    const Float ISP_ERRBOUND = (16.0 + 224.0 * EPSILON) * EPSILON;
+
+    void init_predicates() {
+        static std::once_flag flag;
+        std::call_once(flag, [](){ exactinit(); });
+    }
+
+    /**
+     * Structure of arrays holding one block of queries: lanes[i*DIM+j][k]
+     * is coordinate j of point argument i of the k-th query in the block.
+     */
+    template<size_t NUM_ARGS, size_t DIM>
+    struct Block {
+        std::array<std::array<Float, BLOCK_SIZE>, NUM_ARGS*DIM> lanes;
+        std::array<Float, BLOCK_SIZE> det;
+        std::array<Float, BLOCK_SIZE> errbound;
+    };
+
+    /**
+     * Each filter mirrors the stage A computation of the corresponding
+     * adaptive predicate in predicates.c, but differences are taken with
+     * respect to the last point argument for every lane at once.
+     */
+    void orient2d_filter(Block<3, 2>& b, size_t n) {
+        const Float* ax = b.lanes[0].data(); const Float* ay = b.lanes[1].data();
+        const Float* bx = b.lanes[2].data(); const Float* by = b.lanes[3].data();
+        const Float* cx = b.lanes[4].data(); const Float* cy = b.lanes[5].data();
+        for (size_t k=0; k<n; k++) {
+            const Float detleft = (ax[k] - cx[k]) * (by[k] - cy[k]);
+            const Float detright = (ay[k] - cy[k]) * (bx[k] - cx[k]);
+            b.det[k] = detleft - detright;
+            b.errbound[k] = CCW_ERRBOUND *
+                (std::abs(detleft) + std::abs(detright));
+        }
+    }
+
+    void orient3d_filter(Block<4, 3>& b, size_t n) {
+        const Float* ax = b.lanes[0].data(); const Float* ay = b.lanes[1].data();
+        const Float* az = b.lanes[2].data(); const Float* bx = b.lanes[3].data();
+        const Float* by = b.lanes[4].data(); const Float* bz = b.lanes[5].data();
+        const Float* cx = b.lanes[6].data(); const Float* cy = b.lanes[7].data();
+        const Float* cz = b.lanes[8].data(); const Float* dx = b.lanes[9].data();
+        const Float* dy = b.lanes[10].data(); const Float* dz = b.lanes[11].data();
+        for (size_t k=0; k<n; k++) {
+            const Float adx = ax[k] - dx[k], bdx = bx[k] - dx[k], cdx = cx[k] - dx[k];
+            const Float ady = ay[k] - dy[k], bdy = by[k] - dy[k], cdy = cy[k] - dy[k];
+            const Float adz = az[k] - dz[k], bdz = bz[k] - dz[k], cdz = cz[k] - dz[k];
+
+            const Float bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+            const Float cdxady = cdx * ady, adxcdy = adx * cdy;
+            const Float adxbdy = adx * bdy, bdxady = bdx * ady;
+
+            b.det[k] = adz * (bdxcdy - cdxbdy)
+                + bdz * (cdxady - adxcdy)
+                + cdz * (adxbdy - bdxady);
+            const Float permanent =
+                (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+            b.errbound[k] = O3D_ERRBOUND * permanent;
+        }
+    }
+
+    void incircle_filter(Block<4, 2>& b, size_t n) {
+        const Float* ax = b.lanes[0].data(); const Float* ay = b.lanes[1].data();
+        const Float* bx = b.lanes[2].data(); const Float* by = b.lanes[3].data();
+        const Float* cx = b.lanes[4].data(); const Float* cy = b.lanes[5].data();
+        const Float* dx = b.lanes[6].data(); const Float* dy = b.lanes[7].data();
+        for (size_t k=0; k<n; k++) {
+            const Float adx = ax[k] - dx[k], bdx = bx[k] - dx[k], cdx = cx[k] - dx[k];
+            const Float ady = ay[k] - dy[k], bdy = by[k] - dy[k], cdy = cy[k] - dy[k];
+
+            const Float bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+            const Float cdxady = cdx * ady, adxcdy = adx * cdy;
+            const Float adxbdy = adx * bdy, bdxady = bdx * ady;
+            const Float alift = adx * adx + ady * ady;
+            const Float blift = bdx * bdx + bdy * bdy;
+            const Float clift = cdx * cdx + cdy * cdy;
+
+            b.det[k] = alift * (bdxcdy - cdxbdy)
+                + blift * (cdxady - adxcdy)
+                + clift * (adxbdy - bdxady);
+            const Float permanent =
+                (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+            b.errbound[k] = ICC_ERRBOUND * permanent;
+        }
+    }
+
+    void insphere_filter(Block<5, 3>& b, size_t n) {
+        const Float* ax = b.lanes[0].data(); const Float* ay = b.lanes[1].data();
+        const Float* az = b.lanes[2].data(); const Float* bx = b.lanes[3].data();
+        const Float* by = b.lanes[4].data(); const Float* bz = b.lanes[5].data();
+        const Float* cx = b.lanes[6].data(); const Float* cy = b.lanes[7].data();
+        const Float* cz = b.lanes[8].data(); const Float* dx = b.lanes[9].data();
+        const Float* dy = b.lanes[10].data(); const Float* dz = b.lanes[11].data();
+        const Float* ex = b.lanes[12].data(); const Float* ey = b.lanes[13].data();
+        const Float* ez = b.lanes[14].data();
+        for (size_t k=0; k<n; k++) {
+            const Float aex = ax[k] - ex[k], bex = bx[k] - ex[k];
+            const Float cex = cx[k] - ex[k], dex = dx[k] - ex[k];
+            const Float aey = ay[k] - ey[k], bey = by[k] - ey[k];
+            const Float cey = cy[k] - ey[k], dey = dy[k] - ey[k];
+            const Float aez = az[k] - ez[k], bez = bz[k] - ez[k];
+            const Float cez = cz[k] - ez[k], dez = dz[k] - ez[k];
+
+            const Float aexbey = aex * bey, bexaey = bex * aey;
+            const Float bexcey = bex * cey, cexbey = cex * bey;
+            const Float cexdey = cex * dey, dexcey = dex * cey;
+            const Float dexaey = dex * aey, aexdey = aex * dey;
+            const Float aexcey = aex * cey, cexaey = cex * aey;
+            const Float bexdey = bex * dey, dexbey = dex * bey;
+            const Float ab = aexbey - bexaey;
+            const Float bc = bexcey - cexbey;
+            const Float cd = cexdey - dexcey;
+            const Float da = dexaey - aexdey;
+            const Float ac = aexcey - cexaey;
+            const Float bd = bexdey - dexbey;
+
+            const Float abc = aez * bc - bez * ac + cez * ab;
+            const Float bcd = bez * cd - cez * bd + dez * bc;
+            const Float cda = cez * da + dez * ac + aez * cd;
+            const Float dab = dez * ab + aez * bd + bez * da;
+
+            const Float alift = aex * aex + aey * aey + aez * aez;
+            const Float blift = bex * bex + bey * bey + bez * bez;
+            const Float clift = cex * cex + cey * cey + cez * cez;
+            const Float dlift = dex * dex + dey * dey + dez * dez;
+
+            b.det[k] = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+            const Float aezplus = std::abs(aez), bezplus = std::abs(bez);
+            const Float cezplus = std::abs(cez), dezplus = std::abs(dez);
+            const Float ab_plus = std::abs(aexbey) + std::abs(bexaey);
+            const Float bc_plus = std::abs(bexcey) + std::abs(cexbey);
+            const Float cd_plus = std::abs(cexdey) + std::abs(dexcey);
+            const Float da_plus = std::abs(dexaey) + std::abs(aexdey);
+            const Float ac_plus = std::abs(aexcey) + std::abs(cexaey);
+            const Float bd_plus = std::abs(bexdey) + std::abs(dexbey);
+            const Float permanent =
+                (cd_plus * bezplus + bd_plus * cezplus + bc_plus * dezplus) * alift +
+                (da_plus * cezplus + ac_plus * dezplus + cd_plus * aezplus) * blift +
+                (ab_plus * dezplus + bd_plus * aezplus + da_plus * bezplus) * clift +
+                (bc_plus * aezplus + ac_plus * bezplus + ab_plus * cezplus) * dlift;
+            b.errbound[k] = ISP_ERRBOUND * permanent;
+        }
+    }
+
+    /**
+     * Run filter over all queries in blocks and call exact(points) on the
+     * queries whose sign could not be certified by the filter.
+     */
+    template<size_t NUM_ARGS, size_t DIM, typename Filter, typename Exact>
+    VectorF evaluate(const std::array<const MatrixFr*, NUM_ARGS>& args,
+            Filter filter, Exact exact) {
+        init_predicates();
+
+        size_t num_queries = 0;
+        for (const auto arg : args) {
+            num_queries = std::max(num_queries, size_t(arg->rows()));
+        }
+        for (const auto arg : args) {
+            if (arg->cols() != DIM) {
+                std::stringstream err_msg;
+                err_msg << "Expect " << DIM << "D points, but got "
+                    << arg->cols() << "D points.";
+                throw RuntimeError(err_msg.str());
+            }
+            if (arg->rows() != 1 && size_t(arg->rows()) != num_queries) {
+                throw RuntimeError(
+                        "Arguments must have the same number of points or a single point");
+            }
+        }
+
+        VectorF result(num_queries);
+        const size_t num_blocks = (num_queries + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    Block<NUM_ARGS, DIM> block;
+                    std::array<Float*, NUM_ARGS> points;
+                    std::array<Float, NUM_ARGS*DIM> coords;
+                    for (size_t bi=r.begin(); bi!=r.end(); bi++) {
+                        const size_t begin = bi * BLOCK_SIZE;
+                        const size_t n = std::min(BLOCK_SIZE, num_queries - begin);
+                        for (size_t i=0; i<NUM_ARGS; i++) {
+                            const MatrixFr& arg = *args[i];
+                            const bool broadcast = arg.rows() == 1;
+                            for (size_t j=0; j<DIM; j++) {
+                                auto& lane = block.lanes[i*DIM+j];
+                                if (broadcast) {
+                                    std::fill_n(lane.begin(), n, arg(0, j));
+                                } else {
+                                    for (size_t k=0; k<n; k++) {
+                                        lane[k] = arg(begin+k, j);
+                                    }
+                                }
+                            }
+                        }
+
+                        filter(block, n);
+
+                        for (size_t k=0; k<n; k++) {
+                            const Float det = block.det[k];
+                            const Float errbound = block.errbound[k];
+                            if (det > errbound || -det > errbound) {
+                                result[begin+k] = det;
+                                continue;
+                            }
+                            for (size_t i=0; i<NUM_ARGS; i++) {
+                                for (size_t j=0; j<DIM; j++) {
+                                    coords[i*DIM+j] = block.lanes[i*DIM+j][k];
+                                }
+                                points[i] = coords.data() + i*DIM;
+                            }
+                            result[begin+k] = exact(points);
+                        }
+                    }
+                });
+        return result;
+    }
+}
+using namespace BatchPredicatesHelper;
+
+VectorF BatchPredicates::orient2d(
+        const MatrixFr& pa,
+        const MatrixFr& pb,
+        const MatrixFr& pc) {
+    return evaluate<3, 2>({&pa, &pb, &pc}, orient2d_filter,
+            [](const std::array<Float*, 3>& p) {
+                return ::orient2d(p[0], p[1], p[2]);
+            });
+}
+
+VectorF BatchPredicates::orient3d(
+        const MatrixFr& pa,
+        const MatrixFr& pb,
+        const MatrixFr& pc,
+        const MatrixFr& pd) {
+    return evaluate<4, 3>({&pa, &pb, &pc, &pd}, orient3d_filter,
+            [](const std::array<Float*, 4>& p) {
+                return ::orient3d(p[0], p[1], p[2], p[3]);
+            });
+}
+
+VectorF BatchPredicates::incircle(
+        const MatrixFr& pa,
+        const MatrixFr& pb,
+        const MatrixFr& pc,
+        const MatrixFr& pd) {
+    return evaluate<4, 2>({&pa, &pb, &pc, &pd}, incircle_filter,
+            [](const std::array<Float*, 4>& p) {
+                return ::incircle(p[0], p[1], p[2], p[3]);
+            });
+}
+
+VectorF BatchPredicates::insphere(
+        const MatrixFr& pa,
+        const MatrixFr& pb,
+        const MatrixFr& pc,
+        const MatrixFr& pd,
+        const MatrixFr& pe) {
+    return evaluate<5, 3>({&pa, &pb, &pc, &pd, &pe}, insphere_filter,
+            [](const std::array<Float*, 5>& p) {
+                return ::insphere(p[0], p[1], p[2], p[3], p[4]);
+            });
+}
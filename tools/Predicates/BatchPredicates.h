@@ -0,0 +1,49 @@
+/* This file is part of PyMesh. Copyright (c) 2019 by Qingnan Zhou */
+#pragma once
+
+#include <Core/EigenTypedef.h>
+
+namespace PyMesh {
+
+/**
+ * Batched versions of Shewchuk's adaptive predicates.
+ *
+ * Each argument is a matrix whose rows are points.  All arguments must have
+ * the same number of rows, except that an argument with a single row is
+ * broadcast to every query (e.g. classifying many points against a single
+ * plane).  Entry i of the result has the same sign as the scalar predicate
+ * evaluated on row i of the arguments.
+ *
+ * Queries are processed in blocks.  Within a block, the floating point
+ * filter of the scalar predicate is evaluated as a branch-free loop so
+ * that it can be vectorized, and only the queries whose sign is uncertain
+ * are passed on to the adaptive exact predicate.  Blocks are processed in
+ * parallel with TBB.
+ */
+namespace BatchPredicates {
+    VectorF orient2d(
+            const MatrixFr& pa,
+            const MatrixFr& pb,
+            const MatrixFr& pc);
+
+    VectorF orient3d(
+            const MatrixFr& pa,
+            const MatrixFr& pb,
+            const MatrixFr& pc,
+            const MatrixFr& pd);
+
+    VectorF incircle(
+            const MatrixFr& pa,
+            const MatrixFr& pb,
+            const MatrixFr& pc,
+            const MatrixFr& pd);
+
+    VectorF insphere(
+            const MatrixFr& pa,
+            const MatrixFr& pb,
+            const MatrixFr& pc,
+            const MatrixFr& pd,
+            const MatrixFr& pe);
+}
+
+}
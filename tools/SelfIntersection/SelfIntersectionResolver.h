@@ -27,9 +27,9 @@ class SelfIntersectionResolver {
                     "Resolving self-interesection is not implemented");
         }
 
-        const MatrixFr get_vertices() const { return m_vertices; }
-        const MatrixIr get_faces() const { return m_faces; }
-        const VectorI  get_face_sources() const { return m_face_sources; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_sources() const { return m_face_sources; }
 
     protected:
         MatrixFr m_vertices;
@@ -0,0 +1,253 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "AMGPreconditioner.h"
+
+#include <cmath>
+#include <vector>
+
+#include <tbb/tbb.h>
+
+using namespace PyMesh;
+
+namespace AMGPreconditionerHelper {
+    typedef AMGPreconditioner::RowMajorMatrix RowMajorMatrix;
+    typedef Eigen::Triplet<Float> Triplet;
+
+    /**
+     * Levels with at most this many unknowns are solved directly.
+     */
+    const size_t COARSE_SIZE = 256;
+    const size_t MAX_LEVELS = 20;
+
+    /**
+     * Nodes i and j are strongly connected if
+     * |A_ij| >= STRENGTH_THRESHOLD * sqrt(|A_ii| |A_jj|), where |.| is the
+     * Frobenius norm of the corresponding block.
+     */
+    const Float STRENGTH_THRESHOLD = 0.08;
+
+    /**
+     * Frobenius norms of the block_size x block_size blocks, as a node
+     * level matrix.
+     */
+    RowMajorMatrix compute_block_norms(const RowMajorMatrix& A,
+            size_t block_size) {
+        const size_t num_nodes = A.rows() / block_size;
+        std::vector<Triplet> entries;
+        entries.reserve(A.nonZeros());
+        for (int i=0; i<A.outerSize(); i++) {
+            for (RowMajorMatrix::InnerIterator it(A, i); it; ++it) {
+                entries.emplace_back(i / block_size, it.col() / block_size,
+                        it.value() * it.value());
+            }
+        }
+        RowMajorMatrix norms(num_nodes, num_nodes);
+        norms.setFromTriplets(entries.begin(), entries.end());
+        norms = norms.cwiseSqrt();
+        return norms;
+    }
+
+    /**
+     * Greedy aggregation (Vanek, Mandel and Brezina 1996).  Returns the
+     * number of aggregates.
+     */
+    size_t aggregate(const RowMajorMatrix& A, size_t block_size,
+            std::vector<int>& aggregates) {
+        const RowMajorMatrix norms = compute_block_norms(A, block_size);
+        const size_t num_nodes = norms.rows();
+        const VectorF diagonal = norms.diagonal();
+
+        std::vector<std::vector<int> > strong(num_nodes);
+        for (size_t i=0; i<num_nodes; i++) {
+            for (RowMajorMatrix::InnerIterator it(norms, i); it; ++it) {
+                const size_t j = it.col();
+                if (i == j) continue;
+                if (it.value() >= STRENGTH_THRESHOLD *
+                        std::sqrt(diagonal[i] * diagonal[j])) {
+                    strong[i].push_back(j);
+                }
+            }
+        }
+
+        // Pass 1: nodes whose strong neighborhood is free become a root.
+        aggregates.assign(num_nodes, -1);
+        int count = 0;
+        for (size_t i=0; i<num_nodes; i++) {
+            if (aggregates[i] >= 0) continue;
+            bool free = true;
+            for (int j : strong[i]) {
+                if (aggregates[j] >= 0) { free = false; break; }
+            }
+            if (!free) continue;
+            aggregates[i] = count;
+            for (int j : strong[i]) aggregates[j] = count;
+            count++;
+        }
+
+        // Pass 2: join a neighboring aggregate from pass 1.
+        const std::vector<int> roots = aggregates;
+        for (size_t i=0; i<num_nodes; i++) {
+            if (aggregates[i] >= 0) continue;
+            for (int j : strong[i]) {
+                if (roots[j] >= 0) {
+                    aggregates[i] = roots[j];
+                    break;
+                }
+            }
+        }
+
+        // Pass 3: group whatever is left with its free neighbors.
+        for (size_t i=0; i<num_nodes; i++) {
+            if (aggregates[i] >= 0) continue;
+            aggregates[i] = count;
+            for (int j : strong[i]) {
+                if (aggregates[j] < 0) aggregates[j] = count;
+            }
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * Piecewise constant interpolation of each unknown over the aggregates,
+     * with orthonormal columns.
+     */
+    RowMajorMatrix tentative_prolongation(const std::vector<int>& aggregates,
+            size_t num_aggregates, size_t block_size) {
+        std::vector<size_t> sizes(num_aggregates, 0);
+        for (int a : aggregates) sizes[a]++;
+
+        const size_t num_nodes = aggregates.size();
+        std::vector<Triplet> entries;
+        entries.reserve(num_nodes * block_size);
+        for (size_t i=0; i<num_nodes; i++) {
+            const int a = aggregates[i];
+            const Float value = 1.0 / std::sqrt(Float(sizes[a]));
+            for (size_t c=0; c<block_size; c++) {
+                entries.emplace_back(i*block_size+c, a*block_size+c, value);
+            }
+        }
+        RowMajorMatrix T(num_nodes * block_size, num_aggregates * block_size);
+        T.setFromTriplets(entries.begin(), entries.end());
+        return T;
+    }
+
+    /**
+     * Power iteration estimate of the spectral radius of D^-1 A.
+     */
+    Float estimate_spectral_radius(const RowMajorMatrix& A,
+            const VectorF& inv_diagonal) {
+        const size_t n = A.rows();
+        VectorF x(n), y;
+        for (size_t i=0; i<n; i++) {
+            x[i] = 1.0 + Float(i % 7) / 7.0;
+        }
+        x.normalize();
+        Float rho = 1.0;
+        for (size_t itr=0; itr<20; itr++) {
+            ParallelLinearAlgebra::multiply(A, x, y);
+            y = y.cwiseProduct(inv_diagonal);
+            rho = y.norm();
+            if (rho <= 0.0) return 1.0;
+            x = y / rho;
+        }
+        return rho;
+    }
+}
+using namespace AMGPreconditionerHelper;
+
+void AMGPreconditioner::compute(const ZSparseMatrix& matrix) {
+    if (m_block_size == 0 || matrix.rows() % m_block_size != 0) {
+        throw RuntimeError(
+                "AMG block size does not divide the number of unknowns");
+    }
+    if (matrix.rows() != matrix.cols()) {
+        throw RuntimeError("AMG requires a square matrix");
+    }
+
+    m_levels.clear();
+    RowMajorMatrix A = matrix;
+    while (true) {
+        Level level;
+        level.A = A;
+        const VectorF diagonal = A.diagonal();
+        if (diagonal.size() > 0 && diagonal.minCoeff() <= 0.0) {
+            throw RuntimeError("AMG requires positive diagonal entries");
+        }
+        level.inv_diagonal = diagonal.cwiseInverse();
+        level.omega = 4.0 / 3.0 /
+            estimate_spectral_radius(A, level.inv_diagonal);
+
+        const size_t n = A.rows();
+        if (n <= COARSE_SIZE || m_levels.size()+1 >= MAX_LEVELS) {
+            m_levels.push_back(std::move(level));
+            break;
+        }
+
+        std::vector<int> aggregates;
+        const size_t num_aggregates = aggregate(A, m_block_size, aggregates);
+        if (num_aggregates * m_block_size >= n) {
+            // No coarsening progress.
+            m_levels.push_back(std::move(level));
+            break;
+        }
+
+        // Smoothed prolongation P = (I - omega D^-1 A) T.
+        const RowMajorMatrix T = tentative_prolongation(
+                aggregates, num_aggregates, m_block_size);
+        RowMajorMatrix AT = A * T;
+        for (int i=0; i<AT.outerSize(); i++) {
+            const Float scale = level.omega * level.inv_diagonal[i];
+            for (RowMajorMatrix::InnerIterator it(AT, i); it; ++it) {
+                it.valueRef() *= scale;
+            }
+        }
+        level.P = T - AT;
+        level.R = level.P.transpose();
+        const RowMajorMatrix AP = A * level.P;
+        A = (level.R * AP).pruned();
+        m_levels.push_back(std::move(level));
+    }
+
+    const ZSparseMatrix::ParentType coarse_matrix = m_levels.back().A;
+    m_coarse_solver.compute(coarse_matrix);
+    if (m_coarse_solver.info() != Eigen::Success) {
+        throw RuntimeError("AMG coarse level factorization failed");
+    }
+}
+
+void AMGPreconditioner::apply(const VectorF& r, VectorF& z) const {
+    if (m_levels.empty()) {
+        throw RuntimeError("AMG preconditioner is not computed");
+    }
+    z = VectorF::Zero(r.size());
+    v_cycle(0, r, z);
+}
+
+void AMGPreconditioner::v_cycle(size_t level_idx,
+        const VectorF& b, VectorF& x) const {
+    const Level& level = m_levels[level_idx];
+    if (level_idx+1 == m_levels.size()) {
+        x = m_coarse_solver.solve(b);
+        return;
+    }
+
+    smooth(level, b, x);
+
+    VectorF r, coarse_b, coarse_x, correction;
+    ParallelLinearAlgebra::residual(level.A, x, b, r);
+    ParallelLinearAlgebra::multiply(level.R, r, coarse_b);
+    coarse_x = VectorF::Zero(coarse_b.size());
+    v_cycle(level_idx+1, coarse_b, coarse_x);
+    ParallelLinearAlgebra::multiply(level.P, coarse_x, correction);
+    ParallelLinearAlgebra::axpy(1.0, correction, x);
+
+    smooth(level, b, x);
+}
+
+void AMGPreconditioner::smooth(const Level& level,
+        const VectorF& b, VectorF& x) const {
+    VectorF r;
+    ParallelLinearAlgebra::residual(level.A, x, b, r);
+    ParallelLinearAlgebra::axpy(level.omega,
+            r.cwiseProduct(level.inv_diagonal), x);
+}
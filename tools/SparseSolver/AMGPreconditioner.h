@@ -0,0 +1,55 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <vector>
+
+#include <Eigen/SparseCholesky>
+
+#include "ParallelLinearAlgebra.h"
+#include "Preconditioner.h"
+
+namespace PyMesh {
+
+/**
+ * Smoothed aggregation algebraic multigrid.  apply() performs a single
+ * V-cycle with damped Jacobi pre/post smoothing, so the preconditioner is
+ * symmetric and can be used with conjugate gradient.
+ *
+ * For vector valued problems (e.g. elasticity), set the block size to the
+ * number of interleaved unknowns per node.  Nodes are aggregated as a whole
+ * and each unknown is interpolated separately, i.e. the near null space is
+ * spanned by the translations.
+ */
+class AMGPreconditioner : public Preconditioner {
+    public:
+        typedef ParallelLinearAlgebra::RowMajorMatrix RowMajorMatrix;
+
+    public:
+        void set_block_size(size_t block_size) { m_block_size = block_size; }
+        size_t get_block_size() const { return m_block_size; }
+
+        virtual void compute(const ZSparseMatrix& matrix) override;
+        virtual void apply(const VectorF& r, VectorF& z) const override;
+
+        size_t get_num_levels() const { return m_levels.size(); }
+
+    private:
+        struct Level {
+            RowMajorMatrix A;
+            VectorF inv_diagonal;
+            Float omega;
+            // Prolongation from the next coarser level and its transpose.
+            RowMajorMatrix P;
+            RowMajorMatrix R;
+        };
+
+        void v_cycle(size_t level, const VectorF& b, VectorF& x) const;
+        void smooth(const Level& level, const VectorF& b, VectorF& x) const;
+
+    private:
+        size_t m_block_size = 1;
+        std::vector<Level> m_levels;
+        Eigen::SimplicialLDLT<ZSparseMatrix::ParentType> m_coarse_solver;
+};
+
+}
@@ -0,0 +1,16 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "IncompleteCholeskyPreconditioner.h"
+
+using namespace PyMesh;
+
+void IncompleteCholeskyPreconditioner::compute(const ZSparseMatrix& matrix) {
+    m_engine.compute(matrix);
+    if (m_engine.info() != Eigen::Success) {
+        throw RuntimeError("Incomplete Cholesky factorization failed");
+    }
+}
+
+void IncompleteCholeskyPreconditioner::apply(
+        const VectorF& r, VectorF& z) const {
+    z = m_engine.solve(r);
+}
@@ -0,0 +1,27 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Eigen/IterativeLinearSolvers>
+
+#include "Preconditioner.h"
+
+namespace PyMesh {
+
+/**
+ * Limited memory incomplete Cholesky factorization with diagonal shifting
+ * for robustness (see Eigen::IncompleteCholesky).  The natural ordering is
+ * kept: fill reducing orderings such as AMD noticeably weaken the
+ * incomplete factor on mesh based systems.
+ */
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+    public:
+        virtual void compute(const ZSparseMatrix& matrix) override;
+        virtual void apply(const VectorF& r, VectorF& z) const override;
+
+    private:
+        typedef Eigen::IncompleteCholesky<Float, Eigen::Lower,
+                Eigen::NaturalOrdering<int> > Engine;
+        Engine m_engine;
+};
+
+}
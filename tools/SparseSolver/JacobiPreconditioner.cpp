@@ -0,0 +1,33 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "JacobiPreconditioner.h"
+
+#include <tbb/tbb.h>
+
+using namespace PyMesh;
+
+void JacobiPreconditioner::compute(const ZSparseMatrix& matrix) {
+    compute_from_diagonal(matrix.diagonal());
+}
+
+void JacobiPreconditioner::compute_from_diagonal(const VectorF& diagonal) {
+    const size_t n = diagonal.size();
+    m_inv_diagonal.resize(n);
+    for (size_t i=0; i<n; i++) {
+        if (diagonal[i] <= 0.0) {
+            throw RuntimeError(
+                    "Jacobi preconditioner requires positive diagonal entries");
+        }
+        m_inv_diagonal[i] = 1.0 / diagonal[i];
+    }
+}
+
+void JacobiPreconditioner::apply(const VectorF& r, VectorF& z) const {
+    const size_t n = r.size();
+    z.resize(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i=range.begin(); i!=range.end(); i++) {
+                    z[i] = m_inv_diagonal[i] * r[i];
+                }
+            });
+}
@@ -0,0 +1,18 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include "Preconditioner.h"
+
+namespace PyMesh {
+
+class JacobiPreconditioner : public Preconditioner {
+    public:
+        virtual void compute(const ZSparseMatrix& matrix) override;
+        virtual void compute_from_diagonal(const VectorF& diagonal) override;
+        virtual void apply(const VectorF& r, VectorF& z) const override;
+
+    private:
+        VectorF m_inv_diagonal;
+};
+
+}
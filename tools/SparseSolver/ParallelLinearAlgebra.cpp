@@ -0,0 +1,89 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "ParallelLinearAlgebra.h"
+
+#include <tbb/tbb.h>
+
+using namespace PyMesh;
+
+namespace ParallelLinearAlgebraHelper {
+    /**
+     * Vectors shorter than this are processed serially.  The threading
+     * overhead dominates for small problems (e.g. coarse multigrid levels).
+     */
+    const size_t GRAIN_SIZE = 4096;
+
+    template<typename Func>
+    void for_each_block(size_t n, const Func& func) {
+        if (n <= GRAIN_SIZE) {
+            func(0, n);
+        } else {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n, GRAIN_SIZE),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                        func(r.begin(), r.end());
+                    });
+        }
+    }
+
+    inline Float row_dot(const ParallelLinearAlgebra::RowMajorMatrix& A,
+            size_t i, const Float* x) {
+        const int* indices = A.innerIndexPtr();
+        const Float* values = A.valuePtr();
+        const int* outer = A.outerIndexPtr();
+        const int* nnz = A.innerNonZeroPtr();
+        const int begin = outer[i];
+        const int end = nnz == nullptr ? outer[i+1] : begin + nnz[i];
+        Float sum = 0.0;
+        for (int k=begin; k<end; k++) {
+            sum += values[k] * x[indices[k]];
+        }
+        return sum;
+    }
+}
+using namespace ParallelLinearAlgebraHelper;
+
+void ParallelLinearAlgebra::multiply(const RowMajorMatrix& A,
+        const VectorF& x, VectorF& y) {
+    const size_t n = A.rows();
+    y.resize(n);
+    for_each_block(n, [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++) {
+            y[i] = row_dot(A, i, x.data());
+        }
+    });
+}
+
+void ParallelLinearAlgebra::residual(const RowMajorMatrix& A,
+        const VectorF& x, const VectorF& b, VectorF& r) {
+    const size_t n = A.rows();
+    r.resize(n);
+    for_each_block(n, [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++) {
+            r[i] = b[i] - row_dot(A, i, x.data());
+        }
+    });
+}
+
+Float ParallelLinearAlgebra::dot(const VectorF& x, const VectorF& y) {
+    const size_t n = x.size();
+    if (n <= GRAIN_SIZE) return x.dot(y);
+    // Deterministic reduction keeps iteration counts reproducible.
+    return tbb::parallel_deterministic_reduce(
+            tbb::blocked_range<size_t>(0, n, GRAIN_SIZE), Float(0.0),
+            [&](const tbb::blocked_range<size_t>& r, Float sum) {
+                return sum + x.segment(r.begin(), r.size()).dot(
+                        y.segment(r.begin(), r.size()));
+            }, std::plus<Float>());
+}
+
+void ParallelLinearAlgebra::axpy(Float alpha, const VectorF& x, VectorF& y) {
+    for_each_block(x.size(), [&](size_t begin, size_t end) {
+        y.segment(begin, end-begin) += alpha * x.segment(begin, end-begin);
+    });
+}
+
+void ParallelLinearAlgebra::xpby(const VectorF& x, Float beta, VectorF& y) {
+    for_each_block(x.size(), [&](size_t begin, size_t end) {
+        y.segment(begin, end-begin) =
+            x.segment(begin, end-begin) + beta * y.segment(begin, end-begin);
+    });
+}
@@ -0,0 +1,42 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <Eigen/Sparse>
+
+#include <Core/EigenTypedef.h>
+
+namespace PyMesh {
+
+/**
+ * Multithreaded (TBB) kernels used by the iterative solvers.  Sparse
+ * matrices are stored row major so that y = A x can be split over rows
+ * without write conflicts.
+ */
+namespace ParallelLinearAlgebra {
+    typedef Eigen::SparseMatrix<Float, Eigen::RowMajor, int> RowMajorMatrix;
+
+    /**
+     * y = A x.
+     */
+    void multiply(const RowMajorMatrix& A, const VectorF& x, VectorF& y);
+
+    /**
+     * r = b - A x.
+     */
+    void residual(const RowMajorMatrix& A, const VectorF& x,
+            const VectorF& b, VectorF& r);
+
+    Float dot(const VectorF& x, const VectorF& y);
+
+    /**
+     * y += alpha * x.
+     */
+    void axpy(Float alpha, const VectorF& x, VectorF& y);
+
+    /**
+     * y = x + beta * y.
+     */
+    void xpby(const VectorF& x, Float beta, VectorF& y);
+}
+
+}
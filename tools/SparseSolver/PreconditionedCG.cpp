@@ -0,0 +1,110 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "PreconditionedCG.h"
+
+#include <Core/Exception.h>
+
+#include "AMGPreconditioner.h"
+
+using namespace PyMesh;
+
+void PreconditionedCG::factorize(const ZSparseMatrix& matrix) {
+    if (matrix.rows() != matrix.cols()) {
+        throw RuntimeError("Conjugate gradient requires a square matrix");
+    }
+    m_size = matrix.rows();
+    m_matrix = matrix;
+    m_operator = nullptr;
+
+    m_preconditioner = Preconditioner::create(m_preconditioner_type);
+    auto amg = std::dynamic_pointer_cast<AMGPreconditioner>(m_preconditioner);
+    if (amg) {
+        amg->set_block_size(m_block_size);
+    }
+    m_preconditioner->compute(matrix);
+}
+
+void PreconditionedCG::set_linear_operator(size_t size,
+        const LinearOperator& op, const VectorF& diagonal) {
+    if (!op) {
+        throw RuntimeError("Invalid linear operator");
+    }
+    m_size = size;
+    m_matrix.resize(0, 0);
+    m_matrix.data().squeeze();
+    m_operator = op;
+
+    if (diagonal.size() == 0) {
+        // Unpreconditioned.
+        m_preconditioner = nullptr;
+    } else {
+        if (size_t(diagonal.size()) != size) {
+            throw RuntimeError("Diagonal size does not match operator size");
+        }
+        m_preconditioner = Preconditioner::create(m_preconditioner_type);
+        m_preconditioner->compute_from_diagonal(diagonal);
+    }
+}
+
+MatrixF PreconditionedCG::solve(const MatrixF& rhs) {
+    if (size_t(rhs.rows()) != m_size) {
+        throw RuntimeError("Right hand side size does not match the system");
+    }
+
+    m_num_iterations = 0;
+    MatrixF solution(rhs.rows(), rhs.cols());
+    VectorF x;
+    for (int i=0; i<rhs.cols(); i++) {
+        solve_single(rhs.col(i), x);
+        solution.col(i) = x;
+    }
+    return solution;
+}
+
+void PreconditionedCG::solve_single(const VectorF& b, VectorF& x) {
+    using namespace ParallelLinearAlgebra;
+    const size_t n = m_size;
+    const int max_iterations = m_max_iterations > 0 ?
+        m_max_iterations : int(2 * n);
+
+    x = VectorF::Zero(n);
+    const Float b_norm_sq = dot(b, b);
+    if (b_norm_sq == 0.0) return;
+    const Float threshold = m_tol * m_tol * b_norm_sq;
+
+    VectorF r = b;
+    VectorF z, p, Ap;
+    if (m_preconditioner) m_preconditioner->apply(r, z);
+    else z = r;
+    p = z;
+    Float rz = dot(r, z);
+
+    for (int itr=0; itr<max_iterations; itr++) {
+        multiply(p, Ap);
+        const Float pAp = dot(p, Ap);
+        if (pAp <= 0.0) {
+            throw RuntimeError(
+                    "solve: Conjugate gradient requires a positive definite system");
+        }
+        const Float alpha = rz / pAp;
+        axpy(alpha, p, x);
+        axpy(-alpha, Ap, r);
+        m_num_iterations++;
+        if (dot(r, r) <= threshold) return;
+
+        if (m_preconditioner) m_preconditioner->apply(r, z);
+        else z = r;
+        const Float rz_next = dot(r, z);
+        xpby(z, rz_next / rz, p);
+        rz = rz_next;
+    }
+    throw RuntimeError("solve: Conjugate gradient did not converge");
+}
+
+void PreconditionedCG::multiply(const VectorF& x, VectorF& y) const {
+    if (m_operator) {
+        y.resize(m_size);
+        m_operator(x, y);
+    } else {
+        ParallelLinearAlgebra::multiply(m_matrix, x, y);
+    }
+}
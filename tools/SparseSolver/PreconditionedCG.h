@@ -0,0 +1,58 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <string>
+
+#include "ParallelLinearAlgebra.h"
+#include "Preconditioner.h"
+#include "SparseSolver.h"
+
+namespace PyMesh {
+
+/**
+ * Preconditioned conjugate gradient for symmetric positive definite
+ * systems.  Matrix vector products and vector updates are multithreaded.
+ * The system is either an assembled matrix or a matrix-free operator (see
+ * set_linear_operator()), in which case only Jacobi preconditioning from
+ * the provided diagonal is available.
+ */
+class PreconditionedCG : public SparseSolver {
+    public:
+        PreconditionedCG(const std::string& preconditioner_type)
+            : m_preconditioner_type(preconditioner_type), m_size(0) {}
+
+    public:
+        virtual void compute(const ZSparseMatrix& matrix) override {
+            analyze_pattern(matrix);
+            factorize(matrix);
+        }
+
+        virtual void analyze_pattern(const ZSparseMatrix& matrix) override {}
+
+        virtual void factorize(const ZSparseMatrix& matrix) override;
+
+        virtual void set_linear_operator(size_t size,
+                const LinearOperator& op, const VectorF& diagonal) override;
+
+        virtual MatrixF solve(const MatrixF& rhs) override;
+
+        /**
+         * Iterations used by the last call to solve(), summed over all
+         * right hand sides.
+         */
+        int get_num_iterations() const { return m_num_iterations; }
+
+    private:
+        void solve_single(const VectorF& b, VectorF& x);
+        void multiply(const VectorF& x, VectorF& y) const;
+
+    private:
+        std::string m_preconditioner_type;
+        Preconditioner::Ptr m_preconditioner;
+        ParallelLinearAlgebra::RowMajorMatrix m_matrix;
+        LinearOperator m_operator;
+        size_t m_size;
+        int m_num_iterations = 0;
+};
+
+}
@@ -0,0 +1,20 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "Preconditioner.h"
+
+#include "AMGPreconditioner.h"
+#include "IncompleteCholeskyPreconditioner.h"
+#include "JacobiPreconditioner.h"
+
+using namespace PyMesh;
+
+Preconditioner::Ptr Preconditioner::create(const std::string& type) {
+    if (type == "Jacobi") {
+        return std::make_shared<JacobiPreconditioner>();
+    } else if (type == "IC") {
+        return std::make_shared<IncompleteCholeskyPreconditioner>();
+    } else if (type == "AMG") {
+        return std::make_shared<AMGPreconditioner>();
+    } else {
+        throw NotImplementedError("Unsupported preconditioner: " + type);
+    }
+}
@@ -0,0 +1,47 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <Core/EigenTypedef.h>
+#include <Core/Exception.h>
+#include <Math/ZSparseMatrix.h>
+
+namespace PyMesh {
+
+/**
+ * Preconditioner M ~ A^-1 for the preconditioned conjugate gradient solver.
+ * M must be symmetric positive definite.
+ */
+class Preconditioner {
+    public:
+        typedef std::shared_ptr<Preconditioner> Ptr;
+
+        /**
+         * Supported types: "Jacobi", "IC" (incomplete Cholesky) and "AMG"
+         * (smoothed aggregation algebraic multigrid).
+         */
+        static Ptr create(const std::string& type);
+
+    public:
+        virtual ~Preconditioner() = default;
+
+        virtual void compute(const ZSparseMatrix& matrix) = 0;
+
+        /**
+         * Setup from the diagonal of the matrix only.  This is used in
+         * matrix-free mode, where the matrix is never assembled.
+         */
+        virtual void compute_from_diagonal(const VectorF& diagonal) {
+            throw NotImplementedError(
+                    "Preconditioner requires an assembled matrix");
+        }
+
+        /**
+         * z = M r.
+         */
+        virtual void apply(const VectorF& r, VectorF& z) const = 0;
+};
+
+}
@@ -18,6 +18,7 @@
 
 #include <Core/Exception.h>
 
+#include "PreconditionedCG.h"
 #include "SparseSolverImplementation.h"
 
 using namespace PyMesh;
@@ -50,6 +51,12 @@ SparseSolver::Ptr SparseSolver::create(const std::string& solver_type) {
         using SparseQR = Eigen::SparseQR<ZSparseMatrix::ParentType,
               Eigen::COLAMDOrdering<ZSparseMatrix::ParentType::StorageIndex> >;
         return SparseSolver::Ptr(new SparseSolverImplementation<SparseQR>);
+    } else if (solver_type == "PCG_Jacobi") {
+        return SparseSolver::Ptr(new PreconditionedCG("Jacobi"));
+    } else if (solver_type == "PCG_IC") {
+        return SparseSolver::Ptr(new PreconditionedCG("IC"));
+    } else if (solver_type == "PCG_AMG") {
+        return SparseSolver::Ptr(new PreconditionedCG("AMG"));
     }
 #ifdef WITH_UMFPACK
     if (solver_type == "UmfPackLU") {
@@ -95,7 +102,10 @@ std::vector<std::string> SparseSolver::get_supported_solvers() {
         "LSCG",
         "BiCG",
         "SparseLU",
-        "SparseQR"
+        "SparseQR",
+        "PCG_Jacobi",
+        "PCG_IC",
+        "PCG_AMG"
     };
 #ifdef WITH_UMFPACK
     solver_names.push_back("UmfPackLU");
@@ -1,5 +1,6 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #pragma once
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,6 +14,10 @@ namespace PyMesh {
 class SparseSolver {
     public:
         typedef std::shared_ptr<SparseSolver> Ptr;
+        /**
+         * Matrix-free operator computing y = A x.
+         */
+        typedef std::function<void(const VectorF& x, VectorF& y)> LinearOperator;
         static Ptr create(const std::string& solve_type);
         static std::vector<std::string> get_supported_solvers();
 
@@ -33,6 +38,18 @@ class SparseSolver {
             return m_max_iterations;
         }
 
+        /**
+         * Number of interleaved unknowns per node (e.g. dim for
+         * elasticity).  Used by the AMG preconditioner to aggregate nodes.
+         */
+        void set_block_size(size_t block_size) {
+            m_block_size = block_size;
+        }
+
+        size_t get_block_size() const {
+            return m_block_size;
+        }
+
     public:
         virtual void compute(const ZSparseMatrix& matrix) {
             throw NotImplementedError(
@@ -49,6 +66,17 @@ class SparseSolver {
                     "SparseSolver::facetorize is not implemented");
         }
 
+        /**
+         * Use a matrix-free operator of the given size instead of an
+         * assembled matrix.  The diagonal is optional and only used for
+         * preconditioning.  This replaces analyze_pattern() and factorize().
+         */
+        virtual void set_linear_operator(size_t size,
+                const LinearOperator& op, const VectorF& diagonal) {
+            throw NotImplementedError(
+                    "Sparse solver does not support matrix-free mode");
+        }
+
         virtual MatrixF solve(const MatrixF& rhs) {
             throw NotImplementedError(
                     "SparseSolver::facetorize is not implemented");
@@ -61,6 +89,7 @@ class SparseSolver {
     protected:
         Float m_tol = Eigen::NumTraits<Float>::epsilon();
         int m_max_iterations = -1;
+        size_t m_block_size = 1;
 };
 
 }
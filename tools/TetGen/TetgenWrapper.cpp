@@ -2,6 +2,7 @@
 #ifdef WITH_TETGEN
 #include "TetgenWrapper.h"
 #include <iostream>
+#include <mutex>
 #include <tetgen.h>
 
 #include <Core/Exception.h>
@@ -12,6 +13,17 @@
 
 using namespace PyMesh;
 
+namespace TetgenWrapperHelper {
+    /**
+     * TetGen's exactinit() stores the predicate filter bounds of the current
+     * input in static variables, so concurrent calls to tetrahedralize() must
+     * be serialized.
+     */
+    std::mutex tetgen_lock;
+}
+
+using namespace TetgenWrapperHelper;
+
 void TetgenWrapper::run() {
     tetgenio in, out, addin, bgmin;
 
@@ -94,6 +106,7 @@ void TetgenWrapper::run() {
 
     std::string flags = generate_command_line_options();
     try {
+        std::lock_guard<std::mutex> guard(tetgen_lock);
         tetrahedralize(const_cast<char*>(flags.c_str()), &in, &out);
     } catch (int error_code) {
         throw TetgenException(error_code);
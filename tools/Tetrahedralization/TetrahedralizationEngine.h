@@ -72,9 +72,9 @@ class TetrahedralizationEngine {
             m_feature_angle = val;
         }
 
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        MatrixIr get_voxels() const { return m_voxels; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const MatrixIr& get_voxels() const { return m_voxels; }
 
     protected:
         void preprocess();
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,12 @@ using namespace PyMesh;
 
 namespace TriangleWrapperHelper {
     const int REGION_BOUNDARY = 2;
+
+    /**
+     * Triangle keeps process-wide state (random seed, exact arithmetic
+     * splitters), so concurrent calls to triangulate() must be serialized.
+     */
+    std::mutex triangle_lock;
     using Region = TriangleWrapper::Region;
     using Regions = TriangleWrapper::Regions;
 
@@ -352,7 +359,10 @@ void TriangleWrapper::run_triangle(const std::string& flags) {
                 in.trianglearealist);
     }
 
-    triangulate(const_cast<char*>(flags.c_str()), &in, &out, &out_voro);
+    {
+        std::lock_guard<std::mutex> guard(triangle_lock);
+        triangulate(const_cast<char*>(flags.c_str()), &in, &out, &out_voro);
+    }
 
     if (out.numberofpoints > 0 && out.pointlist) {
         m_vertices.resize(out.numberofpoints, dim);
@@ -55,10 +55,10 @@ class InflatorEngine {
         void with_abs_geometry_correction(const VectorF& correction);
         void set_geometry_correction_cap(Float cap) { m_correction_cap = cap; }
         void set_geometry_spread_constant(Float val) { m_spread_const = val; }
-        VectorF  get_thickness() const { return m_thickness; }
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        VectorI  get_face_sources() const { return m_face_sources; }
+        const VectorF&  get_thickness() const { return m_thickness; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const VectorI&  get_face_sources() const { return m_face_sources; }
         ThicknessType get_thickness_type() const { return m_thickness_type; }
 
         void set_profile(WireProfilePtr profile) { m_profile = profile; }
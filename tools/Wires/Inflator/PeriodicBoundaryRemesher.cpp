@@ -103,6 +103,11 @@ PeriodicBoundaryRemesher::PeriodicBoundaryRemesher(
     m_vertices(vertices), m_faces(faces),
     m_bbox_min(bbox_min), m_bbox_max(bbox_max) {
         assert(m_faces.cols() == 3);
+        const size_t num_faces = m_faces.rows();
+        m_face_sources.resize(num_faces);
+        for (size_t i=0; i<num_faces; i++) {
+            m_face_sources[i] = i;
+        }
 
     //VectorF labels = VectorF::Ones(m_vertices.rows());
     //save_mesh("init.msh", m_vertices, m_faces, labels);
@@ -121,7 +126,14 @@ void PeriodicBoundaryRemesher::remesh(Float ave_edge_length) {
 
 void PeriodicBoundaryRemesher::clean_up() {
     MeshCleaner cleaner;
-    cleaner.clean(m_vertices, m_faces, 1e-3);
+    VectorI face_indices = cleaner.clean(m_vertices, m_faces, 1e-3);
+
+    const size_t num_faces = m_faces.rows();
+    VectorI face_sources(num_faces);
+    for (size_t i=0; i<num_faces; i++) {
+        face_sources[i] = m_face_sources[face_indices[i]];
+    }
+    m_face_sources.swap(face_sources);
 }
 
 void PeriodicBoundaryRemesher::label_bd_faces() {
@@ -480,6 +492,19 @@ void PeriodicBoundaryRemesher::remesh_boundary(Float max_area) {
         m_faces.block(count, 0, faces.rows(), 3) = faces;
         count += faces.rows();
     }
+
+    // Interior faces come first and keep their sources.
+    VectorI face_sources = VectorI::Constant(face_count, -1);
+    size_t interior_count = 0;
+    const size_t num_ori_faces = m_bd_face_markers.size();
+    for (size_t i=0; i<num_ori_faces; i++) {
+        if (m_bd_face_markers[i] == 0) {
+            face_sources[interior_count] = m_face_sources[i];
+            interior_count++;
+        }
+    }
+    assert(interior_count == size_t(remeshed_faces[0].rows()));
+    m_face_sources.swap(face_sources);
 }
 
 void PeriodicBoundaryRemesher::add_interior_geometry(
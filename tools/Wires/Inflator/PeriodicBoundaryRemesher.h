@@ -19,6 +19,12 @@ class PeriodicBoundaryRemesher {
         MatrixFr get_vertices() const { return m_vertices; }
         MatrixIr get_faces() const {return m_faces; }
 
+        /**
+         * Index of the input face each output face comes from, or -1 for
+         * faces generated on the bbox boundary.
+         */
+        VectorI get_face_sources() const { return m_face_sources; }
+
     protected:
         void clean_up();
         void label_bd_faces();
@@ -50,6 +56,7 @@ class PeriodicBoundaryRemesher {
     protected:
         MatrixFr m_vertices;
         MatrixIr m_faces;
+        VectorI  m_face_sources;
 
         VectorF m_bbox_min;
         VectorF m_bbox_max;
@@ -14,8 +14,8 @@ class PeriodicInflator3D : public PeriodicInflator {
     protected:
         virtual void clip_to_center_cell();
         void clip_phantom_mesh();
-        void update_face_sources();
         void periodic_remesh();
+        void update_face_sources(const VectorI& remeshed_sources);
 
     private:
         VectorF m_center_cell_bbox_min;
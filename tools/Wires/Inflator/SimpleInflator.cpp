@@ -3,8 +3,10 @@
 
 #include <limits>
 #include <iostream>
+
+#include <tbb/tbb.h>
+
 #include <ConvexHull/ConvexHullEngine.h>
-#include <Triangle/TriangleWrapper.h>
 
 using namespace PyMesh;
 
@@ -64,6 +66,56 @@ namespace SimpleInflatorHelper {
         VectorF proj = (loop.rowwise() - v0.transpose()) * dir / dir_sq_len;
         return ((proj.array() > 0.0).all() && (proj.array() < 1.0).all());
     }
+
+    /**
+     * Triangulate a convex polygon without adding vertices.  The polygon is
+     * given as counterclockwise boundary segments.  Each chord picks the
+     * vertex that sees it at the largest angle, which yields the Delaunay
+     * triangulation of a convex polygon.
+     */
+    MatrixIr triangulate_convex_polygon(
+            const MatrixFr& vertices, const MatrixIr& segments) {
+        const size_t num_vertices = segments.rows();
+        VectorI next = VectorI::Constant(vertices.rows(), -1);
+        for (size_t i=0; i<num_vertices; i++) {
+            next[segments(i, 0)] = segments(i, 1);
+        }
+        std::vector<int> polygon(num_vertices);
+        polygon[0] = segments(0, 0);
+        for (size_t i=1; i<num_vertices; i++) {
+            polygon[i] = next[polygon[i-1]];
+        }
+
+        MatrixIr faces(num_vertices-2, 3);
+        size_t count = 0;
+        std::vector<std::pair<size_t, size_t> > chords;
+        chords.emplace_back(0, num_vertices-1);
+        while (!chords.empty()) {
+            const size_t i = chords.back().first;
+            const size_t j = chords.back().second;
+            chords.pop_back();
+            if (j - i < 2) continue;
+
+            const VectorF& vi = vertices.row(polygon[i]);
+            const VectorF& vj = vertices.row(polygon[j]);
+            size_t best = i+1;
+            Float best_cos = std::numeric_limits<Float>::max();
+            for (size_t k=i+1; k<j; k++) {
+                const VectorF& vk = vertices.row(polygon[k]);
+                const Float cos_angle = (vi - vk).normalized().dot(
+                        (vj - vk).normalized());
+                if (cos_angle < best_cos) {
+                    best_cos = cos_angle;
+                    best = k;
+                }
+            }
+            faces.row(count++) = Vector3I(polygon[i], polygon[best], polygon[j]);
+            chords.emplace_back(i, best);
+            chords.emplace_back(best, j);
+        }
+        assert(count == num_vertices-2);
+        return faces;
+    }
 }
 
 using namespace SimpleInflatorHelper;
@@ -86,10 +138,9 @@ const std::vector<MatrixFr>& SimpleInflator::get_shape_velocities() const {
 void SimpleInflator::initialize() {
     check_thickness();
     m_end_loops.clear();
-    m_vertex_list.clear();
-    m_face_list.clear();
-    m_face_source_list.clear();
-    m_num_vertex_accumulated = 0;
+    m_vertex_blocks.clear();
+    m_face_blocks.clear();
+    m_face_block_sources.clear();
 
     if (!m_wire_network->with_connectivity()) {
         m_wire_network->compute_connectivity();
@@ -128,25 +179,29 @@ void SimpleInflator::generate_end_loops() {
     const MatrixFr vertices = m_wire_network->get_vertices();
     const MatrixIr edges = m_wire_network->get_edges();
     const MatrixFr edge_thickness = get_edge_thickness();
-    for (size_t i=0; i<num_edges; i++) {
-        const VectorI& edge = edges.row(i);
-        const VectorF& v1 = vertices.row(edge[0]);
-        const VectorF& v2 = vertices.row(edge[1]);
-        Float edge_len = (v2 - v1).norm();
-        MatrixFr loop_1 = m_profile->place(v1, v2,
-                m_end_loop_offsets[edge[0]],
-                edge_thickness(i, 0),
-                m_rel_correction, m_abs_correction, m_correction_cap,
-                m_spread_const);
-        assert(loop_is_valid(loop_1, v1, v2));
-        MatrixFr loop_2 = m_profile->place(v1, v2,
-                edge_len - m_end_loop_offsets[edge[1]],
-                edge_thickness(i, 1),
-                m_rel_correction, m_abs_correction, m_correction_cap,
-                m_spread_const);
-        assert(loop_is_valid(loop_2, v1, v2));
-        m_end_loops.push_back(std::make_pair(loop_1, loop_2));
-    }
+    m_end_loops.resize(num_edges);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const VectorI& edge = edges.row(i);
+                    const VectorF& v1 = vertices.row(edge[0]);
+                    const VectorF& v2 = vertices.row(edge[1]);
+                    Float edge_len = (v2 - v1).norm();
+                    MatrixFr loop_1 = m_profile->place(v1, v2,
+                            m_end_loop_offsets[edge[0]],
+                            edge_thickness(i, 0),
+                            m_rel_correction, m_abs_correction,
+                            m_correction_cap, m_spread_const);
+                    assert(loop_is_valid(loop_1, v1, v2));
+                    MatrixFr loop_2 = m_profile->place(v1, v2,
+                            edge_len - m_end_loop_offsets[edge[1]],
+                            edge_thickness(i, 1),
+                            m_rel_correction, m_abs_correction,
+                            m_correction_cap, m_spread_const);
+                    assert(loop_is_valid(loop_2, v1, v2));
+                    m_end_loops[i] = std::make_pair(loop_1, loop_2);
+                }
+            });
 }
 
 void SimpleInflator::generate_joints() {
@@ -168,24 +223,34 @@ void SimpleInflator::generate_joints() {
         source_edge_indices[edge[1]].push_back(i);
     }
 
-    for (size_t i=0; i<num_vertices; i++) {
-        const auto& incident_loops = loops[i];
-        const auto& edge_ids = source_edge_indices[i];
-        assert(incident_loops.size() == edge_ids.size());
-        size_t valance = incident_loops.size();
-        MatrixFr pts(valance * loop_size + 1, dim);
-        VectorI  source_ids(pts.rows());
-        pts.row(0) = vertices.row(i);
-        source_ids[0] = -1;
-        size_t count = 0;
-        for (auto loop : incident_loops) {
-            pts.block(count*loop_size+1, 0, loop_size, dim) = *loop;
-            source_ids.segment(count*loop_size+1, loop_size) =
-                VectorI::Ones(loop_size) * edge_ids[count];
-            count++;
-        }
-        generate_joint(pts, source_ids, i);
-    }
+    const size_t block_offset = m_vertex_blocks.size();
+    m_vertex_blocks.resize(block_offset + num_vertices);
+    m_face_blocks.resize(block_offset + num_vertices);
+    m_face_block_sources.resize(block_offset + num_vertices);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const auto& incident_loops = loops[i];
+                    const auto& edge_ids = source_edge_indices[i];
+                    assert(incident_loops.size() == edge_ids.size());
+                    size_t valance = incident_loops.size();
+                    MatrixFr pts(valance * loop_size + 1, dim);
+                    VectorI  source_ids(pts.rows());
+                    pts.row(0) = vertices.row(i);
+                    source_ids[0] = -1;
+                    size_t count = 0;
+                    for (auto loop : incident_loops) {
+                        pts.block(count*loop_size+1, 0, loop_size, dim) = *loop;
+                        source_ids.segment(count*loop_size+1, loop_size) =
+                            VectorI::Ones(loop_size) * edge_ids[count];
+                        count++;
+                    }
+                    generate_joint(pts, source_ids,
+                            m_vertex_blocks[block_offset + i],
+                            m_face_blocks[block_offset + i]);
+                    m_face_block_sources[block_offset + i] = i+1;
+                }
+            });
 }
 
 void SimpleInflator::connect_end_loops() {
@@ -199,60 +264,69 @@ void SimpleInflator::connect_end_loops() {
             loop_size, dim != 2);
     const size_t num_connecting_faces = connecting_faces.rows();
 
-    for (size_t i=0; i<num_edges; i++) {
-        Float edge_length = edge_lengths(i, 0);
-        const auto& end_loops = m_end_loops[i];
-        const size_t num_segments = std::max(1.0,
-                std::round(edge_length / ave_thickness));
-        MatrixFr pts((num_segments+1)*loop_size, dim);
-
-        for (size_t j=0; j<num_segments+1; j++) {
-            Float alpha = Float(j) / Float(num_segments);
-            pts.block(j*loop_size, 0, loop_size, dim) =
-                end_loops.first * (1.0 - alpha) + end_loops.second * alpha;
-        }
-
-        MatrixIr faces(num_connecting_faces * num_segments, 3);
-        for (size_t j=0; j<num_segments; j++) {
-            faces.block(j*num_connecting_faces, 0, num_connecting_faces, 3) =
-                connecting_faces.array() + j*loop_size;
-        }
-
-        m_vertex_list.push_back(pts);
-        m_face_list.push_back(faces.array() + m_num_vertex_accumulated);
-        m_face_source_list.push_back(int(i)*(-1)-1);
-        m_num_vertex_accumulated += pts.rows();
-    }
+    const size_t block_offset = m_vertex_blocks.size();
+    m_vertex_blocks.resize(block_offset + num_edges);
+    m_face_blocks.resize(block_offset + num_edges);
+    m_face_block_sources.resize(block_offset + num_edges);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_edges),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    Float edge_length = edge_lengths(i, 0);
+                    const auto& end_loops = m_end_loops[i];
+                    const size_t num_segments = std::max(1.0,
+                            std::round(edge_length / ave_thickness));
+                    MatrixFr pts((num_segments+1)*loop_size, dim);
+
+                    for (size_t j=0; j<num_segments+1; j++) {
+                        Float alpha = Float(j) / Float(num_segments);
+                        pts.block(j*loop_size, 0, loop_size, dim) =
+                            end_loops.first * (1.0 - alpha) +
+                            end_loops.second * alpha;
+                    }
+
+                    MatrixIr faces(num_connecting_faces * num_segments, 3);
+                    for (size_t j=0; j<num_segments; j++) {
+                        faces.block(j*num_connecting_faces, 0,
+                                num_connecting_faces, 3) =
+                            connecting_faces.array() + j*loop_size;
+                    }
+
+                    m_vertex_blocks[block_offset + i].swap(pts);
+                    m_face_blocks[block_offset + i].swap(faces);
+                    m_face_block_sources[block_offset + i] = int(i)*(-1)-1;
+                }
+            });
 }
 
 void SimpleInflator::finalize() {
     const size_t dim = m_wire_network->get_dim();
-    size_t num_vertices = 0;
-    size_t num_faces = 0;
-    for (auto itr : m_vertex_list) num_vertices += itr.rows();
-    for (auto itr : m_face_list) num_faces += itr.rows();
-
-    m_vertices.resize(num_vertices, dim);
-    m_faces.resize(num_faces, 3);
-    m_face_sources.resize(num_faces);
-
-    size_t vertex_count=0;
-    for (auto itr : m_vertex_list) {
-        size_t size = itr.rows();
-        m_vertices.block(vertex_count, 0, size, dim) = itr;
-        vertex_count += size;
+    const size_t num_blocks = m_vertex_blocks.size();
+    assert(m_face_blocks.size() == num_blocks);
+    assert(m_face_block_sources.size() == num_blocks);
+
+    std::vector<size_t> vertex_offsets(num_blocks+1, 0);
+    std::vector<size_t> face_offsets(num_blocks+1, 0);
+    for (size_t i=0; i<num_blocks; i++) {
+        vertex_offsets[i+1] = vertex_offsets[i] + m_vertex_blocks[i].rows();
+        face_offsets[i+1] = face_offsets[i] + m_face_blocks[i].rows();
     }
 
-    size_t face_count=0;
-    auto source_itr = m_face_source_list.begin();
-    for (auto itr : m_face_list) {
-        size_t size = itr.rows();
-        m_faces.block(face_count, 0, size, 3) = itr;
-        m_face_sources.segment(face_count, size) =
-            VectorI::Ones(size) * (*source_itr);
-        face_count += size;
-        source_itr++;
-    }
+    m_vertices.resize(vertex_offsets.back(), dim);
+    m_faces.resize(face_offsets.back(), 3);
+    m_face_sources.resize(face_offsets.back());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const size_t num_block_vertices = m_vertex_blocks[i].rows();
+                    const size_t num_block_faces = m_face_blocks[i].rows();
+                    m_vertices.block(vertex_offsets[i], 0,
+                            num_block_vertices, dim) = m_vertex_blocks[i];
+                    m_faces.block(face_offsets[i], 0, num_block_faces, 3) =
+                        m_face_blocks[i].array() + int(vertex_offsets[i]);
+                    m_face_sources.segment(face_offsets[i], num_block_faces)
+                        .setConstant(m_face_block_sources[i]);
+                }
+            });
 
     clean_up();
 }
@@ -337,44 +411,40 @@ MatrixFr SimpleInflator::get_edge_thickness() const {
     return thickness;
 }
 
-void SimpleInflator::generate_joint(
-        const MatrixFr& pts, const VectorI& source_ids, size_t vertex_index) {
+void SimpleInflator::generate_joint(const MatrixFr& pts,
+        const VectorI& source_ids,
+        MatrixFr& joint_vertices, MatrixIr& joint_faces) const {
+    // Joints are small and run concurrently, so use the built-in hull
+    // instead of a general purpose (and non-reentrant) library.
     const size_t dim = m_wire_network->get_dim();
-    ConvexHullEngine::Ptr convex_hull = ConvexHullEngine::create(dim, "auto");
+    ConvexHullEngine::Ptr convex_hull =
+        ConvexHullEngine::create(dim, "incremental");
     convex_hull->run(pts);
 
-    MatrixFr vertices = convex_hull->get_vertices();
+    joint_vertices = convex_hull->get_vertices();
     MatrixIr faces = convex_hull->get_faces();
     VectorI  index_map = convex_hull->get_index_map();
 
     if (dim == 2) {
         // Need to triangulate the loop.
-        const size_t num_vertices = vertices.rows();
-        TriangleWrapper tri;
-        tri.set_points(vertices);
-        tri.set_segments(faces);
-        tri.set_split_boundary(false);
-        tri.set_max_num_steiner_points(0);
-        tri.set_verbosity(0);
-        tri.run();
-        vertices = tri.get_vertices();
-        faces = tri.get_faces();
-        assert(vertices.rows() == num_vertices);
+        joint_faces = triangulate_convex_polygon(joint_vertices, faces);
+        return;
     }
 
-    m_vertex_list.push_back(vertices);
     const size_t num_faces = faces.rows();
+    std::vector<bool> to_keep(num_faces, true);
+    size_t num_kept = 0;
     for (size_t i=0; i<num_faces; i++) {
-        const auto& face = faces.row(i);
-        if (dim == 3) {
-            auto ori_indices = map_indices(face, index_map);
-            if (belong_to_the_same_loop(ori_indices, source_ids)) continue;
-        }
-        m_face_list.push_back(face.array() + m_num_vertex_accumulated);
-        m_face_source_list.push_back(vertex_index+1);
+        auto ori_indices = map_indices(faces.row(i), index_map);
+        to_keep[i] = !belong_to_the_same_loop(ori_indices, source_ids);
+        if (to_keep[i]) num_kept++;
     }
 
-    m_num_vertex_accumulated += vertices.rows();
+    joint_faces.resize(num_kept, 3);
+    size_t count = 0;
+    for (size_t i=0; i<num_faces; i++) {
+        if (to_keep[i]) joint_faces.row(count++) = faces.row(i);
+    }
 }
 
 bool SimpleInflator::belong_to_the_same_loop(
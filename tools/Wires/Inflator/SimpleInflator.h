@@ -3,7 +3,6 @@
 
 #include "InflatorEngine.h"
 
-#include <list>
 #include <vector>
 
 namespace PyMesh {
@@ -30,7 +29,8 @@ class SimpleInflator : public InflatorEngine {
         VectorF compute_vertex_thickness() const;
         void validate_end_loop_offset() const;
         MatrixFr get_edge_thickness() const;
-        void generate_joint(const MatrixFr& pts, const VectorI& source_ids, size_t vertex_index);
+        void generate_joint(const MatrixFr& pts, const VectorI& source_ids,
+                MatrixFr& joint_vertices, MatrixIr& joint_faces) const;
         bool belong_to_the_same_loop(
                 const VectorI& indices, const VectorI& source_ids) const;
 
@@ -38,10 +38,14 @@ class SimpleInflator : public InflatorEngine {
         VectorF m_end_loop_offsets;
         std::vector<std::pair<MatrixFr, MatrixFr> > m_end_loops;
 
-        size_t m_num_vertex_accumulated;
-        std::list<MatrixFr> m_vertex_list;
-        std::list<MatrixIr> m_face_list;
-        std::list<int> m_face_source_list;
+        /**
+         * One block per wire vertex (joint) followed by one block per wire
+         * edge.  Face indices are local to their block.  Blocks are
+         * generated independently and merged in finalize().
+         */
+        std::vector<MatrixFr> m_vertex_blocks;
+        std::vector<MatrixIr> m_face_blocks;
+        std::vector<int> m_face_block_sources;
 };
 
 }
@@ -3,6 +3,10 @@
 
 #include <cmath>
 #include <iostream>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 #include <IO/MeshWriter.h>
 #include <Math/MatrixUtils.h>
@@ -27,30 +31,46 @@ PeriodicExploration::PeriodicExploration(const std::string& wire_file,
         * 0.5 * cell_size;
     m_wire_network->scale_fit(
             -half_bbox_size, half_bbox_size);
-    m_parameters = ParameterManager::create_empty_manager(
-            m_wire_network, m_default_thickness);
+    m_parameter_factory = [default_thickness](WireNetwork::Ptr wire_network) {
+        return ParameterManager::create_empty_manager(
+                wire_network, default_thickness);
+    };
+    m_parameters = m_parameter_factory(m_wire_network);
 
     m_refine_algorithm = "simple";
     m_refine_order = 0;
     m_profile = WireProfile::create("square");
+    m_save_debug_mesh = true;
 }
 
 void PeriodicExploration::with_parameters(
         const std::string& orbit_file, const std::string& modifier_file) {
-    m_parameters = ParameterManager::create_from_setting_file(
-            m_wire_network, m_default_thickness, orbit_file, modifier_file);
+    const Float default_thickness = m_default_thickness;
+    m_parameter_factory = [=](WireNetwork::Ptr wire_network) {
+        return ParameterManager::create_from_setting_file(
+                wire_network, default_thickness, orbit_file, modifier_file);
+    };
+    m_parameters = m_parameter_factory(m_wire_network);
 }
 
 void PeriodicExploration::with_all_parameters(
         TargetType thickness_type) {
-    m_parameters = ParameterManager::create(
-            m_wire_network, m_default_thickness, thickness_type);
+    const Float default_thickness = m_default_thickness;
+    m_parameter_factory = [=](WireNetwork::Ptr wire_network) {
+        return ParameterManager::create(
+                wire_network, default_thickness, thickness_type);
+    };
+    m_parameters = m_parameter_factory(m_wire_network);
 }
 
 void PeriodicExploration::with_all_isotropic_parameters(
         TargetType thickness_type) {
-    m_parameters = ParameterManager::create_isotropic(
-            m_wire_network, m_default_thickness, thickness_type);
+    const Float default_thickness = m_default_thickness;
+    m_parameter_factory = [=](WireNetwork::Ptr wire_network) {
+        return ParameterManager::create_isotropic(
+                wire_network, default_thickness, thickness_type);
+    };
+    m_parameters = m_parameter_factory(m_wire_network);
 }
 
 void PeriodicExploration::with_refinement(
@@ -119,9 +139,11 @@ bool PeriodicExploration::run_tetgen(Float max_tet_vol) {
     try {
         tetgen.run();
     } catch (TetgenException& e) {
-        save_mesh("tetgen_debug.msh");
         std::cerr << e.what() << std::endl;
-        std::cerr << "Data saved in tetgen_debug.msh" << std::endl;
+        if (m_save_debug_mesh) {
+            save_mesh("tetgen_debug.msh");
+            std::cerr << "Data saved in tetgen_debug.msh" << std::endl;
+        }
         return false;
     }
 
@@ -150,6 +172,59 @@ bool PeriodicExploration::run_tetgen(Float max_tet_vol) {
 #endif
 }
 
+std::vector<Mesh::Ptr> PeriodicExploration::batch_inflate(
+        const MatrixFr& dofs, std::vector<bool>& success,
+        bool use_reflective_inflator, Float max_tet_vol) const {
+    const size_t num_dofs = get_num_dofs();
+    if (size_t(dofs.cols()) != num_dofs) {
+        std::stringstream err_msg;
+        err_msg << "Invalid number of dofs!  Expecting " << num_dofs
+            << " columns, got " << dofs.cols() << " columns";
+        throw RuntimeError(err_msg.str());
+    }
+
+    const size_t num_samples = dofs.rows();
+    std::vector<Mesh::Ptr> meshes(num_samples);
+    std::vector<char> succeeded(num_samples, false);
+
+    // Workers are reused across samples: every sample resets the dofs, and
+    // periodic_inflate() restores the wire network even when it throws.
+    tbb::enumerable_thread_specific<Ptr> workers(
+            [this]() { return clone(); });
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_samples),
+            [&](const tbb::blocked_range<size_t>& r) {
+                Ptr& worker = workers.local();
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    try {
+                        worker->set_dofs(dofs.row(i).transpose());
+                        worker->periodic_inflate(use_reflective_inflator);
+                        succeeded[i] = worker->run_tetgen(max_tet_vol);
+                        meshes[i] = worker->get_mesh();
+                    } catch (const std::exception& e) {
+                        std::cerr << "Sample " << i << " failed: "
+                            << e.what() << std::endl;
+                    }
+                }
+            });
+
+    success.assign(succeeded.begin(), succeeded.end());
+    return meshes;
+}
+
+PeriodicExploration::Ptr PeriodicExploration::clone() const {
+    Ptr other(new PeriodicExploration());
+    other->m_default_thickness = m_default_thickness;
+    other->m_wire_network = WireNetwork::create_raw(
+            m_wire_network->get_vertices(), m_wire_network->get_edges());
+    other->m_parameter_factory = m_parameter_factory;
+    other->m_parameters = m_parameter_factory(other->m_wire_network);
+    other->m_profile = m_profile;
+    other->m_save_debug_mesh = false;
+    other->m_refine_algorithm = m_refine_algorithm;
+    other->m_refine_order = m_refine_order;
+    return other;
+}
+
 bool PeriodicExploration::is_printable() {
     ParameterCommon::Variables vars;
     MatrixFr offset = m_parameters->evaluate_offset(vars);
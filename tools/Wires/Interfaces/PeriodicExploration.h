@@ -1,6 +1,8 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,9 @@
 namespace PyMesh {
 
 class PeriodicExploration {
+    public:
+        typedef std::shared_ptr<PeriodicExploration> Ptr;
+
     public:
         PeriodicExploration(const std::string& wire_file,
                 Float cell_size,
@@ -67,12 +72,29 @@ class PeriodicExploration {
          */
         bool run_tetgen(Float max_tet_vol=0.0);
 
+        /**
+         * Inflate and tetrahedralize one sample per row of dofs.
+         *
+         * Samples are processed in parallel.  Each worker thread owns a
+         * private copy of the wire network and parameters, so this object is
+         * left untouched.  Triangle and TetGen are not reentrant, so their
+         * calls are serialized by TriangleWrapper and TetgenWrapper; only the
+         * remaining inflation work runs concurrently.  success[i] is true
+         * only if both inflation and tetgen succeeded for sample i.  If
+         * inflation failed, the returned mesh is null; if only tetgen failed
+         * (or tetgen is not available), it is the surface mesh.
+         */
+        std::vector<Mesh::Ptr> batch_inflate(const MatrixFr& dofs,
+                std::vector<bool>& success,
+                bool use_reflective_inflator=false,
+                Float max_tet_vol=0.0) const;
+
         Mesh::Ptr get_mesh() { return m_mesh; }
-        MatrixFr get_vertices() const { return m_vertices; }
-        MatrixIr get_faces() const { return m_faces; }
-        MatrixIr get_voxels() const { return m_voxels; }
+        const MatrixFr& get_vertices() const { return m_vertices; }
+        const MatrixIr& get_faces() const { return m_faces; }
+        const MatrixIr& get_voxels() const { return m_voxels; }
         std::vector<MatrixFr> get_shape_velocities() const { return m_shape_velocities; }
-        VectorI get_face_sources() const { return m_face_sources; }
+        const VectorI& get_face_sources() const { return m_face_sources; }
         bool is_printable();
 
 
@@ -80,6 +102,11 @@ class PeriodicExploration {
         WireNetwork::Ptr get_wire_network() { return m_wire_network; }
 
     private:
+        typedef std::function<ParameterManager::Ptr(WireNetwork::Ptr)>
+            ParameterFactory;
+
+        PeriodicExploration() {}
+        Ptr clone() const;
         void update_mesh();
         void save_mesh(const std::string& filename) const;
 
@@ -87,7 +114,9 @@ class PeriodicExploration {
         Float m_default_thickness;
         WireNetwork::Ptr m_wire_network;
         ParameterManager::Ptr m_parameters;
+        ParameterFactory m_parameter_factory;
         WireProfile::Ptr m_profile;
+        bool m_save_debug_mesh;
 
         MatrixFr m_vertices;
         MatrixIr m_faces;
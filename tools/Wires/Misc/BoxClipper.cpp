@@ -0,0 +1,330 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "BoxClipper.h"
+
+#include <cassert>
+#include <map>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#include <Core/Exception.h>
+#include <Triangle/TriangleWrapper.h>
+
+using namespace PyMesh;
+
+namespace BoxClipperHelper {
+    typedef std::pair<int, int> Edge;
+
+    enum Side { INSIDE=-1, ON=0, OUTSIDE=1 };
+
+    Float signed_area(const MatrixFr& pts, int i, int j, int k) {
+        const Vector2F& p0 = pts.row(i);
+        const Vector2F& p1 = pts.row(j);
+        const Vector2F& p2 = pts.row(k);
+        return (p1[0] - p0[0]) * (p2[1] - p0[1])
+             - (p1[1] - p0[1]) * (p2[0] - p0[0]);
+    }
+}
+
+using namespace BoxClipperHelper;
+
+BoxClipper::BoxClipper(const VectorF& bbox_min, const VectorF& bbox_max) :
+    m_bbox_min(bbox_min), m_bbox_max(bbox_max), m_tol(1e-6) {
+        if (m_bbox_min.size() != 3 || m_bbox_max.size() != 3) {
+            throw NotImplementedError("BoxClipper only supports 3D boxes.");
+        }
+        if (!(m_bbox_max.array() > m_bbox_min.array()).all()) {
+            std::stringstream err_msg;
+            err_msg << "Invalid bbox!" << std::endl;
+            err_msg << "\tbbox_min: " << m_bbox_min.transpose() << std::endl;
+            err_msg << "\tbbox_max: " << m_bbox_max.transpose() << std::endl;
+            throw RuntimeError(err_msg.str());
+        }
+    }
+
+void BoxClipper::run(const MatrixFr& vertices, const MatrixIr& faces) {
+    if (vertices.cols() != 3 || faces.cols() != 3) {
+        throw NotImplementedError(
+                "BoxClipper only supports 3D triangle meshes.");
+    }
+
+    const size_t num_vertices = vertices.rows();
+    const size_t num_faces = faces.rows();
+    m_vertices.resize(num_vertices);
+    for (size_t i=0; i<num_vertices; i++) {
+        m_vertices[i] = vertices.row(i).transpose();
+    }
+    m_faces.resize(num_faces);
+    m_face_sources.resize(num_faces);
+    for (size_t i=0; i<num_faces; i++) {
+        m_faces[i] = faces.row(i).transpose();
+        m_face_sources[i] = i;
+    }
+
+    for (size_t axis=0; axis<3; axis++) {
+        clip(axis, m_bbox_min[axis], -1.0);
+        clip(axis, m_bbox_max[axis],  1.0);
+    }
+    remove_isolated_vertices();
+}
+
+MatrixFr BoxClipper::get_vertices() const {
+    const size_t num_vertices = m_vertices.size();
+    MatrixFr vertices(num_vertices, 3);
+    for (size_t i=0; i<num_vertices; i++) {
+        vertices.row(i) = m_vertices[i].transpose();
+    }
+    return vertices;
+}
+
+MatrixIr BoxClipper::get_faces() const {
+    const size_t num_faces = m_faces.size();
+    MatrixIr faces(num_faces, 3);
+    for (size_t i=0; i<num_faces; i++) {
+        faces.row(i) = m_faces[i].transpose();
+    }
+    return faces;
+}
+
+VectorI BoxClipper::get_face_sources() const {
+    VectorI face_sources(m_face_sources.size());
+    std::copy(m_face_sources.begin(), m_face_sources.end(),
+            face_sources.data());
+    return face_sources;
+}
+
+/**
+ * Keep the part of the mesh satisfying sign * (x[axis] - value) <= 0.
+ */
+void BoxClipper::clip(size_t axis, Float value, Float sign) {
+    const size_t num_vertices = m_vertices.size();
+    std::vector<short> sides(num_vertices);
+    for (size_t i=0; i<num_vertices; i++) {
+        Float d = sign * (m_vertices[i][axis] - value);
+        if (d > m_tol) {
+            sides[i] = OUTSIDE;
+        } else if (d < -m_tol) {
+            sides[i] = INSIDE;
+        } else {
+            sides[i] = ON;
+            m_vertices[i][axis] = value;
+        }
+    }
+
+    // Intersection vertices are keyed by the undirected edge so that both
+    // faces adjacent to an edge share the same cut point.
+    std::map<Edge, int> cut_vertices;
+    auto get_cut_vertex = [&](int i, int j) {
+        const Edge key(std::min(i, j), std::max(i, j));
+        auto itr = cut_vertices.find(key);
+        if (itr != cut_vertices.end()) return itr->second;
+
+        const Vector3F& v0 = m_vertices[key.first];
+        const Vector3F& v1 = m_vertices[key.second];
+        const Float d0 = v0[axis] - value;
+        const Float d1 = v1[axis] - value;
+        Vector3F p = v0 + (v1 - v0) * (d0 / (d0 - d1));
+        p[axis] = value;
+
+        const int idx = m_vertices.size();
+        m_vertices.push_back(p);
+        sides.push_back(ON);
+        cut_vertices.insert({key, idx});
+        return idx;
+    };
+
+    const size_t num_faces = m_faces.size();
+    std::vector<Vector3I> clipped_faces;
+    std::vector<int> clipped_face_sources;
+    clipped_faces.reserve(num_faces);
+    clipped_face_sources.reserve(num_faces);
+    for (size_t i=0; i<num_faces; i++) {
+        const Vector3I& f = m_faces[i];
+        const short s0 = sides[f[0]];
+        const short s1 = sides[f[1]];
+        const short s2 = sides[f[2]];
+        if (s0 <= ON && s1 <= ON && s2 <= ON) {
+            // Faces lying on the plane are dropped and replaced by the cap.
+            if (s0 == ON && s1 == ON && s2 == ON) continue;
+            clipped_faces.push_back(f);
+            clipped_face_sources.push_back(m_face_sources[i]);
+            continue;
+        }
+        if (s0 >= ON && s1 >= ON && s2 >= ON) continue;
+
+        // Sutherland-Hodgman against a single plane.  A triangle clipped by
+        // a half space is a convex polygon with at most 4 vertices.
+        int poly[4];
+        size_t poly_size = 0;
+        for (size_t j=0; j<3; j++) {
+            const int a = f[j];
+            const int b = f[(j+1)%3];
+            if (sides[a] <= ON) poly[poly_size++] = a;
+            if (sides[a] * sides[b] < 0) {
+                poly[poly_size++] = get_cut_vertex(a, b);
+            }
+        }
+        assert(poly_size <= 4);
+
+        for (size_t j=1; j+1<poly_size; j++) {
+            clipped_faces.emplace_back(poly[0], poly[j], poly[j+1]);
+            clipped_face_sources.push_back(m_face_sources[i]);
+        }
+    }
+
+    // Directed edges on the plane without a twin bound the cut.
+    std::set<Edge> on_plane_edges;
+    for (const auto& f : clipped_faces) {
+        for (size_t j=0; j<3; j++) {
+            const int a = f[j];
+            const int b = f[(j+1)%3];
+            if (sides[a] == ON && sides[b] == ON) {
+                on_plane_edges.insert({a, b});
+            }
+        }
+    }
+    std::vector<int> bd_edges;
+    for (const auto& e : on_plane_edges) {
+        if (on_plane_edges.find({e.second, e.first}) == on_plane_edges.end()) {
+            bd_edges.push_back(e.first);
+            bd_edges.push_back(e.second);
+        }
+    }
+
+    m_faces.swap(clipped_faces);
+    m_face_sources.swap(clipped_face_sources);
+    cap(axis, value, sign, bd_edges);
+}
+
+/**
+ * Close the holes bounded by bd_edges with faces lying on the plane.  The cap
+ * contains every bd edge in reversed direction and is oriented along
+ * sign * e_axis.
+ */
+void BoxClipper::cap(size_t axis, Float value, Float sign,
+        const std::vector<int>& bd_edges) {
+    if (bd_edges.empty()) return;
+    assert(bd_edges.size() % 2 == 0);
+
+    const size_t u = (axis+1) % 3;
+    const size_t v = (axis+2) % 3;
+    const size_t num_bd_edges = bd_edges.size() / 2;
+
+    std::vector<int> local_index(m_vertices.size(), -1);
+    std::vector<int> cap_vertices;
+    MatrixIr segments(num_bd_edges, 2);
+    for (size_t i=0; i<num_bd_edges; i++) {
+        for (size_t j=0; j<2; j++) {
+            const int vi = bd_edges[i*2+j];
+            if (local_index[vi] < 0) {
+                local_index[vi] = cap_vertices.size();
+                cap_vertices.push_back(vi);
+            }
+            segments(i, j) = local_index[vi];
+        }
+    }
+
+    const size_t num_cap_vertices = cap_vertices.size();
+    MatrixFr points(num_cap_vertices, 2);
+    for (size_t i=0; i<num_cap_vertices; i++) {
+        const Vector3F& p = m_vertices[cap_vertices[i]];
+        points(i, 0) = p[u];
+        points(i, 1) = p[v];
+    }
+
+    TriangleWrapper triangle;
+    triangle.set_points(points);
+    triangle.set_segments(segments);
+    triangle.set_min_angle(0.0);
+    triangle.set_split_boundary(false);
+    triangle.set_verbosity(0);
+    triangle.run();
+
+    const MatrixFr& tri_vertices = triangle.get_vertices();
+    MatrixIr tri_faces = triangle.get_faces();
+    const VectorI& regions = triangle.get_regions();
+    assert(regions.size() == tri_faces.rows());
+
+    // Counterclockwise faces in the (u, v) plane face +e_axis.  Such a face
+    // is inside the cap iff it traverses a bd edge backward when sign > 0,
+    // and forward otherwise.
+    std::set<Edge> inward_edges;
+    for (size_t i=0; i<num_bd_edges; i++) {
+        if (sign > 0) {
+            inward_edges.insert({segments(i, 1), segments(i, 0)});
+        } else {
+            inward_edges.insert({segments(i, 0), segments(i, 1)});
+        }
+    }
+
+    const size_t num_tri_faces = tri_faces.rows();
+    std::map<int, bool> region_is_inside;
+    for (size_t i=0; i<num_tri_faces; i++) {
+        if (signed_area(tri_vertices, tri_faces(i,0), tri_faces(i,1),
+                    tri_faces(i,2)) < 0) {
+            std::swap(tri_faces(i,1), tri_faces(i,2));
+        }
+        for (size_t j=0; j<3; j++) {
+            const int a = tri_faces(i, j);
+            const int b = tri_faces(i, (j+1)%3);
+            if (inward_edges.find({a, b}) != inward_edges.end()) {
+                region_is_inside.insert({regions[i], true});
+            } else if (inward_edges.find({b, a}) != inward_edges.end()) {
+                region_is_inside.insert({regions[i], false});
+            }
+        }
+    }
+
+    // Triangle only appends Steiner points after the input points.
+    const size_t num_tri_vertices = tri_vertices.rows();
+    std::vector<int> vertex_map(num_tri_vertices);
+    for (size_t i=0; i<num_tri_vertices; i++) {
+        if (i < num_cap_vertices) {
+            vertex_map[i] = cap_vertices[i];
+        } else {
+            Vector3F p;
+            p[axis] = value;
+            p[u] = tri_vertices(i, 0);
+            p[v] = tri_vertices(i, 1);
+            vertex_map[i] = m_vertices.size();
+            m_vertices.push_back(p);
+        }
+    }
+
+    for (size_t i=0; i<num_tri_faces; i++) {
+        auto itr = region_is_inside.find(regions[i]);
+        if (itr == region_is_inside.end() || !itr->second) continue;
+        Vector3I f(
+                vertex_map[tri_faces(i, 0)],
+                vertex_map[tri_faces(i, 1)],
+                vertex_map[tri_faces(i, 2)]);
+        if (sign < 0) std::swap(f[1], f[2]);
+        m_faces.push_back(f);
+        m_face_sources.push_back(-1);
+    }
+}
+
+void BoxClipper::remove_isolated_vertices() {
+    const size_t num_vertices = m_vertices.size();
+    std::vector<int> index_map(num_vertices, -1);
+    for (const auto& f : m_faces) {
+        index_map[f[0]] = 0;
+        index_map[f[1]] = 0;
+        index_map[f[2]] = 0;
+    }
+
+    size_t count = 0;
+    for (size_t i=0; i<num_vertices; i++) {
+        if (index_map[i] < 0) continue;
+        index_map[i] = count;
+        m_vertices[count] = m_vertices[i];
+        count++;
+    }
+    m_vertices.resize(count);
+
+    for (auto& f : m_faces) {
+        f[0] = index_map[f[0]];
+        f[1] = index_map[f[1]];
+        f[2] = index_map[f[2]];
+    }
+}
@@ -0,0 +1,53 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+
+namespace PyMesh {
+
+/**
+ * Clip a closed, outward oriented triangle mesh against an axis-aligned box.
+ *
+ * The mesh is cut by the 6 box planes one at a time.  Each cut reuses a
+ * single vertex per intersected edge and closes the resulting holes with cap
+ * faces lying on the plane, so the output stays watertight.  Vertices within
+ * tolerance of a plane are snapped onto it, i.e. boundary vertices lie
+ * exactly on the box.
+ */
+class BoxClipper {
+    public:
+        BoxClipper(const VectorF& bbox_min, const VectorF& bbox_max);
+
+    public:
+        void set_tolerance(Float tol) { m_tol = tol; }
+
+        void run(const MatrixFr& vertices, const MatrixIr& faces);
+
+        MatrixFr get_vertices() const;
+        MatrixIr get_faces() const;
+
+        /**
+         * Index of the input face each output face is cut from, or -1 for
+         * cap faces on the box boundary.
+         */
+        VectorI get_face_sources() const;
+
+    private:
+        void clip(size_t axis, Float value, Float sign);
+        void cap(size_t axis, Float value, Float sign,
+                const std::vector<int>& bd_edges);
+        void remove_isolated_vertices();
+
+    private:
+        VectorF m_bbox_min;
+        VectorF m_bbox_max;
+        Float m_tol;
+
+        std::vector<Vector3F> m_vertices;
+        std::vector<Vector3I> m_faces;
+        std::vector<int> m_face_sources;
+};
+
+}
@@ -13,14 +13,20 @@
 
 using namespace PyMesh;
 
-void MeshCleaner::clean(MatrixFr& vertices, MatrixIr& faces, Float tol) {
+VectorI MeshCleaner::clean(MatrixFr& vertices, MatrixIr& faces, Float tol) {
     remove_isolated_vertices(vertices, faces);
     remove_duplicated_vertices(vertices, faces, tol);
-    remove_fin_faces(vertices, faces);
-    VectorI face_sources = remove_short_edges(vertices, faces, tol);
-    remove_obtuse_triangle(vertices, faces);
+    VectorI face_sources = remove_fin_faces(vertices, faces);
+    VectorI short_edge_sources = remove_short_edges(vertices, faces, tol);
+    VectorI obtuse_sources = remove_obtuse_triangle(vertices, faces);
     remove_isolated_vertices(vertices, faces);
-    //return face_sources;
+
+    const size_t num_faces = faces.rows();
+    VectorI result(num_faces);
+    for (size_t i=0; i<num_faces; i++) {
+        result[i] = face_sources[short_edge_sources[obtuse_sources[i]]];
+    }
+    return result;
 }
 
 VectorI MeshCleaner::compute_importance_level(const MatrixFr& vertices) {
@@ -73,18 +79,20 @@ void MeshCleaner::remove_isolated_vertices(
     faces = remover.get_faces();
 }
 
-void MeshCleaner::remove_obtuse_triangle(MatrixFr& vertices, MatrixIr& faces) {
+VectorI MeshCleaner::remove_obtuse_triangle(MatrixFr& vertices, MatrixIr& faces) {
     ObtuseTriangleRemoval remover(vertices, faces);
     remover.run(M_PI - 1e-3);
     vertices = remover.get_vertices();
     faces = remover.get_faces();
+    return remover.get_face_indices();
 }
 
-void MeshCleaner::remove_fin_faces(MatrixFr& vertices, MatrixIr& faces) {
+VectorI MeshCleaner::remove_fin_faces(MatrixFr& vertices, MatrixIr& faces) {
     FinFaceRemoval remover(vertices, faces);
     size_t num_face_removed = remover.run();
     if (num_face_removed > 0) {
         faces = remover.get_faces();
     }
+    return remover.get_face_indices();
 }
 
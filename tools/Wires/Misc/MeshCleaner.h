@@ -7,14 +7,18 @@ namespace PyMesh {
 
 class MeshCleaner {
     public:
-        void clean(MatrixFr& vertices, MatrixIr& faces, Float tol);
+        /**
+         * Returns the index of the input face each output face originates
+         * from.
+         */
+        VectorI clean(MatrixFr& vertices, MatrixIr& faces, Float tol);
 
         VectorI compute_importance_level(const MatrixFr& vertices);
         void remove_duplicated_vertices(MatrixFr& vertices, MatrixIr& faces, Float tol);
         VectorI remove_short_edges(MatrixFr& vertices, MatrixIr& faces, Float tol);
         void remove_isolated_vertices(MatrixFr& vertices, MatrixIr& faces);
-        void remove_obtuse_triangle(MatrixFr& vertices, MatrixIr& faces);
-        void remove_fin_faces(MatrixFr& vertices, MatrixIr& faces);
+        VectorI remove_obtuse_triangle(MatrixFr& vertices, MatrixIr& faces);
+        VectorI remove_fin_faces(MatrixFr& vertices, MatrixIr& faces);
 };
 
 }
@@ -12,7 +12,7 @@ class EdgeThicknessParameter : public PatternParameter {
         virtual ~EdgeThicknessParameter() {}
 
     public:
-        virtual void apply(VectorF& results, const Variables& vars);
+        virtual void apply_value(VectorF& results, Float value) const;
         virtual MatrixFr compute_derivative() const;
         virtual ParameterType get_type() const { return EDGE_THICKNESS; }
 };
@@ -23,21 +23,26 @@ MatrixFr EdgeThicknessParameterDerivative::compute() {
         in_roi[roi[i]] = true;
     }
 
+    const MatrixIr& faces = m_data->faces;
+    const MatrixFr& face_normals = m_data->face_normals;
+    const MatrixFr& face_voronoi_areas = m_data->face_voronoi_areas;
+    const VectorI&  face_source = m_data->face_source;
+
     MatrixFr derivative_v = MatrixFr::Zero(num_mesh_vertices, dim);
     VectorF weights = VectorF::Zero(num_mesh_vertices);
 
     for (size_t i=0; i<num_mesh_faces; i++) {
-        const VectorI  face = m_mesh->get_face(i);
-        const VectorF& normal = m_face_normals.row(i);
-        int source = m_face_source[i];
+        int source = face_source[i];
         if (source < 0) {
             // Source is edge
             size_t edge_idx = -source - 1;
             assert(edge_idx >= 0 && edge_idx < num_wire_edges);
             if (in_roi[edge_idx]) {
-                Float w0 = m_face_voronoi_areas(i, 0);
-                Float w1 = m_face_voronoi_areas(i, 1);
-                Float w2 = m_face_voronoi_areas(i, 2);
+                const Vector3I& face = faces.row(i);
+                const VectorF& normal = face_normals.row(i);
+                Float w0 = face_voronoi_areas(i, 0);
+                Float w1 = face_voronoi_areas(i, 1);
+                Float w2 = face_voronoi_areas(i, 2);
 
                 derivative_v.row(face[0]) += w0 * normal.transpose();
                 derivative_v.row(face[1]) += w1 * normal.transpose();
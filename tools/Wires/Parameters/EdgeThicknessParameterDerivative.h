@@ -10,6 +10,10 @@ class EdgeThicknessParameterDerivative : public ParameterDerivative {
         EdgeThicknessParameterDerivative(
                 Mesh::Ptr mesh, PatternParameter::Ptr param)
             : ParameterDerivative(mesh, param) { }
+        EdgeThicknessParameterDerivative(
+                Mesh::Ptr mesh, PatternParameter::Ptr param,
+                MeshData::Ptr data)
+            : ParameterDerivative(mesh, param, data) {}
 
         virtual ~EdgeThicknessParameterDerivative() {}
 
@@ -0,0 +1,397 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#include "Formula.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#include <tbb/tbb.h>
+
+#include <Core/Exception.h>
+
+using namespace PyMesh;
+
+namespace FormulaHelper {
+    struct FunctionInfo {
+        const char* name;
+        Formula::OpCode op;
+        size_t arity;
+    };
+
+    const FunctionInfo functions[] = {
+        {"sin",   Formula::SIN,   1},
+        {"cos",   Formula::COS,   1},
+        {"tan",   Formula::TAN,   1},
+        {"asin",  Formula::ASIN,  1},
+        {"acos",  Formula::ACOS,  1},
+        {"atan",  Formula::ATAN,  1},
+        {"exp",   Formula::EXP,   1},
+        {"log",   Formula::LOG,   1},
+        {"sqrt",  Formula::SQRT,  1},
+        {"abs",   Formula::ABS,   1},
+        {"floor", Formula::FLOOR, 1},
+        {"ceil",  Formula::CEIL,  1},
+        {"min",   Formula::MIN,   2},
+        {"max",   Formula::MAX,   2},
+        {"pow",   Formula::POW,   2},
+        {"atan2", Formula::ATAN2, 2},
+        {"clamp", Formula::CLAMP, 3}
+    };
+
+    size_t get_arity(Formula::OpCode op) {
+        switch (op) {
+            case Formula::CONST:
+            case Formula::LOAD:
+                return 0;
+            case Formula::ADD:
+            case Formula::SUB:
+            case Formula::MUL:
+            case Formula::DIV:
+            case Formula::POW:
+            case Formula::MIN:
+            case Formula::MAX:
+            case Formula::ATAN2:
+                return 2;
+            case Formula::CLAMP:
+                return 3;
+            default:
+                return 1;
+        }
+    }
+
+    inline Float apply_op(Formula::OpCode op, const Float* args) {
+        switch (op) {
+            case Formula::NEG:   return -args[0];
+            case Formula::ADD:   return args[0] + args[1];
+            case Formula::SUB:   return args[0] - args[1];
+            case Formula::MUL:   return args[0] * args[1];
+            case Formula::DIV:   return args[0] / args[1];
+            case Formula::POW:   return pow(args[0], args[1]);
+            case Formula::SIN:   return sin(args[0]);
+            case Formula::COS:   return cos(args[0]);
+            case Formula::TAN:   return tan(args[0]);
+            case Formula::ASIN:  return asin(args[0]);
+            case Formula::ACOS:  return acos(args[0]);
+            case Formula::ATAN:  return atan(args[0]);
+            case Formula::EXP:   return exp(args[0]);
+            case Formula::LOG:   return log(args[0]);
+            case Formula::SQRT:  return sqrt(args[0]);
+            case Formula::ABS:   return fabs(args[0]);
+            case Formula::FLOOR: return floor(args[0]);
+            case Formula::CEIL:  return ceil(args[0]);
+            case Formula::MIN:   return std::min(args[0], args[1]);
+            case Formula::MAX:   return std::max(args[0], args[1]);
+            case Formula::ATAN2: return atan2(args[0], args[1]);
+            case Formula::CLAMP:
+                return std::min(std::max(args[0], args[1]), args[2]);
+            default:
+                throw NotImplementedError("Unknown formula op code");
+        }
+    }
+}
+
+using namespace FormulaHelper;
+
+/**
+ * Recursive descent parser emitting postfix code:
+ *
+ *   expression := term (('+' | '-') term)*
+ *   term       := unary (('*' | '/') unary)*
+ *   unary      := ('-' | '+') unary | power
+ *   power      := primary ('^' unary)?
+ *   primary    := number | name | name '(' arguments ')' | '(' expression ')'
+ */
+class Formula::Parser {
+    public:
+        Parser(Formula& formula) :
+            m_formula(formula), m_text(formula.m_expression),
+            m_pos(0), m_depth(0) {}
+
+        void parse() {
+            parse_expression();
+            skip_spaces();
+            if (m_pos != m_text.size()) {
+                error("unexpected character");
+            }
+            assert(m_depth == 1);
+        }
+
+    private:
+        void parse_expression() {
+            parse_term();
+            while (true) {
+                skip_spaces();
+                if (peek() == '+') {
+                    m_pos++;
+                    parse_term();
+                    emit(ADD);
+                } else if (peek() == '-') {
+                    m_pos++;
+                    parse_term();
+                    emit(SUB);
+                } else {
+                    break;
+                }
+            }
+        }
+
+        void parse_term() {
+            parse_unary();
+            while (true) {
+                skip_spaces();
+                if (peek() == '*') {
+                    m_pos++;
+                    parse_unary();
+                    emit(MUL);
+                } else if (peek() == '/') {
+                    m_pos++;
+                    parse_unary();
+                    emit(DIV);
+                } else {
+                    break;
+                }
+            }
+        }
+
+        void parse_unary() {
+            skip_spaces();
+            if (peek() == '-') {
+                m_pos++;
+                parse_unary();
+                emit(NEG);
+            } else if (peek() == '+') {
+                m_pos++;
+                parse_unary();
+            } else {
+                parse_power();
+            }
+        }
+
+        void parse_power() {
+            parse_primary();
+            skip_spaces();
+            if (peek() == '^') {
+                m_pos++;
+                parse_unary();
+                emit(POW);
+            }
+        }
+
+        void parse_primary() {
+            skip_spaces();
+            const char c = peek();
+            if (c == '(') {
+                m_pos++;
+                parse_expression();
+                expect(')');
+            } else if (isdigit(c) || c == '.') {
+                const char* begin = m_text.c_str() + m_pos;
+                char* end = nullptr;
+                Float value = strtod(begin, &end);
+                if (end == begin) error("invalid number");
+                m_pos += end - begin;
+                emit(CONST, value);
+            } else if (isalpha(c) || c == '_') {
+                std::string name = parse_name();
+                skip_spaces();
+                if (peek() == '(') {
+                    m_pos++;
+                    parse_function(name);
+                } else if (name == "pi") {
+                    emit(CONST, M_PI);
+                } else {
+                    emit(LOAD, 0.0, get_variable_index(name));
+                }
+            } else {
+                error("expecting a number, a name or '('");
+            }
+        }
+
+        void parse_function(const std::string& name) {
+            const FunctionInfo* info = nullptr;
+            for (const auto& f : functions) {
+                if (name == f.name) { info = &f; break; }
+            }
+            if (info == nullptr) {
+                error("unknown function \"" + name + "\"");
+            }
+
+            size_t num_args = 0;
+            skip_spaces();
+            if (peek() != ')') {
+                parse_expression();
+                num_args++;
+                skip_spaces();
+                while (peek() == ',') {
+                    m_pos++;
+                    parse_expression();
+                    num_args++;
+                    skip_spaces();
+                }
+            }
+            expect(')');
+
+            if (num_args != info->arity) {
+                std::stringstream err_msg;
+                err_msg << "function \"" << name << "\" expects "
+                    << info->arity << " argument(s), got " << num_args;
+                error(err_msg.str());
+            }
+            emit(info->op);
+        }
+
+        std::string parse_name() {
+            const size_t begin = m_pos;
+            while (m_pos < m_text.size() &&
+                    (isalnum(m_text[m_pos]) || m_text[m_pos] == '_')) {
+                m_pos++;
+            }
+            return m_text.substr(begin, m_pos - begin);
+        }
+
+        int get_variable_index(const std::string& name) {
+            auto& variables = m_formula.m_variables;
+            auto itr = std::find(variables.begin(), variables.end(), name);
+            if (itr != variables.end()) return itr - variables.begin();
+            variables.push_back(name);
+            return variables.size() - 1;
+        }
+
+        /**
+         * Append an instruction.  Operations whose operands are all
+         * constants are folded right away.
+         */
+        void emit(OpCode op, Float value=0.0, int index=0) {
+            auto& code = m_formula.m_code;
+            const size_t arity = get_arity(op);
+            m_depth = m_depth + 1 - arity;
+            if (m_depth > MAX_STACK_DEPTH) {
+                error("expression is nested too deeply");
+            }
+
+            if (arity > 0 && code.size() >= arity &&
+                    std::all_of(code.end() - arity, code.end(),
+                        [](const Instruction& instr) {
+                        return instr.op == CONST; })) {
+                Float args[3];
+                for (size_t i=0; i<arity; i++) {
+                    args[i] = code[code.size() - arity + i].value;
+                }
+                code.resize(code.size() - arity);
+                code.push_back({CONST, apply_op(op, args), 0});
+            } else {
+                code.push_back({op, value, index});
+            }
+        }
+
+        void skip_spaces() {
+            while (m_pos < m_text.size() && isspace(m_text[m_pos])) m_pos++;
+        }
+
+        char peek() const {
+            return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+        }
+
+        void expect(char c) {
+            skip_spaces();
+            if (peek() != c) {
+                error(std::string("expecting '") + c + "'");
+            }
+            m_pos++;
+        }
+
+        void error(const std::string& msg) const {
+            std::stringstream err_msg;
+            err_msg << "Invalid formula \"" << m_text << "\": " << msg
+                << " at position " << m_pos;
+            throw RuntimeError(err_msg.str());
+        }
+
+    private:
+        Formula& m_formula;
+        const std::string& m_text;
+        size_t m_pos;
+        size_t m_depth;
+};
+
+Formula::Formula(const std::string& expression) : m_expression(expression) {
+    Parser parser(*this);
+    parser.parse();
+}
+
+Float Formula::evaluate(const Formula::Variables& vars) const {
+    const size_t num_vars = m_variables.size();
+    std::vector<Float> values(num_vars);
+    for (size_t i=0; i<num_vars; i++) {
+        auto itr = vars.find(m_variables[i]);
+        if (itr == vars.end()) {
+            std::stringstream err_msg;
+            err_msg << "Cannot apply formula: " << m_expression
+                << ", variable \"" << m_variables[i] << "\" is undefined";
+            throw RuntimeError(err_msg.str());
+        }
+        values[i] = itr->second;
+    }
+    return evaluate(values.data());
+}
+
+Float Formula::evaluate(const Float* values) const {
+    if (m_code.empty()) {
+        throw RuntimeError("Cannot evaluate empty formula");
+    }
+
+    Float stack[MAX_STACK_DEPTH];
+    size_t top = 0;
+    for (const auto& instr : m_code) {
+        switch (instr.op) {
+            case CONST:
+                stack[top++] = instr.value;
+                break;
+            case LOAD:
+                stack[top++] = values[instr.index];
+                break;
+            default:
+                {
+                    top -= get_arity(instr.op);
+                    stack[top] = apply_op(instr.op, stack + top);
+                    top++;
+                }
+        }
+    }
+    assert(top == 1);
+    return stack[0];
+}
+
+VectorF Formula::evaluate_batch(const std::vector<std::string>& names,
+        const MatrixFr& values) const {
+    assert(size_t(values.cols()) == names.size());
+    const size_t num_vars = m_variables.size();
+    std::vector<size_t> columns(num_vars);
+    for (size_t i=0; i<num_vars; i++) {
+        auto itr = std::find(names.begin(), names.end(), m_variables[i]);
+        if (itr == names.end()) {
+            std::stringstream err_msg;
+            err_msg << "Cannot apply formula: " << m_expression
+                << ", variable \"" << m_variables[i] << "\" is undefined";
+            throw RuntimeError(err_msg.str());
+        }
+        columns[i] = itr - names.begin();
+    }
+
+    const size_t num_rows = values.rows();
+    VectorF results(num_rows);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                std::vector<Float> row_values(num_vars);
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    for (size_t j=0; j<num_vars; j++) {
+                        row_values[j] = values(i, columns[j]);
+                    }
+                    results[i] = evaluate(row_values.data());
+                }
+            });
+    return results;
+}
@@ -0,0 +1,86 @@
+/* This file is part of PyMesh. Copyright (c) 2018 by Qingnan Zhou */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Core/EigenTypedef.h>
+
+#include "ParameterCommon.h"
+
+namespace PyMesh {
+
+/**
+ * Arithmetic expression over named variables, compiled once into a compact
+ * stack bytecode.
+ *
+ * Syntax:
+ *   numbers, variable names, pi
+ *   + - * / ^ (power), unary -, parentheses
+ *   sin cos tan asin acos atan exp log sqrt abs floor ceil
+ *   min(a, b) max(a, b) pow(a, b) atan2(a, b) clamp(x, lo, hi)
+ *
+ * A formula consisting of a single variable name evaluates to the value of
+ * that variable, which is how parameter formulas used to be interpreted.
+ *
+ * Evaluation does not modify the formula, so one instance can be shared by
+ * many threads.
+ */
+class Formula {
+    public:
+        typedef ParameterCommon::Variables Variables;
+
+    public:
+        Formula() {}
+        explicit Formula(const std::string& expression);
+
+    public:
+        bool is_empty() const { return m_code.empty(); }
+        const std::string& get_expression() const { return m_expression; }
+
+        /**
+         * Variables referenced by the formula, in the order expected by
+         * evaluate(const Float*).
+         */
+        const std::vector<std::string>& get_variable_names() const {
+            return m_variables;
+        }
+
+        Float evaluate(const Variables& vars) const;
+
+        /**
+         * values[i] is the value of get_variable_names()[i].
+         */
+        Float evaluate(const Float* values) const;
+
+        /**
+         * Evaluate once per row of values.  names[j] is the name of column j.
+         * Rows are evaluated in parallel.
+         */
+        VectorF evaluate_batch(const std::vector<std::string>& names,
+                const MatrixFr& values) const;
+
+    public:
+        enum OpCode {
+            CONST, LOAD, NEG, ADD, SUB, MUL, DIV, POW,
+            SIN, COS, TAN, ASIN, ACOS, ATAN, EXP, LOG, SQRT, ABS, FLOOR, CEIL,
+            MIN, MAX, ATAN2, CLAMP
+        };
+
+        struct Instruction {
+            OpCode op;
+            Float value;
+            int index;
+        };
+
+        static const size_t MAX_STACK_DEPTH = 64;
+
+    private:
+        class Parser;
+
+        std::string m_expression;
+        std::vector<Instruction> m_code;
+        std::vector<std::string> m_variables;
+};
+
+}
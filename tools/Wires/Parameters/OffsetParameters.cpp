@@ -3,6 +3,8 @@
 #include <iostream>
 #include <cassert>
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 
 #include "VertexOffsetParameter.h"
@@ -93,3 +95,32 @@ MatrixFr OffsetParameters::evaluate(const OffsetParameters::Variables& vars) {
     MatrixFr results = Eigen::Map<MatrixFr>(offset.data(), size, dim);
     return results;
 }
+
+MatrixFr OffsetParameters::evaluate_batch(
+        const std::vector<std::string>& names, const MatrixFr& values) const {
+    const size_t dim = m_wire_network->get_dim();
+    const size_t size = m_wire_network->get_num_vertices();
+
+    std::vector<VectorF> param_values;
+    for (const auto& param : m_params) {
+        param_values.push_back(param->evaluate_batch(names, values));
+    }
+
+    const size_t num_rows = values.rows();
+    MatrixFr results(num_rows * size, dim);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                VectorF offset(size * dim);
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    offset.setConstant(m_default_offset);
+                    size_t count = 0;
+                    for (const auto& param : m_params) {
+                        param->apply_value(offset, param_values[count][i]);
+                        count++;
+                    }
+                    results.block(i * size, 0, size, dim) =
+                        Eigen::Map<MatrixFr>(offset.data(), size, dim);
+                }
+            });
+    return results;
+}
@@ -2,6 +2,7 @@
 #pragma once
 #include <list>
 #include <string>
+#include <vector>
 
 #include <Wires/WireNetwork/WireNetwork.h>
 
@@ -30,6 +31,14 @@ class OffsetParameters : public ParameterList {
 
         MatrixFr evaluate(const Variables& vars);
 
+        /**
+         * Evaluate offsets for each row of values, whose columns are named by
+         * names.  Offsets of row i occupy rows [i*n, (i+1)*n) of the result,
+         * where n is the number of wire vertices.
+         */
+        MatrixFr evaluate_batch(const std::vector<std::string>& names,
+                const MatrixFr& values) const;
+
         Float get_default() const { return m_default_offset; }
         void set_default(Float value) { m_default_offset = value; }
 
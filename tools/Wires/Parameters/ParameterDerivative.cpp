@@ -1,58 +1,120 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "ParameterDerivative.h"
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 
 using namespace PyMesh;
 
-ParameterDerivative::ParameterDerivative(Mesh::Ptr mesh, PatternParameter::Ptr param)
-    : m_mesh(mesh), m_parameter(param) {
-        initialize_wires();
-        initialize_mesh();
-        initialize_normals();
-        initialize_face_voronoi_areas();
+namespace ParameterDerivativeHelper {
+    Float compute_projection_ratio(
+            const VectorF& p, const VectorF& end_0, const VectorF& end_1) {
+        VectorF v0 = end_1 - end_0;
+        VectorF v1 = p - end_0;
+        return v1.dot(v0) / v0.squaredNorm();
     }
 
-void ParameterDerivative::initialize_wires()  {
-    WireNetwork::Ptr wire_network = m_parameter->get_wire_network();
-    if (!wire_network->with_connectivity()) {
-        wire_network->compute_connectivity();
+    void initialize_wires(WireNetwork::Ptr wire_network) {
+        if (!wire_network->with_connectivity()) {
+            wire_network->compute_connectivity();
+        }
     }
-}
 
-void ParameterDerivative::initialize_mesh() {
-    assert(m_mesh->get_vertex_per_face() == 3);
-    if (!m_mesh->has_float_attribute("face_voronoi_area")) {
-        m_mesh->add_float_attribute("face_voronoi_area");
-    }
+    void initialize_mesh(Mesh::Ptr mesh, ParameterDerivative::MeshData& data) {
+        assert(mesh->get_vertex_per_face() == 3);
+        if (!mesh->has_float_attribute("face_voronoi_area")) {
+            mesh->add_float_attribute("face_voronoi_area");
+        }
+
+        if (!mesh->has_int_attribute("face_source")) {
+            throw RuntimeError("Mesh does not have face source attribute");
+        }
+        data.face_source = mesh->get_int_attribute("face_source");
 
-    if (!m_mesh->has_int_attribute("face_source")) {
-        throw RuntimeError("Mesh does not have face source attribute");
+        const size_t num_faces = mesh->get_num_faces();
+        const VectorI& faces = mesh->get_faces();
+        data.faces.resize(num_faces, 3);
+        std::copy(faces.data(), faces.data() + faces.size(),
+                data.faces.data());
     }
-    m_face_source = m_mesh->get_int_attribute("face_source");
-}
 
-void ParameterDerivative::initialize_normals() {
-    const size_t dim = m_mesh->get_dim();
-    if (dim == 2) {
-        throw NotImplementedError("2D is not supported yet");
-    } else {
-        if (!m_mesh->has_float_attribute("face_normal")) {
-            m_mesh->add_float_attribute("face_normal");
+    void initialize_normals(Mesh::Ptr mesh, ParameterDerivative::MeshData& data) {
+        const size_t dim = mesh->get_dim();
+        if (dim == 2) {
+            throw NotImplementedError("2D is not supported yet");
+        } else {
+            if (!mesh->has_float_attribute("face_normal")) {
+                mesh->add_float_attribute("face_normal");
+            }
+            const VectorF& face_normals = mesh->get_float_attribute("face_normal");
+            data.face_normals.resize(mesh->get_num_faces(), dim);
+            std::copy(face_normals.data(), face_normals.data() + face_normals.size(),
+                    data.face_normals.data());
         }
-        VectorF face_normals = m_mesh->get_float_attribute("face_normal");
-        m_face_normals.resize(m_mesh->get_num_faces(), dim);
-        std::copy(face_normals.data(), face_normals.data() + face_normals.size(),
-                m_face_normals.data());
+    }
+
+    void initialize_face_voronoi_areas(Mesh::Ptr mesh,
+            ParameterDerivative::MeshData& data) {
+        const VectorF& face_voronoi_area =
+            mesh->get_float_attribute("face_voronoi_area");
+        data.face_voronoi_areas.resize(mesh->get_num_faces(),
+                mesh->get_vertex_per_face());
+        std::copy(face_voronoi_area.data(),
+                face_voronoi_area.data() + face_voronoi_area.size(),
+                data.face_voronoi_areas.data());
+    }
+
+    void initialize_face_edge_ratios(Mesh::Ptr mesh,
+            WireNetwork::Ptr wire_network,
+            ParameterDerivative::MeshData& data) {
+        const Float eps = 1e-3;
+        const size_t num_faces = mesh->get_num_faces();
+        const size_t num_wire_edges = wire_network->get_num_edges();
+        const MatrixFr& wire_vertices = wire_network->get_vertices();
+        const MatrixIr& wire_edges = wire_network->get_edges();
+
+        data.face_edge_ratios = MatrixFr::Zero(num_faces, 3);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_faces),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        const int source = data.face_source[i];
+                        if (source >= 0) continue;
+                        const size_t edge_idx = -source - 1;
+                        assert(edge_idx < num_wire_edges);
+
+                        const Vector2I& edge = wire_edges.row(edge_idx);
+                        const VectorF& v0 = wire_vertices.row(edge[0]);
+                        const VectorF& v1 = wire_vertices.row(edge[1]);
+                        for (size_t j=0; j<3; j++) {
+                            const VectorF c = mesh->get_vertex(data.faces(i, j));
+                            const Float loc = compute_projection_ratio(c, v0, v1);
+                            assert(loc >= -eps && loc <= 1.0 + eps);
+                            data.face_edge_ratios(i, j) = loc;
+                        }
+                    }
+                });
     }
 }
 
-void ParameterDerivative::initialize_face_voronoi_areas() {
-    VectorF face_voronoi_area = m_mesh->get_float_attribute("face_voronoi_area");
-    m_face_voronoi_areas.resize(m_mesh->get_num_faces(),
-            m_mesh->get_vertex_per_face());
-    std::copy(face_voronoi_area.data(),
-            face_voronoi_area.data() + face_voronoi_area.size(),
-            m_face_voronoi_areas.data());
+using namespace ParameterDerivativeHelper;
+
+ParameterDerivative::MeshData::Ptr ParameterDerivative::precompute(
+        Mesh::Ptr mesh, WireNetwork::Ptr wire_network) {
+    MeshData::Ptr data = std::make_shared<MeshData>();
+    initialize_wires(wire_network);
+    initialize_mesh(mesh, *data);
+    initialize_normals(mesh, *data);
+    initialize_face_voronoi_areas(mesh, *data);
+    initialize_face_edge_ratios(mesh, wire_network, *data);
+    return data;
 }
 
+ParameterDerivative::ParameterDerivative(Mesh::Ptr mesh, PatternParameter::Ptr param)
+    : m_mesh(mesh), m_parameter(param) {
+        m_data = precompute(mesh, param->get_wire_network());
+    }
+
+ParameterDerivative::ParameterDerivative(Mesh::Ptr mesh,
+        PatternParameter::Ptr param, MeshData::Ptr data)
+    : m_mesh(mesh), m_parameter(param), m_data(data) { }
@@ -6,6 +6,7 @@
 
 #include <Mesh.h>
 #include <Core/Exception.h>
+#include <Wires/WireNetwork/WireNetwork.h>
 #include "PatternParameter.h"
 
 namespace PyMesh {
@@ -14,8 +15,34 @@ class ParameterDerivative {
     public:
         typedef std::shared_ptr<ParameterDerivative> Ptr;
 
+        /**
+         * Per-face quantities of the inflated mesh that do not depend on the
+         * parameter.  They are computed once and shared by the derivatives
+         * of all parameters.
+         */
+        struct MeshData {
+            typedef std::shared_ptr<MeshData> Ptr;
+
+            MatrixIr faces;
+            VectorI  face_source;
+            MatrixFr face_normals;
+            MatrixFr face_voronoi_areas;
+
+            /**
+             * Projection of each face corner onto the source wire edge of
+             * the face, as a ratio along the edge.  Only meaningful for
+             * faces generated from an edge.
+             */
+            MatrixFr face_edge_ratios;
+        };
+
+        static MeshData::Ptr precompute(
+                Mesh::Ptr mesh, WireNetwork::Ptr wire_network);
+
     public:
         ParameterDerivative(Mesh::Ptr mesh, PatternParameter::Ptr param);
+        ParameterDerivative(Mesh::Ptr mesh, PatternParameter::Ptr param,
+                MeshData::Ptr data);
         virtual ~ParameterDerivative() {}
 
         /**
@@ -23,21 +50,16 @@ class ParameterDerivative {
          * change in the parameter.  The output is a "#v x dim" matrix where #v
          * is the numver of vertices, and dim is the dimention of the embedding
          * space.
+         *
+         * The mesh and the shared data are only read, so derivatives of
+         * different parameters can be computed concurrently.
          */
         virtual MatrixFr compute()=0;
 
-    protected:
-        void initialize_wires();
-        void initialize_mesh();
-        void initialize_normals();
-        void initialize_face_voronoi_areas();
-
     protected:
         Mesh::Ptr m_mesh;
         PatternParameter::Ptr m_parameter;
-        VectorI m_face_source;
-        MatrixFr m_face_normals;
-        MatrixFr m_face_voronoi_areas;
+        MeshData::Ptr m_data;
 };
 
 }
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 
 #include "EdgeThicknessParameterDerivative.h"
@@ -357,30 +359,57 @@ void ParameterManager::set_dofs(const VectorF& values) {
 }
 
 std::vector<MatrixFr> ParameterManager::compute_shape_velocity(Mesh::Ptr mesh) {
-    std::vector<MatrixFr> velocity;
+    const size_t num_dofs = get_num_dofs();
+    const size_t num_vertices = mesh->get_num_vertices();
+    const MatrixFr velocity_tensor = compute_shape_velocity_tensor(mesh);
+
+    std::vector<MatrixFr> velocity(num_dofs);
+    for (size_t i=0; i<num_dofs; i++) {
+        velocity[i] = velocity_tensor.block(i*num_vertices, 0,
+                num_vertices, velocity_tensor.cols());
+    }
+    return velocity;
+}
+
+MatrixFr ParameterManager::compute_shape_velocity_tensor(Mesh::Ptr mesh) {
+    ParameterDerivative::MeshData::Ptr data =
+        ParameterDerivative::precompute(mesh, m_wire_network);
+
+    std::vector<ParameterDerivative::Ptr> derivatives;
     for (auto param : m_thickness_params) {
         ParameterDerivative::Ptr param_derivative;
         if (param->get_type() == PatternParameter::VERTEX_THICKNESS) {
             param_derivative = std::make_shared<
-                VertexThicknessParameterDerivative>(mesh, param);
+                VertexThicknessParameterDerivative>(mesh, param, data);
         } else if (param->get_type() == PatternParameter::EDGE_THICKNESS) {
             param_derivative = std::make_shared<
-                EdgeThicknessParameterDerivative>(mesh, param);
+                EdgeThicknessParameterDerivative>(mesh, param, data);
         } else {
             assert(false);
         }
-        velocity.push_back(param_derivative->compute());
+        derivatives.push_back(param_derivative);
     }
 
     for (auto param : m_offset_params) {
         ParameterDerivative::Ptr param_derivative;
         assert(param->get_type() == PatternParameter::VERTEX_OFFSET);
-        param_derivative =
-            std::make_shared<VertexOffsetParameterDerivative>(mesh, param);
-        velocity.push_back(param_derivative->compute());
-    }
-    assert(velocity.size() == get_num_dofs());
-
+        param_derivative = std::make_shared<
+            VertexOffsetParameterDerivative>(mesh, param, data);
+        derivatives.push_back(param_derivative);
+    }
+    assert(derivatives.size() == get_num_dofs());
+
+    const size_t num_dofs = derivatives.size();
+    const size_t num_vertices = mesh->get_num_vertices();
+    const size_t dim = mesh->get_dim();
+    MatrixFr velocity(num_dofs * num_vertices, dim);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_dofs),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    velocity.block(i*num_vertices, 0, num_vertices, dim) =
+                        derivatives[i]->compute();
+                }
+            });
     return velocity;
 }
 
@@ -561,6 +590,16 @@ MatrixFr ParameterManager::evaluate_offset(
     return m_offset_params.evaluate(vars);
 }
 
+VectorF ParameterManager::evaluate_thickness_batch(
+        const std::vector<std::string>& names, const MatrixFr& values) const {
+    return m_thickness_params.evaluate_batch(names, values);
+}
+
+MatrixFr ParameterManager::evaluate_offset_batch(
+        const std::vector<std::string>& names, const MatrixFr& values) const {
+    return m_offset_params.evaluate_batch(names, values);
+}
+
 void ParameterManager::set_thickness_type(
         ParameterManager::TargetType type) {
     Float default_thickness = m_thickness_params.get_default();
@@ -107,6 +107,10 @@ class ParameterManager {
         VectorF get_dofs() const;
         void set_dofs(const VectorF& values);
         std::vector<MatrixFr> compute_shape_velocity(Mesh::Ptr mesh);
+        // Shape velocities of all dofs stacked into a single
+        // (#dofs * #v) x dim matrix; rows [i*#v, (i+1)*#v) belong to dof i.
+        // Dofs are computed in parallel.
+        MatrixFr compute_shape_velocity_tensor(Mesh::Ptr mesh);
         MatrixFr compute_wire_gradient(size_t i) const;
         VectorI get_thickness_dof_map() const;
         MatrixIr get_offset_dof_map() const;
@@ -122,6 +126,17 @@ class ParameterManager {
         MatrixFr evaluate_offset_no_formula();
         MatrixFr evaluate_offset(const Variables& vars);
 
+        // Batch versions of the above, one evaluation per row of values.
+        // Columns of values are named by names.  See
+        // ThicknessParameters::evaluate_batch and
+        // OffsetParameters::evaluate_batch for the output layout.
+        VectorF evaluate_thickness_batch(
+                const std::vector<std::string>& names,
+                const MatrixFr& values) const;
+        MatrixFr evaluate_offset_batch(
+                const std::vector<std::string>& names,
+                const MatrixFr& values) const;
+
         // The following methods are used for adding parameters in code.
         TargetType get_thickness_type() const {
             return m_thickness_params.get_type();
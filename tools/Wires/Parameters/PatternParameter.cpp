@@ -1,17 +1,18 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "PatternParameter.h"
-#include <sstream>
-#include <Core/Exception.h>
 
 using namespace PyMesh;
 
+VectorF PatternParameter::evaluate_batch(
+        const std::vector<std::string>& names, const MatrixFr& values) const {
+    if (m_compiled_formula.is_empty()) {
+        return VectorF::Constant(values.rows(), m_value);
+    } else {
+        return m_compiled_formula.evaluate_batch(names, values);
+    }
+}
+
 void PatternParameter::evaluate_formula(
         const PatternParameter::Variables& vars) {
-    Variables::const_iterator itr = vars.find(m_formula);
-    if (itr == vars.end()) {
-        std::stringstream err_msg;
-        err_msg << "Cannot apply formula: " << m_formula;
-        throw RuntimeError(err_msg.str());
-    }
-    m_value = itr->second;
+    m_value = m_compiled_formula.evaluate(vars);
 }
@@ -3,10 +3,12 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <Core/EigenTypedef.h>
 #include <Wires/WireNetwork/WireNetwork.h>
 
+#include "Formula.h"
 #include "ParameterCommon.h"
 
 namespace PyMesh {
@@ -37,6 +39,8 @@ class PatternParameter {
 
         void set_formula(const std::string& formula) {
             m_formula = formula;
+            m_compiled_formula =
+                formula == "" ? Formula() : Formula(formula);
         }
 
         const std::string& get_formula() const {
@@ -47,7 +51,27 @@ class PatternParameter {
         void set_wire_network(WireNetwork::Ptr network) { m_wire_network = network; }
 
     public:
-        virtual void apply(VectorF& results, const Variables& vars)=0;
+        /**
+         * Evaluate the formula (if any) into the parameter value and write
+         * the value into results.
+         */
+        void apply(VectorF& results, const Variables& vars) {
+            if (m_formula != "") evaluate_formula(vars);
+            apply_value(results, m_value);
+        }
+
+        /**
+         * Write value into the entries of results affected by this
+         * parameter.  The parameter itself is not modified.
+         */
+        virtual void apply_value(VectorF& results, Float value) const=0;
+
+        /**
+         * Parameter value for each row of values, whose columns are named by
+         * names.  Without formula, every row gets the current value.
+         */
+        VectorF evaluate_batch(const std::vector<std::string>& names,
+                const MatrixFr& values) const;
 
         /**
          * Compute dv/dp, i.e. gradient of wire vertex location with respect to
@@ -69,6 +93,7 @@ class PatternParameter {
         VectorI m_roi;
         Float m_value;
         std::string m_formula;
+        Formula m_compiled_formula;
 };
 
 }
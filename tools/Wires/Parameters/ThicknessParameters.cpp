@@ -3,6 +3,8 @@
 #include "VertexThicknessParameter.h"
 #include "EdgeThicknessParameter.h"
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 
 using namespace PyMesh;
@@ -44,3 +46,35 @@ VectorF ThicknessParameters::evaluate(
     return results;
 }
 
+VectorF ThicknessParameters::evaluate_batch(
+        const std::vector<std::string>& names, const MatrixFr& values) const {
+    size_t size = 0;
+    if (m_type == ParameterCommon::VERTEX) {
+        size = m_wire_network->get_num_vertices();
+    } else {
+        size = m_wire_network->get_num_edges();
+    }
+
+    std::vector<VectorF> param_values;
+    for (const auto& param : m_params) {
+        param_values.push_back(param->evaluate_batch(names, values));
+    }
+
+    const size_t num_rows = values.rows();
+    VectorF results(num_rows * size);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_rows),
+            [&](const tbb::blocked_range<size_t>& r) {
+                VectorF local_results(size);
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    local_results.setConstant(m_default_thickness);
+                    size_t count = 0;
+                    for (const auto& param : m_params) {
+                        param->apply_value(local_results,
+                                param_values[count][i]);
+                        count++;
+                    }
+                    results.segment(i * size, size) = local_results;
+                }
+            });
+    return results;
+}
@@ -2,6 +2,7 @@
 #pragma once
 #include <list>
 #include <string>
+#include <vector>
 
 #include <Wires/WireNetwork/WireNetwork.h>
 
@@ -29,6 +30,14 @@ class ThicknessParameters : public ParameterList {
 
         VectorF evaluate(const Variables& vars);
 
+        /**
+         * Evaluate thickness for each row of values, whose columns are named
+         * by names.  Results of row i occupy entries [i*n, (i+1)*n), where n
+         * is the number of thickness entries per wire network.
+         */
+        VectorF evaluate_batch(const std::vector<std::string>& names,
+                const MatrixFr& values) const;
+
         Float get_default() const { return m_default_thickness; }
         void set_default(Float value) { m_default_thickness = value; }
 
@@ -8,19 +8,17 @@ VertexCustomOffsetParameter::VertexCustomOffsetParameter(
     PatternParameter(wire_network), m_derivative(offset) {
     }
 
-void VertexCustomOffsetParameter::apply(
-        VectorF& results, const Variables& vars) {
+void VertexCustomOffsetParameter::apply_value(
+        VectorF& results, Float value) const {
     const size_t dim = m_wire_network->get_dim();
     const size_t num_vertices = m_wire_network->get_num_vertices();
     const size_t roi_size = m_roi.size();
     assert(results.size() == dim * num_vertices);
 
-    if (m_formula != "") evaluate_formula(vars);
-
     for (size_t i=0; i<roi_size; i++) {
         size_t v_idx = m_roi[i];
         assert(v_idx < num_vertices);
-        results.segment(v_idx*dim, dim) += m_derivative.row(v_idx) * m_value;
+        results.segment(v_idx*dim, dim) += m_derivative.row(v_idx) * value;
     }
 }
 
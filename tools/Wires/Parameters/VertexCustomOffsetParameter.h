@@ -12,7 +12,7 @@ class VertexCustomOffsetParameter : public PatternParameter {
         virtual ~VertexCustomOffsetParameter() {}
 
     public:
-        virtual void apply(VectorF& results, const Variables& vars);
+        virtual void apply_value(VectorF& results, Float value) const;
         virtual MatrixFr compute_derivative() const;
         virtual ParameterType get_type() const { return VERTEX_OFFSET; }
 
@@ -10,8 +10,8 @@ VertexIsotropicOffsetParameter::VertexIsotropicOffsetParameter(
     assert(m_dof_dir.size() == m_wire_network->get_dim());
 }
 
-void VertexIsotropicOffsetParameter::apply(VectorF& results,
-        const PatternParameter::Variables& vars) {
+void VertexIsotropicOffsetParameter::apply_value(
+        VectorF& results, Float value) const {
     const size_t dim = m_wire_network->get_dim();
     const size_t num_vertices = m_wire_network->get_num_vertices();
     const size_t roi_size = m_roi.size();
@@ -20,13 +20,11 @@ void VertexIsotropicOffsetParameter::apply(VectorF& results,
     assert(results.size() == dim * num_vertices);
     assert(roi_size == m_transforms.size());
 
-    if (m_formula != "") evaluate_formula(vars);
-
     const MatrixFr& vertices = m_wire_network->get_vertices();
     size_t seed_vertex_index = m_roi.minCoeff();
     VectorF seed_vertex = vertices.row(seed_vertex_index);
     VectorF seed_offset = VectorF::Zero(dim);
-    seed_offset = (bbox_max - center).cwiseProduct(m_dof_dir) * m_value;
+    seed_offset = (bbox_max - center).cwiseProduct(m_dof_dir) * value;
 
     for (size_t i=0; i<roi_size; i++) {
         size_t v_idx = m_roi[i];
@@ -21,7 +21,7 @@ class VertexIsotropicOffsetParameter : public PatternParameter {
         virtual ~VertexIsotropicOffsetParameter() {}
 
     public:
-        virtual void apply(VectorF& results, const Variables& vars);
+        virtual void apply_value(VectorF& results, Float value) const;
         virtual MatrixFr compute_derivative() const;
         virtual ParameterType get_type() const { return VERTEX_OFFSET; }
 
@@ -10,8 +10,7 @@ VertexOffsetParameter::VertexOffsetParameter(
     assert(m_axis < m_wire_network->get_dim());
 }
 
-void VertexOffsetParameter::apply(VectorF& results,
-        const PatternParameter::Variables& vars) {
+void VertexOffsetParameter::apply_value(VectorF& results, Float value) const {
     const VectorF bbox_min = m_wire_network->get_bbox_min();
     const VectorF bbox_max = m_wire_network->get_bbox_max();
     const VectorF center = 0.5 * (bbox_min + bbox_max);
@@ -23,8 +22,6 @@ void VertexOffsetParameter::apply(VectorF& results,
     assert(m_axis < dim);
     assert(results.size() == dim * num_vertices);
 
-    if (m_formula != "") evaluate_formula(vars);
-
     const MatrixFr& vertices = m_wire_network->get_vertices();
 
     for (size_t i=0; i<roi_size; i++) {
@@ -35,7 +32,7 @@ void VertexOffsetParameter::apply(VectorF& results,
         Float sign = v[m_axis] - center[m_axis] > 0.0 ? 1.0 : -1.0;
 
         results[v_idx * dim + m_axis] =
-            sign * half_bbox_size[m_axis] * m_value;
+            sign * half_bbox_size[m_axis] * value;
     }
 }
 
@@ -11,7 +11,7 @@ class VertexOffsetParameter : public PatternParameter {
         virtual ~VertexOffsetParameter() {}
 
     public:
-        virtual void apply(VectorF& results, const Variables& vars);
+        virtual void apply_value(VectorF& results, Float value) const;
         virtual MatrixFr compute_derivative() const;
         virtual ParameterType get_type() const { return VERTEX_OFFSET; }
         size_t get_axis() const { return m_axis; }
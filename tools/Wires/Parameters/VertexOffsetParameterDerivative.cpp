@@ -3,17 +3,6 @@
 
 using namespace PyMesh;
 
-namespace VertexOffsetParameterDerivativeHelper {
-    Float compute_projection_ratio(
-            const VectorF& p, const VectorF& end_0, const VectorF& end_1) {
-        VectorF v0 = end_1 - end_0;
-        VectorF v1 = p - end_0;
-        return v1.dot(v0) / v0.squaredNorm();
-    }
-}
-
-using namespace VertexOffsetParameterDerivativeHelper;
-
 MatrixFr VertexOffsetParameterDerivative::compute() {
     WireNetwork::Ptr wire_network = m_parameter->get_wire_network();
 
@@ -36,7 +25,7 @@ MatrixFr VertexOffsetParameterDerivative::compute() {
     MatrixFr wire_derivative = m_parameter->compute_derivative();
 
     for (size_t i=0; i< num_mesh_faces; i++) {
-        int source = m_face_source[i];
+        int source = m_data->face_source[i];
         if (source < 0) {
             // Source is edge
             size_t edge_idx = -source - 1;
@@ -66,32 +55,18 @@ void VertexOffsetParameterDerivative::compute_derivative_on_edge(
         const MatrixFr& wire_derivative,
         MatrixFr& derivative_v,
         VectorF& weights) {
-    const Float eps = 1e-3;
     WireNetwork::Ptr wire_network = m_parameter->get_wire_network();
-
-    const MatrixFr& wire_vertices = wire_network->get_vertices();
     const MatrixIr& wire_edges = wire_network->get_edges();
-
     const Vector2I& edge = wire_edges.row(wire_edge_index);
-    const VectorF& v0 = wire_vertices.row(edge[0]);
-    const VectorF& v1 = wire_vertices.row(edge[1]);
-
-    const VectorI  face = m_mesh->get_face(face_index);
-    const VectorF& c0 = m_mesh->get_vertex(face[0]);
-    const VectorF& c1 = m_mesh->get_vertex(face[1]);
-    const VectorF& c2 = m_mesh->get_vertex(face[2]);
-
-    Float loc_0 = compute_projection_ratio(c0, v0, v1);
-    Float loc_1 = compute_projection_ratio(c1, v0, v1);
-    Float loc_2 = compute_projection_ratio(c2, v0, v1);
 
-    assert(loc_0 >= -eps && loc_0 <= 1.0 + eps);
-    assert(loc_1 >= -eps && loc_1 <= 1.0 + eps);
-    assert(loc_2 >= -eps && loc_2 <= 1.0 + eps);
+    const Vector3I& face = m_data->faces.row(face_index);
+    const Float loc_0 = m_data->face_edge_ratios(face_index, 0);
+    const Float loc_1 = m_data->face_edge_ratios(face_index, 1);
+    const Float loc_2 = m_data->face_edge_ratios(face_index, 2);
 
-    Float w0 = m_face_voronoi_areas(face_index, 0);
-    Float w1 = m_face_voronoi_areas(face_index, 1);
-    Float w2 = m_face_voronoi_areas(face_index, 2);
+    Float w0 = m_data->face_voronoi_areas(face_index, 0);
+    Float w1 = m_data->face_voronoi_areas(face_index, 1);
+    Float w2 = m_data->face_voronoi_areas(face_index, 2);
 
     if (in_roi[edge[0]]) {
         derivative_v.row(face[0]) += w0 * (1.0 - loc_0) * wire_derivative.row(edge[0]);
@@ -121,11 +96,11 @@ void VertexOffsetParameterDerivative::compute_derivative_on_vertex(
         VectorF& weights) {
     if (!in_roi[wire_vertex_index]) return;
 
-    const VectorI face = m_mesh->get_face(face_index);
+    const Vector3I& face = m_data->faces.row(face_index);
 
-    Float w0 = m_face_voronoi_areas(face_index, 0);
-    Float w1 = m_face_voronoi_areas(face_index, 1);
-    Float w2 = m_face_voronoi_areas(face_index, 2);
+    Float w0 = m_data->face_voronoi_areas(face_index, 0);
+    Float w1 = m_data->face_voronoi_areas(face_index, 1);
+    Float w2 = m_data->face_voronoi_areas(face_index, 2);
 
     derivative_v.row(face[0]) = w0 * wire_derivative.row(wire_vertex_index);
     derivative_v.row(face[1]) = w1 * wire_derivative.row(wire_vertex_index);
@@ -11,6 +11,10 @@ class VertexOffsetParameterDerivative : public ParameterDerivative {
         VertexOffsetParameterDerivative(
                 Mesh::Ptr mesh, PatternParameter::Ptr param)
             : ParameterDerivative(mesh, param) {}
+        VertexOffsetParameterDerivative(
+                Mesh::Ptr mesh, PatternParameter::Ptr param,
+                MeshData::Ptr data)
+            : ParameterDerivative(mesh, param, data) {}
         virtual ~VertexOffsetParameterDerivative() {}
 
     public:
@@ -10,17 +10,6 @@
 
 using namespace PyMesh;
 
-namespace VertexThicknessParameterDerivativeHelper {
-    Float compute_projection_ratio(
-            const VectorF& p, const VectorF& end_0, const VectorF& end_1) {
-        VectorF v0 = end_1 - end_0;
-        VectorF v1 = p - end_0;
-        return v1.dot(v0) / v0.squaredNorm();
-    }
-}
-
-using namespace VertexThicknessParameterDerivativeHelper;
-
 MatrixFr VertexThicknessParameterDerivative::compute() {
     WireNetwork::Ptr wire_network = m_parameter->get_wire_network();
 
@@ -42,7 +31,7 @@ MatrixFr VertexThicknessParameterDerivative::compute() {
     VectorF weights = VectorF::Zero(num_mesh_vertices);
 
     for (size_t i=0; i< num_mesh_faces; i++) {
-        int source = m_face_source[i];
+        int source = m_data->face_source[i];
         if (source < 0) {
             // Source is edge
             size_t edge_idx = -source - 1;
@@ -67,33 +56,19 @@ void VertexThicknessParameterDerivative::compute_derivative_on_edge(
         size_t wire_edge_index, size_t face_index,
         const BoolVector& in_roi, MatrixFr& derivative_v,
         VectorF& weights) {
-    const Float eps = 1e-3;
     WireNetwork::Ptr wire_network = m_parameter->get_wire_network();
-
-    const MatrixFr& wire_vertices = wire_network->get_vertices();
     const MatrixIr& wire_edges = wire_network->get_edges();
-
     const Vector2I& edge = wire_edges.row(wire_edge_index);
-    const VectorF&  v0 = wire_vertices.row(edge[0]);
-    const VectorF&  v1 = wire_vertices.row(edge[1]);
-
-    const VectorI  face = m_mesh->get_face(face_index);
-    const VectorF& face_normal = m_face_normals.row(face_index);
-    const VectorF& c0 = m_mesh->get_vertex(face[0]);
-    const VectorF& c1 = m_mesh->get_vertex(face[1]);
-    const VectorF& c2 = m_mesh->get_vertex(face[2]);
-
-    Float loc_0 = compute_projection_ratio(c0, v0, v1);
-    Float loc_1 = compute_projection_ratio(c1, v0, v1);
-    Float loc_2 = compute_projection_ratio(c2, v0, v1);
 
-    assert(loc_0 >= -eps && loc_0 <= 1.0 + eps);
-    assert(loc_1 >= -eps && loc_1 <= 1.0 + eps);
-    assert(loc_2 >= -eps && loc_2 <= 1.0 + eps);
+    const Vector3I& face = m_data->faces.row(face_index);
+    const VectorF& face_normal = m_data->face_normals.row(face_index);
+    const Float loc_0 = m_data->face_edge_ratios(face_index, 0);
+    const Float loc_1 = m_data->face_edge_ratios(face_index, 1);
+    const Float loc_2 = m_data->face_edge_ratios(face_index, 2);
 
-    Float w0 = m_face_voronoi_areas(face_index, 0);
-    Float w1 = m_face_voronoi_areas(face_index, 1);
-    Float w2 = m_face_voronoi_areas(face_index, 2);
+    Float w0 = m_data->face_voronoi_areas(face_index, 0);
+    Float w1 = m_data->face_voronoi_areas(face_index, 1);
+    Float w2 = m_data->face_voronoi_areas(face_index, 2);
 
     if (in_roi[edge[0]]) {
         derivative_v.row(face[0]) += w0 * (1.0 - loc_0) * face_normal.transpose();
@@ -120,12 +95,12 @@ void VertexThicknessParameterDerivative::compute_derivative_on_vertex(
         VectorF& weights) {
     if (!in_roi[wire_vertex_index]) return;
 
-    const VectorI  face = m_mesh->get_face(face_index);
-    const VectorF& face_normal = m_face_normals.row(face_index);
+    const Vector3I& face = m_data->faces.row(face_index);
+    const VectorF& face_normal = m_data->face_normals.row(face_index);
 
-    Float w0 = m_face_voronoi_areas(face_index, 0);
-    Float w1 = m_face_voronoi_areas(face_index, 1);
-    Float w2 = m_face_voronoi_areas(face_index, 2);
+    Float w0 = m_data->face_voronoi_areas(face_index, 0);
+    Float w1 = m_data->face_voronoi_areas(face_index, 1);
+    Float w2 = m_data->face_voronoi_areas(face_index, 2);
 
     derivative_v.row(face[0]) += face_normal.transpose() * w0;
     derivative_v.row(face[1]) += face_normal.transpose() * w1;
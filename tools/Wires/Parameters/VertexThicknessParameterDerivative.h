@@ -11,6 +11,10 @@ class VertexThicknessParameterDerivative : public ParameterDerivative {
         VertexThicknessParameterDerivative(
                 Mesh::Ptr mesh, PatternParameter::Ptr param)
             : ParameterDerivative(mesh, param) { }
+        VertexThicknessParameterDerivative(
+                Mesh::Ptr mesh, PatternParameter::Ptr param,
+                MeshData::Ptr data)
+            : ParameterDerivative(mesh, param, data) {}
         virtual ~VertexThicknessParameterDerivative() {}
 
     public:
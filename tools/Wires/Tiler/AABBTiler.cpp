@@ -1,10 +1,19 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "AABBTiler.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <list>
+#include <map>
+#include <tuple>
 
+#include <tbb/tbb.h>
+
+#include <Wires/Attributes/WireVertexPeriodicIndexAttribute.h>
 #include <Wires/Parameters/ParameterCommon.h>
 
 using namespace PyMesh;
@@ -64,6 +73,299 @@ namespace AABBTilerHelper {
         }
         return operators;
     }
+
+    typedef std::array<int, 3> Index3;
+
+    /**
+     * Unit vertices that coincide across cell boundaries form a periodic
+     * class.  Every member of a class is the class base shifted by a 0/1
+     * lattice step along each axis.  A tiled vertex is identified by its class
+     * and the lattice coordinate of the base, which gives it a fixed slot
+     * before any cell is written.  2D lattices use a single layer along z.
+     */
+    struct PeriodicLattice {
+        Index3 repetitions;
+        std::vector<int> vertex_class;
+        std::vector<Index3> vertex_shift;
+        std::vector<size_t> member_offsets;
+        std::vector<int> members;
+        std::vector<Index3> class_extents;
+        std::vector<size_t> slot_offsets;
+
+        // Unit edges that are translated copies of each other form a group.
+        // Only the first member with a valid cell emits the tiled edge.
+        std::vector<int> edge_anchor;
+        std::vector<int> edge_group;
+        std::vector<size_t> edge_rank;
+        std::vector<size_t> group_offsets;
+        std::vector<int> group_members;
+
+        size_t get_num_cells() const {
+            return size_t(repetitions[0]) * repetitions[1] * repetitions[2];
+        }
+
+        size_t get_num_slots() const {
+            return slot_offsets.back();
+        }
+
+        Index3 get_cell(size_t i) const {
+            Index3 cell;
+            cell[2] = i % repetitions[2]; i /= repetitions[2];
+            cell[1] = i % repetitions[1]; i /= repetitions[1];
+            cell[0] = i;
+            return cell;
+        }
+
+        bool is_valid_cell(const Index3& cell) const {
+            for (size_t i=0; i<3; i++) {
+                if (cell[i] < 0 || cell[i] >= repetitions[i]) return false;
+            }
+            return true;
+        }
+
+        size_t get_slot(int class_id, const Index3& coord) const {
+            const Index3& extent = class_extents[class_id];
+            return slot_offsets[class_id] +
+                (size_t(coord[0]) * extent[1] + coord[1]) * extent[2] + coord[2];
+        }
+
+        /**
+         * Call visitor(unit_vertex, cell) for every cell that places a copy
+         * of a unit vertex into the given slot.
+         */
+        template<typename Visitor>
+        void for_each_copy(size_t slot, Visitor visitor) const {
+            const int class_id = std::upper_bound(slot_offsets.begin(),
+                    slot_offsets.end(), slot) - slot_offsets.begin() - 1;
+            const Index3& extent = class_extents[class_id];
+            size_t local = slot - slot_offsets[class_id];
+            Index3 coord;
+            coord[2] = local % extent[2]; local /= extent[2];
+            coord[1] = local % extent[1]; local /= extent[1];
+            coord[0] = local;
+
+            for (size_t i=member_offsets[class_id];
+                    i<member_offsets[class_id+1]; i++) {
+                const int v = members[i];
+                const Index3& shift = vertex_shift[v];
+                const Index3 cell{{coord[0] - shift[0],
+                    coord[1] - shift[1], coord[2] - shift[2]}};
+                if (is_valid_cell(cell)) visitor(v, cell);
+            }
+        }
+
+        size_t get_tiled_vertex_slot(int v, const Index3& cell) const {
+            const Index3& shift = vertex_shift[v];
+            return get_slot(vertex_class[v], Index3{{cell[0] + shift[0],
+                    cell[1] + shift[1], cell[2] + shift[2]}});
+        }
+
+        bool is_edge_owner(size_t e, const Index3& cell) const {
+            const size_t begin = group_offsets[edge_group[e]];
+            const Index3& shift = vertex_shift[edge_anchor[e]];
+            for (size_t i=begin; i<edge_rank[e]; i++) {
+                const Index3& other_shift =
+                    vertex_shift[edge_anchor[group_members[i]]];
+                const Index3 other_cell{{
+                    cell[0] + shift[0] - other_shift[0],
+                    cell[1] + shift[1] - other_shift[1],
+                    cell[2] + shift[2] - other_shift[2]}};
+                if (is_valid_cell(other_cell)) return false;
+            }
+            return true;
+        }
+    };
+
+    /**
+     * Same tolerance as the duplicated vertex removal it replaces.
+     */
+    const Float PERIODIC_TOL = 1e-3;
+
+    bool compute_vertex_classes(const WireNetwork& unit_network,
+            const VectorF& cell_size, PeriodicLattice& lattice) {
+        const size_t dim = unit_network.get_dim();
+        const size_t num_vertices = unit_network.get_num_vertices();
+        const MatrixFr& vertices = unit_network.get_vertices();
+        const VectorF bbox_min = unit_network.get_bbox_min();
+        const VectorF bbox_max = unit_network.get_bbox_max();
+
+        WireVertexPeriodicIndexAttribute periodic_index;
+        periodic_index.compute(unit_network);
+        const MatrixFr& labels = periodic_index.get_values();
+
+        std::map<int, int> class_map;
+        lattice.vertex_class.resize(num_vertices);
+        for (size_t i=0; i<num_vertices; i++) {
+            const int class_id = class_map.size();
+            auto itr = class_map.insert(
+                    std::make_pair(int(labels(i, 0)), class_id)).first;
+            lattice.vertex_class[i] = itr->second;
+        }
+        const size_t num_classes = class_map.size();
+
+        lattice.member_offsets.assign(num_classes+1, 0);
+        for (const auto class_id : lattice.vertex_class) {
+            lattice.member_offsets[class_id+1]++;
+        }
+        for (size_t i=0; i<num_classes; i++) {
+            lattice.member_offsets[i+1] += lattice.member_offsets[i];
+        }
+        lattice.members.resize(num_vertices);
+        std::vector<size_t> member_count(lattice.member_offsets.begin(),
+                lattice.member_offsets.end()-1);
+        for (size_t i=0; i<num_vertices; i++) {
+            lattice.members[member_count[lattice.vertex_class[i]]++] = i;
+        }
+
+        MatrixFr class_base = MatrixFr::Constant(num_classes, dim,
+                std::numeric_limits<Float>::max());
+        for (size_t i=0; i<num_vertices; i++) {
+            const int class_id = lattice.vertex_class[i];
+            class_base.row(class_id) =
+                class_base.row(class_id).cwiseMin(vertices.row(i));
+        }
+
+        lattice.vertex_shift.assign(num_vertices, Index3{{0, 0, 0}});
+        lattice.class_extents.assign(num_classes, lattice.repetitions);
+        for (size_t i=0; i<num_vertices; i++) {
+            const int class_id = lattice.vertex_class[i];
+            for (size_t j=0; j<dim; j++) {
+                const Float offset = vertices(i, j) - class_base(class_id, j);
+                const int shift = int(std::round(offset / cell_size[j]));
+                if (shift < 0 || shift > 1) return false;
+                if (std::abs(offset - shift * cell_size[j]) > PERIODIC_TOL)
+                    return false;
+                lattice.vertex_shift[i][j] = shift;
+                if (shift > 0) {
+                    lattice.class_extents[class_id][j] =
+                        lattice.repetitions[j] + 1;
+                }
+            }
+        }
+
+        // A vertex on the cell boundary must be matched by a periodic copy
+        // on the opposite side, otherwise neighboring cells would not share it.
+        for (size_t i=0; i<num_vertices; i++) {
+            const int class_id = lattice.vertex_class[i];
+            for (size_t j=0; j<dim; j++) {
+                const bool spans = lattice.class_extents[class_id][j] >
+                    lattice.repetitions[j];
+                if (std::abs(vertices(i, j) - bbox_max[j]) < PERIODIC_TOL &&
+                        lattice.vertex_shift[i][j] == 0) return false;
+                if (std::abs(vertices(i, j) - bbox_min[j]) < PERIODIC_TOL &&
+                        !spans) return false;
+            }
+        }
+
+        lattice.slot_offsets.assign(num_classes+1, 0);
+        for (size_t i=0; i<num_classes; i++) {
+            const Index3& extent = lattice.class_extents[i];
+            lattice.slot_offsets[i+1] = lattice.slot_offsets[i] +
+                size_t(extent[0]) * extent[1] * extent[2];
+        }
+        return true;
+    }
+
+    void compute_edge_groups(const WireNetwork& unit_network,
+            PeriodicLattice& lattice) {
+        typedef std::tuple<int, int, int, int, int> EdgeKey;
+        const size_t num_edges = unit_network.get_num_edges();
+        const MatrixIr& edges = unit_network.get_edges();
+
+        std::vector<std::pair<EdgeKey, int> > keys(num_edges);
+        lattice.edge_anchor.resize(num_edges);
+        for (size_t i=0; i<num_edges; i++) {
+            int v0 = edges(i, 0);
+            int v1 = edges(i, 1);
+            Index3 delta;
+            for (size_t j=0; j<3; j++) {
+                delta[j] = lattice.vertex_shift[v1][j] -
+                    lattice.vertex_shift[v0][j];
+            }
+            // Orient the key so reversed copies of an edge compare equal.
+            const int c0 = lattice.vertex_class[v0];
+            const int c1 = lattice.vertex_class[v1];
+            if (c0 > c1 || (c0 == c1 && delta < Index3{{0, 0, 0}})) {
+                std::swap(v0, v1);
+                for (auto& d : delta) d = -d;
+            }
+            lattice.edge_anchor[i] = v0;
+            keys[i] = std::make_pair(EdgeKey(lattice.vertex_class[v0],
+                        lattice.vertex_class[v1], delta[0], delta[1], delta[2]),
+                    int(i));
+        }
+        std::sort(keys.begin(), keys.end());
+
+        lattice.edge_group.resize(num_edges);
+        lattice.edge_rank.resize(num_edges);
+        lattice.group_members.resize(num_edges);
+        lattice.group_offsets.clear();
+        for (size_t i=0; i<num_edges; i++) {
+            if (i == 0 || keys[i].first != keys[i-1].first) {
+                lattice.group_offsets.push_back(i);
+            }
+            const int e = keys[i].second;
+            lattice.edge_group[e] = lattice.group_offsets.size() - 1;
+            lattice.edge_rank[e] = i;
+            lattice.group_members[i] = e;
+        }
+        lattice.group_offsets.push_back(num_edges);
+    }
+
+    bool compute_periodic_lattice(const WireNetwork& unit_network,
+            const VectorF& cell_size, const VectorI& repetitions,
+            PeriodicLattice& lattice) {
+        const size_t dim = unit_network.get_dim();
+        if (dim != 2 && dim != 3) return false;
+        lattice.repetitions = Index3{{1, 1, 1}};
+        for (size_t i=0; i<dim; i++) {
+            if (repetitions[i] <= 0) return false;
+            lattice.repetitions[i] = repetitions[i];
+        }
+
+        if (!compute_vertex_classes(unit_network, cell_size, lattice))
+            return false;
+        compute_edge_groups(unit_network, lattice);
+        return true;
+    }
+
+    /**
+     * Vertex values of the copies merged into a tiled vertex are averaged,
+     * as the duplicated vertex removal used to do.
+     */
+    MatrixFr tile_vertex_values(const PeriodicLattice& lattice,
+            const std::vector<size_t>& vertex_slots, const MatrixFr& values) {
+        const size_t num_vertices = vertex_slots.size();
+        const size_t cols = values.cols();
+        MatrixFr result = MatrixFr::Zero(num_vertices, cols);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        size_t count = 0;
+                        lattice.for_each_copy(vertex_slots[i],
+                                [&](int v, const Index3& cell) {
+                                    result.row(i) += values.row(v);
+                                    count++;
+                                });
+                        assert(count > 0);
+                        result.row(i) /= Float(count);
+                    }
+                });
+        return result;
+    }
+
+    MatrixFr tile_edge_values(const std::vector<int>& edge_sources,
+            const MatrixFr& values) {
+        const size_t num_edges = edge_sources.size();
+        MatrixFr result(num_edges, values.cols());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_edges),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        result.row(i) = values.row(edge_sources[i]);
+                    }
+                });
+        return result;
+    }
 }
 
 using namespace AABBTilerHelper;
@@ -88,6 +390,142 @@ WireNetwork::Ptr AABBTiler::tile() {
             m_repetitions.cast<Float>());
     normalize_unit_wire(cell_size);
 
+    WireNetwork::Ptr tiled_network = tile_periodic(cell_size);
+    if (!tiled_network) {
+        tiled_network = tile_with_clean_up(cell_size);
+    }
+    return tiled_network;
+}
+
+WireNetwork::Ptr AABBTiler::tile_periodic(const VectorF& cell_size) {
+    PeriodicLattice lattice;
+    if (!compute_periodic_lattice(*m_unit_wire_network, cell_size,
+                m_repetitions, lattice)) {
+        return WireNetwork::Ptr();
+    }
+
+    const size_t dim = m_unit_wire_network->get_dim();
+    const size_t num_cells = lattice.get_num_cells();
+    const size_t num_slots = lattice.get_num_slots();
+    const size_t num_unit_edges = m_unit_wire_network->get_num_edges();
+    const MatrixFr& unit_vertices = m_unit_wire_network->get_vertices();
+    const MatrixIr& unit_edges = m_unit_wire_network->get_edges();
+    const VectorF ref_pt = m_unit_wire_network->get_bbox_min();
+
+    // Slots along the outer lattice boundary may receive no copy.
+    std::vector<int> slot_map(num_slots);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_slots),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    int used = 0;
+                    lattice.for_each_copy(i,
+                            [&](int v, const Index3& cell) { used = 1; });
+                    slot_map[i] = used;
+                }
+            });
+    std::vector<size_t> vertex_slots;
+    vertex_slots.reserve(num_slots);
+    for (size_t i=0; i<num_slots; i++) {
+        if (slot_map[i]) {
+            slot_map[i] = vertex_slots.size();
+            vertex_slots.push_back(i);
+        } else {
+            slot_map[i] = -1;
+        }
+    }
+    const size_t num_vertices = vertex_slots.size();
+
+    MatrixFr tiled_vertices(num_vertices, dim);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_vertices),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    bool assigned = false;
+                    lattice.for_each_copy(vertex_slots[i],
+                            [&](int v, const Index3& cell) {
+                                if (assigned) return;
+                                for (size_t j=0; j<dim; j++) {
+                                    tiled_vertices(i, j) = unit_vertices(v, j)
+                                        + cell_size[j] * cell[j] - ref_pt[j];
+                                }
+                                assigned = true;
+                            });
+                }
+            });
+
+    std::vector<size_t> edge_offsets(num_cells+1, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_cells),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Index3 cell = lattice.get_cell(i);
+                    size_t count = 0;
+                    for (size_t j=0; j<num_unit_edges; j++) {
+                        if (lattice.is_edge_owner(j, cell)) count++;
+                    }
+                    edge_offsets[i+1] = count;
+                }
+            });
+    for (size_t i=0; i<num_cells; i++) {
+        edge_offsets[i+1] += edge_offsets[i];
+    }
+
+    const size_t num_edges = edge_offsets.back();
+    MatrixIr tiled_edges(num_edges, 2);
+    std::vector<int> edge_sources(num_edges);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_cells),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    const Index3 cell = lattice.get_cell(i);
+                    size_t count = edge_offsets[i];
+                    for (size_t j=0; j<num_unit_edges; j++) {
+                        if (!lattice.is_edge_owner(j, cell)) continue;
+                        for (size_t k=0; k<2; k++) {
+                            tiled_edges(count, k) = slot_map[
+                                lattice.get_tiled_vertex_slot(
+                                        unit_edges(j, k), cell)];
+                        }
+                        edge_sources[count] = j;
+                        count++;
+                    }
+                }
+            });
+
+    WireNetwork::Ptr tiled_network =
+        WireNetwork::create_raw(tiled_vertices, tiled_edges);
+
+    auto add_tiled_attribute = [&](const std::string& name,
+            bool vertex_wise, const MatrixFr& values) {
+        tiled_network->add_attribute(name, vertex_wise, false);
+        if (vertex_wise) {
+            tiled_network->set_attribute(name,
+                    tile_vertex_values(lattice, vertex_slots, values));
+        } else {
+            tiled_network->set_attribute(name,
+                    tile_edge_values(edge_sources, values));
+        }
+    };
+
+    std::vector<std::string> attr_names =
+        m_unit_wire_network->get_attribute_names();
+    for (const auto& name : attr_names) {
+        add_tiled_attribute(name,
+                m_unit_wire_network->is_vertex_attribute(name),
+                m_unit_wire_network->get_attribute(name));
+    }
+
+    // Parameters are not spatially varying here, so every cell shares the
+    // values evaluated on the unit wire.
+    assert(m_params);
+    ParameterCommon::Variables vars;
+    add_tiled_attribute("thickness",
+            m_params->get_thickness_type() == ParameterCommon::VERTEX,
+            m_params->evaluate_thickness(vars));
+    add_tiled_attribute("vertex_offset", true,
+            m_params->evaluate_offset(vars));
+
+    return tiled_network;
+}
+
+WireNetwork::Ptr AABBTiler::tile_with_clean_up(const VectorF& cell_size) {
     std::vector<VectorI> indices = enumerate(m_repetitions);
     const size_t num_repetitions = indices.size();
     auto transforms = get_tiling_operators(m_unit_wire_network->get_bbox_min(),
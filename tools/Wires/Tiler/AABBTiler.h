@@ -17,6 +17,15 @@ class AABBTiler : public TilerEngine {
         virtual WireNetwork::Ptr tile();
 
     protected:
+        /**
+         * Tile by periodic vertex classes of the unit wire.  Output offsets
+         * are known before any cell is written, so cells are filled in
+         * parallel and vertices shared across cell boundaries are never
+         * duplicated.  Returns nullptr if the unit wire is not periodic.
+         */
+        WireNetwork::Ptr tile_periodic(const VectorF& cell_size);
+        WireNetwork::Ptr tile_with_clean_up(const VectorF& cell_size);
+
         void evaluate_parameters(
                 WireNetwork& wire_network, const FuncList& funcs);
         void evaluate_thickness_parameters(
@@ -1,6 +1,8 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "MeshTiler.h"
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 #include <Wires/Misc/BilinearInterpolation.h>
 #include <Wires/Misc/TrilinearInterpolation.h>
@@ -72,68 +74,49 @@ void MeshTiler::scale_to_unit_box() {
 
 void MeshTiler::evaluate_parameters(WireNetwork& wire_network,
         const MeshTiler::FuncList& funcs) {
-    evaluate_thickness_parameters(wire_network, funcs);
-    evaluate_offset_parameters(wire_network, funcs);
+    std::vector<std::string> names;
+    MatrixFr values;
+    extract_cell_variables(m_mesh, names, values);
+    assert(size_t(values.rows()) == funcs.size());
+
+    evaluate_thickness_parameters(wire_network, names, values);
+    evaluate_offset_parameters(wire_network, funcs, names, values);
 }
 
 void MeshTiler::evaluate_thickness_parameters(WireNetwork& wire_network,
-        const MeshTiler::FuncList& funcs) {
-    const size_t num_vertices = wire_network.get_num_vertices();
-    const size_t num_edges = wire_network.get_num_edges();
-    const size_t num_unit_vertices = m_unit_wire_network->get_num_vertices();
-    const size_t num_unit_edges = m_unit_wire_network->get_num_edges();
-
-    size_t num_thickness_entries, thickness_index_stride;
+        const std::vector<std::string>& names, const MatrixFr& values) {
     if (m_params->get_thickness_type() == ParameterCommon::VERTEX) {
-        thickness_index_stride = num_unit_vertices;
-        num_thickness_entries = num_vertices;
         wire_network.add_attribute("thickness", true);
     } else {
-        thickness_index_stride = num_unit_edges;
-        num_thickness_entries = num_edges;
         wire_network.add_attribute("thickness", false);
     }
-    MatrixFr thickness(num_thickness_entries, 1);
-
-    auto vars_array = extract_attributes(m_mesh);
-    assert(vars_array.size() == funcs.size());
-    size_t count=0;
-    auto vars_itr = vars_array.begin();
-    for (auto f : funcs) {
-        assert(vars_itr != vars_array.end());
-        VectorF local_thickness = m_params->evaluate_thickness(*vars_itr);
-        thickness.block(count * thickness_index_stride, 0,
-                thickness_index_stride, 1) = local_thickness;
-        count++;
-        vars_itr++;
-    }
+
+    // Formulas are compiled once and evaluated for all cells in parallel.
+    MatrixFr thickness = m_params->evaluate_thickness_batch(names, values);
     wire_network.set_attribute("thickness", thickness);
 }
 
 void MeshTiler::evaluate_offset_parameters(WireNetwork& wire_network,
-        const MeshTiler::FuncList& funcs) {
+        const MeshTiler::FuncList& funcs,
+        const std::vector<std::string>& names, const MatrixFr& values) {
     const size_t dim = wire_network.get_dim();
-    const size_t num_vertices = wire_network.get_num_vertices();
     const size_t num_unit_vertices = m_unit_wire_network->get_num_vertices();
 
     wire_network.add_attribute("vertex_offset", true);
-    MatrixFr attr_value(num_vertices, dim);
+    MatrixFr attr_value = m_params->evaluate_offset_batch(names, values);
+    assert(size_t(attr_value.rows()) == wire_network.get_num_vertices());
 
-    auto vars_array = extract_attributes(m_mesh);
     const MatrixFr& ori_vertices = m_unit_wire_network->get_vertices();
-    size_t count=0;
-    auto vars_itr = vars_array.begin();
-    for (auto f : funcs) {
-        assert(vars_itr != vars_array.end());
-        MatrixFr local_offseted_vertices = ori_vertices +
-            m_params->evaluate_offset(*vars_itr);
-        attr_value.block(count * num_unit_vertices, 0,
-                num_unit_vertices, dim) = f(local_offseted_vertices);
-        count++;
-        vars_itr++;
-    }
+    const std::vector<Func> func_array(funcs.begin(), funcs.end());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, func_array.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    auto block = attr_value.block(i * num_unit_vertices, 0,
+                            num_unit_vertices, dim);
+                    block = func_array[i](ori_vertices + MatrixFr(block));
+                }
+            });
 
     attr_value = attr_value - wire_network.get_vertices();
     wire_network.set_attribute("vertex_offset", attr_value);
 }
-
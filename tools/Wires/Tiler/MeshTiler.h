@@ -1,6 +1,9 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "TilerEngine.h"
 #include <Mesh.h>
 
@@ -24,10 +27,13 @@ class MeshTiler : public TilerEngine {
 
         void evaluate_parameters(
                 WireNetwork& wire_network, const FuncList& funcs);
-        void evaluate_thickness_parameters(
-                WireNetwork& wire_network, const FuncList& funcs);
-        void evaluate_offset_parameters(
-                WireNetwork& wire_network, const FuncList& funcs);
+        void evaluate_thickness_parameters(WireNetwork& wire_network,
+                const std::vector<std::string>& names,
+                const MatrixFr& values);
+        void evaluate_offset_parameters(WireNetwork& wire_network,
+                const FuncList& funcs,
+                const std::vector<std::string>& names,
+                const MatrixFr& values);
 
     private:
         MeshPtr m_mesh;
@@ -1,6 +1,10 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #include "MeshTilerHelper.h"
 
+#include <algorithm>
+
+#include <tbb/tbb.h>
+
 #include <Core/EigenTypedef.h>
 #include <Core/Exception.h>
 
@@ -109,3 +113,68 @@ std::vector<ParameterCommon::Variables> MeshTilerHelper::extract_attributes(
         throw RuntimeError(err_msg.str());
     }
 }
+
+void MeshTilerHelper::extract_cell_variables(Mesh::Ptr mesh,
+        std::vector<std::string>& names, MatrixFr& values) {
+    const size_t dim = mesh->get_dim();
+    size_t num_cells, num_vertex_per_cell;
+    const VectorI* cells;
+    if (dim == 2) {
+        num_cells = mesh->get_num_faces();
+        num_vertex_per_cell = mesh->get_vertex_per_face();
+        cells = &mesh->get_faces();
+    } else if (dim == 3) {
+        num_cells = mesh->get_num_voxels();
+        num_vertex_per_cell = mesh->get_vertex_per_voxel();
+        cells = &mesh->get_voxels();
+    } else {
+        std::stringstream err_msg;
+        err_msg << "Unsupport dim: " << dim;
+        throw RuntimeError(err_msg.str());
+    }
+
+    names.clear();
+    std::vector<const VectorF*> attributes;
+    for (const auto& name : mesh->get_float_attribute_names()) {
+        const VectorF& attr = mesh->get_float_attribute(name);
+        if (size_t(attr.size()) != num_cells) continue;
+        names.push_back(name);
+        attributes.push_back(&attr);
+    }
+
+    // Attributes take precedence over coordinates of the same name.
+    const char* coordinate_names[3] = {"x", "y", "z"};
+    std::vector<size_t> coordinate_axes;
+    for (size_t i=0; i<dim; i++) {
+        if (std::find(names.begin(), names.end(), coordinate_names[i])
+                == names.end()) {
+            names.push_back(coordinate_names[i]);
+            coordinate_axes.push_back(i);
+        }
+    }
+
+    const size_t num_attributes = attributes.size();
+    values.resize(num_cells, names.size());
+    const VectorF& vertices = mesh->get_vertices();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_cells),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    for (size_t j=0; j<num_attributes; j++) {
+                        values(i, j) = (*attributes[j])[i];
+                    }
+
+                    VectorF centroid = VectorF::Zero(dim);
+                    for (size_t j=0; j<num_vertex_per_cell; j++) {
+                        const size_t vi = (*cells)[i*num_vertex_per_cell+j];
+                        centroid += vertices.segment(vi*dim, dim);
+                    }
+                    centroid /= num_vertex_per_cell;
+
+                    size_t col = num_attributes;
+                    for (auto axis : coordinate_axes) {
+                        values(i, col) = centroid[axis];
+                        col++;
+                    }
+                }
+            });
+}
@@ -1,6 +1,7 @@
 /* This file is part of PyMesh. Copyright (c) 2015 by Qingnan Zhou */
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "TilerEngine.h"
@@ -18,5 +19,13 @@ namespace MeshTilerHelper {
     std::vector<ParameterCommon::Variables> extract_voxel_attributes(Mesh::Ptr mesh);
 
     std::vector<ParameterCommon::Variables> extract_attributes(Mesh::Ptr mesh);
+
+    /**
+     * Gather per-cell variables for formula evaluation as a table with one
+     * row per cell (face in 2D, voxel in 3D).  Columns are the scalar cell
+     * attributes of mesh followed by the cell centroid "x", "y" (and "z").
+     */
+    void extract_cell_variables(Mesh::Ptr mesh,
+            std::vector<std::string>& names, MatrixFr& values);
 }
 }
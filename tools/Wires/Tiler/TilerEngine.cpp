@@ -7,6 +7,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include <tbb/tbb.h>
+
 #include <Core/Exception.h>
 #include <MeshUtils/DuplicatedVertexRemoval.h>
 #include <Misc/Multiplet.h>
@@ -74,13 +76,17 @@ MatrixFr TilerEngine::tile_vertices(const TilerEngine::FuncList& funcs) {
     const size_t num_vertices = m_unit_wire_network->get_num_vertices();
     const MatrixFr& vertices = m_unit_wire_network->get_vertices();
 
+    // Each copy owns a fixed block of the output, so copies can be written
+    // concurrently.
+    const std::vector<Func> func_array(funcs.begin(), funcs.end());
     MatrixFr tiled_vertices(num_copies * num_vertices, dim);
-
-    size_t vertex_count = 0;
-    for (auto f : funcs) {
-        tiled_vertices.block(vertex_count, 0, num_vertices, dim) = f(vertices);
-        vertex_count += num_vertices;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_copies),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    tiled_vertices.block(i*num_vertices, 0, num_vertices, dim) =
+                        func_array[i](vertices);
+                }
+            });
 
     return tiled_vertices;
 }
@@ -88,15 +94,16 @@ MatrixFr TilerEngine::tile_vertices(const TilerEngine::FuncList& funcs) {
 MatrixIr TilerEngine::tile_edges(size_t num_repetitions) {
     const size_t num_vertices = m_unit_wire_network->get_num_vertices();
     const size_t num_edges    = m_unit_wire_network->get_num_edges();
+    const MatrixIr& edges = m_unit_wire_network->get_edges();
 
     MatrixIr tiled_edges(num_edges * num_repetitions, 2);
-
-    size_t vertex_count = 0;
-    for (size_t i=0; i<num_repetitions; i++) {
-        tiled_edges.block(num_edges * i, 0, num_edges, 2) =
-            m_unit_wire_network->get_edges().array() + vertex_count;
-        vertex_count += num_vertices;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_repetitions),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i=r.begin(); i!=r.end(); i++) {
+                    tiled_edges.block(num_edges * i, 0, num_edges, 2) =
+                        edges.array() + int(num_vertices * i);
+                }
+            });
     return tiled_edges;
 }
 
@@ -128,10 +135,12 @@ void TilerEngine::update_attributes(WireNetwork& wire_network, size_t num_repeti
         const size_t rows = values.rows();
         const size_t cols = values.cols();
         MatrixFr tiled_values(rows * num_repetitions, cols);
-
-        for (size_t i=0; i<num_repetitions; i++) {
-            tiled_values.block(i*rows, 0, rows, cols) = values;
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_repetitions),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i=r.begin(); i!=r.end(); i++) {
+                        tiled_values.block(i*rows, 0, rows, cols) = values;
+                    }
+                });
 
         wire_network.set_attribute(name, tiled_values);
     }